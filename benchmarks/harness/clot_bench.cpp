@@ -0,0 +1,895 @@
+// clot-bench: repeatable timings for the .clot programs in benchmarks/cases.
+//
+// Every run is a fresh process (so startup and parsing are part of the
+// figure), started after `--warmup` discarded runs. Per case and mode it
+// reports median, p95, mean, standard deviation and minimum wall time, the
+// largest RSS seen and, where the kernel allows perf counters, the median
+// count of user-space instructions. Results can be written as JSON and
+// compared with a previous JSON file; a case regresses when its median grows
+// by more than `--threshold` percent (instructions are compared instead of
+// time when both files have them, since they are far less noisy).
+//
+// POSIX only: fork/exec, wait4 and, on Linux, perf_event_open.
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+
+#include "clot/runtime/env.hpp"
+#include "clot/runtime/i18n.hpp"
+
+namespace {
+
+using clot::runtime::Tr;
+
+enum class BenchMode {
+    Interpret,
+    Compile,
+};
+
+std::string ModeName(BenchMode mode) {
+    return mode == BenchMode::Interpret ? "interpret" : "compile";
+}
+
+struct BenchOptions {
+    std::string clot_path = "./build/wsl-release/clot";
+    std::vector<std::string> inputs;
+    std::size_t runs = 10;
+    std::size_t warmup = 2;
+    std::vector<BenchMode> modes = {BenchMode::Interpret, BenchMode::Compile};
+    // name -> value, applied to `name = ...;  // bench:param` lines.
+    std::vector<std::pair<std::string, std::string>> params;
+    std::string filter;
+    std::string json_path;
+    std::string baseline_path;
+    double threshold_percent = 5.0;
+    bool show_help = false;
+};
+
+struct RunSample {
+    double wall_ms = 0.0;
+    std::uint64_t max_rss_kb = 0;
+    std::optional<std::uint64_t> instructions;
+};
+
+struct CaseResult {
+    std::string name;
+    BenchMode mode = BenchMode::Interpret;
+    bool ok = false;
+    std::string error;
+    std::optional<double> compile_ms;
+    std::size_t runs = 0;
+    double median_ms = 0.0;
+    double p95_ms = 0.0;
+    double mean_ms = 0.0;
+    double stddev_ms = 0.0;
+    double min_ms = 0.0;
+    std::uint64_t max_rss_kb = 0;
+    std::optional<std::uint64_t> instructions;
+};
+
+void PrintHelp() {
+    std::cout << Tr(
+        "Uso: clot-bench [casos...] [opciones]\n\n"
+        "Casos: archivos .clot o directorios (por defecto benchmarks/cases).\n\n"
+        "Opciones:\n"
+        "  --clot <ruta>            Binario clot a medir (por defecto ./build/wsl-release/clot)\n"
+        "  -n, --runs <n>           Ejecuciones medidas por caso y modo (por defecto 10)\n"
+        "  -w, --warmup <n>         Ejecuciones descartadas antes de medir (por defecto 2)\n"
+        "  --modes <lista>          interpret, compile o interpret,compile (por defecto ambos)\n"
+        "  --param <nombre>=<valor> Sustituye lineas 'nombre = ...;  // bench:param' de los casos\n"
+        "  --filter <texto>         Solo casos cuyo nombre contiene el texto\n"
+        "  --json <archivo>         Escribe los resultados en JSON\n"
+        "  --baseline <archivo>     Compara con un JSON previo; sale con 1 si hay regresiones\n"
+        "  --threshold <pct>        Crecimiento de la mediana tolerado (por defecto 5)\n"
+        "  -h, --help               Muestra esta ayuda\n",
+        "Usage: clot-bench [cases...] [options]\n\n"
+        "Cases: .clot files or directories (default benchmarks/cases).\n\n"
+        "Options:\n"
+        "  --clot <path>            clot binary to measure (default ./build/wsl-release/clot)\n"
+        "  -n, --runs <n>           Measured runs per case and mode (default 10)\n"
+        "  -w, --warmup <n>         Discarded runs before measuring (default 2)\n"
+        "  --modes <list>           interpret, compile or interpret,compile (default both)\n"
+        "  --param <name>=<value>   Replace 'name = ...;  // bench:param' lines in the cases\n"
+        "  --filter <text>          Only cases whose name contains the text\n"
+        "  --json <file>            Write the results as JSON\n"
+        "  --baseline <file>        Compare with an earlier JSON; exit 1 on regressions\n"
+        "  --threshold <pct>        Tolerated growth of the median (default 5)\n"
+        "  -h, --help               Show this help\n");
+}
+
+bool ParseCount(const std::string& text, std::size_t* out_value) {
+    if (text.empty() || !std::all_of(text.begin(), text.end(), [](unsigned char c) { return std::isdigit(c); })) {
+        return false;
+    }
+    *out_value = static_cast<std::size_t>(std::strtoull(text.c_str(), nullptr, 10));
+    return true;
+}
+
+bool ParseArgs(int argc, char* argv[], BenchOptions* out_options, std::string* out_error) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const auto next_value = [&](std::string* out_value) {
+            if (i + 1 >= argc) {
+                *out_error = Tr("Falta valor para ", "Missing value for ") + arg + ".";
+                return false;
+            }
+            *out_value = argv[++i];
+            return true;
+        };
+
+        std::string value;
+        if (arg == "-h" || arg == "--help") {
+            out_options->show_help = true;
+        } else if (arg == "--clot") {
+            if (!next_value(&out_options->clot_path)) {
+                return false;
+            }
+        } else if (arg == "-n" || arg == "--runs") {
+            if (!next_value(&value)) {
+                return false;
+            }
+            if (!ParseCount(value, &out_options->runs) || out_options->runs == 0) {
+                *out_error = Tr("Cantidad de ejecuciones invalida: ", "Invalid run count: ") + value;
+                return false;
+            }
+        } else if (arg == "-w" || arg == "--warmup") {
+            if (!next_value(&value)) {
+                return false;
+            }
+            if (!ParseCount(value, &out_options->warmup)) {
+                *out_error = Tr("Cantidad de calentamientos invalida: ", "Invalid warmup count: ") + value;
+                return false;
+            }
+        } else if (arg == "--modes") {
+            if (!next_value(&value)) {
+                return false;
+            }
+            out_options->modes.clear();
+            std::stringstream parts(value);
+            std::string part;
+            while (std::getline(parts, part, ',')) {
+                if (part == "interpret") {
+                    out_options->modes.push_back(BenchMode::Interpret);
+                } else if (part == "compile") {
+                    out_options->modes.push_back(BenchMode::Compile);
+                } else {
+                    *out_error = Tr("Modo invalido: ", "Invalid mode: ") + part;
+                    return false;
+                }
+            }
+            if (out_options->modes.empty()) {
+                *out_error = Tr("Modo invalido: ", "Invalid mode: ") + value;
+                return false;
+            }
+        } else if (arg == "--param") {
+            if (!next_value(&value)) {
+                return false;
+            }
+            const std::size_t equals = value.find('=');
+            const bool valid_name =
+                equals != std::string::npos && equals > 0 &&
+                std::all_of(value.begin(), value.begin() + static_cast<std::ptrdiff_t>(equals), [](unsigned char c) {
+                    return std::isalnum(c) || c == '_';
+                });
+            if (!valid_name) {
+                *out_error = Tr("Parametro invalido (se espera nombre=valor): ", "Invalid parameter (expected name=value): ") +
+                             value;
+                return false;
+            }
+            out_options->params.emplace_back(value.substr(0, equals), value.substr(equals + 1));
+        } else if (arg == "--filter") {
+            if (!next_value(&out_options->filter)) {
+                return false;
+            }
+        } else if (arg == "--json") {
+            if (!next_value(&out_options->json_path)) {
+                return false;
+            }
+        } else if (arg == "--baseline") {
+            if (!next_value(&out_options->baseline_path)) {
+                return false;
+            }
+        } else if (arg == "--threshold") {
+            if (!next_value(&value)) {
+                return false;
+            }
+            char* end = nullptr;
+            out_options->threshold_percent = std::strtod(value.c_str(), &end);
+            if (end == value.c_str() || *end != '\0' || out_options->threshold_percent < 0.0) {
+                *out_error = Tr("Umbral invalido: ", "Invalid threshold: ") + value;
+                return false;
+            }
+        } else if (!arg.empty() && arg[0] == '-') {
+            *out_error = Tr("Opcion desconocida: ", "Unknown option: ") + arg;
+            return false;
+        } else {
+            out_options->inputs.push_back(arg);
+        }
+    }
+
+    if (out_options->inputs.empty()) {
+        out_options->inputs.push_back("benchmarks/cases");
+    }
+    return true;
+}
+
+std::vector<std::filesystem::path> CollectCases(const BenchOptions& options) {
+    std::vector<std::filesystem::path> cases;
+    for (const std::string& input : options.inputs) {
+        const std::filesystem::path path(input);
+        if (std::filesystem::is_directory(path)) {
+            std::vector<std::filesystem::path> found;
+            for (const auto& entry : std::filesystem::directory_iterator(path)) {
+                const std::string file_name = entry.path().filename().string();
+                // Leftovers of --param runs start with a dot.
+                if (entry.is_regular_file() && entry.path().extension() == ".clot" && file_name[0] != '.') {
+                    found.push_back(entry.path());
+                }
+            }
+            std::sort(found.begin(), found.end());
+            cases.insert(cases.end(), found.begin(), found.end());
+        } else {
+            cases.push_back(path);
+        }
+    }
+
+    if (!options.filter.empty()) {
+        cases.erase(std::remove_if(cases.begin(),
+                                   cases.end(),
+                                   [&](const std::filesystem::path& path) {
+                                       return path.stem().string().find(options.filter) == std::string::npos;
+                                   }),
+                    cases.end());
+    }
+    return cases;
+}
+
+// Copy of `source` with the --param values applied, written beside it (so
+// relative imports resolve the same way) as .<stem>.bench.clot. Returns the
+// original path when no parameter line matches.
+bool ApplyParams(const std::filesystem::path& source,
+                 const std::vector<std::pair<std::string, std::string>>& params,
+                 std::filesystem::path* out_path,
+                 std::string* out_label,
+                 std::string* out_error) {
+    *out_path = source;
+    *out_label = source.stem().string();
+    if (params.empty()) {
+        return true;
+    }
+
+    std::ifstream input(source);
+    if (!input) {
+        *out_error = Tr("No se pudo abrir el archivo: ", "Could not open file: ") + source.string();
+        return false;
+    }
+
+    std::vector<std::regex> patterns;
+    for (const auto& param : params) {
+        patterns.emplace_back("^(\\s*)" + param.first + "\\s*=\\s*[^;]*;(\\s*//\\s*bench:param.*)$");
+    }
+
+    std::string text;
+    std::string line;
+    std::vector<std::string> applied;
+    while (std::getline(input, line)) {
+        for (std::size_t i = 0; i < params.size(); ++i) {
+            std::smatch match;
+            if (std::regex_match(line, match, patterns[i])) {
+                line = match[1].str() + params[i].first + " = " + params[i].second + ";" + match[2].str();
+                applied.push_back(params[i].first + "=" + params[i].second);
+            }
+        }
+        text += line;
+        text += '\n';
+    }
+    if (applied.empty()) {
+        return true;
+    }
+
+    *out_path = source.parent_path() / ("." + source.stem().string() + ".bench.clot");
+    std::ofstream output(*out_path, std::ios::binary | std::ios::trunc);
+    output << text;
+    if (!output) {
+        *out_error = Tr("No se pudo escribir ", "Could not write ") + out_path->string();
+        return false;
+    }
+
+    *out_label += "[";
+    for (std::size_t i = 0; i < applied.size(); ++i) {
+        *out_label += (i == 0 ? "" : ",") + applied[i];
+    }
+    *out_label += "]";
+    return true;
+}
+
+#if defined(__linux__)
+// User-space instructions retired by `pid` and its descendants, counting from
+// its next exec. -1 when perf events are unavailable (no PMU, container,
+// perf_event_paranoid).
+int OpenInstructionCounter(pid_t pid) {
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.disabled = 1;
+    attr.enable_on_exec = 1;
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, pid, -1, -1, PERF_FLAG_FD_CLOEXEC));
+}
+#endif
+
+// Runs argv once with stdout and stderr discarded. The child waits on a pipe
+// until the parent has attached the instruction counter, so the count and
+// the wall time both start at exec.
+bool RunOnce(const std::vector<std::string>& argv, RunSample* out_sample, std::string* out_error) {
+    int sync_pipe[2];
+    if (pipe(sync_pipe) != 0) {
+        *out_error = std::string("pipe: ") + std::strerror(errno);
+        return false;
+    }
+
+    const pid_t pid = fork();
+    if (pid < 0) {
+        *out_error = std::string("fork: ") + std::strerror(errno);
+        close(sync_pipe[0]);
+        close(sync_pipe[1]);
+        return false;
+    }
+
+    if (pid == 0) {
+        close(sync_pipe[1]);
+        char go = 0;
+        if (read(sync_pipe[0], &go, 1) != 1) {
+            _exit(127);
+        }
+        close(sync_pipe[0]);
+        const int null_fd = open("/dev/null", O_WRONLY);
+        if (null_fd >= 0) {
+            dup2(null_fd, STDOUT_FILENO);
+            dup2(null_fd, STDERR_FILENO);
+            close(null_fd);
+        }
+        std::vector<char*> raw_argv;
+        for (const std::string& arg : argv) {
+            raw_argv.push_back(const_cast<char*>(arg.c_str()));
+        }
+        raw_argv.push_back(nullptr);
+        execvp(raw_argv[0], raw_argv.data());
+        _exit(127);
+    }
+
+    close(sync_pipe[0]);
+    int counter_fd = -1;
+#if defined(__linux__)
+    counter_fd = OpenInstructionCounter(pid);
+#endif
+
+    const auto start = std::chrono::steady_clock::now();
+    const bool released = write(sync_pipe[1], "x", 1) == 1;
+    close(sync_pipe[1]);
+
+    int status = 0;
+    rusage usage{};
+    const pid_t waited = wait4(pid, &status, 0, &usage);
+    const auto end = std::chrono::steady_clock::now();
+
+    std::optional<std::uint64_t> instructions;
+    if (counter_fd >= 0) {
+        std::uint64_t count = 0;
+        if (read(counter_fd, &count, sizeof(count)) == static_cast<ssize_t>(sizeof(count))) {
+            instructions = count;
+        }
+        close(counter_fd);
+    }
+
+    if (!released || waited != pid) {
+        *out_error = Tr("No se pudo ejecutar ", "Could not run ") + argv[0];
+        return false;
+    }
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        *out_error = argv[0] + Tr(" termino con estado ", " exited with status ") +
+                     std::to_string(WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status));
+        return false;
+    }
+
+    out_sample->wall_ms = std::chrono::duration<double, std::milli>(end - start).count();
+#if defined(__APPLE__)
+    out_sample->max_rss_kb = static_cast<std::uint64_t>(usage.ru_maxrss) / 1024;
+#else
+    out_sample->max_rss_kb = static_cast<std::uint64_t>(usage.ru_maxrss);
+#endif
+    out_sample->instructions = instructions;
+    return true;
+}
+
+double Percentile(const std::vector<double>& sorted, double fraction) {
+    // Nearest rank, so p95 of ten runs is the tenth one.
+    const double rank = std::ceil(fraction * static_cast<double>(sorted.size()));
+    const std::size_t index = rank < 1.0 ? 0 : static_cast<std::size_t>(rank) - 1;
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+void Summarize(const std::vector<RunSample>& samples, CaseResult* out_result) {
+    std::vector<double> times;
+    std::vector<std::uint64_t> instructions;
+    for (const RunSample& sample : samples) {
+        times.push_back(sample.wall_ms);
+        out_result->max_rss_kb = std::max(out_result->max_rss_kb, sample.max_rss_kb);
+        if (sample.instructions.has_value()) {
+            instructions.push_back(*sample.instructions);
+        }
+    }
+    std::sort(times.begin(), times.end());
+
+    const std::size_t count = times.size();
+    out_result->runs = count;
+    out_result->min_ms = times.front();
+    out_result->median_ms =
+        count % 2 == 1 ? times[count / 2] : (times[count / 2 - 1] + times[count / 2]) / 2.0;
+    out_result->p95_ms = Percentile(times, 0.95);
+
+    double sum = 0.0;
+    for (const double time : times) {
+        sum += time;
+    }
+    out_result->mean_ms = sum / static_cast<double>(count);
+    double squares = 0.0;
+    for (const double time : times) {
+        squares += (time - out_result->mean_ms) * (time - out_result->mean_ms);
+    }
+    out_result->stddev_ms = count > 1 ? std::sqrt(squares / static_cast<double>(count - 1)) : 0.0;
+
+    // Only when every run was counted; a partial median would mislead.
+    if (instructions.size() == count) {
+        std::sort(instructions.begin(), instructions.end());
+        out_result->instructions = instructions[count / 2];
+    }
+}
+
+CaseResult RunCase(const BenchOptions& options,
+                   const std::filesystem::path& program,
+                   const std::string& label,
+                   BenchMode mode,
+                   const std::filesystem::path& work_dir) {
+    CaseResult result;
+    result.name = label;
+    result.mode = mode;
+
+    std::vector<std::string> argv;
+    if (mode == BenchMode::Interpret) {
+        argv = {options.clot_path, program.string()};
+    } else {
+        const std::filesystem::path exe = work_dir / (program.stem().string() + ".exe");
+        const std::vector<std::string> build = {
+            options.clot_path, program.string(), "--mode", "compile", "--emit", "exe", "-o", exe.string()};
+        RunSample build_sample;
+        if (!RunOnce(build, &build_sample, &result.error)) {
+            result.error = Tr("compilacion no disponible: ", "compile not available: ") + result.error;
+            return result;
+        }
+        result.compile_ms = build_sample.wall_ms;
+        argv = {exe.string()};
+    }
+
+    std::vector<RunSample> samples;
+    for (std::size_t i = 0; i < options.warmup + options.runs; ++i) {
+        RunSample sample;
+        if (!RunOnce(argv, &sample, &result.error)) {
+            return result;
+        }
+        if (i >= options.warmup) {
+            samples.push_back(sample);
+        }
+    }
+
+    Summarize(samples, &result);
+    result.ok = true;
+    return result;
+}
+
+std::string FormatMs(double value) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(3) << value;
+    return out.str();
+}
+
+std::string JsonString(const std::string& text) {
+    std::string out = "\"";
+    for (const char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out += escaped;
+        } else {
+            out += c;
+        }
+    }
+    return out + "\"";
+}
+
+std::string ResultsJson(const BenchOptions& options, const std::vector<CaseResult>& results) {
+    std::ostringstream out;
+    out << "{\n  \"clot\": " << JsonString(options.clot_path) << ",\n  \"runs\": " << options.runs
+        << ",\n  \"warmup\": " << options.warmup << ",\n  \"cases\": [";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const CaseResult& result = results[i];
+        out << (i == 0 ? "\n" : ",\n") << "    {\"name\": " << JsonString(result.name)
+            << ", \"mode\": " << JsonString(ModeName(result.mode)) << ", \"ok\": " << (result.ok ? "true" : "false");
+        if (!result.ok) {
+            out << ", \"error\": " << JsonString(result.error) << "}";
+            continue;
+        }
+        out << ", \"runs\": " << result.runs << ", \"median_ms\": " << FormatMs(result.median_ms)
+            << ", \"p95_ms\": " << FormatMs(result.p95_ms) << ", \"mean_ms\": " << FormatMs(result.mean_ms)
+            << ", \"stddev_ms\": " << FormatMs(result.stddev_ms) << ", \"min_ms\": " << FormatMs(result.min_ms)
+            << ", \"max_rss_kb\": " << result.max_rss_kb << ", \"instructions\": "
+            << (result.instructions.has_value() ? std::to_string(*result.instructions) : "null")
+            << ", \"compile_ms\": " << (result.compile_ms.has_value() ? FormatMs(*result.compile_ms) : "null")
+            << "}";
+    }
+    out << "\n  ]\n}\n";
+    return out.str();
+}
+
+// Just enough JSON to read a results file back: objects, arrays, strings,
+// numbers, true/false/null.
+struct JsonValue {
+    enum class Kind { Null, Bool, Number, String, Array, Object };
+    Kind kind = Kind::Null;
+    bool boolean = false;
+    double number = 0.0;
+    std::string text;
+    std::vector<JsonValue> items;
+    std::vector<std::pair<std::string, JsonValue>> members;
+
+    const JsonValue* Find(const std::string& key) const {
+        for (const auto& [name, value] : members) {
+            if (name == key) {
+                return &value;
+            }
+        }
+        return nullptr;
+    }
+};
+
+class JsonReader {
+public:
+    explicit JsonReader(const std::string& text) : text_(text) {}
+
+    bool Read(JsonValue* out_value) {
+        if (!ParseValue(out_value)) {
+            return false;
+        }
+        SkipSpace();
+        return position_ == text_.size();
+    }
+
+private:
+    void SkipSpace() {
+        while (position_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[position_]))) {
+            ++position_;
+        }
+    }
+
+    bool Consume(char expected) {
+        SkipSpace();
+        if (position_ < text_.size() && text_[position_] == expected) {
+            ++position_;
+            return true;
+        }
+        return false;
+    }
+
+    bool ParseString(std::string* out_text) {
+        if (!Consume('"')) {
+            return false;
+        }
+        while (position_ < text_.size() && text_[position_] != '"') {
+            char c = text_[position_++];
+            if (c == '\\' && position_ < text_.size()) {
+                c = text_[position_++];
+                if (c == 'n') {
+                    c = '\n';
+                } else if (c == 't') {
+                    c = '\t';
+                } else if (c == 'u' && position_ + 4 <= text_.size()) {
+                    c = static_cast<char>(std::strtol(text_.substr(position_, 4).c_str(), nullptr, 16));
+                    position_ += 4;
+                }
+            }
+            out_text->push_back(c);
+        }
+        return Consume('"');
+    }
+
+    bool ParseValue(JsonValue* out_value) {
+        SkipSpace();
+        if (position_ >= text_.size()) {
+            return false;
+        }
+
+        const char c = text_[position_];
+        if (c == '{') {
+            ++position_;
+            out_value->kind = JsonValue::Kind::Object;
+            if (Consume('}')) {
+                return true;
+            }
+            do {
+                std::string key;
+                JsonValue member;
+                if (!ParseString(&key) || !Consume(':') || !ParseValue(&member)) {
+                    return false;
+                }
+                out_value->members.emplace_back(std::move(key), std::move(member));
+            } while (Consume(','));
+            return Consume('}');
+        }
+        if (c == '[') {
+            ++position_;
+            out_value->kind = JsonValue::Kind::Array;
+            if (Consume(']')) {
+                return true;
+            }
+            do {
+                JsonValue item;
+                if (!ParseValue(&item)) {
+                    return false;
+                }
+                out_value->items.push_back(std::move(item));
+            } while (Consume(','));
+            return Consume(']');
+        }
+        if (c == '"') {
+            out_value->kind = JsonValue::Kind::String;
+            return ParseString(&out_value->text);
+        }
+        for (const char* literal : {"true", "false", "null"}) {
+            const std::size_t length = std::strlen(literal);
+            if (text_.compare(position_, length, literal) == 0) {
+                position_ += length;
+                out_value->kind = literal[0] == 'n' ? JsonValue::Kind::Null : JsonValue::Kind::Bool;
+                out_value->boolean = literal[0] == 't';
+                return true;
+            }
+        }
+
+        char* end = nullptr;
+        out_value->number = std::strtod(text_.c_str() + position_, &end);
+        if (end == text_.c_str() + position_) {
+            return false;
+        }
+        out_value->kind = JsonValue::Kind::Number;
+        position_ = static_cast<std::size_t>(end - text_.c_str());
+        return true;
+    }
+
+    const std::string& text_;
+    std::size_t position_ = 0;
+};
+
+struct BaselineEntry {
+    double median_ms = 0.0;
+    std::optional<double> instructions;
+};
+
+bool LoadBaseline(const std::string& path, std::map<std::string, BaselineEntry>* out_entries, std::string* out_error) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        *out_error = Tr("No se pudo abrir el archivo: ", "Could not open file: ") + path;
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    const std::string text = buffer.str();
+
+    JsonValue root;
+    JsonReader reader(text);
+    const JsonValue* cases = nullptr;
+    if (!reader.Read(&root) || (cases = root.Find("cases")) == nullptr || cases->kind != JsonValue::Kind::Array) {
+        *out_error = Tr("Baseline invalido: ", "Invalid baseline: ") + path;
+        return false;
+    }
+
+    for (const JsonValue& item : cases->items) {
+        const JsonValue* name = item.Find("name");
+        const JsonValue* mode = item.Find("mode");
+        const JsonValue* ok = item.Find("ok");
+        const JsonValue* median = item.Find("median_ms");
+        if (name == nullptr || mode == nullptr || ok == nullptr || !ok->boolean || median == nullptr) {
+            continue;
+        }
+        BaselineEntry entry;
+        entry.median_ms = median->number;
+        if (const JsonValue* instructions = item.Find("instructions");
+            instructions != nullptr && instructions->kind == JsonValue::Kind::Number) {
+            entry.instructions = instructions->number;
+        }
+        (*out_entries)[name->text + "/" + mode->text] = entry;
+    }
+    return true;
+}
+
+void PrintTable(const std::vector<CaseResult>& results) {
+    std::cout << std::left << std::setw(32) << Tr("caso", "case") << std::setw(11) << Tr("modo", "mode")
+              << std::right << std::setw(11) << Tr("mediana ms", "median ms") << std::setw(10) << "p95 ms"
+              << std::setw(10) << "stddev" << std::setw(12) << Tr("RSS max KiB", "max RSS KiB") << std::setw(16)
+              << Tr("instrucciones", "instructions") << std::setw(10) << "vs interp" << "\n";
+
+    std::map<std::string, double> interpret_medians;
+    for (const CaseResult& result : results) {
+        if (result.ok && result.mode == BenchMode::Interpret) {
+            interpret_medians[result.name] = result.median_ms;
+        }
+    }
+
+    for (const CaseResult& result : results) {
+        std::cout << std::left << std::setw(32) << result.name << std::setw(11) << ModeName(result.mode);
+        if (!result.ok) {
+            std::cout << result.error << "\n";
+            continue;
+        }
+        std::cout << std::right << std::setw(11) << FormatMs(result.median_ms) << std::setw(10)
+                  << FormatMs(result.p95_ms) << std::setw(10) << FormatMs(result.stddev_ms) << std::setw(12)
+                  << result.max_rss_kb << std::setw(16)
+                  << (result.instructions.has_value() ? std::to_string(*result.instructions) : "-");
+        const auto interpret = interpret_medians.find(result.name);
+        if (result.mode == BenchMode::Compile && interpret != interpret_medians.end() && result.median_ms > 0.0) {
+            std::ostringstream speedup;
+            speedup << std::fixed << std::setprecision(2) << interpret->second / result.median_ms << "x";
+            std::cout << std::setw(10) << speedup.str();
+        }
+        std::cout << "\n";
+    }
+}
+
+// Prints one line per case found in the baseline; returns the number of
+// regressions.
+std::size_t CompareWithBaseline(const std::vector<CaseResult>& results,
+                                const std::map<std::string, BaselineEntry>& baseline,
+                                double threshold_percent) {
+    std::size_t regressions = 0;
+    std::cout << "\n" << Tr("Comparacion con baseline (umbral ", "Baseline comparison (threshold ")
+              << threshold_percent << "%):\n";
+    for (const CaseResult& result : results) {
+        if (!result.ok) {
+            continue;
+        }
+        const std::string key = result.name + "/" + ModeName(result.mode);
+        const auto found = baseline.find(key);
+        if (found == baseline.end()) {
+            std::cout << "  " << key << ": " << Tr("sin baseline", "no baseline") << "\n";
+            continue;
+        }
+
+        const bool by_instructions = result.instructions.has_value() && found->second.instructions.has_value() &&
+                                     *found->second.instructions > 0.0;
+        const double before = by_instructions ? *found->second.instructions : found->second.median_ms;
+        const double after = by_instructions ? static_cast<double>(*result.instructions) : result.median_ms;
+        const double change = before > 0.0 ? (after - before) / before * 100.0 : 0.0;
+        const bool regressed = change > threshold_percent;
+        regressions += regressed ? 1 : 0;
+
+        std::cout << "  " << key << ": " << std::showpos << std::fixed << std::setprecision(1) << change
+                  << std::noshowpos << "% " << (by_instructions ? Tr("instrucciones", "instructions") : "median")
+                  << (regressed ? Tr("  REGRESION", "  REGRESSION")
+                                : (change < -threshold_percent ? Tr("  mejora", "  improvement") : ""))
+                  << "\n";
+    }
+    return regressions;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    if (const auto env_lang = clot::runtime::GetEnvVar("CLOT_LANG"); env_lang) {
+        clot::runtime::Language language = clot::runtime::Language::English;
+        if (clot::runtime::ParseLanguage(*env_lang, &language)) {
+            clot::runtime::SetLanguage(language);
+        }
+    }
+
+    BenchOptions options;
+    std::string error;
+    if (!ParseArgs(argc, argv, &options, &error)) {
+        std::cerr << "Error: " << error << "\n";
+        return 2;
+    }
+    if (options.show_help) {
+        PrintHelp();
+        return 0;
+    }
+
+    std::map<std::string, BaselineEntry> baseline;
+    if (!options.baseline_path.empty() && !LoadBaseline(options.baseline_path, &baseline, &error)) {
+        std::cerr << "Error: " << error << "\n";
+        return 2;
+    }
+
+    const std::vector<std::filesystem::path> cases = CollectCases(options);
+    if (cases.empty()) {
+        std::cerr << "Error: " << Tr("no se encontraron casos .clot.", "no .clot cases found.") << "\n";
+        return 2;
+    }
+
+    std::error_code ignored;
+    const std::filesystem::path work_dir =
+        std::filesystem::temp_directory_path() / ("clot-bench-" + std::to_string(getpid()));
+    std::filesystem::create_directories(work_dir, ignored);
+
+    std::vector<CaseResult> results;
+    bool failed = false;
+    for (const std::filesystem::path& source : cases) {
+        std::filesystem::path program;
+        std::string label;
+        if (!ApplyParams(source, options.params, &program, &label, &error)) {
+            std::cerr << "Error: " << error << "\n";
+            failed = true;
+            continue;
+        }
+        for (const BenchMode mode : options.modes) {
+            results.push_back(RunCase(options, program, label, mode, work_dir));
+            // An unavailable compile backend is reported, not a failure.
+            if (!results.back().ok && mode == BenchMode::Interpret) {
+                failed = true;
+            }
+        }
+        if (program != source) {
+            std::filesystem::remove(program, ignored);
+        }
+    }
+    std::filesystem::remove_all(work_dir, ignored);
+
+    PrintTable(results);
+
+    if (!options.json_path.empty()) {
+        std::ofstream json(options.json_path, std::ios::binary | std::ios::trunc);
+        json << ResultsJson(options, results);
+        if (!json) {
+            std::cerr << "Error: " << Tr("No se pudo escribir ", "Could not write ") << options.json_path << "\n";
+            failed = true;
+        }
+    }
+
+    if (!options.baseline_path.empty() && CompareWithBaseline(results, baseline, options.threshold_percent) > 0) {
+        failed = true;
+    }
+    return failed ? 1 : 0;
+}
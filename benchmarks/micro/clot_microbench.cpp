@@ -0,0 +1,668 @@
+// clot_microbench: in-process timings for the runtime primitives that every
+// program leans on (BigInt, Decimal, Value copy/compare/hash, the tokenizer
+// and the parser), so a regression in bigint.hpp or value.hpp shows up here
+// before it shows up in clot-bench's whole-program figures.
+//
+// Inputs come from a fixed-seed mt19937_64 (`--seed`), so every build sees the
+// same digits, strings and programs. Each benchmark is calibrated to a batch
+// of roughly `--min-time-ms / --samples` and then timed for `--samples`
+// batches; the figures are nanoseconds per operation (median, minimum, mean).
+// Results can be written as JSON and compared with a previous JSON file.
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "clot/frontend/parser.hpp"
+#include "clot/frontend/tokenizer.hpp"
+#include "clot/runtime/bigint.hpp"
+#include "clot/runtime/decimal.hpp"
+#include "clot/runtime/env.hpp"
+#include "clot/runtime/i18n.hpp"
+#include "clot/runtime/value.hpp"
+#include "clot/runtime/value_hash.hpp"
+
+namespace {
+
+using clot::runtime::BigInt;
+using clot::runtime::Decimal;
+using clot::runtime::Tr;
+using clot::runtime::Value;
+
+struct MicroOptions {
+    std::uint64_t seed = 42;
+    std::size_t samples = 10;
+    double min_time_ms = 200.0;
+    std::string filter;
+    std::string json_path;
+    std::string baseline_path;
+    double threshold_percent = 10.0;
+    bool list_only = false;
+    bool show_help = false;
+};
+
+// `run(iterations)` performs the operation `iterations` times.
+struct Benchmark {
+    std::string name;
+    std::size_t size = 0;
+    std::function<void(std::size_t)> run;
+
+    std::string Label() const { return name + "/" + std::to_string(size); }
+};
+
+struct MicroResult {
+    std::string label;
+    std::size_t size = 0;
+    std::size_t iterations = 0;
+    double median_ns = 0.0;
+    double min_ns = 0.0;
+    double mean_ns = 0.0;
+};
+
+// Keeps the optimizer from discarding a result it can see is unused.
+template <typename T>
+void KeepAlive(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static const void* volatile sink;
+    sink = &value;
+#endif
+}
+
+void PrintHelp() {
+    std::cout << Tr(
+        "Uso: clot_microbench [opciones]\n\n"
+        "Opciones:\n"
+        "  --filter <texto>         Solo benchmarks cuyo nombre contiene el texto\n"
+        "  --samples <n>            Lotes medidos por benchmark (por defecto 10)\n"
+        "  --min-time-ms <ms>       Tiempo total aproximado por benchmark (por defecto 200)\n"
+        "  --seed <n>               Semilla de las entradas (por defecto 42)\n"
+        "  --json <archivo>         Escribe los resultados en JSON\n"
+        "  --baseline <archivo>     Compara con un JSON previo; sale con 1 si hay regresiones\n"
+        "  --threshold <pct>        Crecimiento de la mediana tolerado (por defecto 10)\n"
+        "  --list                   Lista los benchmarks sin ejecutarlos\n"
+        "  -h, --help               Muestra esta ayuda\n",
+        "Usage: clot_microbench [options]\n\n"
+        "Options:\n"
+        "  --filter <text>          Only benchmarks whose name contains the text\n"
+        "  --samples <n>            Measured batches per benchmark (default 10)\n"
+        "  --min-time-ms <ms>       Approximate total time per benchmark (default 200)\n"
+        "  --seed <n>               Seed for the inputs (default 42)\n"
+        "  --json <file>            Write the results as JSON\n"
+        "  --baseline <file>        Compare with an earlier JSON; exit 1 on regressions\n"
+        "  --threshold <pct>        Tolerated growth of the median (default 10)\n"
+        "  --list                   List the benchmarks without running them\n"
+        "  -h, --help               Show this help\n");
+}
+
+bool ParseUnsigned(const std::string& text, std::uint64_t* out_value) {
+    if (text.empty() || !std::all_of(text.begin(), text.end(), [](unsigned char c) { return std::isdigit(c); })) {
+        return false;
+    }
+    *out_value = std::strtoull(text.c_str(), nullptr, 10);
+    return true;
+}
+
+bool ParsePositive(const std::string& text, double* out_value) {
+    char* end = nullptr;
+    const double value = std::strtod(text.c_str(), &end);
+    if (text.empty() || end == nullptr || *end != '\0' || !(value > 0.0)) {
+        return false;
+    }
+    *out_value = value;
+    return true;
+}
+
+bool ParseArgs(int argc, char* argv[], MicroOptions* out_options, std::string* out_error) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const auto next_value = [&](std::string* out_value) {
+            if (i + 1 >= argc) {
+                *out_error = Tr("Falta valor para ", "Missing value for ") + arg + ".";
+                return false;
+            }
+            *out_value = argv[++i];
+            return true;
+        };
+
+        std::string value;
+        std::uint64_t number = 0;
+        if (arg == "-h" || arg == "--help") {
+            out_options->show_help = true;
+        } else if (arg == "--list") {
+            out_options->list_only = true;
+        } else if (arg == "--filter") {
+            if (!next_value(&out_options->filter)) {
+                return false;
+            }
+        } else if (arg == "--samples") {
+            if (!next_value(&value)) {
+                return false;
+            }
+            if (!ParseUnsigned(value, &number) || number == 0) {
+                *out_error = Tr("Cantidad de lotes invalida: ", "Invalid sample count: ") + value;
+                return false;
+            }
+            out_options->samples = static_cast<std::size_t>(number);
+        } else if (arg == "--min-time-ms") {
+            if (!next_value(&value)) {
+                return false;
+            }
+            if (!ParsePositive(value, &out_options->min_time_ms)) {
+                *out_error = Tr("Tiempo minimo invalido: ", "Invalid minimum time: ") + value;
+                return false;
+            }
+        } else if (arg == "--seed") {
+            if (!next_value(&value)) {
+                return false;
+            }
+            if (!ParseUnsigned(value, &out_options->seed)) {
+                *out_error = Tr("Semilla invalida: ", "Invalid seed: ") + value;
+                return false;
+            }
+        } else if (arg == "--json") {
+            if (!next_value(&out_options->json_path)) {
+                return false;
+            }
+        } else if (arg == "--baseline") {
+            if (!next_value(&out_options->baseline_path)) {
+                return false;
+            }
+        } else if (arg == "--threshold") {
+            if (!next_value(&value)) {
+                return false;
+            }
+            if (!ParsePositive(value, &out_options->threshold_percent)) {
+                *out_error = Tr("Umbral invalido: ", "Invalid threshold: ") + value;
+                return false;
+            }
+        } else {
+            *out_error = Tr("Opcion desconocida: ", "Unknown option: ") + arg;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Input generation. Only raw mt19937_64 output is used (its sequence is fixed
+// by the standard, unlike the distributions), so inputs match across
+// compilers and standard libraries.
+class InputGenerator {
+public:
+    explicit InputGenerator(std::uint64_t seed) : engine_(seed) {}
+
+    std::uint64_t Below(std::uint64_t bound) { return engine_() % bound; }
+
+    std::string Digits(std::size_t count) {
+        std::string digits;
+        digits.reserve(count);
+        digits.push_back(static_cast<char>('1' + Below(9)));
+        while (digits.size() < count) {
+            digits.push_back(static_cast<char>('0' + Below(10)));
+        }
+        return digits;
+    }
+
+    BigInt Integer(std::size_t digits) {
+        BigInt value;
+        BigInt::TryParse(Digits(digits), &value);
+        return value;
+    }
+
+    // `digits` significant digits, `scale` of them after the point.
+    Decimal DecimalNumber(std::size_t digits, int scale) { return Decimal(Integer(digits), scale); }
+
+    std::string Word(std::size_t length) {
+        std::string word;
+        word.reserve(length);
+        while (word.size() < length) {
+            word.push_back(static_cast<char>('a' + Below(26)));
+        }
+        return word;
+    }
+
+private:
+    std::mt19937_64 engine_;
+};
+
+Value IntegerList(InputGenerator& input, std::size_t count) {
+    Value::List list;
+    list.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        list.emplace_back(static_cast<long long>(input.Below(1000000)));
+    }
+    return Value(std::move(list));
+}
+
+Value StringMap(InputGenerator& input, std::size_t count) {
+    Value::Map map;
+    map.entries.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        map.entries.emplace_back(Value(static_cast<long long>(i)), Value(input.Word(12)));
+    }
+    return Value(std::move(map));
+}
+
+// One line mixing the token kinds the tokenizer sees in practice, about
+// `length` characters long.
+std::string SourceLine(InputGenerator& input, std::size_t length) {
+    std::string line = "result = ";
+    for (std::size_t term = 0; line.size() < length; ++term) {
+        if (term > 0) {
+            line += term % 3 == 0 ? " + " : (term % 3 == 1 ? " * " : " - ");
+        }
+        const std::string name = input.Word(6);
+        switch (term % 4) {
+            case 0:
+                line += name + "[" + std::to_string(input.Below(100)) + "]";
+                break;
+            case 1:
+                line += std::to_string(input.Below(10000)) + "." + std::to_string(input.Below(100));
+                break;
+            case 2:
+                line += name + "(\"" + input.Word(8) + "\", " + std::to_string(input.Below(100)) + ")";
+                break;
+            default:
+                line += "f\"" + input.Word(4) + " {" + name + "}\"";
+                break;
+        }
+    }
+    return line + ";  // fin";
+}
+
+// A program of about `line_count` lines: typed functions with branches and
+// loops, call sites and f-strings.
+std::vector<std::string> SourceProgram(InputGenerator& input, std::size_t line_count) {
+    std::vector<std::string> lines = {"total = 0;", "values = [3, 1, 4, 1, 5, 9, 2, 6];"};
+    for (std::size_t index = 0; lines.size() < line_count; ++index) {
+        const std::string name = "f" + std::to_string(index);
+        const std::string factor = std::to_string(input.Below(97) + 1);
+        const std::vector<std::string> block = {
+            "func int " + name + "(x: int):",
+            "    acc = x * " + factor + " + 1;",
+            "    while acc > 100:",
+            "        acc = acc / 2;",
+            "    endwhile",
+            "    if acc % 2 == 0:",
+            "        acc += " + std::to_string(input.Below(10)) + ";",
+            "    else:",
+            "        acc = acc * 3 + 1;",
+            "    endif",
+            "    return acc;",
+            "endfunc",
+            "total = total + " + name + "(values[" + std::to_string(index % 8) + "]);",
+            "label = f\"" + name + " {total}\";",
+        };
+        lines.insert(lines.end(), block.begin(), block.end());
+    }
+    lines.push_back("println(total);");
+    return lines;
+}
+
+bool BuildBenchmarks(std::uint64_t seed, std::vector<Benchmark>* out_benchmarks, std::string* out_error) {
+    InputGenerator input(seed);
+    std::vector<Benchmark>& benchmarks = *out_benchmarks;
+
+    for (const std::size_t digits : {20, 200, 2000}) {
+        const BigInt lhs = input.Integer(digits);
+        const BigInt rhs = input.Integer(digits);
+        const BigInt divisor = input.Integer(digits / 2);
+        const std::string text = lhs.convert_to<std::string>();
+
+        benchmarks.push_back({"bigint.add", digits, [lhs, rhs](std::size_t n) {
+                                  for (std::size_t i = 0; i < n; ++i) {
+                                      KeepAlive(lhs + rhs);
+                                  }
+                              }});
+        benchmarks.push_back({"bigint.mul", digits, [lhs, rhs](std::size_t n) {
+                                  for (std::size_t i = 0; i < n; ++i) {
+                                      KeepAlive(lhs * rhs);
+                                  }
+                              }});
+        benchmarks.push_back({"bigint.divmod", digits, [lhs, divisor](std::size_t n) {
+                                  for (std::size_t i = 0; i < n; ++i) {
+                                      KeepAlive(lhs / divisor);
+                                      KeepAlive(lhs % divisor);
+                                  }
+                              }});
+        benchmarks.push_back({"bigint.compare", digits, [lhs, rhs](std::size_t n) {
+                                  for (std::size_t i = 0; i < n; ++i) {
+                                      KeepAlive(lhs < rhs);
+                                  }
+                              }});
+        benchmarks.push_back({"bigint.parse", digits, [text](std::size_t n) {
+                                  BigInt parsed;
+                                  for (std::size_t i = 0; i < n; ++i) {
+                                      BigInt::TryParse(text, &parsed);
+                                      KeepAlive(parsed);
+                                  }
+                              }});
+        benchmarks.push_back({"bigint.to_string", digits, [lhs](std::size_t n) {
+                                  for (std::size_t i = 0; i < n; ++i) {
+                                      KeepAlive(lhs.convert_to<std::string>());
+                                  }
+                              }});
+    }
+
+    for (const std::size_t digits : {20, 200}) {
+        const Decimal lhs = input.DecimalNumber(digits, 8);
+        const Decimal rhs = input.DecimalNumber(digits / 2, 4);
+        const std::string text = lhs.ToString();
+
+        benchmarks.push_back({"decimal.add", digits, [lhs, rhs](std::size_t n) {
+                                  for (std::size_t i = 0; i < n; ++i) {
+                                      KeepAlive(lhs + rhs);
+                                  }
+                              }});
+        benchmarks.push_back({"decimal.mul", digits, [lhs, rhs](std::size_t n) {
+                                  for (std::size_t i = 0; i < n; ++i) {
+                                      KeepAlive(lhs * rhs);
+                                  }
+                              }});
+        benchmarks.push_back({"decimal.div", digits, [lhs, rhs](std::size_t n) {
+                                  Decimal quotient;
+                                  for (std::size_t i = 0; i < n; ++i) {
+                                      Decimal::Divide(lhs, rhs, 28, &quotient, nullptr);
+                                      KeepAlive(quotient);
+                                  }
+                              }});
+        benchmarks.push_back({"decimal.parse", digits, [text](std::size_t n) {
+                                  Decimal parsed;
+                                  for (std::size_t i = 0; i < n; ++i) {
+                                      Decimal::TryParse(text, &parsed);
+                                      KeepAlive(parsed);
+                                  }
+                              }});
+        benchmarks.push_back({"decimal.to_string", digits, [lhs](std::size_t n) {
+                                  for (std::size_t i = 0; i < n; ++i) {
+                                      KeepAlive(lhs.ToString());
+                                  }
+                              }});
+    }
+
+    // Scalars first (size 1), then containers by element count.
+    std::vector<std::pair<std::string, std::pair<std::size_t, Value>>> values = {
+        {"int", {1, Value(static_cast<long long>(input.Below(1000000)))}},
+        {"double", {1, Value(static_cast<double>(input.Below(1000000)) / 7.0)}},
+        {"string", {64, Value(input.Word(64))}},
+    };
+    for (const std::size_t count : {16, 256, 4096}) {
+        values.push_back({"list", {count, IntegerList(input, count)}});
+    }
+    for (const std::size_t count : {16, 256}) {
+        values.push_back({"map", {count, StringMap(input, count)}});
+    }
+    for (const auto& [kind, sized] : values) {
+        const std::size_t size = sized.first;
+        const Value value = sized.second;
+        // An equal copy, so Equals() walks the whole value.
+        const Value other = sized.second;
+        benchmarks.push_back({"value.copy." + kind, size, [value](std::size_t n) {
+                                  for (std::size_t i = 0; i < n; ++i) {
+                                      Value copy = value;
+                                      KeepAlive(copy);
+                                  }
+                              }});
+        benchmarks.push_back({"value.equals." + kind, size, [value, other](std::size_t n) {
+                                  for (std::size_t i = 0; i < n; ++i) {
+                                      KeepAlive(value.Equals(other));
+                                  }
+                              }});
+        benchmarks.push_back({"value.hash." + kind, size, [value](std::size_t n) {
+                                  for (std::size_t i = 0; i < n; ++i) {
+                                      KeepAlive(clot::runtime::HashValue(value));
+                                  }
+                              }});
+    }
+
+    for (const std::size_t length : {40, 400, 4000}) {
+        const std::string line = SourceLine(input, length);
+        benchmarks.push_back({"tokenizer.line", length, [line](std::size_t n) {
+                                  for (std::size_t i = 0; i < n; ++i) {
+                                      KeepAlive(clot::frontend::Tokenizer::TokenizeLine(line));
+                                  }
+                              }});
+    }
+
+    for (const std::size_t line_count : {100, 1000, 10000}) {
+        const clot::frontend::Parser parser(SourceProgram(input, line_count));
+        // A parse error would time the error path instead.
+        clot::frontend::Program checked;
+        clot::frontend::Diagnostic diagnostic;
+        if (!parser.Parse(&checked, &diagnostic)) {
+            *out_error = Tr("El programa generado no compila (linea ", "The generated program does not parse (line ") +
+                         std::to_string(diagnostic.line) + "): " + diagnostic.message;
+            return false;
+        }
+        benchmarks.push_back({"parser.program", line_count, [parser](std::size_t n) {
+                                  for (std::size_t i = 0; i < n; ++i) {
+                                      clot::frontend::Program program;
+                                      clot::frontend::Diagnostic diagnostic;
+                                      KeepAlive(parser.Parse(&program, &diagnostic));
+                                      KeepAlive(program);
+                                  }
+                              }});
+    }
+
+    return true;
+}
+
+double NowNs() {
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now().time_since_epoch())
+                                   .count());
+}
+
+MicroResult Measure(const Benchmark& benchmark, const MicroOptions& options) {
+    // Grow the batch until it fills its share of the time budget; this also
+    // serves as warmup.
+    const double batch_ns = options.min_time_ms * 1e6 / static_cast<double>(options.samples);
+    std::size_t iterations = 1;
+    for (;;) {
+        const double start = NowNs();
+        benchmark.run(iterations);
+        const double elapsed = NowNs() - start;
+        if (elapsed >= batch_ns || iterations >= (std::size_t{1} << 40)) {
+            break;
+        }
+        const double scale = elapsed > 0.0 ? batch_ns / elapsed : 100.0;
+        iterations = static_cast<std::size_t>(static_cast<double>(iterations) * std::clamp(scale * 1.2, 2.0, 100.0));
+    }
+
+    std::vector<double> per_op;
+    per_op.reserve(options.samples);
+    for (std::size_t sample = 0; sample < options.samples; ++sample) {
+        const double start = NowNs();
+        benchmark.run(iterations);
+        per_op.push_back((NowNs() - start) / static_cast<double>(iterations));
+    }
+    std::sort(per_op.begin(), per_op.end());
+
+    MicroResult result;
+    result.label = benchmark.Label();
+    result.size = benchmark.size;
+    result.iterations = iterations;
+    const std::size_t middle = per_op.size() / 2;
+    result.median_ns = per_op.size() % 2 == 1 ? per_op[middle] : (per_op[middle - 1] + per_op[middle]) / 2.0;
+    result.min_ns = per_op.front();
+    double total = 0.0;
+    for (const double value : per_op) {
+        total += value;
+    }
+    result.mean_ns = total / static_cast<double>(per_op.size());
+    return result;
+}
+
+std::string FormatNs(double value) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(value < 100.0 ? 2 : 1) << value;
+    return out.str();
+}
+
+std::string ResultsJson(const MicroOptions& options, const std::vector<MicroResult>& results) {
+    std::ostringstream out;
+    out << "{\n  \"seed\": " << options.seed << ",\n  \"samples\": " << options.samples
+        << ",\n  \"benchmarks\": [";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const MicroResult& result = results[i];
+        // One benchmark per line; LoadBaseline relies on it.
+        out << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << result.label << "\", \"size\": " << result.size
+            << ", \"iterations\": " << result.iterations << ", \"median_ns\": " << FormatNs(result.median_ns)
+            << ", \"min_ns\": " << FormatNs(result.min_ns) << ", \"mean_ns\": " << FormatNs(result.mean_ns) << "}";
+    }
+    out << "\n  ]\n}\n";
+    return out.str();
+}
+
+// Reads the median of every benchmark from a file written by ResultsJson.
+bool LoadBaseline(const std::string& path, std::map<std::string, double>* out_medians, std::string* out_error) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        *out_error = Tr("No se pudo abrir el archivo: ", "Could not open file: ") + path;
+        return false;
+    }
+    const std::string name_key = "{\"name\": \"";
+    const std::string median_key = "\"median_ns\": ";
+    std::string line;
+    while (std::getline(file, line)) {
+        const std::size_t name_at = line.find(name_key);
+        const std::size_t median_at = line.find(median_key);
+        if (name_at == std::string::npos || median_at == std::string::npos) {
+            continue;
+        }
+        const std::size_t name_start = name_at + name_key.size();
+        const std::size_t name_end = line.find('"', name_start);
+        if (name_end == std::string::npos) {
+            continue;
+        }
+        (*out_medians)[line.substr(name_start, name_end - name_start)] =
+            std::strtod(line.c_str() + median_at + median_key.size(), nullptr);
+    }
+    if (out_medians->empty()) {
+        *out_error = Tr("Baseline invalido: ", "Invalid baseline: ") + path;
+        return false;
+    }
+    return true;
+}
+
+void PrintRow(const MicroResult& result) {
+    std::cout << std::left << std::setw(28) << result.label << std::right << std::setw(14)
+              << FormatNs(result.median_ns) << std::setw(14) << FormatNs(result.min_ns) << std::setw(14)
+              << FormatNs(result.mean_ns) << std::setw(14) << result.iterations << "\n";
+}
+
+// Prints one line per benchmark found in both runs; returns the number of
+// regressions.
+std::size_t CompareWithBaseline(
+    const std::vector<MicroResult>& results,
+    const std::map<std::string, double>& baseline,
+    double threshold_percent) {
+    std::size_t regressions = 0;
+    std::cout << "\n" << Tr("Comparacion con baseline (umbral ", "Baseline comparison (threshold ")
+              << threshold_percent << "%):\n";
+    for (const MicroResult& result : results) {
+        const auto found = baseline.find(result.label);
+        if (found == baseline.end() || found->second <= 0.0) {
+            std::cout << "  " << result.label << ": " << Tr("sin baseline", "no baseline") << "\n";
+            continue;
+        }
+        const double change = (result.median_ns / found->second - 1.0) * 100.0;
+        const bool regressed = change > threshold_percent;
+        if (regressed) {
+            ++regressions;
+        }
+        std::cout << "  " << std::left << std::setw(28) << result.label << std::right << std::showpos << std::fixed
+                  << std::setprecision(1) << change << std::noshowpos << "%"
+                  << (regressed ? Tr("  REGRESION", "  REGRESSION")
+                                : (change < -threshold_percent ? Tr("  mejora", "  improvement") : ""))
+                  << "\n";
+    }
+    return regressions;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    if (const auto env_lang = clot::runtime::GetEnvVar("CLOT_LANG"); env_lang) {
+        clot::runtime::Language language = clot::runtime::Language::English;
+        if (clot::runtime::ParseLanguage(*env_lang, &language)) {
+            clot::runtime::SetLanguage(language);
+        }
+    }
+
+    MicroOptions options;
+    std::string error;
+    if (!ParseArgs(argc, argv, &options, &error)) {
+        std::cerr << "Error: " << error << "\n";
+        return 2;
+    }
+    if (options.show_help) {
+        PrintHelp();
+        return 0;
+    }
+
+    std::map<std::string, double> baseline;
+    if (!options.baseline_path.empty() && !LoadBaseline(options.baseline_path, &baseline, &error)) {
+        std::cerr << "Error: " << error << "\n";
+        return 2;
+    }
+
+    std::vector<Benchmark> benchmarks;
+    if (!BuildBenchmarks(options.seed, &benchmarks, &error)) {
+        std::cerr << "Error: " << error << "\n";
+        return 1;
+    }
+    benchmarks.erase(std::remove_if(benchmarks.begin(), benchmarks.end(),
+                                    [&](const Benchmark& benchmark) {
+                                        return benchmark.Label().find(options.filter) == std::string::npos;
+                                    }),
+                     benchmarks.end());
+    if (benchmarks.empty()) {
+        std::cerr << "Error: " << Tr("ningun benchmark coincide con el filtro.", "no benchmark matches the filter.")
+                  << "\n";
+        return 2;
+    }
+    if (options.list_only) {
+        for (const Benchmark& benchmark : benchmarks) {
+            std::cout << benchmark.Label() << "\n";
+        }
+        return 0;
+    }
+
+    std::cout << std::left << std::setw(28) << "benchmark" << std::right << std::setw(14)
+              << Tr("mediana ns", "median ns") << std::setw(14) << Tr("min ns", "min ns") << std::setw(14)
+              << Tr("media ns", "mean ns") << std::setw(14) << Tr("iteraciones", "iterations") << "\n";
+    std::vector<MicroResult> results;
+    for (const Benchmark& benchmark : benchmarks) {
+        results.push_back(Measure(benchmark, options));
+        PrintRow(results.back());
+    }
+
+    bool failed = false;
+    if (!options.json_path.empty()) {
+        std::ofstream json(options.json_path, std::ios::binary | std::ios::trunc);
+        json << ResultsJson(options, results);
+        if (!json) {
+            std::cerr << "Error: " << Tr("No se pudo escribir ", "Could not write ") << options.json_path << "\n";
+            failed = true;
+        }
+    }
+
+    if (!options.baseline_path.empty() && CompareWithBaseline(results, baseline, options.threshold_percent) > 0) {
+        failed = true;
+    }
+    return failed ? 1 : 0;
+}
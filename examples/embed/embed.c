@@ -0,0 +1,120 @@
+/*
+ * Embedding libclot from C: parse a program once, run it on a reusable
+ * context, call its functions with host values and expose a host function
+ * to Clot.
+ *
+ *   clot-embed                 runs the built-in demo program
+ *   clot-embed script.clot f   runs script.clot, then calls f() and prints it
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "clot/clot.h"
+
+static const char* kDemoProgram =
+    "func int price(qty: int):\n"
+    "    return host_scale(qty) + 1;\n"
+    "endfunc\n"
+    "\n"
+    "func greet(name):\n"
+    "    return f\"Hola {name}\";\n"
+    "endfunc\n"
+    "\n"
+    "func checked(x):\n"
+    "    if x < 0:\n"
+    "        throw(\"negativo\");\n"
+    "    endif\n"
+    "    return x;\n"
+    "endfunc\n"
+    "\n"
+    "println(\"cargado\");\n";
+
+/* host_scale(x) -> x * factor; the factor comes from user_data. */
+static clot_value* HostScale(void* user_data, const clot_value* const* args, size_t arg_count) {
+    int ok = 0;
+    long long x = 0;
+    if (arg_count != 1) {
+        return clot_value_error("host_scale(x) requiere 1 argumento.");
+    }
+    x = clot_value_as_int(args[0], &ok);
+    if (!ok) {
+        return clot_value_error("host_scale(x) requiere un entero.");
+    }
+    return clot_value_int(x * *(const long long*)user_data);
+}
+
+static int CallAndPrint(clot_context* context, const char* name, clot_value* argument) {
+    const clot_value* args[1];
+    clot_value* result = NULL;
+    size_t arg_count = 0;
+    int status = CLOT_OK;
+
+    if (argument != NULL) {
+        args[0] = argument;
+        arg_count = 1;
+    }
+    status = clot_context_call(context, name, args, arg_count, &result);
+    if (status == CLOT_OK) {
+        printf("%s -> %s\n", name, clot_value_to_string(result));
+        clot_value_free(result);
+    } else {
+        printf("%s -> error: %s\n", name, clot_context_error(context));
+    }
+    clot_value_free(argument);
+    return status;
+}
+
+int main(int argc, char* argv[]) {
+    char error[512];
+    long long factor = 10;
+    clot_program* program = NULL;
+    clot_context* context = NULL;
+    int failed = 0;
+    int run = 0;
+
+    if (getenv("CLOT_LANG") != NULL) {
+        clot_set_language(getenv("CLOT_LANG"));
+    }
+
+    if (argc == 3) {
+        program = clot_program_parse_file(argv[1], error, sizeof(error));
+    } else {
+        program = clot_program_parse(kDemoProgram, NULL, error, sizeof(error));
+    }
+    if (program == NULL) {
+        fprintf(stderr, "%s\n", error);
+        return 1;
+    }
+
+    context = clot_context_new();
+    clot_context_register_builtin(context, "host_scale", HostScale, &factor);
+
+    if (argc == 3) {
+        failed = clot_context_run(context, program) != CLOT_OK || CallAndPrint(context, argv[2], NULL) != CLOT_OK;
+        if (failed) {
+            fprintf(stderr, "%s\n", clot_context_error(context));
+        }
+    } else {
+        /* The same parsed program and context serve every run. */
+        for (run = 0; run < 2 && !failed; ++run) {
+            if (clot_context_run(context, program) != CLOT_OK) {
+                fprintf(stderr, "%s\n", clot_context_error(context));
+                failed = 1;
+                break;
+            }
+            CallAndPrint(context, "price", clot_value_int(4 + run));
+        }
+        CallAndPrint(context, "greet", clot_value_string("embebido"));
+        CallAndPrint(context, "checked", clot_value_int(-1));
+        CallAndPrint(context, "missing", NULL);
+        /* This host does not link the heap hooks, so a heap limit is refused. */
+        if (clot_context_set_limits(context, 1u << 20, 0, 0) != CLOT_OK) {
+            printf("limits -> error: %s\n", clot_context_error(context));
+        }
+    }
+
+    clot_context_free(context);
+    clot_program_free(program);
+    return failed;
+}
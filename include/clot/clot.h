@@ -0,0 +1,124 @@
+#ifndef CLOT_CLOT_H
+#define CLOT_CLOT_H
+
+/*
+ * Embedding API of libclot.
+ *
+ * A program is parsed once (clot_program_parse*) and can then be run on any
+ * number of contexts. A context is a reusable interpreter: clot_context_run
+ * resets its variables, functions and classes and executes the program's top
+ * level, after which clot_context_call invokes the program's functions with
+ * host values. Native builtins registered on a context are kept across runs.
+ *
+ * Programs are immutable and may be shared by contexts on different threads;
+ * a context must be used by one thread at a time. Functions that can fail
+ * return CLOT_OK or CLOT_ERROR; the message is then available from
+ * clot_context_error (context calls) or the caller's buffer (parsing), in
+ * the language chosen with clot_set_language. No C++ exception crosses this
+ * API: one raised inside (running out of memory included) is reported as
+ * CLOT_ERROR, a null handle, or a zero result with *ok cleared.
+ */
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define CLOT_OK 0
+#define CLOT_ERROR 1
+
+typedef struct clot_program clot_program;
+typedef struct clot_context clot_context;
+typedef struct clot_value clot_value;
+
+typedef enum clot_type {
+    CLOT_TYPE_NULL = 0,
+    CLOT_TYPE_BOOL = 1,
+    CLOT_TYPE_INT = 2,
+    CLOT_TYPE_DOUBLE = 3,
+    CLOT_TYPE_STRING = 4,
+    /* Lists, maps, objects, decimals and the remaining Clot types. They can
+       be passed back to Clot and rendered with clot_value_to_string. */
+    CLOT_TYPE_OTHER = 5
+} clot_type;
+
+/*
+ * A native builtin. `args` are borrowed for the duration of the call. Return
+ * a new value (ownership passes to the interpreter), NULL for Clot null, or
+ * clot_value_error(message) to raise an error catchable with try/catch.
+ */
+typedef clot_value* (*clot_native_fn)(void* user_data, const clot_value* const* args, size_t arg_count);
+
+/* Library version, e.g. "0.3.4". */
+const char* clot_version(void);
+
+/* "es" or "en" (also "spanish"/"english"); returns CLOT_ERROR if unknown. */
+int clot_set_language(const char* language);
+
+/* Programs. `source_path` (may be NULL) resolves relative imports. On failure
+   returns NULL and writes the diagnostic to `error_buffer` if given. */
+clot_program* clot_program_parse(
+    const char* source_text,
+    const char* source_path,
+    char* error_buffer,
+    size_t error_buffer_size);
+clot_program* clot_program_parse_file(const char* path, char* error_buffer, size_t error_buffer_size);
+/* Contexts that ran the program keep it alive until their next run or free. */
+void clot_program_free(clot_program* program);
+
+/* Contexts. */
+clot_context* clot_context_new(void);
+void clot_context_free(clot_context* context);
+int clot_context_register_builtin(
+    clot_context* context,
+    const char* name,
+    clot_native_fn function,
+    void* user_data);
+/* Resource limits for later runs and calls on `context`; 0 leaves a resource
+   unbounded. Each clot_context_run and clot_context_call gets a fresh budget
+   and fails with a MemoryError, TimeoutError or InstructionLimitError message
+   when it goes over. libclot does not replace the global operator new and
+   delete, so a heap limit returns CLOT_ERROR unless the host compiles
+   src/runtime/heap_hooks.cpp into its executable. Those hooks count the whole
+   process's heap, host allocations included, so only a host that runs one
+   context at a time gets a per-context heap limit. */
+int clot_context_set_limits(
+    clot_context* context,
+    unsigned long long max_heap_bytes,
+    unsigned long long max_wall_ms,
+    unsigned long long max_statements);
+int clot_context_run(clot_context* context, const clot_program* program);
+/* On success `*out_result` (if not NULL) receives a new value owned by the
+   caller; functions without a return value yield null. */
+int clot_context_call(
+    clot_context* context,
+    const char* function_name,
+    const clot_value* const* args,
+    size_t arg_count,
+    clot_value** out_result);
+/* Message of the last failed call on `context`; valid until the next call. */
+const char* clot_context_error(const clot_context* context);
+
+/* Values. Every clot_value_* constructor returns a value owned by the caller. */
+clot_value* clot_value_null(void);
+clot_value* clot_value_bool(int value);
+clot_value* clot_value_int(long long value);
+clot_value* clot_value_double(double value);
+clot_value* clot_value_string(const char* text);
+clot_value* clot_value_error(const char* message);
+void clot_value_free(clot_value* value);
+
+clot_type clot_value_type(const clot_value* value);
+int clot_value_as_bool(const clot_value* value);
+/* Integers outside the range of long long, and non-numbers, set *ok to 0. */
+long long clot_value_as_int(const clot_value* value, int* ok);
+double clot_value_as_double(const clot_value* value, int* ok);
+/* Text of the value as println renders it; valid while `value` lives. */
+const char* clot_value_to_string(const clot_value* value);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CLOT_CLOT_H */
@@ -26,6 +26,16 @@ struct CompileOptions {
     std::string source_text;
     std::string project_root;
     RuntimeBridgeMode runtime_bridge_mode = RuntimeBridgeMode::Static;
+    // Executables from the AOT subset are emitted as one module per function,
+    // compiled on `codegen_jobs` threads (0 = hardware concurrency). Objects are
+    // reused from `object_cache_dir` when set.
+    unsigned codegen_jobs = 0;
+    std::string object_cache_dir;
+    // IR-level PGO: `instrument` links a binary that writes .profraw counters
+    // (merge them with llvm-profdata); `profile_use_path` feeds the merged
+    // .profdata back into the O2 pipeline.
+    bool instrument = false;
+    std::string profile_use_path;
     bool verbose = false;
 };
 
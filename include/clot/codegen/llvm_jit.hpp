@@ -0,0 +1,41 @@
+#ifndef CLOT_CODEGEN_LLVM_JIT_HPP
+#define CLOT_CODEGEN_LLVM_JIT_HPP
+
+#include <memory>
+#include <string>
+
+#include "clot/frontend/ast.hpp"
+
+namespace clot::codegen {
+
+// Native entry produced by the JIT. Slot i points to the double bound to
+// parameter i: a private copy for by-value params or the caller cell for
+// by-reference params. Returns null, or the (Spanish) message of a failed
+// range check; the string lives as long as the JIT.
+using NativeEntryPoint = const char* (*)(double* const* slots);
+
+class LlvmJit {
+public:
+    LlvmJit();
+    ~LlvmJit();
+
+    LlvmJit(const LlvmJit&) = delete;
+    LlvmJit& operator=(const LlvmJit&) = delete;
+
+    static bool IsAvailable();
+    static bool IsEligibleFunction(const frontend::FunctionDeclStmt& function, bool math_module_imported);
+
+    bool CompileFunction(
+        const frontend::FunctionDeclStmt& function,
+        bool math_module_imported,
+        NativeEntryPoint* out_entry,
+        std::string* out_error);
+
+private:
+    struct State;
+    std::unique_ptr<State> state_;
+};
+
+}  // namespace clot::codegen
+
+#endif  // CLOT_CODEGEN_LLVM_JIT_HPP
@@ -1,6 +1,7 @@
 #ifndef CLOT_FRONTEND_AST_HPP
 #define CLOT_FRONTEND_AST_HPP
 
+#include <cstddef>
 #include <memory>
 #include <optional>
 #include <string>
@@ -118,6 +119,14 @@ struct StringExpr final : Expr {
     std::string value;
 };
 
+// f-string literal. `parts` alternates literal StringExpr segments and the
+// placeholder expressions in source order; the result is the concatenation of
+// every part rendered with ToString().
+struct InterpolatedStringExpr final : Expr {
+    explicit InterpolatedStringExpr(std::vector<std::unique_ptr<Expr>> in_parts) : parts(std::move(in_parts)) {}
+    std::vector<std::unique_ptr<Expr>> parts;
+};
+
 struct BoolExpr final : Expr {
     explicit BoolExpr(bool in_value) : value(in_value) {}
     bool value = false;
@@ -195,6 +204,9 @@ struct BinaryExpr final : Expr {
 
 struct Statement {
     virtual ~Statement() = default;
+
+    // 1-based source line where the statement starts (0 when synthesized).
+    std::size_t line = 0;
 };
 
 struct AssignmentStmt final : Statement {
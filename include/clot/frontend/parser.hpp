@@ -35,6 +35,12 @@ private:
         std::vector<std::unique_ptr<Statement>>* out_statements,
         Diagnostic* out_error) const;
 
+    bool ParseStatementKind(
+        std::size_t* line_index,
+        const std::vector<Token>& tokens,
+        std::vector<std::unique_ptr<Statement>>* out_statements,
+        Diagnostic* out_error) const;
+
     bool ParseAssignment(
         std::size_t* line_index,
         const std::vector<Token>& tokens,
@@ -1,9 +1,11 @@
 #ifndef CLOT_INTERPRETER_INTERPRETER_HPP
 #define CLOT_INTERPRETER_INTERPRETER_HPP
 
+#include <chrono>
 #include <filesystem>
 #include <future>
 #include <cstdint>
+#include <functional>
 #include <map>
 #include <memory>
 #include <optional>
@@ -15,14 +17,107 @@
 #include "clot/frontend/ast.hpp"
 #include "clot/runtime/value.hpp"
 
+namespace clot::runtime {
+class MlCsvReader;
+class Profiler;
+}  // namespace clot::runtime
+
 namespace clot::interpreter {
 
+class ModuleCache;
+
 class Interpreter {
 public:
+    // Native entry for a function compiled in-process (see clot::codegen::LlvmJit).
+    // Slot i points to the double bound to parameter i. Returns null, or the
+    // message of a runtime error raised by the native code.
+    using NativeFunctionEntry = const char* (*)(double* const* slots);
+    // `note` is free text from the compile (e.g. a --verbose line). With
+    // background compiles the hook runs on a worker thread, so it must not
+    // print; the note reaches the NativeCompileLog on the interpreter thread
+    // when the result is installed.
+    struct NativeCompileResult {
+        NativeFunctionEntry entry = nullptr;
+        std::string note;
+    };
+    using NativeCompileHook =
+        std::function<NativeCompileResult(const frontend::FunctionDeclStmt& function, bool math_module_imported)>;
+    using NativeCompileLog = std::function<void(const std::string& note)>;
+
+    // A function tiers up once it passes either threshold: calls to it, or loop
+    // back-edges taken while it is the innermost running function.
+    struct TierUpPolicy {
+        std::uint64_t call_threshold = 10;
+        std::uint64_t back_edge_threshold = 10000;
+        bool background_compile = true;
+    };
+
+    struct TierStats {
+        std::size_t profiled_functions = 0;
+        std::size_t native_functions = 0;
+        std::size_t profiled_loops = 0;
+        std::uint64_t max_loop_back_edges = 0;
+    };
+
     void SetEntryFilePath(const std::string& file_path);
+    void SetNativeCompileHook(NativeCompileHook hook, const TierUpPolicy& policy, NativeCompileLog log = {});
+    TierStats CollectTierStats() const;
+    // Waits for background compiles still in flight and installs them, so
+    // their notes reach the log before the caller reports on the run.
+    void FinishNativeCompiles();
+    // Times every call and statement on `profiler` (null to turn it off); the
+    // caller keeps ownership.
+    void SetProfiler(runtime::Profiler* profiler);
+    // Takes parsed imports from `cache` (null to parse every import); the
+    // caller keeps ownership.
+    void SetModuleCache(ModuleCache* cache);
+
+    // Host functions callable from Clot by name (the embedding API in
+    // clot/clot.h registers them). They receive evaluated arguments, take
+    // precedence over the language builtins and survive Execute().
+    using NativeBuiltin = std::function<bool(
+        const std::vector<runtime::Value>& arguments,
+        runtime::Value* out_value,
+        std::string* out_error)>;
+    void RegisterNativeBuiltin(const std::string& name, NativeBuiltin builtin);
+
+    // Per-run ceilings, 0 meaning unbounded (see interpreter_limits.cpp).
+    // Execute() and CallFunction() each start a fresh budget. They are checked
+    // before every statement and block, and before bulk allocations (list
+    // repetition, ndarray constructors). Going over raises MemoryError,
+    // TimeoutError or InstructionLimitError, all ResourceLimitError. A caught
+    // MemoryError lets the run go on once memory is released; the time and
+    // statement limits fail again on the next statement, so catch blocks cannot
+    // outlive them.
+    struct ResourceLimits {
+        // Growth of the process heap (runtime::TrackedHeapBytes) since the run
+        // started, so concurrent runs in one process share it.
+        std::uint64_t max_heap_bytes = 0;
+        std::uint64_t max_wall_ms = 0;
+        std::uint64_t max_statements = 0;
+    };
+    // Fails if a heap limit is asked for where heap accounting is unsupported.
+    bool SetResourceLimits(const ResourceLimits& limits, std::string* out_error);
 
     bool Execute(const frontend::Program& program, std::string* out_error);
 
+    // Snapshots (see interpreter_snapshot.cpp). WriteSnapshot saves the state
+    // left by the last successful Execute(): globals, functions, classes,
+    // interfaces and imported modules. After LoadSnapshot, every Execute()
+    // starts from that state instead of an empty one, as if the snapshot's
+    // program had run first; its sources are reparsed and must be unchanged.
+    bool WriteSnapshot(const std::string& path, std::string* out_error) const;
+    bool LoadSnapshot(const std::string& path, std::string* out_error);
+
+    // Calls the top-level function `name` defined by the last Execute(); the
+    // executed program must still be alive. Uncaught exceptions are reported
+    // in `out_error` as Execute() reports them.
+    bool CallFunction(
+        const std::string& name,
+        const std::vector<runtime::Value>& arguments,
+        runtime::Value* out_value,
+        std::string* out_error);
+
 private:
     bool ExecuteStatement(const frontend::Statement& statement, std::string* out_error);
     bool ExecuteBlock(const std::vector<std::unique_ptr<frontend::Statement>>& statements, std::string* out_error);
@@ -35,6 +130,9 @@ private:
     bool ExecuteSwitch(const frontend::SwitchStmt& statement, std::string* out_error);
     bool ExecuteDeferredStatementsForCurrentBlock(std::string* out_error);
     bool RaiseExceptionValue(const runtime::Value& value, std::string* out_error);
+    // Replaces `out_error` with "Excepcion no capturada: ..." when an exception
+    // is pending, and clears it.
+    void ReportUncaughtException(std::string* out_error);
 
     bool EvaluateExpression(
         const frontend::Expr& expression,
@@ -102,6 +200,108 @@ private:
         runtime::Value* out_value,
         std::string* out_error);
 
+    // Calls a function value (FunctionRef) with already-evaluated arguments, for
+    // builtins that take callbacks.
+    bool InvokeFunctionValue(
+        const runtime::Value& function,
+        const std::vector<runtime::Value>& arguments,
+        runtime::Value* out_value,
+        std::string* out_error,
+        bool require_return_value = true);
+
+    // Methods on string values (split, join, find, replace, strip, ...). The
+    // method arguments start at `argument_offset` in `call`.
+    static bool IsStringMethod(const std::string& name);
+    bool ExecuteStringMethod(
+        const std::string& text,
+        const std::string& method,
+        const frontend::CallExpr& call,
+        std::size_t argument_offset,
+        runtime::Value* out_value,
+        std::string* out_error);
+
+    // Native numeric arrays: the nd_* constructors, methods such as sum/dot/
+    // slice/reshape, and elementwise arithmetic with broadcasting.
+    static bool IsNdArrayBuiltin(const std::string& name);
+    static bool IsNdArrayMethod(const std::string& name);
+    static runtime::Value NdArrayItem(const runtime::NdArray& array, std::size_t index);
+    bool ExecuteNdArrayBuiltin(const frontend::CallExpr& call, runtime::Value* out_value, std::string* out_error);
+    bool ExecuteNdArrayMethod(
+        const runtime::NdArray& array,
+        const std::string& method,
+        const frontend::CallExpr& call,
+        std::size_t argument_offset,
+        runtime::Value* out_value,
+        std::string* out_error);
+    bool EvaluateNdArrayBinary(
+        frontend::BinaryOp op,
+        const runtime::Value& lhs,
+        const runtime::Value& rhs,
+        runtime::Value* out_value,
+        std::string* out_error) const;
+
+    // Forward-mode dual numbers: the dual/dual_seed/dual_gradient builtins,
+    // arithmetic, member access (value, derivative, tangents), the methods
+    // of the former Dual class and the derivative rules of the math builtins.
+    static bool IsDualBuiltin(const std::string& name);
+    bool ExecuteDualBuiltin(const frontend::CallExpr& call, runtime::Value* out_value, std::string* out_error);
+    static bool ApplyDualMath(
+        const std::string& name,
+        const std::vector<runtime::Value>& arguments,
+        runtime::Value* out_value,
+        std::string* out_error);
+    static bool ReadDualMember(
+        const runtime::Dual& dual,
+        const runtime::Value& member,
+        runtime::Value* out_value,
+        std::string* out_error);
+    static bool IsDualMethod(const std::string& name);
+    bool ExecuteDualMethod(
+        const runtime::Value& receiver,
+        const std::string& method,
+        const frontend::CallExpr& call,
+        std::size_t argument_offset,
+        runtime::Value* out_value,
+        std::string* out_error);
+    bool EvaluateDualBinary(
+        frontend::BinaryOp op,
+        const runtime::Value& lhs,
+        const runtime::Value& rhs,
+        runtime::Value* out_value,
+        std::string* out_error) const;
+    // f and its gradient at `point`, from one call of the function value `f`
+    // on the point seeded as n-direction duals.
+    bool EvaluateDualGradient(
+        const runtime::Value& function,
+        const std::vector<double>& point,
+        double* out_value,
+        std::vector<double>* out_gradient,
+        std::string* out_error);
+
+    // opt_minimize: native gradient descent, L-BFGS and Nelder-Mead drivers
+    // that call back into a Clot objective, optionally batched and from
+    // several starts.
+    static bool IsOptimizeBuiltin(const std::string& name);
+    bool ExecuteOptimizeBuiltin(const frontend::CallExpr& call, runtime::Value* out_value, std::string* out_error);
+
+    // ml_*: float32 dense layers, activations, softmax/cross-entropy,
+    // SGD/Adam steps and streamed CSV mini-batches.
+    static bool IsMlBuiltin(const std::string& name);
+    bool ExecuteMlBuiltin(const frontend::CallExpr& call, runtime::Value* out_value, std::string* out_error);
+
+    // stats_summary/stats_histogram/stats_quantiles: single-pass reductions
+    // over in-memory sequences or streamed files.
+    static bool IsStatsBuiltin(const std::string& name);
+    bool ExecuteStatsBuiltin(const frontend::CallExpr& call, runtime::Value* out_value, std::string* out_error);
+
+    bool TryExecuteNativeFunction(
+        const frontend::FunctionDeclStmt& function,
+        const frontend::CallExpr& call,
+        NativeFunctionEntry entry,
+        bool* out_handled,
+        runtime::Value* out_value,
+        std::string* out_error);
+
     bool ExecuteInterfaceDeclaration(const frontend::InterfaceDeclStmt& declaration, std::string* out_error);
     bool ExecuteClassDeclaration(const frontend::ClassDeclStmt& declaration, std::string* out_error);
     bool ExecuteSuperCall(
@@ -246,6 +446,7 @@ private:
     runtime::Value BuildModuleAliasValue(const ModuleExports& exports) const;
     std::filesystem::path ResolveModulePath(const std::string& module_name) const;
     std::filesystem::path CurrentModuleBaseDir() const;
+    void RestoreSnapshot();
 
     std::map<std::string, runtime::VariableSlot> environment_;
     std::map<std::string, const frontend::FunctionDeclStmt*> functions_;
@@ -265,7 +466,15 @@ private:
     std::vector<runtime::Value*> constructor_instance_stack_;
     std::vector<std::filesystem::path> module_base_dirs_;
     std::filesystem::path entry_file_path_;
-    std::vector<std::unique_ptr<frontend::Program>> loaded_module_programs_;
+    struct LoadedModule {
+        std::filesystem::path path;
+        std::shared_ptr<const frontend::Program> program;
+    };
+    std::vector<LoadedModule> loaded_module_programs_;
+    const frontend::Program* entry_program_ = nullptr;
+    struct SnapshotState;
+    std::shared_ptr<const SnapshotState> snapshot_;
+    ModuleCache* module_cache_ = nullptr;
     std::unordered_map<std::string, ModuleExports> module_exports_cache_;
     std::unordered_map<std::string, std::string> class_aliases_;
     std::optional<RuntimeExceptionRecord> pending_exception_;
@@ -287,8 +496,56 @@ private:
 
     std::unordered_map<long long, AsyncTaskState> async_tasks_;
     long long next_async_task_id_ = 1;
+    std::unordered_map<long long, std::shared_ptr<runtime::MlCsvReader>> ml_csv_readers_;
+    long long next_ml_csv_reader_id_ = 1;
+    std::unordered_map<std::string, NativeBuiltin> native_builtins_;
+    runtime::Profiler* profiler_ = nullptr;
+    // Set by ExecuteClassCallable so the profiled frame reads Class.method.
+    const std::string* profiled_class_name_ = nullptr;
     std::unordered_map<std::uint64_t, std::vector<std::pair<runtime::Value, long long>>> value_identity_cache_;
     long long next_value_identity_id_ = 1;
+
+    enum class FunctionTier {
+        Interpreted,
+        Compiling,
+        Native,
+        Rejected,
+    };
+
+    struct FunctionProfile {
+        const frontend::FunctionDeclStmt* declaration = nullptr;
+        std::uint64_t calls = 0;
+        std::uint64_t back_edges = 0;
+        FunctionTier tier = FunctionTier::Interpreted;
+        NativeFunctionEntry native_entry = nullptr;
+        std::future<NativeCompileResult> pending_entry;
+    };
+
+    // Resource limits (interpreter_limits.cpp).
+    void StartResourceBudget();
+    bool CheckResourceLimits(std::string* out_error);
+    bool ReserveHeap(std::uint64_t bytes, std::string* out_error) const;
+    // Milliseconds left under max_wall_ms; empty without a time limit.
+    std::optional<std::uint64_t> RemainingWallMilliseconds() const;
+
+    ResourceLimits resource_limits_;
+    bool resource_limits_enabled_ = false;
+    bool time_limit_exceeded_ = false;
+    std::uint64_t statements_executed_ = 0;
+    std::uint64_t limit_checks_ = 0;
+    std::int64_t heap_baseline_ = 0;
+    std::chrono::steady_clock::time_point run_started_;
+
+    NativeFunctionEntry TierUpFunction(FunctionProfile* profile);
+    NativeFunctionEntry InstallNativeEntry(FunctionProfile* profile, NativeCompileResult result);
+    void NoteLoopBackEdge(const frontend::Statement& loop);
+
+    NativeCompileHook native_compile_hook_;
+    NativeCompileLog native_compile_log_;
+    TierUpPolicy tier_up_policy_;
+    std::unordered_map<const frontend::FunctionDeclStmt*, FunctionProfile> function_profiles_;
+    std::unordered_map<const frontend::Statement*, std::uint64_t> loop_back_edges_;
+    std::vector<FunctionProfile*> active_function_profiles_;
 };
 
 }  // namespace clot::interpreter
@@ -0,0 +1,48 @@
+#ifndef CLOT_INTERPRETER_MODULE_CACHE_HPP
+#define CLOT_INTERPRETER_MODULE_CACHE_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "clot/frontend/ast.hpp"
+#include "clot/frontend/parser.hpp"
+
+namespace clot::interpreter {
+
+// Parsed source files shared by interpreter runs (see clot serve). An entry is
+// reused while the file keeps its modification time and size, and reparsed
+// otherwise. Programs are immutable, so interpreters may hold them after the
+// entry is replaced. Not thread-safe.
+class ModuleCache {
+public:
+    // On failure returns false with either `out_error` set (the file could not
+    // be read) or `out_diagnostic` set (parse error, `out_error` left empty).
+    bool Load(
+        const std::filesystem::path& path,
+        std::shared_ptr<const frontend::Program>* out_program,
+        frontend::Diagnostic* out_diagnostic,
+        std::string* out_error);
+
+    // Files parsed by Load since the last call: misses and invalidations.
+    std::vector<std::filesystem::path> TakeParsedPaths();
+
+    std::size_t Size() const;
+
+private:
+    struct Entry {
+        std::filesystem::file_time_type modified;
+        std::uintmax_t size = 0;
+        std::shared_ptr<const frontend::Program> program;
+    };
+
+    std::map<std::string, Entry> entries_;
+    std::vector<std::filesystem::path> parsed_paths_;
+};
+
+}  // namespace clot::interpreter
+
+#endif  // CLOT_INTERPRETER_MODULE_CACHE_HPP
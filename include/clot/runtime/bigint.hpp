@@ -10,12 +10,26 @@
 #include <utility>
 #include <vector>
 
+#include "clot/runtime/counters.hpp"
+
 namespace clot::runtime {
 
 class BigInt {
 public:
     BigInt() = default;
 
+    BigInt(const BigInt& other) : negative_(other.negative_), digits_(other.digits_) {
+        CountEvent(Counter::BigIntStrings);
+    }
+    BigInt(BigInt&& other) = default;
+    BigInt& operator=(const BigInt& other) {
+        negative_ = other.negative_;
+        digits_ = other.digits_;
+        CountEvent(Counter::BigIntStrings);
+        return *this;
+    }
+    BigInt& operator=(BigInt&& other) = default;
+
     BigInt(long long value) {
         if (value < 0) {
             negative_ = true;
@@ -471,7 +485,9 @@ private:
         return true;
     }
 
+    // Every freshly built digit string passes through here.
     void Normalize() {
+        CountEvent(Counter::BigIntStrings);
         std::size_t first_non_zero = digits_.find_first_not_of('0');
         if (first_non_zero == std::string::npos) {
             digits_ = "0";
@@ -0,0 +1,74 @@
+#ifndef CLOT_RUNTIME_COUNTERS_HPP
+#define CLOT_RUNTIME_COUNTERS_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+
+namespace clot::runtime {
+
+// Event counters behind clot --stats. They are always compiled in; while
+// disabled (the default) each hook costs one relaxed load and a branch.
+enum class Counter : std::size_t {
+    // Whole-environment copies made to enter a call, getter or setter, and the
+    // variable slots they copied.
+    EnvironmentCopies,
+    EnvironmentSlotsCopied,
+    // Copy constructions and assignments of Value; copying a container counts
+    // every element it holds.
+    ValueCopies,
+    // Decimal digit strings built for BigInt results, conversions and copies.
+    BigIntStrings,
+    // Statements and expressions dispatched through the interpreter's
+    // dynamic_cast chains.
+    StatementDispatches,
+    ExpressionDispatches,
+    ModuleLoads,
+    Count,
+};
+
+namespace counters_detail {
+inline std::atomic<bool> enabled{false};
+inline std::atomic<std::uint64_t> values[static_cast<std::size_t>(Counter::Count)];
+}  // namespace counters_detail
+
+inline bool CountersEnabled() {
+    return counters_detail::enabled.load(std::memory_order_relaxed);
+}
+
+inline void CountEvent(Counter counter, std::uint64_t amount = 1) {
+    if (CountersEnabled()) {
+        counters_detail::values[static_cast<std::size_t>(counter)].fetch_add(amount, std::memory_order_relaxed);
+    }
+}
+
+// Enabling also clears every counter.
+void EnableCounters(bool enabled);
+
+// Per-builtin call tally; only records while counters are enabled.
+void CountBuiltinCall(const std::string& name);
+
+struct CounterReport {
+    std::uint64_t values[static_cast<std::size_t>(Counter::Count)] = {};
+    std::map<std::string, std::uint64_t> builtin_calls;
+    // Process figures; empty where the platform does not expose them.
+    std::optional<std::uint64_t> peak_rss_bytes;
+    std::optional<std::uint64_t> heap_bytes;
+
+    std::uint64_t Get(Counter counter) const { return values[static_cast<std::size_t>(counter)]; }
+};
+
+CounterReport CollectCounters();
+
+// Aligned text for a terminal, in the UI language.
+std::string FormatCounterReport(const CounterReport& report);
+
+// One JSON object with stable snake_case keys; absent process figures are null.
+std::string FormatCounterReportJson(const CounterReport& report);
+
+}  // namespace clot::runtime
+
+#endif  // CLOT_RUNTIME_COUNTERS_HPP
@@ -0,0 +1,80 @@
+#ifndef CLOT_RUNTIME_DUAL_HPP
+#define CLOT_RUNTIME_DUAL_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace clot::runtime {
+
+enum class DualBinaryOp {
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Power,
+};
+
+// Elementary functions with a native derivative rule.
+enum class DualFunction {
+    Sqrt,
+    Exp,
+    Ln,
+    Log10,
+    Abs,
+    Sin,
+    Cos,
+    Tan,
+    Asin,
+    Acos,
+    Atan,
+};
+
+// Forward-mode dual number: a float64 value plus one tangent per seeded
+// direction, so a single evaluation of f yields f and a directional derivative
+// (or, with n one-hot directions, the full gradient of f at a point). A dual
+// with zero directions is a constant and combines with any other dual.
+//
+// Up to kInlineDirections tangents are stored inline, so the common one- or
+// few-variable case never allocates; wider duals spill to a heap vector.
+class Dual {
+public:
+    static constexpr std::size_t kInlineDirections = 4;
+
+    Dual() = default;
+    // `directions` zero tangents.
+    explicit Dual(double value, std::size_t directions = 0);
+
+    double Value() const { return value_; }
+    std::size_t Directions() const { return directions_; }
+    const double* Tangents() const { return directions_ <= kInlineDirections ? inline_ : heap_.data(); }
+    double* Tangents() { return directions_ <= kInlineDirections ? inline_ : heap_.data(); }
+    // Tangent `index`, or 0 when the dual has fewer directions (constants).
+    double Tangent(std::size_t index) const { return index < directions_ ? Tangents()[index] : 0.0; }
+
+    bool Equals(const Dual& other) const;
+
+private:
+    double value_ = 0.0;
+    std::size_t directions_ = 0;
+    double inline_[kInlineDirections] = {};
+    std::vector<double> heap_;
+};
+
+// `lhs op rhs` by the sum, product, quotient and power rules. Fails on a
+// division by zero or when both operands carry a different, non-zero number
+// of directions.
+bool DualBinary(DualBinaryOp op, const Dual& lhs, const Dual& rhs, Dual* out_dual, std::string* out_error);
+Dual DualNegate(const Dual& operand);
+
+// f(x) with tangents scaled by f'(x). Domain errors use the messages of the
+// scalar math builtins (`name` is the builtin, e.g. "ln").
+bool DualApply(DualFunction function,
+               const std::string& name,
+               const Dual& operand,
+               Dual* out_dual,
+               std::string* out_error);
+
+}  // namespace clot::runtime
+
+#endif  // CLOT_RUNTIME_DUAL_HPP
@@ -0,0 +1,39 @@
+#ifndef CLOT_RUNTIME_HEAP_HPP
+#define CLOT_RUNTIME_HEAP_HPP
+
+#include <atomic>
+#include <cstdint>
+
+namespace clot::runtime {
+
+// Heap accounting behind the interpreter's memory limit. The clot executable
+// links src/runtime/heap_hooks.cpp, which replaces the global operator new and
+// delete; libclot does not, so embedding hosts keep their own allocator. Once
+// accounting is enabled the hooks add and subtract the usable size of every
+// block, so TrackedHeapBytes() follows the live C++ heap of the whole process:
+// every list, map, string, BigInt and ndarray a script builds. While disabled
+// (the default) each call costs one relaxed load and a branch.
+//
+// Blocks allocated before accounting was enabled are subtracted when freed, so
+// only the difference between two reads is meaningful.
+namespace heap_detail {
+inline std::atomic<bool> enabled{false};
+inline std::atomic<std::int64_t> bytes{0};
+// Set by heap_hooks.cpp during static initialization.
+inline std::atomic<bool> hooks_installed{false};
+}  // namespace heap_detail
+
+// False unless the replacement operators are linked into this process, and
+// where the allocator cannot report block sizes.
+bool HeapAccountingSupported();
+
+// Accounting stays on for the rest of the process.
+void EnableHeapAccounting();
+
+inline std::int64_t TrackedHeapBytes() {
+    return heap_detail::bytes.load(std::memory_order_relaxed);
+}
+
+}  // namespace clot::runtime
+
+#endif  // CLOT_RUNTIME_HEAP_HPP
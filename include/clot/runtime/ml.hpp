@@ -0,0 +1,155 @@
+#ifndef CLOT_RUNTIME_ML_HPP
+#define CLOT_RUNTIME_ML_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "clot/runtime/ndarray.hpp"
+
+namespace clot::runtime {
+
+// Machine-learning kernels over contiguous float32 arrays. Inputs of another
+// dtype or layout are converted first; every result is a fresh float32 array.
+// Elementwise passes run through the ndarray kernel level (AVX2, 16-byte
+// vectors or scalar, see CLOT_NDARRAY_KERNEL) and split large inputs across
+// hardware threads; the matrix products go through NdMatMul.
+
+enum class MlActivation {
+    Identity,
+    Relu,
+    Sigmoid,
+    Tanh,
+};
+
+// "none", "relu", "sigmoid" or "tanh".
+bool ParseMlActivation(std::string_view name, MlActivation* out_activation);
+
+// act(x).
+NdArray MlActivate(MlActivation activation, const NdArray& input);
+
+// grad_output * act'(x), written in terms of the activation's output y =
+// act(x), which is what a forward pass keeps.
+bool MlActivationBackward(MlActivation activation,
+                          const NdArray& output,
+                          const NdArray& grad_output,
+                          NdArray* out_grad,
+                          std::string* out_error);
+
+// act(x·W + b) for x (batch, in), W (in, out) and b (out).
+bool MlDenseForward(const NdArray& input,
+                    const NdArray& weights,
+                    const NdArray& bias,
+                    MlActivation activation,
+                    NdArray* out_output,
+                    std::string* out_error);
+
+struct MlDenseGradients {
+    NdArray input;
+    NdArray weights;
+    NdArray bias;
+};
+
+// Gradients of a dense layer given its input, weights, forward output and
+// the gradient of the loss with respect to that output.
+bool MlDenseBackward(const NdArray& input,
+                     const NdArray& weights,
+                     const NdArray& output,
+                     const NdArray& grad_output,
+                     MlActivation activation,
+                     MlDenseGradients* out_gradients,
+                     std::string* out_error);
+
+// Row-wise softmax of a (batch, classes) array.
+bool MlSoftmax(const NdArray& logits, NdArray* out_probabilities, std::string* out_error);
+
+// Mean softmax cross-entropy of (batch, classes) logits and its gradient with
+// respect to the logits. `labels` is either a vector of class indices or a
+// (batch, classes) array of target probabilities (one-hot rows).
+bool MlSoftmaxCrossEntropy(const NdArray& logits,
+                           const NdArray& labels,
+                           double* out_loss,
+                           NdArray* out_grad,
+                           std::string* out_error);
+
+// Fraction of rows whose largest logit is at the labelled class; `labels`
+// takes the same two forms as in MlSoftmaxCrossEntropy.
+bool MlAccuracy(const NdArray& logits, const NdArray& labels, double* out_accuracy, std::string* out_error);
+
+// param - learning_rate * grad, or with momentum > 0 the heavy-ball update
+// v = momentum * v + grad; param - learning_rate * v. `velocity` is ignored
+// without momentum; an empty one counts as zeros.
+bool MlSgdStep(const NdArray& param,
+               const NdArray& grad,
+               const NdArray& velocity,
+               double learning_rate,
+               double momentum,
+               NdArray* out_param,
+               NdArray* out_velocity,
+               std::string* out_error);
+
+struct MlAdamOptions {
+    double learning_rate = 0.001;
+    double beta1 = 0.9;
+    double beta2 = 0.999;
+    double epsilon = 1e-8;
+};
+
+// One Adam step; `step` is the 1-based step count used for bias correction.
+// Empty moments count as zeros.
+bool MlAdamStep(const NdArray& param,
+                const NdArray& grad,
+                const NdArray& first_moment,
+                const NdArray& second_moment,
+                std::uint64_t step,
+                const MlAdamOptions& options,
+                NdArray* out_param,
+                NdArray* out_first_moment,
+                NdArray* out_second_moment,
+                std::string* out_error);
+
+// Glorot-uniform (inputs, outputs) float32 weights from a fixed seed.
+NdArray MlGlorotUniform(std::size_t inputs, std::size_t outputs, std::uint64_t seed);
+
+struct MlCsvOptions {
+    char delimiter = ',';
+    // Column holding the label; negative counts from the end (-1 is the
+    // last one). Ignored when has_labels is false.
+    std::ptrdiff_t label_column = -1;
+    bool has_labels = true;
+};
+
+// Streams a numeric CSV file as mini-batches without loading it: each call to
+// Next parses up to `batch_size` more rows. A first line that is not numeric
+// is taken as a header and skipped; blank lines are skipped too.
+class MlCsvReader {
+public:
+    bool Open(const std::string& path, const MlCsvOptions& options, std::string* out_error);
+
+    // Features (rows, columns) and labels (rows) of the next batch. Sets
+    // `out_done` and leaves the arrays alone once the file is exhausted; the
+    // last batch may be short. Without labels `out_labels` is left empty.
+    bool Next(std::size_t batch_size, NdArray* out_features, NdArray* out_labels, bool* out_done, std::string* out_error);
+
+    // Back to the first row, for the next epoch.
+    bool Rewind(std::string* out_error);
+
+private:
+    bool ParseRow(std::string_view line, std::vector<float>* out_fields, std::string* out_error) const;
+
+    std::string path_;
+    MlCsvOptions options_;
+    std::ifstream stream_;
+    std::streampos data_start_ = 0;
+    std::uint64_t data_start_line_ = 0;
+    std::uint64_t line_number_ = 0;
+    std::size_t columns_ = 0;
+    std::vector<float> fields_;
+};
+
+}  // namespace clot::runtime
+
+#endif  // CLOT_RUNTIME_ML_HPP
@@ -0,0 +1,142 @@
+#ifndef CLOT_RUNTIME_NDARRAY_HPP
+#define CLOT_RUNTIME_NDARRAY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace clot::runtime {
+
+// Element type of an NdArray.
+enum class NdType {
+    Float64,
+    Float32,
+    Int64,
+};
+
+enum class NdBinaryOp {
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Power,
+};
+
+enum class NdReduceOp {
+    Sum,
+    Min,
+    Max,
+};
+
+const char* NdTypeName(NdType type);
+bool ParseNdType(std::string_view name, NdType* out_type);
+std::size_t NdTypeSize(NdType type);
+
+// One element read out of an array. `real` holds float64/float32 elements and
+// `integer` holds int64 ones; `type` says which.
+struct NdScalar {
+    NdType type = NdType::Float64;
+    double real = 0.0;
+    std::int64_t integer = 0;
+
+    double AsDouble() const { return type == NdType::Int64 ? static_cast<double>(integer) : real; }
+};
+
+// Typed n-dimensional numeric array. Elements live in one contiguous buffer
+// shared by the array and every view taken from it (slices, rows, transposes),
+// so those views never copy. Strides are in elements and may be zero (a
+// broadcast axis) or negative (a reversed slice).
+//
+// Arrays are immutable once built: operations return new arrays, which is what
+// makes sharing the buffer between Value copies safe. Only the producer of a
+// fresh array writes through MutableData before handing it out.
+class NdArray {
+public:
+    NdArray();
+
+    // Zero-filled contiguous array. An empty shape makes a 0-d array holding
+    // one element, used internally for scalar operands.
+    static NdArray Zeros(NdType type, std::vector<std::size_t> shape);
+    // Contiguous array whose elements are unspecified, for producers that
+    // overwrite every element.
+    static NdArray Uninitialized(NdType type, std::vector<std::size_t> shape);
+    // Contiguous array with every element set to `value` converted to `type`.
+    static NdArray Full(NdType type, std::vector<std::size_t> shape, const NdScalar& value);
+    static NdArray FromScalar(const NdScalar& value);
+
+    NdType Type() const { return type_; }
+    const std::vector<std::size_t>& Shape() const { return shape_; }
+    const std::vector<std::ptrdiff_t>& Strides() const { return strides_; }
+    std::size_t Rank() const { return shape_.size(); }
+    std::size_t Size() const;
+    bool IsContiguous() const;
+
+    // Start of the element storage of a freshly built array (Zeros, Full,
+    // Uninitialized). T must match Type(): double, float or std::int64_t.
+    template <typename T>
+    T* MutableData() {
+        return static_cast<T*>(ElementPointer(offset_));
+    }
+    template <typename T>
+    const T* Data() const {
+        return static_cast<const T*>(ElementPointer(offset_));
+    }
+
+    // Element at a row-major position over the logical shape.
+    NdScalar At(std::size_t flat_index) const;
+
+    // Views. Arguments must already be in range; the interpreter validates and
+    // normalizes them. `stop` is exclusive and may be -1 for a negative step.
+    NdArray Slice(std::size_t axis, std::ptrdiff_t start, std::ptrdiff_t stop, std::ptrdiff_t step) const;
+    NdArray Select(std::size_t axis, std::size_t index) const;
+    NdArray Transpose() const;
+
+    // Same elements with another shape. Zero-copy when the array is contiguous.
+    bool Reshape(const std::vector<std::size_t>& shape, NdArray* out_array, std::string* out_error) const;
+
+    // Contiguous row-major copy, or this array when it already is one.
+    NdArray Contiguous() const;
+    NdArray AsType(NdType type) const;
+
+    bool Equals(const NdArray& other) const;
+    std::string ToString() const;
+
+private:
+    void* ElementPointer(std::ptrdiff_t offset) const;
+
+    NdType type_ = NdType::Float64;
+    std::shared_ptr<void> storage_;
+    std::vector<std::size_t> shape_;
+    std::vector<std::ptrdiff_t> strides_;
+    std::ptrdiff_t offset_ = 0;
+};
+
+// Elementwise `lhs op rhs` with NumPy broadcasting. Both operands are first
+// converted to a common type: float64 if either is float64 or the pair mixes
+// float32 and int64, float32 if both are, int64 otherwise. Divide and Power
+// always produce floats.
+bool NdBinary(NdBinaryOp op, const NdArray& lhs, const NdArray& rhs, NdArray* out_array, std::string* out_error);
+NdArray NdNegate(const NdArray& operand);
+
+// Reductions over every element. Sum of int64 wraps on overflow; Min/Max
+// propagate NaN and fail on an empty array.
+bool NdReduce(NdReduceOp op, const NdArray& operand, NdScalar* out_value, std::string* out_error);
+bool NdMean(const NdArray& operand, NdScalar* out_value, std::string* out_error);
+
+// Inner product of two vectors, or matrix-matrix / matrix-vector /
+// vector-matrix product. A vector-vector product sets `out_is_scalar`.
+bool NdDot(const NdArray& lhs,
+           const NdArray& rhs,
+           NdArray* out_array,
+           NdScalar* out_scalar,
+           bool* out_is_scalar,
+           std::string* out_error);
+
+std::string NdShapeToString(const std::vector<std::size_t>& shape);
+
+}  // namespace clot::runtime
+
+#endif  // CLOT_RUNTIME_NDARRAY_HPP
@@ -0,0 +1,43 @@
+#ifndef CLOT_RUNTIME_NDARRAY_LINALG_HPP
+#define CLOT_RUNTIME_NDARRAY_LINALG_HPP
+
+#include <string>
+
+#include "clot/runtime/ndarray.hpp"
+
+namespace clot::runtime {
+
+// Matrix product of two rank-2 arrays of the same type; the caller checks
+// that lhs.Shape()[1] == rhs.Shape()[0]. Uses a cache-blocked GEMM: panels of
+// both operands are packed into contiguous buffers, a register-tiled micro
+// kernel (AVX2 or 16-byte vectors, per CLOT_NDARRAY_KERNEL) accumulates each
+// tile, and large products split their rows across hardware threads.
+NdArray NdMatMul(const NdArray& lhs, const NdArray& rhs);
+
+// Decompositions and solvers. They accept any numeric dtype, compute in
+// float64 and return float64 arrays.
+
+// A = P·L·U with partial (row) pivoting; L is unit lower triangular. A
+// singular matrix still factors, with zeros on the diagonal of U.
+bool NdLu(const NdArray& matrix, NdArray* out_p, NdArray* out_l, NdArray* out_u, std::string* out_error);
+
+// Reduced Householder QR of an m x n matrix: Q is m x k with orthonormal
+// columns and R is k x n upper triangular, k = min(m, n).
+bool NdQr(const NdArray& matrix, NdArray* out_q, NdArray* out_r, std::string* out_error);
+
+// Lower triangular L with A = L·Lᵀ. Only the lower triangle of A is read.
+bool NdCholesky(const NdArray& matrix, NdArray* out_lower, std::string* out_error);
+
+// Eigenvalues (ascending) and eigenvectors (as columns) of a symmetric
+// matrix, via Householder tridiagonalization and implicit QL. Only the lower
+// triangle of A is read.
+bool NdEigh(const NdArray& matrix, NdArray* out_values, NdArray* out_vectors, std::string* out_error);
+
+// Solution of A·X = B for a square A and a vector or matrix B.
+bool NdSolve(const NdArray& matrix, const NdArray& rhs, NdArray* out_solution, std::string* out_error);
+bool NdInverse(const NdArray& matrix, NdArray* out_inverse, std::string* out_error);
+bool NdDeterminant(const NdArray& matrix, double* out_value, std::string* out_error);
+
+}  // namespace clot::runtime
+
+#endif  // CLOT_RUNTIME_NDARRAY_LINALG_HPP
@@ -0,0 +1,73 @@
+#ifndef CLOT_RUNTIME_OPTIMIZER_HPP
+#define CLOT_RUNTIME_OPTIMIZER_HPP
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace clot::runtime {
+
+enum class OptimizerMethod {
+    GradientDescent,
+    Lbfgs,
+    NelderMead,
+};
+
+// "gd", "lbfgs" or "nelder_mead".
+bool ParseOptimizerMethod(std::string_view name, OptimizerMethod* out_method);
+bool OptimizerNeedsGradient(OptimizerMethod method);
+
+struct OptimizerOptions {
+    OptimizerMethod method = OptimizerMethod::Lbfgs;
+    std::size_t max_iterations = 1000;
+    // Gradient methods stop when every |df/dx_i| <= tolerance. Nelder-Mead
+    // stops when the simplex values differ by at most `tolerance` and its
+    // vertices by at most sqrt(tolerance).
+    double tolerance = 1e-8;
+    // First trial step of each gradient-descent line search (later searches
+    // start from twice the last accepted step); L-BFGS uses it only on its
+    // first iteration, scaled by 1/|g|.
+    double learning_rate = 1.0;
+    // Correction pairs kept by L-BFGS.
+    std::size_t memory = 10;
+    // Nelder-Mead initial simplex: x0 + step * max(|x0_i|, 1) along each axis.
+    double simplex_step = 0.1;
+};
+
+struct OptimizerResult {
+    std::vector<double> x;
+    double value = 0.0;
+    std::size_t iterations = 0;
+    std::size_t evaluations = 0;
+    bool converged = false;
+};
+
+// Evaluates f at every point, and its gradient too when `out_gradients` is
+// not null. Minimize passes all the points one round needs at once, so an
+// objective can evaluate them as a single batch.
+using BatchObjective = std::function<bool(const std::vector<std::vector<double>>& points,
+                                          std::vector<double>* out_values,
+                                          std::vector<std::vector<double>>* out_gradients,
+                                          std::string* out_error)>;
+
+// Wraps a value-only objective with central-difference gradients: each point
+// becomes 2n + 1 points of one batch.
+BatchObjective NumericGradientObjective(BatchObjective objective);
+
+// Runs one optimizer per start point. Every optimizer is an ask/tell state
+// machine: each round the pending points of all unfinished runs go to
+// `objective` in one call, and the runs then take their next step (line
+// search, L-BFGS update, simplex move) natively, spread across hardware
+// threads when there is enough work. `objective` itself is always called
+// from the calling thread. Results are in start order.
+bool Minimize(const OptimizerOptions& options,
+              const std::vector<std::vector<double>>& starts,
+              const BatchObjective& objective,
+              std::vector<OptimizerResult>* out_results,
+              std::string* out_error);
+
+}  // namespace clot::runtime
+
+#endif  // CLOT_RUNTIME_OPTIMIZER_HPP
@@ -0,0 +1,36 @@
+#ifndef CLOT_RUNTIME_OUTPUT_HPP
+#define CLOT_RUNTIME_OUTPUT_HPP
+
+#include <string>
+#include <string_view>
+
+namespace clot::runtime {
+
+// How program output reaches stdout. Auto is line-buffered on a terminal and
+// block-buffered for pipes and files, like C stdio.
+enum class OutputBuffering {
+    Auto,
+    Line,
+    Block,
+    None,
+};
+
+bool ParseOutputBuffering(const std::string& text, OutputBuffering* out_mode);
+
+// Call before anything is written to std::cout. Detaches std::cout from C
+// stdio, points it at a 64 KiB buffer that writes straight to fd 1 and flushes
+// it at exit. std::cerr and std::cin stay tied to std::cout, so diagnostics and
+// prompts always appear after the output that preceded them.
+void ConfigureStdout(OutputBuffering mode);
+
+// Program output (print, println, printf). Line mode flushes once per newline;
+// block mode only when the buffer fills, before stderr/stdin use, or at exit.
+void WriteStdout(std::string_view text);
+void EndStdoutLine();
+
+// Required before running code that prints through C stdio (JIT/AOT printf).
+void FlushStdout();
+
+}  // namespace clot::runtime
+
+#endif  // CLOT_RUNTIME_OUTPUT_HPP
@@ -0,0 +1,89 @@
+#ifndef CLOT_RUNTIME_PARALLEL_SORT_HPP
+#define CLOT_RUNTIME_PARALLEL_SORT_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace clot::runtime {
+
+// Inputs shorter than this are sorted on the calling thread; below it the cost
+// of spawning threads outweighs the work each one would do.
+inline constexpr std::size_t kParallelSortThreshold = 1u << 15;
+
+// Stable sort of `items` by `less`. Large inputs are split into up to one run
+// per hardware thread (a power of two), each run is stable-sorted on its own
+// thread and adjacent runs are merged pairwise, also in parallel, until one run
+// is left. std::merge prefers the left run on ties, so the result is stable.
+//
+// `less` is called concurrently and must not touch shared mutable state.
+template <typename T, typename Less>
+void ParallelStableSort(std::vector<T>* items, Less less) {
+    const std::size_t size = items->size();
+    std::size_t runs = 1;
+    const std::size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    while (runs * 2 <= hardware && size / (runs * 2) >= kParallelSortThreshold) {
+        runs *= 2;
+    }
+
+    if (runs == 1) {
+        std::stable_sort(items->begin(), items->end(), less);
+        return;
+    }
+
+    std::vector<std::size_t> bounds(runs + 1);
+    for (std::size_t run = 0; run <= runs; ++run) {
+        bounds[run] = size * run / runs;
+    }
+
+    {
+        std::vector<std::thread> workers;
+        workers.reserve(runs);
+        for (std::size_t run = 0; run < runs; ++run) {
+            workers.emplace_back([&, run]() {
+                std::stable_sort(items->begin() + static_cast<std::ptrdiff_t>(bounds[run]),
+                                 items->begin() + static_cast<std::ptrdiff_t>(bounds[run + 1]),
+                                 less);
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    std::vector<T> scratch(size);
+    std::vector<T>* source = items;
+    std::vector<T>* target = &scratch;
+    for (std::size_t width = 1; width < runs; width *= 2) {
+        std::vector<std::thread> workers;
+        for (std::size_t run = 0; run < runs; run += width * 2) {
+            workers.emplace_back([&, run]() {
+                const auto base = source->begin();
+                const std::ptrdiff_t first = static_cast<std::ptrdiff_t>(bounds[run]);
+                const std::ptrdiff_t middle = static_cast<std::ptrdiff_t>(bounds[run + width]);
+                const std::ptrdiff_t last = static_cast<std::ptrdiff_t>(bounds[run + width * 2]);
+                std::merge(std::make_move_iterator(base + first),
+                           std::make_move_iterator(base + middle),
+                           std::make_move_iterator(base + middle),
+                           std::make_move_iterator(base + last),
+                           target->begin() + first,
+                           less);
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        std::swap(source, target);
+    }
+
+    if (source != items) {
+        *items = std::move(*source);
+    }
+}
+
+}  // namespace clot::runtime
+
+#endif  // CLOT_RUNTIME_PARALLEL_SORT_HPP
@@ -0,0 +1,155 @@
+#ifndef CLOT_RUNTIME_PROFILER_HPP
+#define CLOT_RUNTIME_PROFILER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace clot::runtime {
+
+// Instrumenting profiler for the interpreter (clot --profile). The
+// interpreter brackets every user-level call and every statement it runs;
+// the profiler keeps a shadow stack and charges wall time to functions, to
+// (function, line) pairs and to distinct call stacks.
+//
+// Inclusive time counts the outermost activation only, so recursion is not
+// double counted; exclusive time is inclusive minus the time of nested frames
+// (callees for functions, nested statements for lines). Not thread-safe: the
+// interpreter runs statements on one thread.
+class Profiler {
+public:
+    struct FunctionStats {
+        std::string name;
+        std::uint64_t calls = 0;
+        std::uint64_t inclusive_ns = 0;
+        std::uint64_t exclusive_ns = 0;
+    };
+
+    struct LineStats {
+        std::string function;
+        std::size_t line = 0;
+        std::uint64_t hits = 0;
+        std::uint64_t inclusive_ns = 0;
+        std::uint64_t exclusive_ns = 0;
+    };
+
+    // Starts timing the root frame, named `root_name`.
+    explicit Profiler(std::string root_name = "main");
+
+    void EnterFunction(std::string_view name);
+    void LeaveFunction();
+
+    // `line` is charged to the innermost function frame.
+    void EnterLine(std::size_t line);
+    void LeaveLine();
+
+    // Closes every open frame, the root included. Later calls are no-ops.
+    void Stop();
+
+    // Sorted by exclusive time, largest first; valid after Stop().
+    std::vector<FunctionStats> Functions() const;
+    std::vector<LineStats> Lines() const;
+    std::uint64_t TotalNanoseconds() const { return total_ns_; }
+
+    // One "root;caller;callee <microseconds>" line per distinct stack, the
+    // weight being the stack's exclusive time. This is the collapsed format
+    // read by flamegraph.pl, inferno and speedscope. Stacks under 1 us are
+    // left out.
+    std::string CollapsedStacks() const;
+
+    // Plain-text report: total time, then functions and lines sorted by
+    // exclusive time.
+    std::string Summary() const;
+
+    // Writes `<prefix>.folded` (CollapsedStacks) and `<prefix>.txt` (Summary).
+    bool WriteReports(const std::string& prefix, std::string* out_error);
+
+private:
+    struct StackNode {
+        std::size_t function = 0;
+        std::size_t parent = 0;
+        std::uint64_t self_ns = 0;
+        std::unordered_map<std::size_t, std::size_t> children;
+    };
+
+    struct Frame {
+        std::size_t id = 0;
+        std::size_t node = 0;
+        std::int64_t start_ns = 0;
+        std::uint64_t child_ns = 0;
+    };
+
+    struct FunctionEntry {
+        FunctionStats stats;
+        std::uint32_t active = 0;
+    };
+
+    struct LineEntry {
+        LineStats stats;
+        std::uint32_t active = 0;
+    };
+
+    static std::int64_t NowNanoseconds();
+    std::size_t FunctionId(std::string_view name);
+    void PushFunction(std::size_t function, std::int64_t now);
+    void PopFunction(std::int64_t now);
+    void PopLine(std::int64_t now);
+
+    std::vector<FunctionEntry> functions_;
+    std::unordered_map<std::string, std::size_t> function_ids_;
+    std::vector<LineEntry> lines_;
+    std::unordered_map<std::uint64_t, std::size_t> line_ids_;
+    std::vector<StackNode> nodes_;
+    std::vector<Frame> call_stack_;
+    std::vector<Frame> line_stack_;
+    std::uint64_t total_ns_ = 0;
+    bool stopped_ = false;
+};
+
+// Scope guards for the interpreter hooks; a null profiler makes them no-ops.
+class ProfileFunctionScope {
+public:
+    ProfileFunctionScope(Profiler* profiler, std::string_view name) : profiler_(profiler) {
+        if (profiler_ != nullptr) {
+            profiler_->EnterFunction(name);
+        }
+    }
+    ~ProfileFunctionScope() {
+        if (profiler_ != nullptr) {
+            profiler_->LeaveFunction();
+        }
+    }
+    ProfileFunctionScope(const ProfileFunctionScope&) = delete;
+    ProfileFunctionScope& operator=(const ProfileFunctionScope&) = delete;
+
+private:
+    Profiler* profiler_;
+};
+
+class ProfileLineScope {
+public:
+    // Statements without a source line (synthesized by the parser) are not
+    // recorded; their time stays with the enclosing line.
+    ProfileLineScope(Profiler* profiler, std::size_t line) : profiler_(line != 0 ? profiler : nullptr) {
+        if (profiler_ != nullptr) {
+            profiler_->EnterLine(line);
+        }
+    }
+    ~ProfileLineScope() {
+        if (profiler_ != nullptr) {
+            profiler_->LeaveLine();
+        }
+    }
+    ProfileLineScope(const ProfileLineScope&) = delete;
+    ProfileLineScope& operator=(const ProfileLineScope&) = delete;
+
+private:
+    Profiler* profiler_;
+};
+
+}  // namespace clot::runtime
+
+#endif  // CLOT_RUNTIME_PROFILER_HPP
@@ -0,0 +1,157 @@
+#ifndef CLOT_RUNTIME_STREAMING_STATS_HPP
+#define CLOT_RUNTIME_STREAMING_STATS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace clot::runtime {
+
+// Single-pass summary: count, a Neumaier-compensated sum, Welford mean and sum
+// of squared deviations, min and max. Partials built on different threads
+// combine with Merge() (Chan et al.) without losing precision. A NaN sample
+// makes min and max NaN, as ndarray reductions do.
+class RunningStats {
+public:
+    void Add(double value);
+    void Merge(const RunningStats& other);
+
+    std::uint64_t Count() const { return count_; }
+    double Sum() const { return sum_ + compensation_; }
+    double Mean() const { return mean_; }
+    // Sample variance (n - 1 denominator); 0 with fewer than two samples.
+    double Variance() const;
+    double Min() const;
+    double Max() const;
+
+private:
+    std::uint64_t count_ = 0;
+    double sum_ = 0.0;
+    double compensation_ = 0.0;
+    double mean_ = 0.0;
+    double m2_ = 0.0;
+    double min_ = 0.0;
+    double max_ = 0.0;
+    bool saw_nan_ = false;
+};
+
+// `bins` equal-width bins over [low, high]; `high` itself falls in the last
+// bin. Samples outside the range (or NaN) are only counted as out of range.
+class FixedHistogram {
+public:
+    FixedHistogram() = default;
+    FixedHistogram(std::size_t bins, double low, double high);
+
+    void Add(double value);
+    void Merge(const FixedHistogram& other);
+
+    const std::vector<std::uint64_t>& Counts() const { return counts_; }
+    std::uint64_t Underflow() const { return underflow_; }
+    std::uint64_t Overflow() const { return overflow_; }
+
+private:
+    std::vector<std::uint64_t> counts_;
+    double low_ = 0.0;
+    double high_ = 0.0;
+    double scale_ = 0.0;
+    std::uint64_t underflow_ = 0;
+    std::uint64_t overflow_ = 0;
+};
+
+// Streaming quantiles with bounded relative error (DDSketch): each sample is
+// counted in a logarithmically spaced bucket, so any quantile is returned
+// within `relative_accuracy` of a true sample value, whatever the
+// distribution. Memory depends on the dynamic range of the data, not on the
+// number of samples, and sketches merge by adding bucket counts. Non-finite
+// samples are ignored.
+class QuantileSketch {
+public:
+    explicit QuantileSketch(double relative_accuracy = 0.01);
+
+    void Add(double value);
+    void Merge(const QuantileSketch& other);
+
+    std::uint64_t Count() const { return positive_.total + negative_.total + zero_count_; }
+    // `quantile` in [0, 1]; the sketch must not be empty.
+    double Quantile(double quantile) const;
+
+private:
+    // Dense counts for bucket indexes [offset, offset + counts.size()).
+    struct Store {
+        std::vector<std::uint64_t> counts;
+        int offset = 0;
+        std::uint64_t total = 0;
+
+        void Add(int index, std::uint64_t count);
+    };
+
+    int BucketIndex(double magnitude) const;
+    double BucketValue(int index) const;
+
+    double gamma_;
+    double log_gamma_;
+    Store positive_;
+    Store negative_;
+    std::uint64_t zero_count_ = 0;
+};
+
+// What a pass over the data should collect besides the summary.
+struct StatsRequest {
+    bool histogram = false;
+    std::size_t bins = 0;
+    double low = 0.0;
+    double high = 0.0;
+    bool quantiles = false;
+    double relative_accuracy = 0.01;
+};
+
+// Per-thread partial of one pass: the summary plus whatever the request asked
+// for.
+class StatsAggregate {
+public:
+    explicit StatsAggregate(const StatsRequest& request);
+
+    void Add(double value);
+    void Merge(const StatsAggregate& other);
+
+    const RunningStats& Summary() const { return summary_; }
+    const FixedHistogram& Histogram() const { return histogram_; }
+    const QuantileSketch& Sketch() const { return sketch_; }
+    // Quantile estimate clamped to the exact min/max of the data.
+    double Quantile(double quantile) const;
+
+    // Fields of a file that were not numbers (headers, blanks in a column).
+    std::uint64_t Skipped() const { return skipped_; }
+    void AddSkipped(std::uint64_t count) { skipped_ += count; }
+
+private:
+    StatsRequest request_;
+    RunningStats summary_;
+    FixedHistogram histogram_;
+    QuantileSketch sketch_;
+    std::uint64_t skipped_ = 0;
+};
+
+// Drivers. Inputs large enough to pay for threads are split into one chunk per
+// hardware thread; each chunk fills its own StatsAggregate and the partials
+// are merged in chunk order at the end.
+StatsAggregate AggregateValues(const double* values, std::size_t count, const StatsRequest& request);
+
+// start, start + step, ... (`count` samples), never materialized.
+StatsAggregate AggregateSequence(double start, double step, std::size_t count, const StatsRequest& request);
+
+// Streams numbers from a text file in 1 MiB blocks; the file is split into
+// byte ranges aligned to line starts, one per thread. With `column` < 0 every
+// token separated by whitespace, ',' or ';' is a sample; otherwise each line
+// is split on `delimiter` and only that 0-based field is read.
+bool AggregateFile(const std::string& path,
+                   std::ptrdiff_t column,
+                   char delimiter,
+                   const StatsRequest& request,
+                   StatsAggregate* out_aggregate,
+                   std::string* out_error);
+
+}  // namespace clot::runtime
+
+#endif  // CLOT_RUNTIME_STREAMING_STATS_HPP
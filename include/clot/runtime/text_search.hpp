@@ -0,0 +1,26 @@
+#ifndef CLOT_RUNTIME_TEXT_SEARCH_HPP
+#define CLOT_RUNTIME_TEXT_SEARCH_HPP
+
+#include <cstddef>
+#include <string_view>
+
+namespace clot::runtime {
+
+// Byte-level search used by the string methods. On x86 the scan compares 32
+// bytes per step with AVX2 when the CPU supports it (checked once at runtime)
+// and 16 bytes with SSE2 otherwise; other targets use memchr/memcmp. All
+// functions return std::string_view::npos when nothing is found.
+
+// First position >= `from` holding `needle`.
+std::size_t FindByte(std::string_view haystack, char needle, std::size_t from = 0);
+
+// First position >= `from` where `needle` starts. An empty needle matches at
+// `from` (if it is within the haystack).
+std::size_t FindSubstring(std::string_view haystack, std::string_view needle, std::size_t from = 0);
+
+// Number of non-overlapping occurrences of a non-empty `needle`.
+std::size_t CountSubstring(std::string_view haystack, std::string_view needle);
+
+}  // namespace clot::runtime
+
+#endif  // CLOT_RUNTIME_TEXT_SEARCH_HPP
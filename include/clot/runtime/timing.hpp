@@ -0,0 +1,15 @@
+#ifndef CLOT_RUNTIME_TIMING_HPP
+#define CLOT_RUNTIME_TIMING_HPP
+
+#include <cstdint>
+#include <optional>
+
+namespace clot::runtime {
+
+// CPU time (user plus system) consumed by the process so far, in nanoseconds;
+// empty where the platform does not expose it.
+std::optional<std::uint64_t> ProcessCpuNanoseconds();
+
+}  // namespace clot::runtime
+
+#endif  // CLOT_RUNTIME_TIMING_HPP
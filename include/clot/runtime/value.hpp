@@ -13,7 +13,10 @@
 #include <vector>
 
 #include "clot/runtime/bigint.hpp"
+#include "clot/runtime/counters.hpp"
 #include "clot/runtime/decimal.hpp"
+#include "clot/runtime/dual.hpp"
+#include "clot/runtime/ndarray.hpp"
 
 namespace clot::runtime {
 
@@ -67,6 +70,14 @@ public:
     };
 
     Value() : data_(BigInt(0)) {}
+    Value(const Value& other) : data_(other.data_) { CountEvent(Counter::ValueCopies); }
+    Value(Value&& other) = default;
+    Value& operator=(const Value& other) {
+        data_ = other.data_;
+        CountEvent(Counter::ValueCopies);
+        return *this;
+    }
+    Value& operator=(Value&& other) = default;
     Value(std::nullptr_t) : data_(std::monostate{}) {}
     explicit Value(BigInt value) : data_(std::move(value)) {}
     explicit Value(long long value) : data_(BigInt(value)) {}
@@ -84,6 +95,8 @@ public:
     explicit Value(Map value) : data_(std::move(value)) {}
     explicit Value(FunctionRef value) : data_(std::move(value)) {}
     explicit Value(Range value) : data_(std::move(value)) {}
+    explicit Value(NdArray value) : data_(std::move(value)) {}
+    explicit Value(Dual value) : data_(std::move(value)) {}
 
     bool IsNull() const { return std::holds_alternative<std::monostate>(data_); }
     bool IsNumber() const {
@@ -106,6 +119,8 @@ public:
     bool IsObject() const { return std::holds_alternative<Object>(data_); }
     bool IsFunctionRef() const { return std::holds_alternative<FunctionRef>(data_); }
     bool IsRange() const { return std::holds_alternative<Range>(data_); }
+    bool IsNdArray() const { return std::holds_alternative<NdArray>(data_); }
+    bool IsDual() const { return std::holds_alternative<Dual>(data_); }
 
     const BigInt* AsBigIntValue() const {
         if (!IsInteger()) {
@@ -142,6 +157,20 @@ public:
         return &std::get<Range>(data_);
     }
 
+    const NdArray* AsNdArray() const {
+        if (!IsNdArray()) {
+            return nullptr;
+        }
+        return &std::get<NdArray>(data_);
+    }
+
+    const Dual* AsDual() const {
+        if (!IsDual()) {
+            return nullptr;
+        }
+        return &std::get<Dual>(data_);
+    }
+
     // Number of values the range yields (always >= 0). Only valid when IsRange().
     BigInt RangeLength() const {
         const Range& range = std::get<Range>(data_);
@@ -290,6 +319,20 @@ public:
         return &std::get<List>(data_);
     }
 
+    const std::string* AsStringValue() const {
+        if (!IsString()) {
+            return nullptr;
+        }
+        return &std::get<std::string>(data_);
+    }
+
+    std::string* MutableString() {
+        if (!IsString()) {
+            return nullptr;
+        }
+        return &std::get<std::string>(data_);
+    }
+
     const std::vector<Value>* AsTuple() const {
         if (!IsTuple()) {
             return nullptr;
@@ -587,6 +630,14 @@ public:
             return RangeLength() != BigInt(0);
         }
 
+        if (std::holds_alternative<NdArray>(data_)) {
+            return std::get<NdArray>(data_).Size() != 0;
+        }
+
+        if (std::holds_alternative<Dual>(data_)) {
+            return std::get<Dual>(data_).Value() != 0.0;
+        }
+
         return true;
     }
 
@@ -724,6 +775,14 @@ public:
             return lhs_range.step == rhs_range.step;
         }
 
+        if (IsNdArray() && other.IsNdArray()) {
+            return std::get<NdArray>(data_).Equals(std::get<NdArray>(other.data_));
+        }
+
+        if (IsDual() && other.IsDual()) {
+            return std::get<Dual>(data_).Equals(std::get<Dual>(other.data_));
+        }
+
         return false;
     }
 
@@ -731,6 +790,28 @@ public:
         return ToStringInternal(false);
     }
 
+    // Appends ToString() to `out`; strings and chars are copied directly.
+    void AppendTo(std::string* out) const {
+        if (const auto* text = std::get_if<std::string>(&data_)) {
+            out->append(*text);
+            return;
+        }
+        if (const auto* character = std::get_if<char>(&data_)) {
+            out->push_back(*character);
+            return;
+        }
+        out->append(ToStringInternal(false));
+    }
+
+    // Capacity hint for rendering this value as text: exact for strings and
+    // chars, a small guess for everything else.
+    std::size_t EstimatedTextSize() const {
+        if (const auto* text = std::get_if<std::string>(&data_)) {
+            return text->size();
+        }
+        return IsChar() ? 1 : 16;
+    }
+
     static bool TryParseBigInt(const std::string& text, BigInt* out_integer) {
         return BigInt::TryParse(text, out_integer);
     }
@@ -757,8 +838,9 @@ private:
         stream << std::setprecision(15) << value;
         std::string text = stream.str();
 
+        // Trim trailing fraction zeros, but never the digits of an exponent.
         const std::size_t dot = text.find('.');
-        if (dot != std::string::npos) {
+        if (dot != std::string::npos && text.find('e') == std::string::npos) {
             while (!text.empty() && text.back() == '0') {
                 text.pop_back();
             }
@@ -779,8 +861,9 @@ private:
         stream << std::setprecision(7) << value;
         std::string text = stream.str();
 
+        // Trim trailing fraction zeros, but never the digits of an exponent.
         const std::size_t dot = text.find('.');
-        if (dot != std::string::npos) {
+        if (dot != std::string::npos && text.find('e') == std::string::npos) {
             while (!text.empty() && text.back() == '0') {
                 text.pop_back();
             }
@@ -964,6 +1047,30 @@ private:
             return text;
         }
 
+        if (std::holds_alternative<NdArray>(data_)) {
+            return std::get<NdArray>(data_).ToString();
+        }
+
+        if (std::holds_alternative<Dual>(data_)) {
+            // dual(value, tangent) with one direction, dual(value, [t0, t1, ...])
+            // otherwise; the same call rebuilds it.
+            const Dual& dual = std::get<Dual>(data_);
+            std::string text = "dual(" + Value(dual.Value()).ToStringInternal(true) + ", ";
+            if (dual.Directions() == 1) {
+                text += Value(dual.Tangent(0)).ToStringInternal(true);
+            } else {
+                text += "[";
+                for (std::size_t i = 0; i < dual.Directions(); ++i) {
+                    text += Value(dual.Tangent(i)).ToStringInternal(true);
+                    if (i + 1 < dual.Directions()) {
+                        text += ", ";
+                    }
+                }
+                text += "]";
+            }
+            return text + ")";
+        }
+
         const FunctionRef& function = std::get<FunctionRef>(data_);
         return "<function:" + function.name + ">";
     }
@@ -983,7 +1090,9 @@ private:
         Map,
         Object,
         FunctionRef,
-        Range>
+        Range,
+        NdArray,
+        Dual>
         data_;
 };
 
@@ -0,0 +1,17 @@
+#ifndef CLOT_RUNTIME_VALUE_HASH_HPP
+#define CLOT_RUNTIME_VALUE_HASH_HPP
+
+#include <cstdint>
+
+#include "clot/runtime/value.hpp"
+
+namespace clot::runtime {
+
+// Structural 64-bit hash behind hash() and id(). Containers hash their
+// elements, sets and maps independently of order; nesting deeper than 128
+// levels hashes to a fixed constant.
+std::uint64_t HashValue(const Value& value);
+
+}  // namespace clot::runtime
+
+#endif  // CLOT_RUNTIME_VALUE_HASH_HPP
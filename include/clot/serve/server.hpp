@@ -0,0 +1,44 @@
+#ifndef CLOT_SERVE_SERVER_HPP
+#define CLOT_SERVE_SERVER_HPP
+
+#include <string>
+
+#include "clot/interpreter/interpreter.hpp"
+#include "clot/runtime/output.hpp"
+
+namespace clot::serve {
+
+// `clot serve`: a resident process that keeps parsed scripts and modules warm
+// and runs each request in a forked child with a fresh interpreter, so runs
+// cannot see each other's state. The client passes its stdin, stdout and
+// stderr over the Unix socket, so output streams to it directly. Cached files
+// are reparsed when their modification time or size changes. Requests run
+// concurrently, one child each; a client that sends nothing is dropped after a
+// few seconds. Both ends refuse peers that run as another user. POSIX only.
+struct ServerOptions {
+    std::string socket_path;
+    bool verbose = false;
+};
+
+// $CLOT_SERVE_SOCKET, else $XDG_RUNTIME_DIR/clot.sock, else /tmp/clot-<uid>.sock.
+std::string DefaultSocketPath();
+
+// Serves until SIGINT, SIGTERM or StopServer.
+bool RunServer(const ServerOptions& options, std::string* out_error);
+
+// Runs `script_path` on the server with this process's stdio, working
+// directory, language and output buffering, under `limits`. `out_exit_code`
+// gets the code the script would have exited with when run by `clot` directly.
+bool RunOnServer(
+    const std::string& socket_path,
+    const std::string& script_path,
+    runtime::OutputBuffering output_buffering,
+    const interpreter::Interpreter::ResourceLimits& limits,
+    int* out_exit_code,
+    std::string* out_error);
+
+bool StopServer(const std::string& socket_path, std::string* out_error);
+
+}  // namespace clot::serve
+
+#endif  // CLOT_SERVE_SERVER_HPP
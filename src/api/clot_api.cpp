@@ -0,0 +1,449 @@
+#include "clot/clot.h"
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "clot/frontend/parser.hpp"
+#include "clot/frontend/source_loader.hpp"
+#include "clot/interpreter/interpreter.hpp"
+#include "clot/runtime/i18n.hpp"
+#include "clot/runtime/value.hpp"
+
+#ifndef CLOT_VERSION
+#define CLOT_VERSION "dev"
+#endif
+
+struct clot_program {
+    std::shared_ptr<const clot::frontend::Program> program;
+    std::string source_path;
+};
+
+struct clot_context {
+    clot::interpreter::Interpreter interpreter;
+    // The program of the last run; functions_ points into its AST.
+    std::shared_ptr<const clot::frontend::Program> program;
+    std::string error;
+};
+
+struct clot_value {
+    clot::runtime::Value value;
+    // Set by clot_value_error; a native builtin returning it raises an error.
+    bool is_error = false;
+    std::string error;
+    // Filled on demand by clot_value_to_string.
+    mutable std::string text;
+    mutable bool has_text = false;
+};
+
+namespace {
+
+void CopyToBuffer(const std::string& text, char* buffer, std::size_t buffer_size) {
+    if (buffer == nullptr || buffer_size == 0) {
+        return;
+    }
+    const std::size_t length = std::min(text.size(), buffer_size - 1);
+    std::memcpy(buffer, text.data(), length);
+    buffer[length] = '\0';
+}
+
+clot_value* NewValue(clot::runtime::Value value) {
+    clot_value* handle = new (std::nothrow) clot_value;
+    if (handle != nullptr) {
+        handle->value = std::move(value);
+    }
+    return handle;
+}
+
+clot_program* ParseLines(
+    std::vector<std::string> lines,
+    const char* source_path,
+    char* error_buffer,
+    std::size_t error_buffer_size) {
+    clot::frontend::Parser parser(std::move(lines));
+    auto program = std::make_shared<clot::frontend::Program>();
+    clot::frontend::Diagnostic diagnostic;
+    if (!parser.Parse(program.get(), &diagnostic)) {
+        CopyToBuffer(
+            clot::runtime::Tr("Error de parseo en linea ", "Parse error at line ") + std::to_string(diagnostic.line) +
+                clot::runtime::Tr(", columna ", ", column ") + std::to_string(diagnostic.column) + ": " +
+                clot::runtime::TranslateDiagnostic(diagnostic.message),
+            error_buffer,
+            error_buffer_size);
+        return nullptr;
+    }
+
+    clot_program* handle = new (std::nothrow) clot_program;
+    if (handle == nullptr) {
+        CopyToBuffer(clot::runtime::Tr("Memoria insuficiente.", "Out of memory."), error_buffer, error_buffer_size);
+        return nullptr;
+    }
+    handle->program = std::move(program);
+    handle->source_path = source_path != nullptr ? source_path : "";
+    return handle;
+}
+
+int Fail(clot_context* context, const std::string& message) {
+    context->error = clot::runtime::TranslateDiagnostic(message);
+    return CLOT_ERROR;
+}
+
+// No C++ exception may cross into the host: every entry point runs its body
+// through one of these, which turn whatever escapes into the C error result.
+std::string CurrentExceptionMessage() {
+    try {
+        throw;
+    } catch (const std::bad_alloc&) {
+        return "Memoria insuficiente.";
+    } catch (const std::exception& error) {
+        return std::string("Excepcion interna: ") + error.what();
+    } catch (...) {
+        return "Excepcion interna desconocida.";
+    }
+}
+
+template <typename Body>
+int GuardContext(clot_context* context, Body&& body) {
+    try {
+        return body();
+    } catch (...) {
+        try {
+            return Fail(context, CurrentExceptionMessage());
+        } catch (...) {
+            context->error.clear();
+            return CLOT_ERROR;
+        }
+    }
+}
+
+template <typename Body>
+clot_program* GuardParse(char* error_buffer, std::size_t error_buffer_size, Body&& body) {
+    try {
+        return body();
+    } catch (...) {
+        try {
+            CopyToBuffer(clot::runtime::TranslateDiagnostic(CurrentExceptionMessage()), error_buffer,
+                         error_buffer_size);
+        } catch (...) {
+            CopyToBuffer("", error_buffer, error_buffer_size);
+        }
+        return nullptr;
+    }
+}
+
+// For calls with no error channel: `fallback` stands in for the result.
+template <typename Result, typename Body>
+Result GuardValue(Result fallback, Body&& body) {
+    try {
+        return body();
+    } catch (...) {
+        return fallback;
+    }
+}
+
+}  // namespace
+
+extern "C" {
+
+const char* clot_version(void) {
+    return CLOT_VERSION;
+}
+
+int clot_set_language(const char* language) {
+    return GuardValue(CLOT_ERROR, [&] {
+        clot::runtime::Language parsed = clot::runtime::Language::Spanish;
+        if (language == nullptr || !clot::runtime::ParseLanguage(language, &parsed)) {
+            return CLOT_ERROR;
+        }
+        clot::runtime::SetLanguage(parsed);
+        return CLOT_OK;
+    });
+}
+
+clot_program* clot_program_parse(
+    const char* source_text,
+    const char* source_path,
+    char* error_buffer,
+    size_t error_buffer_size) {
+    return GuardParse(error_buffer, error_buffer_size, [&]() -> clot_program* {
+        if (source_text == nullptr) {
+            CopyToBuffer(
+                clot::runtime::Tr("Codigo fuente nulo.", "Null source text."), error_buffer, error_buffer_size);
+            return nullptr;
+        }
+
+        // Same line split as clot_runtime_execute_source.
+        std::vector<std::string> lines;
+        std::istringstream stream(source_text);
+        std::string line;
+        while (std::getline(stream, line)) {
+            lines.push_back(line);
+        }
+        const std::size_t length = std::strlen(source_text);
+        if (length > 0 && source_text[length - 1] == '\n') {
+            lines.push_back(std::string());
+        }
+        return ParseLines(std::move(lines), source_path, error_buffer, error_buffer_size);
+    });
+}
+
+clot_program* clot_program_parse_file(const char* path, char* error_buffer, size_t error_buffer_size) {
+    return GuardParse(error_buffer, error_buffer_size, [&]() -> clot_program* {
+        if (path == nullptr) {
+            CopyToBuffer(clot::runtime::Tr("Ruta nula.", "Null path."), error_buffer, error_buffer_size);
+            return nullptr;
+        }
+        std::vector<std::string> lines;
+        std::string error;
+        if (!clot::frontend::LoadSourceLines(path, &lines, &error)) {
+            CopyToBuffer(clot::runtime::TranslateDiagnostic(error), error_buffer, error_buffer_size);
+            return nullptr;
+        }
+        return ParseLines(std::move(lines), path, error_buffer, error_buffer_size);
+    });
+}
+
+void clot_program_free(clot_program* program) {
+    delete program;
+}
+
+clot_context* clot_context_new(void) {
+    return GuardValue<clot_context*>(nullptr, [] { return new (std::nothrow) clot_context; });
+}
+
+void clot_context_free(clot_context* context) {
+    delete context;
+}
+
+int clot_context_register_builtin(
+    clot_context* context,
+    const char* name,
+    clot_native_fn function,
+    void* user_data) {
+    if (context == nullptr) {
+        return CLOT_ERROR;
+    }
+    return GuardContext(context, [&] {
+        if (name == nullptr || name[0] == '\0' || function == nullptr) {
+            return Fail(context, "clot_context_register_builtin requiere nombre y funcion.");
+        }
+
+        context->interpreter.RegisterNativeBuiltin(
+            name,
+            [function, user_data](const std::vector<clot::runtime::Value>& arguments,
+                                  clot::runtime::Value* out_value,
+                                  std::string* out_error) {
+                std::vector<clot_value> handles(arguments.size());
+                std::vector<const clot_value*> pointers(arguments.size());
+                for (std::size_t i = 0; i < arguments.size(); ++i) {
+                    handles[i].value = arguments[i];
+                    pointers[i] = &handles[i];
+                }
+
+                std::unique_ptr<clot_value> result(function(user_data, pointers.data(), pointers.size()));
+                if (result == nullptr) {
+                    *out_value = clot::runtime::Value(nullptr);
+                    return true;
+                }
+                if (result->is_error) {
+                    *out_error = result->error;
+                    return false;
+                }
+                *out_value = std::move(result->value);
+                return true;
+            });
+        context->error.clear();
+        return CLOT_OK;
+    });
+}
+
+int clot_context_set_limits(
+    clot_context* context,
+    unsigned long long max_heap_bytes,
+    unsigned long long max_wall_ms,
+    unsigned long long max_statements) {
+    if (context == nullptr) {
+        return CLOT_ERROR;
+    }
+    return GuardContext(context, [&] {
+        clot::interpreter::Interpreter::ResourceLimits limits;
+        limits.max_heap_bytes = max_heap_bytes;
+        limits.max_wall_ms = max_wall_ms;
+        limits.max_statements = max_statements;
+        std::string error;
+        if (!context->interpreter.SetResourceLimits(limits, &error)) {
+            return Fail(context, error);
+        }
+        context->error.clear();
+        return CLOT_OK;
+    });
+}
+
+int clot_context_run(clot_context* context, const clot_program* program) {
+    if (context == nullptr) {
+        return CLOT_ERROR;
+    }
+    return GuardContext(context, [&] {
+        if (program == nullptr) {
+            return Fail(context, "clot_context_run requiere un programa.");
+        }
+
+        context->program = program->program;
+        context->interpreter.SetEntryFilePath(program->source_path);
+        std::string error;
+        if (!context->interpreter.Execute(*context->program, &error)) {
+            return Fail(context, error);
+        }
+        context->error.clear();
+        return CLOT_OK;
+    });
+}
+
+int clot_context_call(
+    clot_context* context,
+    const char* function_name,
+    const clot_value* const* args,
+    size_t arg_count,
+    clot_value** out_result) {
+    if (context == nullptr) {
+        return CLOT_ERROR;
+    }
+    return GuardContext(context, [&] {
+        if (function_name == nullptr) {
+            return Fail(context, "clot_context_call requiere el nombre de la funcion.");
+        }
+        if (context->program == nullptr) {
+            return Fail(context, "clot_context_call requiere ejecutar un programa antes.");
+        }
+
+        std::vector<clot::runtime::Value> arguments;
+        arguments.reserve(arg_count);
+        for (std::size_t i = 0; i < arg_count; ++i) {
+            arguments.push_back(args[i] != nullptr ? args[i]->value : clot::runtime::Value(nullptr));
+        }
+
+        clot::runtime::Value result;
+        std::string error;
+        if (!context->interpreter.CallFunction(function_name, arguments, &result, &error)) {
+            return Fail(context, error);
+        }
+        if (out_result != nullptr) {
+            *out_result = NewValue(std::move(result));
+        }
+        context->error.clear();
+        return CLOT_OK;
+    });
+}
+
+const char* clot_context_error(const clot_context* context) {
+    return context != nullptr ? context->error.c_str() : "";
+}
+
+clot_value* clot_value_null(void) {
+    return GuardValue<clot_value*>(nullptr, [] { return NewValue(clot::runtime::Value(nullptr)); });
+}
+
+clot_value* clot_value_bool(int value) {
+    return GuardValue<clot_value*>(nullptr, [&] { return NewValue(clot::runtime::Value(value != 0)); });
+}
+
+clot_value* clot_value_int(long long value) {
+    return GuardValue<clot_value*>(nullptr, [&] { return NewValue(clot::runtime::Value(value)); });
+}
+
+clot_value* clot_value_double(double value) {
+    return GuardValue<clot_value*>(nullptr, [&] { return NewValue(clot::runtime::Value(value)); });
+}
+
+clot_value* clot_value_string(const char* text) {
+    return GuardValue<clot_value*>(nullptr, [&] {
+        return NewValue(clot::runtime::Value(std::string(text != nullptr ? text : "")));
+    });
+}
+
+clot_value* clot_value_error(const char* message) {
+    return GuardValue<clot_value*>(nullptr, [&] {
+        std::unique_ptr<clot_value> handle(NewValue(clot::runtime::Value(nullptr)));
+        if (handle != nullptr) {
+            handle->is_error = true;
+            handle->error = message != nullptr ? message : "";
+        }
+        return handle.release();
+    });
+}
+
+void clot_value_free(clot_value* value) {
+    delete value;
+}
+
+clot_type clot_value_type(const clot_value* value) {
+    if (value == nullptr || value->value.IsNull()) {
+        return CLOT_TYPE_NULL;
+    }
+    if (value->value.IsBool()) {
+        return CLOT_TYPE_BOOL;
+    }
+    if (value->value.IsInteger()) {
+        return CLOT_TYPE_INT;
+    }
+    if (value->value.IsDouble() || value->value.IsFloat()) {
+        return CLOT_TYPE_DOUBLE;
+    }
+    if (value->value.IsString()) {
+        return CLOT_TYPE_STRING;
+    }
+    return CLOT_TYPE_OTHER;
+}
+
+int clot_value_as_bool(const clot_value* value) {
+    return GuardValue(0, [&] { return value != nullptr && value->value.AsBool() ? 1 : 0; });
+}
+
+long long clot_value_as_int(const clot_value* value, int* ok) {
+    if (ok != nullptr) {
+        *ok = 0;
+    }
+    return GuardValue(0LL, [&] {
+        bool converted = false;
+        const long long result = value != nullptr ? value->value.AsInteger(&converted) : 0;
+        if (ok != nullptr) {
+            *ok = converted ? 1 : 0;
+        }
+        return result;
+    });
+}
+
+double clot_value_as_double(const clot_value* value, int* ok) {
+    if (ok != nullptr) {
+        *ok = 0;
+    }
+    return GuardValue(0.0, [&] {
+        bool converted = false;
+        const double result = value != nullptr ? value->value.AsNumber(&converted) : 0.0;
+        if (ok != nullptr) {
+            *ok = converted ? 1 : 0;
+        }
+        return result;
+    });
+}
+
+const char* clot_value_to_string(const clot_value* value) {
+    if (value == nullptr) {
+        return "";
+    }
+    return GuardValue<const char*>("", [&] {
+        if (!value->has_text) {
+            value->text = value->value.ToString();
+            value->has_text = true;
+        }
+        return value->text.c_str();
+    });
+}
+
+}  // extern "C"
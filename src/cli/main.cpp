@@ -1,20 +1,29 @@
+#include <cctype>
+#include <cstdint>
 #include <cstdlib>
 #include <algorithm>
 #include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <set>
 #include <string>
 #include <vector>
 
 #include "clot/codegen/llvm_compiler.hpp"
+#include "clot/codegen/llvm_jit.hpp"
 #include "clot/frontend/parser.hpp"
 #include "clot/frontend/source_loader.hpp"
 #include "clot/frontend/static_analyzer.hpp"
 #include "clot/interpreter/interpreter.hpp"
+#include "clot/runtime/counters.hpp"
 #include "clot/runtime/env.hpp"
 #include "clot/runtime/i18n.hpp"
+#include "clot/runtime/output.hpp"
 #include "clot/runtime/paths.hpp"
+#include "clot/runtime/profiler.hpp"
+#include "clot/serve/server.hpp"
 
 #ifndef CLOT_VERSION
 #define CLOT_VERSION "0.3.4"
@@ -26,6 +35,7 @@ enum class RunMode {
     Interpret,
     Compile,
     Analyze,
+    Jit,
 };
 
 struct CliOptions {
@@ -34,8 +44,28 @@ struct CliOptions {
     bool verbose = false;
     std::string input_path;
     RunMode mode = RunMode::Interpret;
+    clot::interpreter::Interpreter::TierUpPolicy tier_up_policy;
     clot::runtime::Language language = clot::runtime::Language::English;
     clot::codegen::CompileOptions compile_options;
+    bool disable_object_cache = false;
+    // Non-empty with --profile: reports go to <prefix>.folded and <prefix>.txt.
+    std::string profile_prefix;
+    // --stats prints the counter report to stderr; --stats-json writes it to a file.
+    bool print_stats = false;
+    std::string stats_json_path;
+    // --snapshot starts from a saved state; --snapshot-write saves the state
+    // left by this run (see Interpreter::WriteSnapshot).
+    std::string snapshot_path;
+    std::string snapshot_write_path;
+    // --max-heap, --max-time and --max-statements (0 = unbounded).
+    clot::interpreter::Interpreter::ResourceLimits resource_limits;
+    clot::runtime::OutputBuffering output_buffering = clot::runtime::OutputBuffering::Auto;
+    // `clot serve` runs (or with --stop, stops) the resident server; --server
+    // runs the input file on it. Both use --socket or the default path.
+    bool serve = false;
+    bool serve_stop = false;
+    bool use_server = false;
+    std::string socket_path;
 };
 
 void PrintVersion() {
@@ -47,21 +77,48 @@ void PrintHelp() {
         std::cout
             << "ClotProgrammingLanguage\n"
             << "Usage:\n"
-            << "  clot [file.clot] [options]\n\n"
+            << "  clot [file.clot] [options]\n"
+            << "  clot serve [--socket <path>] [--stop] [--verbose]\n\n"
             << "Options:\n"
             << "  -h, --help               Show this help\n"
             << "  -v, --version            Show the clot version\n"
-            << "  --mode interpret|compile|analyze Run in interpreter, LLVM compiler or static analyzer mode\n"
+            << "  --mode interpret|compile|analyze|jit Run in interpreter, LLVM compiler, static analyzer or\n"
+            << "                           interpreter + in-process LLVM JIT mode\n"
+            << "  --jit-threshold <n>      Calls before a function is JIT-compiled in jit mode (default 10)\n"
+            << "  --jit-sync               Compile hot functions on the calling thread instead of in background\n"
             << "  --emit exe|obj|ir        Output type in compile mode\n"
             << "  -o, --output <file>      Output path in compile mode\n"
             << "  --target <triple>        LLVM target (e.g. x86_64-pc-linux-gnu)\n"
             << "  --runtime-bridge static|external Runtime bridge strategy in compile mode\n"
+            << "  -j, --jobs <n>           Codegen threads for compile --emit exe (default: all cores)\n"
+            << "  --object-cache <dir>     Reuse per-function objects across builds (or CLOT_OBJECT_CACHE)\n"
+            << "  --no-object-cache        Ignore CLOT_OBJECT_CACHE for this build\n"
+            << "  --instrument             Build an exe that writes LLVM PGO counters (*.profraw)\n"
+            << "  --profile-use <file>     Optimize with a profile merged by llvm-profdata (*.profdata)\n"
+            << "  --profile <prefix>       Time functions and lines; writes <prefix>.folded (flamegraph)\n"
+            << "                           and <prefix>.txt (summary)\n"
+            << "  --stats                  Print runtime counters (copies, dispatch, memory, builtins) at exit\n"
+            << "  --stats-json <file>      Write the runtime counters as JSON\n"
+            << "  --snapshot-write <file>  After the run, save globals, functions, classes and modules\n"
+            << "  --snapshot <file>        Start from a saved snapshot instead of re-running its imports\n"
+            << "  --max-heap <bytes>       Stop the script with MemoryError past this heap growth (k/m/g suffixes)\n"
+            << "  --max-time <ms>          Stop the script with TimeoutError after this wall time\n"
+            << "  --max-statements <n>     Stop the script with InstructionLimitError after n statements\n"
+            << "  --output-buffering auto|line|block|none stdout policy (default auto: line on a TTY,\n"
+            << "                           block for pipes/files; also CLOT_OUTPUT_BUFFERING)\n"
+            << "  --server                 Run the file on a running `clot serve` (warm parsed modules)\n"
+            << "  --socket <path>          clot serve socket (default: CLOT_SERVE_SOCKET,\n"
+            << "                           $XDG_RUNTIME_DIR/clot.sock or /tmp/clot-<uid>.sock)\n"
+            << "  --stop                   With serve: stop the running server\n"
             << "  --lang es|en             UI language (Spanish/English)\n"
             << "  --verbose                Print extra information\n\n"
             << "Examples:\n"
             << "  clot program.clot\n"
             << "  clot program.clot --mode compile --emit exe -o program\n"
             << "  clot program.clot --mode analyze\n"
+            << "  clot program.clot --mode jit --jit-threshold 2\n"
+            << "  clot program.clot --profile out/program\n"
+            << "  clot serve & clot program.clot --server\n"
             << "  clot program.clot --mode compile --emit ir -o program.ll\n";
         return;
     }
@@ -69,21 +126,48 @@ void PrintHelp() {
     std::cout
         << "ClotProgrammingLanguage\n"
         << "Uso:\n"
-        << "  clot [archivo.clot] [opciones]\n\n"
+        << "  clot [archivo.clot] [opciones]\n"
+        << "  clot serve [--socket <ruta>] [--stop] [--verbose]\n\n"
         << "Opciones:\n"
         << "  -h, --help               Muestra esta ayuda\n"
         << "  -v, --version            Muestra la version de clot\n"
-        << "  --mode interpret|compile|analyze Ejecuta en modo interprete, compilador LLVM o analizador estatico\n"
+        << "  --mode interpret|compile|analyze|jit Ejecuta en modo interprete, compilador LLVM, analizador\n"
+        << "                           estatico o interprete + JIT LLVM en proceso\n"
+        << "  --jit-threshold <n>      Llamadas antes de compilar una funcion con JIT (por defecto 10)\n"
+        << "  --jit-sync               Compila funciones calientes en el hilo actual en vez de en segundo plano\n"
         << "  --emit exe|obj|ir        Tipo de salida en modo compile\n"
         << "  -o, --output <archivo>   Ruta de salida en modo compile\n"
         << "  --target <triple>        Target LLVM (ej. x86_64-pc-linux-gnu)\n"
         << "  --runtime-bridge static|external Estrategia del runtime bridge en compile\n"
+        << "  -j, --jobs <n>           Hilos de codegen en compile --emit exe (por defecto: todos los nucleos)\n"
+        << "  --object-cache <dir>     Reutiliza objetos por funcion entre builds (o CLOT_OBJECT_CACHE)\n"
+        << "  --no-object-cache        Ignora CLOT_OBJECT_CACHE en este build\n"
+        << "  --instrument             Genera un exe que escribe contadores PGO de LLVM (*.profraw)\n"
+        << "  --profile-use <archivo>  Optimiza con un perfil combinado por llvm-profdata (*.profdata)\n"
+        << "  --profile <prefijo>      Mide funciones y lineas; escribe <prefijo>.folded (flamegraph)\n"
+        << "                           y <prefijo>.txt (resumen)\n"
+        << "  --stats                  Imprime contadores de ejecucion (copias, despacho, memoria, builtins)\n"
+        << "  --stats-json <archivo>   Escribe los contadores de ejecucion en JSON\n"
+        << "  --snapshot-write <archivo> Al terminar, guarda globales, funciones, clases y modulos\n"
+        << "  --snapshot <archivo>     Parte de un snapshot guardado en vez de re-ejecutar sus imports\n"
+        << "  --max-heap <bytes>       Detiene el script con MemoryError si el heap crece mas (sufijos k/m/g)\n"
+        << "  --max-time <ms>          Detiene el script con TimeoutError tras ese tiempo real\n"
+        << "  --max-statements <n>     Detiene el script con InstructionLimitError tras n sentencias\n"
+        << "  --output-buffering auto|line|block|none Politica de stdout (auto: line en TTY, block en\n"
+        << "                           pipes/archivos; tambien CLOT_OUTPUT_BUFFERING)\n"
+        << "  --server                 Ejecuta el archivo en un `clot serve` activo (modulos ya parseados)\n"
+        << "  --socket <ruta>          Socket de clot serve (por defecto: CLOT_SERVE_SOCKET,\n"
+        << "                           $XDG_RUNTIME_DIR/clot.sock o /tmp/clot-<uid>.sock)\n"
+        << "  --stop                   Con serve: detiene el servidor activo\n"
         << "  --lang es|en             Idioma de interfaz\n"
         << "  --verbose                Imprime informacion adicional\n\n"
         << "Ejemplos:\n"
         << "  clot programa.clot\n"
         << "  clot programa.clot --mode compile --emit exe -o programa\n"
         << "  clot programa.clot --mode analyze\n"
+        << "  clot programa.clot --mode jit --jit-threshold 2\n"
+        << "  clot programa.clot --profile out/programa\n"
+        << "  clot serve & clot programa.clot --server\n"
         << "  clot programa.clot --mode compile --emit ir -o programa.ll\n";
 }
 
@@ -463,6 +547,43 @@ bool BuildAnalyzeProgramSet(const std::string& entry_path,
     return true;
 }
 
+bool ParseUnsigned(const std::string& text, std::uint64_t* out_value) {
+    if (text.empty() || text.size() > 18) {
+        return false;
+    }
+
+    std::uint64_t parsed = 0;
+    for (char character : text) {
+        if (character < '0' || character > '9') {
+            return false;
+        }
+        parsed = parsed * 10 + static_cast<std::uint64_t>(character - '0');
+    }
+
+    *out_value = parsed;
+    return true;
+}
+
+// A byte count with an optional k, m or g suffix (powers of 1024).
+bool ParseByteSize(const std::string& text, std::uint64_t* out_value) {
+    std::string digits = text;
+    std::uint64_t multiplier = 1;
+    if (!digits.empty()) {
+        const char suffix = static_cast<char>(std::tolower(static_cast<unsigned char>(digits.back())));
+        if (suffix == 'k' || suffix == 'm' || suffix == 'g') {
+            multiplier = suffix == 'k' ? 1024ULL : (suffix == 'm' ? 1024ULL * 1024 : 1024ULL * 1024 * 1024);
+            digits.pop_back();
+        }
+    }
+
+    std::uint64_t parsed = 0;
+    if (!ParseUnsigned(digits, &parsed) || parsed > std::numeric_limits<std::uint64_t>::max() / multiplier) {
+        return false;
+    }
+    *out_value = parsed * multiplier;
+    return true;
+}
+
 bool ParseArgs(int argc, char* argv[], CliOptions* out_options, std::string* out_error) {
     for (int i = 1; i < argc; ++i) {
         const std::string arg = argv[i];
@@ -472,6 +593,11 @@ bool ParseArgs(int argc, char* argv[], CliOptions* out_options, std::string* out
             continue;
         }
 
+        if (i == 1 && arg == "serve") {
+            out_options->serve = true;
+            continue;
+        }
+
         if (arg == "-v" || arg == "--version") {
             out_options->show_version = true;
             continue;
@@ -496,6 +622,8 @@ bool ParseArgs(int argc, char* argv[], CliOptions* out_options, std::string* out
                 out_options->mode = RunMode::Compile;
             } else if (value == "analyze") {
                 out_options->mode = RunMode::Analyze;
+            } else if (value == "jit") {
+                out_options->mode = RunMode::Jit;
             } else {
                 *out_error = clot::runtime::Tr("Modo invalido: ", "Invalid mode: ") + value;
                 return false;
@@ -503,6 +631,25 @@ bool ParseArgs(int argc, char* argv[], CliOptions* out_options, std::string* out
             continue;
         }
 
+        if (arg == "--jit-threshold") {
+            if (i + 1 >= argc) {
+                *out_error = clot::runtime::Tr("Falta valor para --jit-threshold.", "Missing value for --jit-threshold.");
+                return false;
+            }
+
+            const std::string value = argv[++i];
+            if (!ParseUnsigned(value, &out_options->tier_up_policy.call_threshold)) {
+                *out_error = clot::runtime::Tr("Umbral JIT invalido: ", "Invalid JIT threshold: ") + value;
+                return false;
+            }
+            continue;
+        }
+
+        if (arg == "--jit-sync") {
+            out_options->tier_up_policy.background_compile = false;
+            continue;
+        }
+
         if (arg == "--emit") {
             if (i + 1 >= argc) {
                 *out_error = clot::runtime::Tr("Falta valor para --emit.", "Missing value for --emit.");
@@ -585,6 +732,174 @@ bool ParseArgs(int argc, char* argv[], CliOptions* out_options, std::string* out
             continue;
         }
 
+        if (arg == "--output-buffering") {
+            if (i + 1 >= argc) {
+                *out_error = clot::runtime::Tr(
+                    "Falta valor para --output-buffering.",
+                    "Missing value for --output-buffering.");
+                return false;
+            }
+
+            const std::string value = argv[++i];
+            if (!clot::runtime::ParseOutputBuffering(value, &out_options->output_buffering)) {
+                *out_error = clot::runtime::Tr(
+                    "Buffering de salida invalido. Use auto, line, block o none.",
+                    "Invalid output buffering. Use auto, line, block, or none.");
+                return false;
+            }
+            continue;
+        }
+
+        if (arg == "-j" || arg == "--jobs") {
+            if (i + 1 >= argc) {
+                *out_error = clot::runtime::Tr("Falta valor para --jobs.", "Missing value for --jobs.");
+                return false;
+            }
+
+            const std::string value = argv[++i];
+            std::uint64_t jobs = 0;
+            if (!ParseUnsigned(value, &jobs) || jobs == 0 || jobs > 1024) {
+                *out_error = clot::runtime::Tr("Cantidad de hilos invalida: ", "Invalid job count: ") + value;
+                return false;
+            }
+            out_options->compile_options.codegen_jobs = static_cast<unsigned>(jobs);
+            continue;
+        }
+
+        if (arg == "--object-cache") {
+            if (i + 1 >= argc) {
+                *out_error = clot::runtime::Tr("Falta valor para --object-cache.", "Missing value for --object-cache.");
+                return false;
+            }
+            out_options->compile_options.object_cache_dir = argv[++i];
+            continue;
+        }
+
+        if (arg == "--instrument") {
+            out_options->compile_options.instrument = true;
+            continue;
+        }
+
+        if (arg == "--profile-use") {
+            if (i + 1 >= argc) {
+                *out_error = clot::runtime::Tr("Falta valor para --profile-use.", "Missing value for --profile-use.");
+                return false;
+            }
+            out_options->compile_options.profile_use_path = argv[++i];
+            continue;
+        }
+
+        if (arg == "--profile") {
+            if (i + 1 >= argc) {
+                *out_error = clot::runtime::Tr("Falta valor para --profile.", "Missing value for --profile.");
+                return false;
+            }
+            out_options->profile_prefix = argv[++i];
+            continue;
+        }
+
+        if (arg == "--stats") {
+            out_options->print_stats = true;
+            continue;
+        }
+
+        if (arg == "--stats-json") {
+            if (i + 1 >= argc) {
+                *out_error = clot::runtime::Tr("Falta valor para --stats-json.", "Missing value for --stats-json.");
+                return false;
+            }
+            out_options->stats_json_path = argv[++i];
+            continue;
+        }
+
+        if (arg == "--snapshot") {
+            if (i + 1 >= argc) {
+                *out_error = clot::runtime::Tr("Falta valor para --snapshot.", "Missing value for --snapshot.");
+                return false;
+            }
+            out_options->snapshot_path = argv[++i];
+            continue;
+        }
+
+        if (arg == "--snapshot-write") {
+            if (i + 1 >= argc) {
+                *out_error =
+                    clot::runtime::Tr("Falta valor para --snapshot-write.", "Missing value for --snapshot-write.");
+                return false;
+            }
+            out_options->snapshot_write_path = argv[++i];
+            continue;
+        }
+
+        if (arg == "--max-heap") {
+            if (i + 1 >= argc) {
+                *out_error = clot::runtime::Tr("Falta valor para --max-heap.", "Missing value for --max-heap.");
+                return false;
+            }
+
+            const std::string value = argv[++i];
+            if (!ParseByteSize(value, &out_options->resource_limits.max_heap_bytes)) {
+                *out_error = clot::runtime::Tr("Valor invalido para --max-heap: ", "Invalid value for --max-heap: ") + value;
+                return false;
+            }
+            continue;
+        }
+
+        if (arg == "--max-time") {
+            if (i + 1 >= argc) {
+                *out_error = clot::runtime::Tr("Falta valor para --max-time.", "Missing value for --max-time.");
+                return false;
+            }
+
+            const std::string value = argv[++i];
+            if (!ParseUnsigned(value, &out_options->resource_limits.max_wall_ms)) {
+                *out_error = clot::runtime::Tr("Valor invalido para --max-time: ", "Invalid value for --max-time: ") + value;
+                return false;
+            }
+            continue;
+        }
+
+        if (arg == "--max-statements") {
+            if (i + 1 >= argc) {
+                *out_error =
+                    clot::runtime::Tr("Falta valor para --max-statements.", "Missing value for --max-statements.");
+                return false;
+            }
+
+            const std::string value = argv[++i];
+            if (!ParseUnsigned(value, &out_options->resource_limits.max_statements)) {
+                *out_error = clot::runtime::Tr("Valor invalido para --max-statements: ",
+                                               "Invalid value for --max-statements: ") +
+                             value;
+                return false;
+            }
+            continue;
+        }
+
+        if (arg == "--no-object-cache") {
+            out_options->disable_object_cache = true;
+            continue;
+        }
+
+        if (arg == "--server") {
+            out_options->use_server = true;
+            continue;
+        }
+
+        if (arg == "--stop") {
+            out_options->serve_stop = true;
+            continue;
+        }
+
+        if (arg == "--socket") {
+            if (i + 1 >= argc) {
+                *out_error = clot::runtime::Tr("Falta valor para --socket.", "Missing value for --socket.");
+                return false;
+            }
+            out_options->socket_path = argv[++i];
+            continue;
+        }
+
         if (!arg.empty() && arg[0] == '-') {
             *out_error = clot::runtime::Tr("Opcion desconocida: ", "Unknown option: ") + arg;
             return false;
@@ -598,6 +913,36 @@ bool ParseArgs(int argc, char* argv[], CliOptions* out_options, std::string* out
         }
     }
 
+    if (out_options->serve) {
+        if (!out_options->input_path.empty()) {
+            *out_error = "serve no recibe archivo de entrada.";
+            return false;
+        }
+        return true;
+    }
+    if (out_options->serve_stop) {
+        *out_error = "--stop solo se usa con serve.";
+        return false;
+    }
+    if (out_options->use_server && out_options->mode != RunMode::Interpret) {
+        *out_error = "--server solo admite --mode interpret.";
+        return false;
+    }
+    const bool uses_snapshot = !out_options->snapshot_path.empty() || !out_options->snapshot_write_path.empty();
+    if (uses_snapshot &&
+        (out_options->use_server ||
+         (out_options->mode != RunMode::Interpret && out_options->mode != RunMode::Jit))) {
+        *out_error = "--snapshot solo admite --mode interpret o jit.";
+        return false;
+    }
+    // JIT-compiled functions run natively, outside the statement checks.
+    const auto& limits = out_options->resource_limits;
+    const bool uses_limits = limits.max_heap_bytes != 0 || limits.max_wall_ms != 0 || limits.max_statements != 0;
+    if (uses_limits && out_options->mode != RunMode::Interpret) {
+        *out_error = "--max-heap, --max-time y --max-statements solo admiten --mode interpret.";
+        return false;
+    }
+
     if (out_options->input_path.empty() && !out_options->show_help && !out_options->show_version) {
         out_options->input_path = FindDefaultInput();
     }
@@ -625,6 +970,17 @@ int main(int argc, char* argv[]) {
         }
     }
 
+    if (const auto env_buffering = clot::runtime::GetEnvVar("CLOT_OUTPUT_BUFFERING"); env_buffering) {
+        if (!clot::runtime::ParseOutputBuffering(*env_buffering, &options.output_buffering)) {
+            std::cerr << clot::runtime::Tr("Error: ", "Error: ")
+                      << clot::runtime::Tr(
+                             "CLOT_OUTPUT_BUFFERING invalido (use auto, line, block o none): ",
+                             "Invalid CLOT_OUTPUT_BUFFERING (use auto, line, block, or none): ")
+                      << *env_buffering << "\n";
+            return 1;
+        }
+    }
+
     std::string cli_error;
     if (!ParseArgs(argc, argv, &options, &cli_error)) {
         std::cerr << clot::runtime::Tr("Error: ", "Error: ")
@@ -636,6 +992,7 @@ int main(int argc, char* argv[]) {
     }
 
     clot::runtime::SetLanguage(options.language);
+    clot::runtime::ConfigureStdout(options.output_buffering);
 
     if (options.show_version) {
         PrintVersion();
@@ -647,6 +1004,36 @@ int main(int argc, char* argv[]) {
         return 0;
     }
 
+    if (options.serve || options.use_server) {
+        const std::string socket_path =
+            options.socket_path.empty() ? clot::serve::DefaultSocketPath() : options.socket_path;
+        std::string serve_error;
+        int exit_code = 0;
+        bool served = false;
+        if (options.serve && options.serve_stop) {
+            served = clot::serve::StopServer(socket_path, &serve_error);
+        } else if (options.serve) {
+            clot::serve::ServerOptions server_options;
+            server_options.socket_path = socket_path;
+            server_options.verbose = options.verbose;
+            served = clot::serve::RunServer(server_options, &serve_error);
+        } else {
+            served = clot::serve::RunOnServer(
+                socket_path,
+                options.input_path,
+                options.output_buffering,
+                options.resource_limits,
+                &exit_code,
+                &serve_error);
+        }
+        if (!served) {
+            std::cerr << clot::runtime::Tr("Error: ", "Error: ")
+                      << clot::runtime::TranslateDiagnostic(serve_error) << "\n";
+            return 1;
+        }
+        return exit_code;
+    }
+
     std::vector<std::string> lines;
     std::string load_error;
     if (!clot::frontend::LoadSourceLines(options.input_path, &lines, &load_error)) {
@@ -720,11 +1107,117 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
-    if (options.mode == RunMode::Interpret) {
+    if (options.mode == RunMode::Jit && !clot::codegen::LlvmJit::IsAvailable()) {
+        std::cerr
+            << clot::runtime::Tr(
+                   "Error: este binario no tiene soporte LLVM habilitado.\n",
+                   "Error: this binary does not have LLVM support enabled.\n")
+            << clot::runtime::Tr(
+                   "Instala LLVM en WSL y recompila con CMake (scripts/install_llvm_wsl.sh).\n",
+                   "Install LLVM in WSL and rebuild with CMake (scripts/install_llvm_wsl.sh).\n");
+        return 1;
+    }
+
+    if (options.mode == RunMode::Interpret || options.mode == RunMode::Jit) {
+        // Declared before the interpreter: background compiles still in flight
+        // are joined when the interpreter is destroyed and need the JIT alive.
+        std::unique_ptr<clot::codegen::LlvmJit> jit;
         clot::interpreter::Interpreter interpreter;
         interpreter.SetEntryFilePath(options.input_path);
+
+        if (options.mode == RunMode::Jit) {
+            jit = std::make_unique<clot::codegen::LlvmJit>();
+            const bool verbose = options.verbose;
+            interpreter.SetNativeCompileHook(
+                [&jit, verbose](const clot::frontend::FunctionDeclStmt& function, bool math_module_imported) {
+                    clot::interpreter::Interpreter::NativeCompileResult result;
+                    if (!clot::codegen::LlvmJit::IsEligibleFunction(function, math_module_imported)) {
+                        return result;
+                    }
+
+                    clot::codegen::NativeEntryPoint entry = nullptr;
+                    std::string jit_error;
+                    if (!jit->CompileFunction(function, math_module_imported, &entry, &jit_error)) {
+                        if (verbose) {
+                            result.note = clot::runtime::Tr("JIT LLVM descartado para '", "LLVM JIT skipped for '") +
+                                          function.name + "': " + clot::runtime::TranslateDiagnostic(jit_error);
+                        }
+                        return result;
+                    }
+
+                    if (verbose) {
+                        result.note =
+                            clot::runtime::Tr("JIT LLVM compilo funcion: ", "LLVM JIT compiled function: ") + function.name;
+                    }
+                    result.entry = entry;
+                    return result;
+                },
+                options.tier_up_policy,
+                [](const std::string& note) { std::cerr << note << "\n"; });
+        }
+
+        std::unique_ptr<clot::runtime::Profiler> profiler;
+        bool profile_written = true;
+        if (!options.profile_prefix.empty()) {
+            profiler = std::make_unique<clot::runtime::Profiler>();
+            interpreter.SetProfiler(profiler.get());
+        }
+
+        std::string limits_error;
+        if (!interpreter.SetResourceLimits(options.resource_limits, &limits_error)) {
+            std::cerr << clot::runtime::Tr("Error: ", "Error: ") << clot::runtime::TranslateDiagnostic(limits_error)
+                      << "\n";
+            return 1;
+        }
+
+        if (!options.snapshot_path.empty()) {
+            std::string snapshot_error;
+            if (!interpreter.LoadSnapshot(options.snapshot_path, &snapshot_error)) {
+                std::cerr << clot::runtime::Tr("Error: ", "Error: ")
+                          << clot::runtime::TranslateDiagnostic(snapshot_error) << "\n";
+                return 1;
+            }
+        }
+
+        const bool collect_stats = options.print_stats || !options.stats_json_path.empty();
+        if (collect_stats) {
+            clot::runtime::EnableCounters(true);
+        }
+
         std::string runtime_error;
-        if (!interpreter.Execute(program, &runtime_error)) {
+        const bool executed = interpreter.Execute(program, &runtime_error);
+        bool stats_written = true;
+        if (collect_stats) {
+            clot::runtime::EnableCounters(false);
+            const clot::runtime::CounterReport report = clot::runtime::CollectCounters();
+            if (options.print_stats) {
+                std::cerr << clot::runtime::FormatCounterReport(report);
+            }
+            if (!options.stats_json_path.empty()) {
+                std::ofstream stats_file(options.stats_json_path, std::ios::binary | std::ios::trunc);
+                if (stats_file) {
+                    stats_file << clot::runtime::FormatCounterReportJson(report);
+                }
+                if (!stats_file) {
+                    std::cerr << clot::runtime::Tr("Error: ", "Error: ")
+                              << clot::runtime::Tr("No se pudo escribir ", "Could not write ")
+                              << options.stats_json_path << "\n";
+                    stats_written = false;
+                }
+            }
+        }
+        if (profiler != nullptr) {
+            // Also written after a runtime error: the profile up to the failure
+            // is often what explains it.
+            std::string profile_error;
+            if (!profiler->WriteReports(options.profile_prefix, &profile_error)) {
+                std::cerr << clot::runtime::Tr("Error: ", "Error: ")
+                          << clot::runtime::TranslateDiagnostic(profile_error) << "\n";
+                profile_written = false;
+            }
+        }
+
+        if (!executed) {
             const std::string translated_runtime_error = clot::runtime::TranslateDiagnostic(runtime_error);
             if (IsUnhandledExceptionDiagnostic(translated_runtime_error)) {
                 std::cerr << translated_runtime_error << "\n";
@@ -735,7 +1228,25 @@ int main(int argc, char* argv[]) {
             return 1;
         }
 
-        return 0;
+        if (!options.snapshot_write_path.empty()) {
+            std::string snapshot_error;
+            if (!interpreter.WriteSnapshot(options.snapshot_write_path, &snapshot_error)) {
+                std::cerr << clot::runtime::Tr("Error: ", "Error: ")
+                          << clot::runtime::TranslateDiagnostic(snapshot_error) << "\n";
+                return 1;
+            }
+        }
+
+        if (options.mode == RunMode::Jit && options.verbose) {
+            interpreter.FinishNativeCompiles();
+            const clot::interpreter::Interpreter::TierStats stats = interpreter.CollectTierStats();
+            std::cerr << clot::runtime::Tr("JIT LLVM: ", "LLVM JIT: ") << stats.native_functions << "/"
+                      << stats.profiled_functions << clot::runtime::Tr(" funciones nativas, ", " native functions, ")
+                      << stats.profiled_loops << clot::runtime::Tr(" bucles perfilados (max ", " profiled loops (max ")
+                      << stats.max_loop_back_edges << clot::runtime::Tr(" iteraciones).", " iterations).") << "\n";
+        }
+
+        return profile_written && stats_written ? 0 : 1;
     }
 
     if (!clot::codegen::LlvmCompiler::IsAvailable()) {
@@ -753,6 +1264,14 @@ int main(int argc, char* argv[]) {
         options.compile_options.output_path = BuildDefaultOutput(options.input_path, options.compile_options.emit_kind);
     }
 
+    if (options.disable_object_cache) {
+        options.compile_options.object_cache_dir.clear();
+    } else if (options.compile_options.object_cache_dir.empty()) {
+        if (const auto env_cache = clot::runtime::GetEnvVar("CLOT_OBJECT_CACHE"); env_cache) {
+            options.compile_options.object_cache_dir = *env_cache;
+        }
+    }
+
     options.compile_options.input_path = options.input_path;
     options.compile_options.source_text = source_text;
     options.compile_options.project_root = std::filesystem::current_path().string();
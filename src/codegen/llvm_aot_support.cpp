@@ -68,6 +68,111 @@ bool ContainsMathImportInStatement(const frontend::Statement& statement) {
     return false;
 }
 
+namespace {
+
+void CollectListVariablesInBlock(const std::vector<std::unique_ptr<frontend::Statement>>& statements,
+                                 std::unordered_set<std::string>* out_names) {
+    for (const auto& nested : statements) {
+        if (nested != nullptr) {
+            CollectListVariables(*nested, out_names);
+        }
+    }
+}
+
+bool IsListVariableExpr(const frontend::Expr& expression, const AotSupportContext& context) {
+    const auto* variable = dynamic_cast<const frontend::VariableExpr*>(&expression);
+    return variable != nullptr && context.list_variables.count(variable->name) > 0;
+}
+
+bool IsAotNumericListLiteral(const frontend::ListExpr& list, const AotSupportContext& context) {
+    return std::all_of(
+        list.elements.begin(),
+        list.elements.end(),
+        [&context](const std::unique_ptr<frontend::Expr>& element) {
+            // bool elements would print as true/false in the interpreter.
+            return element != nullptr &&
+                   dynamic_cast<const frontend::BoolExpr*>(element.get()) == nullptr &&
+                   IsAotSupportedExpr(*element, context);
+        });
+}
+
+bool WritesVariable(const frontend::Statement& statement, const std::string& name) {
+    if (const auto* assignment = dynamic_cast<const frontend::AssignmentStmt*>(&statement)) {
+        return assignment->name == name;
+    }
+
+    if (const auto* mutation = dynamic_cast<const frontend::MutationStmt*>(&statement)) {
+        const frontend::Expr* target = mutation->target.get();
+        if (const auto* index = dynamic_cast<const frontend::IndexExpr*>(target)) {
+            target = index->collection.get();
+        }
+        const auto* variable = dynamic_cast<const frontend::VariableExpr*>(target);
+        return variable != nullptr && variable->name == name;
+    }
+
+    const auto any_writes = [&name](const std::vector<std::unique_ptr<frontend::Statement>>& statements) {
+        return std::any_of(statements.begin(), statements.end(), [&name](const auto& nested) {
+            return nested != nullptr && WritesVariable(*nested, name);
+        });
+    };
+
+    if (const auto* conditional = dynamic_cast<const frontend::IfStmt*>(&statement)) {
+        return any_writes(conditional->then_branch) || any_writes(conditional->else_branch);
+    }
+    if (const auto* while_stmt = dynamic_cast<const frontend::WhileStmt*>(&statement)) {
+        return any_writes(while_stmt->body);
+    }
+    if (const auto* for_stmt = dynamic_cast<const frontend::ForStmt*>(&statement)) {
+        return (for_stmt->initializer != nullptr && WritesVariable(*for_stmt->initializer, name)) ||
+               (for_stmt->update != nullptr && WritesVariable(*for_stmt->update, name)) ||
+               any_writes(for_stmt->body);
+    }
+    if (const auto* for_each = dynamic_cast<const frontend::ForEachStmt*>(&statement)) {
+        return for_each->variable_name == name || any_writes(for_each->body);
+    }
+    return false;
+}
+
+bool IsPlainNumericDeclaration(frontend::DeclarationType type, const frontend::TypeAnnotation& annotation) {
+    return (type == frontend::DeclarationType::Inferred || type == frontend::DeclarationType::Double) &&
+           annotation.custom_name.empty() && annotation.type_args.empty() &&
+           (annotation.base == frontend::TypeHint::Inferred || annotation.base == frontend::TypeHint::Double);
+}
+
+bool AllStatementsSupported(const std::vector<std::unique_ptr<frontend::Statement>>& statements,
+                            const AotSupportContext& context) {
+    return std::all_of(
+        statements.begin(),
+        statements.end(),
+        [&context](const std::unique_ptr<frontend::Statement>& nested) {
+            return nested != nullptr && IsAotSupportedStatement(*nested, context, true);
+        });
+}
+
+}  // namespace
+
+void CollectListVariables(const frontend::Statement& statement, std::unordered_set<std::string>* out_names) {
+    if (const auto* assignment = dynamic_cast<const frontend::AssignmentStmt*>(&statement)) {
+        if (dynamic_cast<const frontend::ListExpr*>(assignment->expr.get()) != nullptr) {
+            out_names->insert(assignment->name);
+        }
+        return;
+    }
+
+    if (const auto* conditional = dynamic_cast<const frontend::IfStmt*>(&statement)) {
+        CollectListVariablesInBlock(conditional->then_branch, out_names);
+        CollectListVariablesInBlock(conditional->else_branch, out_names);
+    } else if (const auto* while_stmt = dynamic_cast<const frontend::WhileStmt*>(&statement)) {
+        CollectListVariablesInBlock(while_stmt->body, out_names);
+    } else if (const auto* for_stmt = dynamic_cast<const frontend::ForStmt*>(&statement)) {
+        CollectListVariablesInBlock(for_stmt->body, out_names);
+    } else if (const auto* for_each = dynamic_cast<const frontend::ForEachStmt*>(&statement)) {
+        CollectListVariablesInBlock(for_each->body, out_names);
+    } else if (const auto* function_decl = dynamic_cast<const frontend::FunctionDeclStmt*>(&statement)) {
+        CollectListVariablesInBlock(function_decl->body, out_names);
+    }
+}
+
 bool CollectAotSupportContext(const frontend::Program& program, AotSupportContext* out_context) {
     AotSupportContext context;
 
@@ -92,6 +197,8 @@ bool CollectAotSupportContext(const frontend::Program& program, AotSupportContex
         if (ContainsMathImportInStatement(*statement)) {
             context.math_module_imported = true;
         }
+
+        CollectListVariables(*statement, &context.list_variables);
     }
 
     *out_context = std::move(context);
@@ -118,7 +225,8 @@ bool IsAotSupportedExpr(const frontend::Expr& expression, const AotSupportContex
     }
 
     if (const auto* variable = dynamic_cast<const frontend::VariableExpr*>(&expression)) {
-        return !ContainsDot(variable->name);
+        // A whole list is not a numeric value; only its elements and len() are.
+        return !ContainsDot(variable->name) && context.list_variables.count(variable->name) == 0;
     }
 
     if (dynamic_cast<const frontend::ListExpr*>(&expression) != nullptr) {
@@ -129,11 +237,17 @@ bool IsAotSupportedExpr(const frontend::Expr& expression, const AotSupportContex
         return false;
     }
 
-    if (dynamic_cast<const frontend::IndexExpr*>(&expression) != nullptr) {
-        return false;
+    if (const auto* index = dynamic_cast<const frontend::IndexExpr*>(&expression)) {
+        return index->collection != nullptr && index->index != nullptr &&
+               IsListVariableExpr(*index->collection, context) && IsAotSupportedExpr(*index->index, context);
     }
 
     if (const auto* call = dynamic_cast<const frontend::CallExpr*>(&expression)) {
+        if (call->callee == "len") {
+            return call->arguments.size() == 1 && !call->arguments[0].by_reference &&
+                   call->arguments[0].value != nullptr && IsListVariableExpr(*call->arguments[0].value, context);
+        }
+
         if (!context.math_module_imported || !IsAotMathBuiltinName(call->callee) || !IsAotMathBuiltinArityValid(*call)) {
             return false;
         }
@@ -182,7 +296,7 @@ bool IsAotSupportedCallStatement(const frontend::CallExpr& call, const AotSuppor
 
         if (by_reference_params[i]) {
             const auto* variable = dynamic_cast<const frontend::VariableExpr*>(argument.value.get());
-            if (variable == nullptr || ContainsDot(variable->name)) {
+            if (variable == nullptr || ContainsDot(variable->name) || context.list_variables.count(variable->name) > 0) {
                 return false;
             }
             continue;
@@ -201,15 +315,67 @@ bool IsAotSupportedStatement(
     const AotSupportContext& context,
     bool inside_function) {
     if (const auto* assignment = dynamic_cast<const frontend::AssignmentStmt*>(&statement)) {
+        if (const auto* list = dynamic_cast<const frontend::ListExpr*>(assignment->expr.get())) {
+            return (assignment->declaration_type == frontend::DeclarationType::Inferred ||
+                    assignment->declaration_type == frontend::DeclarationType::List) &&
+                   assignment->op == frontend::AssignmentOp::Set &&
+                   !ContainsDot(assignment->name) &&
+                   IsAotNumericListLiteral(*list, context);
+        }
+
         if (assignment->declaration_type != frontend::DeclarationType::Inferred &&
             assignment->declaration_type != frontend::DeclarationType::Double) {
             return false;
         }
         return !ContainsDot(assignment->name) &&
+               context.list_variables.count(assignment->name) == 0 &&
                assignment->expr != nullptr &&
                IsAotSupportedExpr(*assignment->expr, context);
     }
 
+    if (const auto* mutation = dynamic_cast<const frontend::MutationStmt*>(&statement)) {
+        if (mutation->target == nullptr || mutation->expr == nullptr) {
+            return false;
+        }
+
+        // `i++` / `i--` add an integer literal; on a double target that stays double.
+        const auto* literal = dynamic_cast<const frontend::NumberExpr*>(mutation->expr.get());
+        const bool value_supported =
+            IsAotSupportedExpr(*mutation->expr, context) ||
+            (literal != nullptr && literal->is_integer_literal && mutation->op != frontend::AssignmentOp::Set);
+        if (!value_supported) {
+            return false;
+        }
+
+        if (dynamic_cast<const frontend::IndexExpr*>(mutation->target.get()) != nullptr) {
+            return IsAotSupportedExpr(*mutation->target, context);
+        }
+        const auto* variable = dynamic_cast<const frontend::VariableExpr*>(mutation->target.get());
+        return variable != nullptr && IsAotSupportedExpr(*variable, context);
+    }
+
+    if (const auto* for_stmt = dynamic_cast<const frontend::ForStmt*>(&statement)) {
+        return (for_stmt->initializer == nullptr || IsAotSupportedStatement(*for_stmt->initializer, context, true)) &&
+               (for_stmt->condition == nullptr || IsAotSupportedExpr(*for_stmt->condition, context)) &&
+               (for_stmt->update == nullptr || IsAotSupportedStatement(*for_stmt->update, context, true)) &&
+               AllStatementsSupported(for_stmt->body, context);
+    }
+
+    if (const auto* for_each = dynamic_cast<const frontend::ForEachStmt*>(&statement)) {
+        // The interpreter iterates a snapshot of the list, so the native loop may
+        // only read the buffer it walks.
+        const auto* collection = dynamic_cast<const frontend::VariableExpr*>(for_each->collection.get());
+        return collection != nullptr &&
+               context.list_variables.count(collection->name) > 0 &&
+               !for_each->variable_is_const &&
+               IsPlainNumericDeclaration(for_each->variable_type, for_each->variable_annotation) &&
+               context.list_variables.count(for_each->variable_name) == 0 &&
+               AllStatementsSupported(for_each->body, context) &&
+               std::none_of(for_each->body.begin(), for_each->body.end(), [&collection](const auto& nested) {
+                   return nested != nullptr && WritesVariable(*nested, collection->name);
+               });
+    }
+
     if (const auto* print = dynamic_cast<const frontend::PrintStmt*>(&statement)) {
         if (print->expr == nullptr) {
             return print->append_newline;
@@ -305,6 +471,40 @@ bool IsAotSupportedProgram(const frontend::Program& program) {
         });
 }
 
+bool IsAotSupportedFunction(const frontend::FunctionDeclStmt& function, bool math_module_imported) {
+    // The interpreter binds defaults, type hints and return values itself, so the
+    // JIT only takes plain numeric procedures whose body is in the AOT subset.
+    const auto is_plain_annotation = [](frontend::TypeHint hint, const frontend::TypeAnnotation& annotation) {
+        const bool plain_hint = hint == frontend::TypeHint::Inferred || hint == frontend::TypeHint::Double;
+        const bool plain_annotation = annotation.custom_name.empty() && annotation.type_args.empty() &&
+                                      (annotation.base == frontend::TypeHint::Inferred ||
+                                       annotation.base == frontend::TypeHint::Double);
+        return plain_hint && plain_annotation;
+    };
+
+    if (function.return_type != frontend::TypeHint::Inferred ||
+        function.return_annotation.base != frontend::TypeHint::Inferred ||
+        !function.return_annotation.custom_name.empty()) {
+        return false;
+    }
+
+    AotSupportContext context;
+    context.math_module_imported = math_module_imported;
+
+    FunctionSignature signature;
+    signature.by_reference_params.reserve(function.params.size());
+    for (const auto& param : function.params) {
+        if (param.default_value != nullptr || !is_plain_annotation(param.type_hint, param.type_annotation)) {
+            return false;
+        }
+        signature.by_reference_params.push_back(param.by_reference);
+    }
+    context.functions[function.name] = std::move(signature);
+    CollectListVariables(function, &context.list_variables);
+
+    return IsAotSupportedStatement(function, context, false);
+}
+
 }  // namespace clot::codegen::internal
 
 #endif  // CLOT_HAS_LLVM
@@ -6,6 +6,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <llvm/IR/Function.h>
@@ -23,18 +24,37 @@ struct FunctionSignature {
 
 struct AotSupportContext {
     std::unordered_map<std::string, FunctionSignature> functions;
+    // Names bound to homogeneous double list literals; lowered as contiguous buffers.
+    std::unordered_set<std::string> list_variables;
     bool math_module_imported = false;
 };
 
 bool ContainsDot(const std::string& value);
 
 bool ContainsMathImportInStatement(const frontend::Statement& statement);
+void CollectListVariables(const frontend::Statement& statement, std::unordered_set<std::string>* out_names);
 bool CollectAotSupportContext(const frontend::Program& program, AotSupportContext* out_context);
 bool IsAotSupportedExpr(const frontend::Expr& expression, const AotSupportContext& context);
 bool IsAotSupportedCallStatement(const frontend::CallExpr& call, const AotSupportContext& context);
 bool IsAotSupportedStatement(const frontend::Statement& statement, const AotSupportContext& context,
                              bool inside_function);
 bool IsAotSupportedProgram(const frontend::Program& program);
+bool IsAotSupportedFunction(const frontend::FunctionDeclStmt& function, bool math_module_imported);
+
+// Split-module codegen for executables: one partition per top-level function
+// plus one for `main`. `cache_key` names the partition's object in the on-disk
+// cache and is empty when the partition cannot be fingerprinted.
+struct CodegenPartition {
+    std::string function_name;
+    std::string cache_key;
+};
+
+std::vector<CodegenPartition> PlanCodegenPartitions(const frontend::Program& program,
+                                                    const CompileOptions& options,
+                                                    const std::string& target_triple);
+
+// Registers the native target once per process; safe to call from any thread.
+void InitializeNativeCodegen();
 
 class LlvmEmitter {
   public:
@@ -43,8 +63,22 @@ class LlvmEmitter {
     bool EmitProgram(const frontend::Program& program, const CompileOptions& options, std::string* out_error);
     bool UsedRuntimeBridge() const;
 
+    // Emits one codegen partition of an AOT-supported program: the body of
+    // `function_name`, or `main` when it is null. Every other user function is
+    // declared external and resolved when the partition objects are linked.
+    bool EmitProgramPartition(const frontend::Program& program, const std::string* function_name,
+                              std::string* out_error);
+
+    // Emits a single function plus a uniform entry `const char* entry(double**)`
+    // for the in-process JIT. Each slot of the argument array points to one
+    // double. The entry returns null, or the message of a failed range check.
+    bool EmitJitFunction(const frontend::FunctionDeclStmt& function, bool math_module_imported,
+                         const std::string& entry_name, std::string* out_error);
+    void SetSymbolPrefix(std::string prefix);
+    void ReleaseModule(std::unique_ptr<llvm::LLVMContext>* out_context, std::unique_ptr<llvm::Module>* out_module);
+
     bool EmitIRFile(const std::string& output_path, std::string* out_error);
-    bool EmitObjectFile(const std::string& output_path, const std::string& requested_target, std::string* out_error);
+    bool EmitObjectFile(const std::string& output_path, const CompileOptions& compile_options, std::string* out_error);
 
   private:
     enum class VariableNumericKind {
@@ -53,6 +87,13 @@ class LlvmEmitter {
         Byte,
     };
 
+    // A list is a (data, length) pair of entry-block slots; the elements live in
+    // a stack buffer owned by the list literal that produced them.
+    struct ListSlot {
+        llvm::AllocaInst* data = nullptr;
+        llvm::AllocaInst* length = nullptr;
+    };
+
     struct UserFunctionInfo {
         const frontend::FunctionDeclStmt* declaration = nullptr;
         llvm::Function* llvm_function = nullptr;
@@ -60,9 +101,12 @@ class LlvmEmitter {
     };
 
     bool EmitRuntimeBridgeProgram(const CompileOptions& options);
+    bool PrepareAotModule(const frontend::Program& program);
+    bool EmitMainFunction(const frontend::Program& program);
     bool CreateMainFunction();
     bool EnsurePrintfFunction();
     bool DeclareUserFunctions(const frontend::Program& program);
+    bool DeclareUserFunction(const frontend::FunctionDeclStmt& function_decl);
     bool EmitUserFunctions();
     bool EmitUserFunction(const UserFunctionInfo& function_info);
     bool EmitStatement(const frontend::Statement& statement, bool allow_function_declaration);
@@ -70,11 +114,23 @@ class LlvmEmitter {
     bool EmitPrint(const frontend::PrintStmt& statement);
     bool EmitIf(const frontend::IfStmt& statement);
     bool EmitWhile(const frontend::WhileStmt& statement);
+    bool EmitFor(const frontend::ForStmt& statement);
+    bool EmitForEach(const frontend::ForEachStmt& statement);
+    bool EmitMutation(const frontend::MutationStmt& statement);
+    bool EmitListAssignment(const std::string& name, const frontend::ListExpr& list);
+    llvm::Value* EmitListElementPointer(const frontend::IndexExpr& index);
+    // Forces vectorization of the loop ending at `latch` unless `body` holds an
+    // FP reduction, which a forced vectorizer may reassociate.
+    void AttachVectorizeHint(llvm::BranchInst* latch, const std::vector<llvm::BasicBlock*>& body);
     bool EmitCallStatement(const frontend::CallExpr& call);
 
     llvm::AllocaInst* CreateEntryBlockAlloca(llvm::Function* function, const std::string& name);
+    llvm::AllocaInst* CreateEntryBlockAlloca(llvm::Function* function, llvm::Type* type, const std::string& name);
     bool EnsureExitFunction();
+    // AOT: prints `message` and exits. JIT: records it in jit_error_ and
+    // returns from the current function, so the caller unwinds to the entry.
     bool EmitRangeCheckOrAbort(llvm::Value* out_of_range, const char* message);
+    void EmitReturnIfJitError();
     llvm::Value* NormalizeForKind(llvm::Value* value, VariableNumericKind kind);
     llvm::Value* EmitBuiltinSumCall(const frontend::CallExpr& call);
     llvm::Value* EmitBuiltinMathCall(const frontend::CallExpr& call);
@@ -84,7 +140,8 @@ class LlvmEmitter {
 
     std::string MangleFunctionName(const std::string& name) const;
 
-    llvm::LLVMContext context_;
+    std::unique_ptr<llvm::LLVMContext> owned_context_;
+    llvm::LLVMContext& context_;
     std::unique_ptr<llvm::Module> module_;
     llvm::IRBuilder<> builder_;
 
@@ -95,15 +152,19 @@ class LlvmEmitter {
 
     std::unordered_map<std::string, llvm::Value*> variables_;
     std::unordered_map<std::string, VariableNumericKind> variable_kinds_;
+    std::unordered_map<std::string, ListSlot> list_variables_;
     std::unordered_map<std::string, UserFunctionInfo> user_functions_;
     std::vector<std::string> user_function_order_;
     bool math_module_imported_ = false;
     bool use_runtime_bridge_ = false;
+    // Set by EmitJitFunction: holds the message of a failed range check.
+    llvm::GlobalVariable* jit_error_ = nullptr;
+    std::string symbol_prefix_ = "clot_fn_";
     std::string error_;
 };
 
-bool LinkExecutable(const std::string& object_path, const std::string& executable_path, bool use_runtime_bridge,
-                    const CompileOptions& options, bool verbose, std::string* out_error);
+bool LinkExecutable(const std::vector<std::string>& object_paths, const std::string& executable_path,
+                    bool use_runtime_bridge, const CompileOptions& options, bool verbose, std::string* out_error);
 
 } // namespace clot::codegen::internal
 
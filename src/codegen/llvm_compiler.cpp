@@ -4,7 +4,17 @@
 
 #include "llvm_backend_internal.hpp"
 
+#include "clot/runtime/i18n.hpp"
+
+#include <algorithm>
+#include <atomic>
 #include <filesystem>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/TargetParser/Host.h>
 
 #endif
 
@@ -20,6 +30,134 @@ bool LlvmCompiler::IsAvailable() {
 
 #ifdef CLOT_HAS_LLVM
 
+namespace {
+
+bool EmitPartitionObject(
+    const frontend::Program& program,
+    const internal::CodegenPartition& partition,
+    const std::string& object_path,
+    const CompileOptions& options,
+    std::string* out_error) {
+    const bool is_main = partition.function_name.empty();
+    internal::LlvmEmitter emitter(is_main ? "clot_module" : "clot_module_" + partition.function_name);
+    return emitter.EmitProgramPartition(program, is_main ? nullptr : &partition.function_name, out_error) &&
+           emitter.EmitObjectFile(object_path, options, out_error);
+}
+
+// Each partition owns its LLVMContext, so workers share nothing but the
+// read-only AST. Cached objects are linked in place; fresh ones are written
+// to a staging name and renamed so concurrent builds never see partial files.
+bool CompileSplitExecutable(
+    const frontend::Program& program,
+    const CompileOptions& options,
+    std::string* out_error) {
+    internal::InitializeNativeCodegen();
+
+    const std::string target_triple =
+        options.target_triple.empty() ? llvm::sys::getDefaultTargetTriple() : options.target_triple;
+    const std::vector<internal::CodegenPartition> partitions =
+        internal::PlanCodegenPartitions(program, options, target_triple);
+
+    const std::filesystem::path executable_path(options.output_path);
+    const std::filesystem::path cache_dir(options.object_cache_dir);
+    const bool use_cache = !options.object_cache_dir.empty();
+    if (use_cache) {
+        std::error_code cache_error;
+        std::filesystem::create_directories(cache_dir, cache_error);
+        if (cache_error) {
+            *out_error = "No se pudo crear el cache de objetos '" + cache_dir.string() + "': " + cache_error.message();
+            return false;
+        }
+    }
+
+    const std::string staging_suffix = ".tmp" + std::to_string(std::random_device{}());
+    std::vector<std::string> object_paths(partitions.size());
+    std::vector<char> temporary(partitions.size(), 0);
+    std::vector<std::string> errors(partitions.size());
+    std::atomic<std::size_t> next_partition{0};
+    std::atomic<std::size_t> cache_hits{0};
+
+    auto worker = [&]() {
+        for (std::size_t i = next_partition++; i < partitions.size(); i = next_partition++) {
+            const internal::CodegenPartition& partition = partitions[i];
+            if (use_cache && !partition.cache_key.empty()) {
+                const std::filesystem::path cached = cache_dir / (partition.cache_key + ".o");
+                std::error_code ignored;
+                if (std::filesystem::exists(cached, ignored)) {
+                    object_paths[i] = cached.string();
+                    ++cache_hits;
+                    continue;
+                }
+
+                const std::filesystem::path staging = cached.string() + staging_suffix;
+                if (!EmitPartitionObject(program, partition, staging.string(), options, &errors[i])) {
+                    std::filesystem::remove(staging, ignored);
+                    continue;
+                }
+
+                std::error_code rename_error;
+                std::filesystem::rename(staging, cached, rename_error);
+                if (rename_error) {
+                    std::filesystem::remove(staging, ignored);
+                    errors[i] = "No se pudo guardar objeto en cache '" + cached.string() + "': " + rename_error.message();
+                    continue;
+                }
+                object_paths[i] = cached.string();
+                continue;
+            }
+
+            const std::string object_path = executable_path.string() + "." + std::to_string(i) + ".o";
+            temporary[i] = 1;
+            object_paths[i] = object_path;
+            EmitPartitionObject(program, partition, object_path, options, &errors[i]);
+        }
+    };
+
+    const unsigned hardware_jobs = std::max(1U, std::thread::hardware_concurrency());
+    const std::size_t jobs = std::min<std::size_t>(
+        options.codegen_jobs == 0 ? hardware_jobs : options.codegen_jobs, partitions.size());
+
+    std::vector<std::thread> workers;
+    for (std::size_t j = 1; j < jobs; ++j) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : workers) {
+        thread.join();
+    }
+
+    auto remove_temporaries = [&]() {
+        std::error_code ignored;
+        for (std::size_t i = 0; i < partitions.size(); ++i) {
+            if (temporary[i] != 0) {
+                std::filesystem::remove(object_paths[i], ignored);
+            }
+        }
+    };
+
+    for (const std::string& error : errors) {
+        if (!error.empty()) {
+            remove_temporaries();
+            *out_error = error;
+            return false;
+        }
+    }
+
+    if (options.verbose) {
+        llvm::outs() << "[clot] codegen: " << partitions.size()
+                     << clot::runtime::Tr(" particiones, ", " partitions, ") << cache_hits.load()
+                     << clot::runtime::Tr(" desde cache, ", " from cache, ") << jobs
+                     << clot::runtime::Tr(" hilos\n", " threads\n");
+    }
+
+    const bool linked = internal::LinkExecutable(
+        object_paths, executable_path.string(), false, options, options.verbose, out_error);
+    remove_temporaries();
+    return linked;
+}
+
+}  // namespace
+
 bool LlvmCompiler::Compile(
     const frontend::Program& program,
     const CompileOptions& options,
@@ -29,6 +167,35 @@ bool LlvmCompiler::Compile(
         return false;
     }
 
+    const bool aot_program = internal::IsAotSupportedProgram(program);
+    if (options.instrument || !options.profile_use_path.empty()) {
+        if (options.instrument && !options.profile_use_path.empty()) {
+            *out_error = "--instrument y --profile-use no se pueden combinar.";
+            return false;
+        }
+        if (options.instrument && options.emit_kind != CompileOptions::EmitKind::Executable) {
+            *out_error = "--instrument requiere --emit exe.";
+            return false;
+        }
+        if (options.emit_kind == CompileOptions::EmitKind::IR) {
+            *out_error = "--profile-use requiere --emit exe u obj.";
+            return false;
+        }
+        if (!aot_program) {
+            *out_error = "PGO requiere el subconjunto AOT; este programa usa runtime bridge.";
+            return false;
+        }
+        std::error_code ignored;
+        if (!options.profile_use_path.empty() && !std::filesystem::is_regular_file(options.profile_use_path, ignored)) {
+            *out_error = "No se encontro el perfil PGO: " + options.profile_use_path;
+            return false;
+        }
+    }
+
+    if (options.emit_kind == CompileOptions::EmitKind::Executable && aot_program) {
+        return CompileSplitExecutable(program, options, out_error);
+    }
+
     internal::LlvmEmitter emitter("clot_module");
     if (!emitter.EmitProgram(program, options, out_error)) {
         return false;
@@ -39,18 +206,18 @@ bool LlvmCompiler::Compile(
     }
 
     if (options.emit_kind == CompileOptions::EmitKind::Object) {
-        return emitter.EmitObjectFile(options.output_path, options.target_triple, out_error);
+        return emitter.EmitObjectFile(options.output_path, options, out_error);
     }
 
     const std::filesystem::path executable_path(options.output_path);
     const std::filesystem::path object_path = executable_path.string() + ".o";
 
-    if (!emitter.EmitObjectFile(object_path.string(), options.target_triple, out_error)) {
+    if (!emitter.EmitObjectFile(object_path.string(), options, out_error)) {
         return false;
     }
 
     if (!internal::LinkExecutable(
-            object_path.string(),
+            {object_path.string()},
             executable_path.string(),
             emitter.UsedRuntimeBridge(),
             options,
@@ -2,21 +2,31 @@
 
 #ifdef CLOT_HAS_LLVM
 
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <unordered_set>
 #include <utility>
 
 #include <llvm/Config/llvm-config.h>
 #include <llvm/IR/BasicBlock.h>
 #include <llvm/IR/Constants.h>
 #include <llvm/IR/DerivedTypes.h>
+#include <llvm/IR/Instructions.h>
 #include <llvm/IR/Intrinsics.h>
 #include <llvm/IR/LegacyPassManager.h>
+#include <llvm/IR/Metadata.h>
 #include <llvm/IR/Type.h>
 #include <llvm/IR/Verifier.h>
 #include <llvm/MC/TargetRegistry.h>
+#include <llvm/Passes/OptimizationLevel.h>
+#include <llvm/Passes/PassBuilder.h>
 #include <llvm/Support/FileSystem.h>
+#include <llvm/Support/PGOOptions.h>
 #include <llvm/Support/TargetSelect.h>
+#include <llvm/Support/VirtualFileSystem.h>
 #include <llvm/Support/raw_ostream.h>
 #include <llvm/Target/TargetMachine.h>
 #include <llvm/Target/TargetOptions.h>
@@ -34,6 +44,98 @@ auto ObjectFileKind() {
 #endif
 }
 
+// Instrumentation and profile use are IR-level PGO: counters are inserted
+// before inlining, and the merged .profdata drives branch weights, inlining
+// and hot/cold function placement.
+std::optional<llvm::PGOOptions> ProfileGuidedOptions(const CompileOptions& options) {
+    if (options.instrument) {
+        return llvm::PGOOptions("", "", "", "", llvm::vfs::getRealFileSystem(), llvm::PGOOptions::IRInstr);
+    }
+    if (!options.profile_use_path.empty()) {
+        return llvm::PGOOptions(options.profile_use_path, "", "", "", llvm::vfs::getRealFileSystem(),
+                                llvm::PGOOptions::IRUse);
+    }
+    return std::nullopt;
+}
+
+// Runs the default O2 pipeline so loop hints (vectorize.enable) reach the loop
+// vectorizer; without it the object file is plain unoptimized codegen.
+void OptimizeModule(llvm::Module* module, llvm::TargetMachine* target_machine, const CompileOptions& options) {
+    llvm::LoopAnalysisManager loop_analysis;
+    llvm::FunctionAnalysisManager function_analysis;
+    llvm::CGSCCAnalysisManager cgscc_analysis;
+    llvm::ModuleAnalysisManager module_analysis;
+
+    llvm::PassBuilder pass_builder(target_machine, llvm::PipelineTuningOptions(), ProfileGuidedOptions(options));
+    pass_builder.registerModuleAnalyses(module_analysis);
+    pass_builder.registerCGSCCAnalyses(cgscc_analysis);
+    pass_builder.registerFunctionAnalyses(function_analysis);
+    pass_builder.registerLoopAnalyses(loop_analysis);
+    pass_builder.crossRegisterProxies(loop_analysis, function_analysis, cgscc_analysis, module_analysis);
+
+    llvm::ModulePassManager pipeline = pass_builder.buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O2);
+    pipeline.run(*module, module_analysis);
+}
+
+// Whether `value` is computed, within the loop body, from a load of `slot`.
+bool ComputedFromSlot(const llvm::Value* value,
+                      const llvm::Value* slot,
+                      const std::unordered_set<const llvm::BasicBlock*>& body,
+                      std::unordered_set<const llvm::Instruction*>* visited) {
+    const auto* instruction = llvm::dyn_cast<llvm::Instruction>(value);
+    if (instruction == nullptr || body.count(instruction->getParent()) == 0 || !visited->insert(instruction).second) {
+        return false;
+    }
+    if (const auto* load = llvm::dyn_cast<llvm::LoadInst>(instruction)) {
+        return load->getPointerOperand() == slot;
+    }
+    for (const llvm::Value* operand : instruction->operands()) {
+        if (ComputedFromSlot(operand, slot, body, visited)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// True when the loop body updates a value from its own previous value
+// (`total += x`, `p = p * x`, a slot passed by reference), i.e. an FP
+// reduction. The for-loop update and the for-each counter live outside `body`.
+bool LoopBodyHasReduction(const std::vector<llvm::BasicBlock*>& blocks) {
+    const std::unordered_set<const llvm::BasicBlock*> body(blocks.begin(), blocks.end());
+    for (const llvm::BasicBlock* block : blocks) {
+        for (const llvm::Instruction& instruction : *block) {
+            if (const auto* store = llvm::dyn_cast<llvm::StoreInst>(&instruction)) {
+                std::unordered_set<const llvm::Instruction*> visited;
+                if (ComputedFromSlot(store->getValueOperand(), store->getPointerOperand(), body, &visited)) {
+                    return true;
+                }
+            } else if (const auto* call = llvm::dyn_cast<llvm::CallInst>(&instruction)) {
+                for (const llvm::Value* argument : call->args()) {
+                    if (llvm::isa<llvm::AllocaInst>(argument)) {
+                        return true;
+                    }
+                }
+            }
+        }
+    }
+    return false;
+}
+
+// Blocks emitted for a loop body: `head`, plus every block appended to
+// `function` from position `first_nested` on (nested ifs and loops).
+std::vector<llvm::BasicBlock*> LoopBodyBlocks(llvm::Function* function,
+                                              llvm::BasicBlock* head,
+                                              std::size_t first_nested) {
+    std::vector<llvm::BasicBlock*> blocks{head};
+    std::size_t position = 0;
+    for (llvm::BasicBlock& block : *function) {
+        if (position++ >= first_nested) {
+            blocks.push_back(&block);
+        }
+    }
+    return blocks;
+}
+
 bool IsAotMathBuiltinName(const std::string& callee) {
     return callee == "sum" ||
            callee == "factorial" ||
@@ -53,8 +155,20 @@ bool IsAotMathBuiltinName(const std::string& callee) {
 
 } // namespace
 
+void InitializeNativeCodegen() {
+    static std::once_flag initialized;
+    std::call_once(initialized, [] {
+        llvm::InitializeNativeTarget();
+        llvm::InitializeNativeTargetAsmPrinter();
+        llvm::InitializeNativeTargetAsmParser();
+    });
+}
+
 LlvmEmitter::LlvmEmitter(std::string module_name)
-    : module_(std::make_unique<llvm::Module>(module_name, context_)), builder_(context_) {}
+    : owned_context_(std::make_unique<llvm::LLVMContext>()),
+      context_(*owned_context_),
+      module_(std::make_unique<llvm::Module>(module_name, context_)),
+      builder_(context_) {}
 
 bool LlvmEmitter::EmitProgram(const frontend::Program& program, const CompileOptions& options, std::string* out_error) {
     use_runtime_bridge_ = !IsAotSupportedProgram(program);
@@ -67,32 +181,71 @@ bool LlvmEmitter::EmitProgram(const frontend::Program& program, const CompileOpt
         return true;
     }
 
-    math_module_imported_ = false;
-    for (const auto& statement : program.statements) {
-        if (statement != nullptr && ContainsMathImportInStatement(*statement)) {
-            math_module_imported_ = true;
-            break;
-        }
+    if (!PrepareAotModule(program) || !EmitUserFunctions() || !EmitMainFunction(program)) {
+        *out_error = error_;
+        return false;
     }
 
-    if (!DeclareUserFunctions(program)) {
-        *out_error = error_;
+    if (llvm::verifyModule(*module_, &llvm::errs())) {
+        *out_error = "LLVM genero un modulo invalido.";
         return false;
     }
 
-    if (!EmitUserFunctions()) {
+    return true;
+}
+
+bool LlvmEmitter::EmitProgramPartition(const frontend::Program& program, const std::string* function_name,
+                                       std::string* out_error) {
+    use_runtime_bridge_ = false;
+    if (!PrepareAotModule(program)) {
         *out_error = error_;
         return false;
     }
 
+    if (function_name == nullptr) {
+        if (!EmitMainFunction(program)) {
+            *out_error = error_;
+            return false;
+        }
+    } else {
+        const auto found = user_functions_.find(*function_name);
+        if (found == user_functions_.end()) {
+            *out_error = "Funcion interna no encontrada durante emision LLVM: " + *function_name;
+            return false;
+        }
+        if (!EmitUserFunction(found->second)) {
+            *out_error = error_;
+            return false;
+        }
+    }
+
+    if (llvm::verifyModule(*module_, &llvm::errs())) {
+        *out_error = "LLVM genero un modulo invalido.";
+        return false;
+    }
+
+    return true;
+}
+
+bool LlvmEmitter::PrepareAotModule(const frontend::Program& program) {
+    math_module_imported_ = false;
+    for (const auto& statement : program.statements) {
+        if (statement != nullptr && ContainsMathImportInStatement(*statement)) {
+            math_module_imported_ = true;
+            break;
+        }
+    }
+
+    return DeclareUserFunctions(program);
+}
+
+bool LlvmEmitter::EmitMainFunction(const frontend::Program& program) {
     if (!CreateMainFunction()) {
-        *out_error = error_;
         return false;
     }
 
     for (const auto& statement : program.statements) {
         if (statement == nullptr || !EmitStatement(*statement, true)) {
-            *out_error = error_;
             return false;
         }
     }
@@ -100,17 +253,83 @@ bool LlvmEmitter::EmitProgram(const frontend::Program& program, const CompileOpt
     builder_.CreateRet(llvm::ConstantInt::get(builder_.getInt32Ty(), 0));
 
     if (llvm::verifyFunction(*main_function_, &llvm::errs())) {
-        *out_error = "LLVM genero una funcion main invalida.";
+        error_ = "LLVM genero una funcion main invalida.";
         return false;
     }
-    if (llvm::verifyModule(*module_, &llvm::errs())) {
-        *out_error = "LLVM genero un modulo invalido.";
+
+    return true;
+}
+
+bool LlvmEmitter::EmitJitFunction(const frontend::FunctionDeclStmt& function, bool math_module_imported,
+                                  const std::string& entry_name, std::string* out_error) {
+    if (!IsAotSupportedFunction(function, math_module_imported)) {
+        *out_error = "La funcion '" + function.name + "' no es elegible para JIT LLVM.";
+        return false;
+    }
+
+    use_runtime_bridge_ = false;
+    math_module_imported_ = math_module_imported;
+    user_functions_.clear();
+    user_function_order_.clear();
+
+    llvm::Type* message_pointer = llvm::PointerType::getUnqual(builder_.getInt8Ty());
+    jit_error_ = new llvm::GlobalVariable(*module_, message_pointer, false, llvm::GlobalValue::InternalLinkage,
+                                          llvm::ConstantPointerNull::get(llvm::cast<llvm::PointerType>(message_pointer)),
+                                          "clot.jit.error");
+
+    if (!DeclareUserFunction(function) || !EmitUserFunctions()) {
+        *out_error = error_;
+        return false;
+    }
+
+    const UserFunctionInfo& info = user_functions_.at(function.name);
+    llvm::Type* slot_pointer = llvm::PointerType::getUnqual(builder_.getDoubleTy());
+    llvm::Type* slots_pointer = llvm::PointerType::getUnqual(slot_pointer);
+    llvm::FunctionType* entry_type = llvm::FunctionType::get(message_pointer, {slots_pointer}, false);
+    llvm::Function* entry =
+        llvm::Function::Create(entry_type, llvm::Function::ExternalLinkage, entry_name, module_.get());
+
+    llvm::BasicBlock* entry_block = llvm::BasicBlock::Create(context_, "entry", entry);
+    builder_.SetInsertPoint(entry_block);
+
+    llvm::Argument* slots = entry->arg_begin();
+    slots->setName("slots");
+
+    std::vector<llvm::Value*> arguments;
+    arguments.reserve(info.param_by_reference.size());
+    for (std::size_t i = 0; i < info.param_by_reference.size(); ++i) {
+        llvm::Value* slot_address = builder_.CreateConstInBoundsGEP1_64(slot_pointer, slots, i, "slot.addr");
+        llvm::Value* slot = builder_.CreateLoad(slot_pointer, slot_address, "slot");
+        if (info.param_by_reference[i]) {
+            arguments.push_back(slot);
+        } else {
+            arguments.push_back(builder_.CreateLoad(builder_.getDoubleTy(), slot, "slot.value"));
+        }
+    }
+
+    builder_.CreateCall(info.llvm_function, arguments);
+    llvm::Value* error = builder_.CreateLoad(message_pointer, jit_error_, "jit.error");
+    builder_.CreateStore(llvm::Constant::getNullValue(message_pointer), jit_error_);
+    builder_.CreateRet(error);
+
+    if (llvm::verifyFunction(*entry, &llvm::errs()) || llvm::verifyModule(*module_, &llvm::errs())) {
+        *out_error = "LLVM genero un modulo JIT invalido para '" + function.name + "'.";
         return false;
     }
 
     return true;
 }
 
+void LlvmEmitter::SetSymbolPrefix(std::string prefix) {
+    symbol_prefix_ = std::move(prefix);
+}
+
+void LlvmEmitter::ReleaseModule(std::unique_ptr<llvm::LLVMContext>* out_context,
+                                std::unique_ptr<llvm::Module>* out_module) {
+    *out_module = std::move(module_);
+    *out_context = std::move(owned_context_);
+}
+
 bool LlvmEmitter::UsedRuntimeBridge() const {
     return use_runtime_bridge_;
 }
@@ -127,11 +346,10 @@ bool LlvmEmitter::EmitIRFile(const std::string& output_path, std::string* out_er
     return true;
 }
 
-bool LlvmEmitter::EmitObjectFile(const std::string& output_path, const std::string& requested_target,
+bool LlvmEmitter::EmitObjectFile(const std::string& output_path, const CompileOptions& compile_options,
                                  std::string* out_error) {
-    llvm::InitializeNativeTarget();
-    llvm::InitializeNativeTargetAsmPrinter();
-    llvm::InitializeNativeTargetAsmParser();
+    const std::string& requested_target = compile_options.target_triple;
+    InitializeNativeCodegen();
 
     const std::string target_triple = requested_target.empty() ? llvm::sys::getDefaultTargetTriple() : requested_target;
 
@@ -153,6 +371,7 @@ bool LlvmEmitter::EmitObjectFile(const std::string& output_path, const std::stri
 
     module_->setTargetTriple(target_triple);
     module_->setDataLayout(target_machine->createDataLayout());
+    OptimizeModule(module_.get(), target_machine.get(), compile_options);
 
     std::error_code error_code;
     llvm::raw_fd_ostream destination(output_path, error_code, llvm::sys::fs::OF_None);
@@ -224,6 +443,7 @@ bool LlvmEmitter::CreateMainFunction() {
     current_function_ = main_function_;
     variables_.clear();
     variable_kinds_.clear();
+    list_variables_.clear();
     return EnsurePrintfFunction();
 }
 
@@ -260,43 +480,50 @@ bool LlvmEmitter::DeclareUserFunctions(const frontend::Program& program) {
             continue;
         }
 
-        if (user_functions_.find(function_decl->name) != user_functions_.end()) {
-            error_ = "Funcion duplicada no soportada en AOT LLVM: " + function_decl->name;
+        if (!DeclareUserFunction(*function_decl)) {
             return false;
         }
+    }
 
-        std::vector<llvm::Type*> params;
-        std::vector<bool> by_reference;
-        params.reserve(function_decl->params.size());
-        by_reference.reserve(function_decl->params.size());
+    return true;
+}
 
-        for (const auto& param : function_decl->params) {
-            if (param.by_reference) {
-                params.push_back(llvm::PointerType::getUnqual(builder_.getDoubleTy()));
-            } else {
-                params.push_back(builder_.getDoubleTy());
-            }
-            by_reference.push_back(param.by_reference);
-        }
+bool LlvmEmitter::DeclareUserFunction(const frontend::FunctionDeclStmt& function_decl) {
+    if (user_functions_.find(function_decl.name) != user_functions_.end()) {
+        error_ = "Funcion duplicada no soportada en AOT LLVM: " + function_decl.name;
+        return false;
+    }
 
-        llvm::FunctionType* function_type = llvm::FunctionType::get(builder_.getVoidTy(), params, false);
-        llvm::Function* llvm_function = llvm::Function::Create(function_type, llvm::Function::ExternalLinkage,
-                                                               MangleFunctionName(function_decl->name), module_.get());
+    std::vector<llvm::Type*> params;
+    std::vector<bool> by_reference;
+    params.reserve(function_decl.params.size());
+    by_reference.reserve(function_decl.params.size());
 
-        if (llvm_function == nullptr) {
-            error_ = "No se pudo crear la funcion LLVM para '" + function_decl->name + "'.";
-            return false;
+    for (const auto& param : function_decl.params) {
+        if (param.by_reference) {
+            params.push_back(llvm::PointerType::getUnqual(builder_.getDoubleTy()));
+        } else {
+            params.push_back(builder_.getDoubleTy());
         }
+        by_reference.push_back(param.by_reference);
+    }
 
-        UserFunctionInfo info;
-        info.declaration = function_decl;
-        info.llvm_function = llvm_function;
-        info.param_by_reference = std::move(by_reference);
+    llvm::FunctionType* function_type = llvm::FunctionType::get(builder_.getVoidTy(), params, false);
+    llvm::Function* llvm_function = llvm::Function::Create(function_type, llvm::Function::ExternalLinkage,
+                                                           MangleFunctionName(function_decl.name), module_.get());
 
-        user_functions_[function_decl->name] = std::move(info);
-        user_function_order_.push_back(function_decl->name);
+    if (llvm_function == nullptr) {
+        error_ = "No se pudo crear la funcion LLVM para '" + function_decl.name + "'.";
+        return false;
     }
 
+    UserFunctionInfo info;
+    info.declaration = &function_decl;
+    info.llvm_function = llvm_function;
+    info.param_by_reference = std::move(by_reference);
+
+    user_functions_[function_decl.name] = std::move(info);
+    user_function_order_.push_back(function_decl.name);
     return true;
 }
 
@@ -324,11 +551,13 @@ bool LlvmEmitter::EmitUserFunction(const UserFunctionInfo& function_info) {
 
     std::unordered_map<std::string, llvm::Value*> saved_variables = std::move(variables_);
     std::unordered_map<std::string, VariableNumericKind> saved_variable_kinds = std::move(variable_kinds_);
+    std::unordered_map<std::string, ListSlot> saved_list_variables = std::move(list_variables_);
     llvm::Function* saved_function = current_function_;
 
     current_function_ = function_info.llvm_function;
     variables_.clear();
     variable_kinds_.clear();
+    list_variables_.clear();
 
     llvm::BasicBlock* entry = llvm::BasicBlock::Create(context_, "entry", function_info.llvm_function);
     builder_.SetInsertPoint(entry);
@@ -336,6 +565,7 @@ bool LlvmEmitter::EmitUserFunction(const UserFunctionInfo& function_info) {
     if (!EnsurePrintfFunction()) {
         variables_ = std::move(saved_variables);
         variable_kinds_ = std::move(saved_variable_kinds);
+        list_variables_ = std::move(saved_list_variables);
         current_function_ = saved_function;
         return false;
     }
@@ -362,6 +592,7 @@ bool LlvmEmitter::EmitUserFunction(const UserFunctionInfo& function_info) {
         if (nested_statement == nullptr || !EmitStatement(*nested_statement, false)) {
             variables_ = std::move(saved_variables);
             variable_kinds_ = std::move(saved_variable_kinds);
+            list_variables_ = std::move(saved_list_variables);
             current_function_ = saved_function;
             return false;
         }
@@ -375,12 +606,14 @@ bool LlvmEmitter::EmitUserFunction(const UserFunctionInfo& function_info) {
         error_ = "LLVM genero una funcion invalida para '" + function_info.declaration->name + "'.";
         variables_ = std::move(saved_variables);
         variable_kinds_ = std::move(saved_variable_kinds);
+        list_variables_ = std::move(saved_list_variables);
         current_function_ = saved_function;
         return false;
     }
 
     variables_ = std::move(saved_variables);
     variable_kinds_ = std::move(saved_variable_kinds);
+    list_variables_ = std::move(saved_list_variables);
     current_function_ = saved_function;
     return true;
 }
@@ -402,6 +635,18 @@ bool LlvmEmitter::EmitStatement(const frontend::Statement& statement, bool allow
         return EmitWhile(*while_stmt);
     }
 
+    if (const auto* for_stmt = dynamic_cast<const frontend::ForStmt*>(&statement)) {
+        return EmitFor(*for_stmt);
+    }
+
+    if (const auto* for_each = dynamic_cast<const frontend::ForEachStmt*>(&statement)) {
+        return EmitForEach(*for_each);
+    }
+
+    if (const auto* mutation = dynamic_cast<const frontend::MutationStmt*>(&statement)) {
+        return EmitMutation(*mutation);
+    }
+
     if (const auto* import_stmt = dynamic_cast<const frontend::ImportStmt*>(&statement)) {
         if (import_stmt->module_name == "math") {
             math_module_imported_ = true;
@@ -443,6 +688,10 @@ bool LlvmEmitter::EmitStatement(const frontend::Statement& statement, bool allow
 }
 
 bool LlvmEmitter::EmitAssignment(const frontend::AssignmentStmt& statement) {
+    if (const auto* list = dynamic_cast<const frontend::ListExpr*>(statement.expr.get())) {
+        return EmitListAssignment(statement.name, *list);
+    }
+
     llvm::Value* expression_value = EmitNumericExpr(*statement.expr);
     if (expression_value == nullptr) {
         return false;
@@ -665,17 +914,297 @@ bool LlvmEmitter::EmitCallStatement(const frontend::CallExpr& call) {
 }
 
 llvm::AllocaInst* LlvmEmitter::CreateEntryBlockAlloca(llvm::Function* function, const std::string& name) {
+    return CreateEntryBlockAlloca(function, builder_.getDoubleTy(), name);
+}
+
+llvm::AllocaInst* LlvmEmitter::CreateEntryBlockAlloca(llvm::Function* function, llvm::Type* type,
+                                                      const std::string& name) {
     llvm::IRBuilder<> entry_builder(&function->getEntryBlock(), function->getEntryBlock().begin());
-    return entry_builder.CreateAlloca(builder_.getDoubleTy(), nullptr, name);
+    return entry_builder.CreateAlloca(type, nullptr, name);
 }
 
-bool LlvmEmitter::EmitRangeCheckOrAbort(llvm::Value* out_of_range, const char* message) {
-    if (out_of_range == nullptr) {
-        error_ = "Error interno: condicion nula para chequeo de rango LLVM.";
+bool LlvmEmitter::EmitListAssignment(const std::string& name, const frontend::ListExpr& list) {
+    if (current_function_ == nullptr) {
+        error_ = "Estado interno invalido: no hay funcion activa para asignacion.";
         return false;
     }
 
-    if (!EnsurePrintfFunction() || !EnsureExitFunction()) {
+    std::vector<llvm::Value*> elements;
+    elements.reserve(list.elements.size());
+    for (const auto& element : list.elements) {
+        llvm::Value* value = element == nullptr ? nullptr : EmitNumericExpr(*element);
+        if (value == nullptr) {
+            return false;
+        }
+        elements.push_back(value);
+    }
+
+    // One buffer per literal site. Lists are only ever bound from literals, so a
+    // buffer is never shared by two names and value semantics hold.
+    const std::uint64_t capacity = std::max<std::uint64_t>(1, elements.size());
+    llvm::ArrayType* buffer_type = llvm::ArrayType::get(builder_.getDoubleTy(), capacity);
+    llvm::AllocaInst* buffer = CreateEntryBlockAlloca(current_function_, buffer_type, name + ".buf");
+    for (std::size_t i = 0; i < elements.size(); ++i) {
+        llvm::Value* slot = builder_.CreateConstInBoundsGEP2_64(buffer_type, buffer, 0, i, name + ".init");
+        builder_.CreateStore(elements[i], slot);
+    }
+
+    auto found = list_variables_.find(name);
+    if (found == list_variables_.end()) {
+        ListSlot slot;
+        slot.data = CreateEntryBlockAlloca(
+            current_function_, llvm::PointerType::getUnqual(builder_.getDoubleTy()), name + ".data");
+        slot.length = CreateEntryBlockAlloca(current_function_, builder_.getInt64Ty(), name + ".len");
+        found = list_variables_.emplace(name, slot).first;
+    }
+
+    llvm::Value* data = builder_.CreateConstInBoundsGEP2_64(buffer_type, buffer, 0, 0, name + ".first");
+    builder_.CreateStore(data, found->second.data);
+    builder_.CreateStore(llvm::ConstantInt::get(builder_.getInt64Ty(), elements.size()), found->second.length);
+    return true;
+}
+
+llvm::Value* LlvmEmitter::EmitListElementPointer(const frontend::IndexExpr& index) {
+    const auto* variable = dynamic_cast<const frontend::VariableExpr*>(index.collection.get());
+    const auto list_it = variable == nullptr ? list_variables_.end() : list_variables_.find(variable->name);
+    if (list_it == list_variables_.end() || index.index == nullptr) {
+        error_ = "La indexacion en AOT LLVM solo se soporta sobre listas numericas.";
+        return nullptr;
+    }
+
+    llvm::Value* position = EmitNumericExpr(*index.index);
+    if (position == nullptr) {
+        return nullptr;
+    }
+
+    // Same contract as the interpreter: the index must be a finite integer
+    // inside [0, len). fptosi of NaN/inf is poison, so compare before use.
+    llvm::Value* lower = llvm::ConstantFP::get(builder_.getDoubleTy(), -9223372036854775808.0);
+    llvm::Value* upper = llvm::ConstantFP::get(builder_.getDoubleTy(), 9223372036854775808.0);
+    llvm::Value* representable = builder_.CreateAnd(builder_.CreateFCmpOGE(position, lower, "index.low"),
+                                                    builder_.CreateFCmpOLT(position, upper, "index.high"));
+    llvm::Value* truncated = builder_.CreateCall(
+        llvm::Intrinsic::getDeclaration(module_.get(), llvm::Intrinsic::trunc, {builder_.getDoubleTy()}),
+        {position}, "index.trunc");
+    llvm::Value* integral = builder_.CreateFCmpOEQ(truncated, position, "index.integral");
+    llvm::Value* invalid = builder_.CreateNot(builder_.CreateAnd(representable, integral), "index.invalid");
+    if (!EmitRangeCheckOrAbort(invalid, "El indice de lista debe ser un entero finito.")) {
+        return nullptr;
+    }
+
+    llvm::Value* offset = builder_.CreateFPToSI(position, builder_.getInt64Ty(), "index.i64");
+    llvm::Value* length = builder_.CreateLoad(builder_.getInt64Ty(), list_it->second.length, "list.len");
+    // Unsigned compare also rejects negative offsets.
+    llvm::Value* out_of_bounds = builder_.CreateICmpUGE(offset, length, "index.oob");
+    if (!EmitRangeCheckOrAbort(out_of_bounds, "Indice fuera de rango en lista.")) {
+        return nullptr;
+    }
+
+    llvm::Type* data_type = llvm::PointerType::getUnqual(builder_.getDoubleTy());
+    llvm::Value* data = builder_.CreateLoad(data_type, list_it->second.data, "list.data");
+    return builder_.CreateInBoundsGEP(builder_.getDoubleTy(), data, offset, "list.elem.ptr");
+}
+
+bool LlvmEmitter::EmitMutation(const frontend::MutationStmt& statement) {
+    if (statement.target == nullptr || statement.expr == nullptr) {
+        error_ = "Mutacion vacia en emision LLVM.";
+        return false;
+    }
+
+    llvm::Value* target = nullptr;
+    VariableNumericKind kind = VariableNumericKind::Dynamic;
+    std::string label = "mut";
+    if (const auto* index = dynamic_cast<const frontend::IndexExpr*>(statement.target.get())) {
+        target = EmitListElementPointer(*index);
+    } else if (const auto* variable = dynamic_cast<const frontend::VariableExpr*>(statement.target.get())) {
+        const auto found = variables_.find(variable->name);
+        if (found == variables_.end()) {
+            error_ = "Variable no definida: " + variable->name;
+            return false;
+        }
+        target = found->second;
+        label = variable->name;
+        const auto kind_it = variable_kinds_.find(variable->name);
+        if (kind_it != variable_kinds_.end()) {
+            kind = kind_it->second;
+        }
+    } else {
+        error_ = "Mutacion no soportada en AOT LLVM.";
+        return false;
+    }
+
+    if (target == nullptr) {
+        return false;
+    }
+
+    llvm::Value* value = EmitNumericExpr(*statement.expr);
+    if (value == nullptr) {
+        return false;
+    }
+
+    if (statement.op != frontend::AssignmentOp::Set) {
+        llvm::Value* current = builder_.CreateLoad(builder_.getDoubleTy(), target, label + ".load");
+        value = statement.op == frontend::AssignmentOp::AddAssign
+                    ? builder_.CreateFAdd(current, value, label + ".add")
+                    : builder_.CreateFSub(current, value, label + ".sub");
+    }
+
+    value = NormalizeForKind(value, kind);
+    if (value == nullptr) {
+        return false;
+    }
+
+    builder_.CreateStore(value, target);
+    return true;
+}
+
+void LlvmEmitter::AttachVectorizeHint(llvm::BranchInst* latch, const std::vector<llvm::BasicBlock*>& body) {
+    // A forced hint lets the vectorizer reassociate FP reductions, so AOT sums
+    // would differ bitwise from interpret mode. Those loops are left to the
+    // vectorizer's cost model, which keeps the sequential order.
+    if (LoopBodyHasReduction(body)) {
+        return;
+    }
+    // Self-referential loop ID as produced by `#pragma clang loop vectorize(enable)`.
+    llvm::Metadata* enable[] = {
+        llvm::MDString::get(context_, "llvm.loop.vectorize.enable"),
+        llvm::ConstantAsMetadata::get(builder_.getTrue()),
+    };
+    llvm::Metadata* loop_operands[] = {nullptr, llvm::MDNode::get(context_, enable)};
+    llvm::MDNode* loop_id = llvm::MDNode::getDistinct(context_, loop_operands);
+    loop_id->replaceOperandWith(0, loop_id);
+    latch->setMetadata(llvm::LLVMContext::MD_loop, loop_id);
+}
+
+bool LlvmEmitter::EmitFor(const frontend::ForStmt& statement) {
+    if (statement.initializer != nullptr && !EmitStatement(*statement.initializer, false)) {
+        return false;
+    }
+
+    llvm::Function* function = builder_.GetInsertBlock()->getParent();
+    llvm::BasicBlock* cond_block = llvm::BasicBlock::Create(context_, "for.cond", function);
+    llvm::BasicBlock* body_block = llvm::BasicBlock::Create(context_, "for.body", function);
+    llvm::BasicBlock* update_block = llvm::BasicBlock::Create(context_, "for.update", function);
+    llvm::BasicBlock* end_block = llvm::BasicBlock::Create(context_, "for.end", function);
+    const std::size_t first_nested_block = function->size();
+
+    builder_.CreateBr(cond_block);
+
+    builder_.SetInsertPoint(cond_block);
+    if (statement.condition != nullptr) {
+        llvm::Value* condition_value = EmitNumericExpr(*statement.condition);
+        if (condition_value == nullptr) {
+            return false;
+        }
+        llvm::Value* zero = llvm::ConstantFP::get(builder_.getDoubleTy(), 0.0);
+        builder_.CreateCondBr(builder_.CreateFCmpONE(condition_value, zero, "for.cond.bool"), body_block, end_block);
+    } else {
+        builder_.CreateBr(body_block);
+    }
+
+    builder_.SetInsertPoint(body_block);
+    for (const auto& nested : statement.body) {
+        if (nested == nullptr || !EmitStatement(*nested, false)) {
+            return false;
+        }
+    }
+    if (builder_.GetInsertBlock()->getTerminator() == nullptr) {
+        builder_.CreateBr(update_block);
+    }
+
+    builder_.SetInsertPoint(update_block);
+    if (statement.update != nullptr && !EmitStatement(*statement.update, false)) {
+        return false;
+    }
+    AttachVectorizeHint(builder_.CreateBr(cond_block), LoopBodyBlocks(function, body_block, first_nested_block));
+
+    builder_.SetInsertPoint(end_block);
+    return true;
+}
+
+bool LlvmEmitter::EmitForEach(const frontend::ForEachStmt& statement) {
+    const auto* collection = dynamic_cast<const frontend::VariableExpr*>(statement.collection.get());
+    const auto list_it = collection == nullptr ? list_variables_.end() : list_variables_.find(collection->name);
+    if (list_it == list_variables_.end()) {
+        error_ = "for-each en AOT LLVM solo recorre listas numericas.";
+        return false;
+    }
+
+    llvm::Function* function = builder_.GetInsertBlock()->getParent();
+    llvm::Type* data_type = llvm::PointerType::getUnqual(builder_.getDoubleTy());
+
+    // Counted loop over a snapshot of (data, len); the body never writes the list.
+    llvm::Value* data = builder_.CreateLoad(data_type, list_it->second.data, "foreach.data");
+    llvm::Value* length = builder_.CreateLoad(builder_.getInt64Ty(), list_it->second.length, "foreach.len");
+    llvm::AllocaInst* counter = CreateEntryBlockAlloca(function, builder_.getInt64Ty(), "foreach.i");
+    builder_.CreateStore(llvm::ConstantInt::get(builder_.getInt64Ty(), 0), counter);
+
+    // The loop variable is scoped to the loop, as in the interpreter.
+    const auto previous_slot = variables_.find(statement.variable_name);
+    const std::optional<llvm::Value*> saved_slot =
+        previous_slot == variables_.end() ? std::nullopt : std::optional<llvm::Value*>(previous_slot->second);
+    const auto previous_kind = variable_kinds_.find(statement.variable_name);
+    const std::optional<VariableNumericKind> saved_kind =
+        previous_kind == variable_kinds_.end() ? std::nullopt : std::optional<VariableNumericKind>(previous_kind->second);
+
+    llvm::AllocaInst* element_slot = CreateEntryBlockAlloca(function, statement.variable_name);
+    variables_[statement.variable_name] = element_slot;
+    variable_kinds_[statement.variable_name] = VariableNumericKind::Dynamic;
+
+    llvm::BasicBlock* cond_block = llvm::BasicBlock::Create(context_, "foreach.cond", function);
+    llvm::BasicBlock* body_block = llvm::BasicBlock::Create(context_, "foreach.body", function);
+    llvm::BasicBlock* latch_block = llvm::BasicBlock::Create(context_, "foreach.latch", function);
+    llvm::BasicBlock* end_block = llvm::BasicBlock::Create(context_, "foreach.end", function);
+    const std::size_t first_nested_block = function->size();
+
+    builder_.CreateBr(cond_block);
+
+    builder_.SetInsertPoint(cond_block);
+    llvm::Value* current = builder_.CreateLoad(builder_.getInt64Ty(), counter, "foreach.i.value");
+    builder_.CreateCondBr(builder_.CreateICmpSLT(current, length, "foreach.more"), body_block, end_block);
+
+    builder_.SetInsertPoint(body_block);
+    llvm::Value* element_ptr = builder_.CreateInBoundsGEP(builder_.getDoubleTy(), data, current, "foreach.elem.ptr");
+    builder_.CreateStore(builder_.CreateLoad(builder_.getDoubleTy(), element_ptr, "foreach.elem"), element_slot);
+
+    bool ok = true;
+    for (const auto& nested : statement.body) {
+        if (nested == nullptr || !EmitStatement(*nested, false)) {
+            ok = false;
+            break;
+        }
+    }
+
+    if (ok) {
+        if (builder_.GetInsertBlock()->getTerminator() == nullptr) {
+            builder_.CreateBr(latch_block);
+        }
+
+        builder_.SetInsertPoint(latch_block);
+        llvm::Value* next = builder_.CreateAdd(
+            builder_.CreateLoad(builder_.getInt64Ty(), counter, "foreach.i.latch"),
+            llvm::ConstantInt::get(builder_.getInt64Ty(), 1), "foreach.i.next", true, true);
+        builder_.CreateStore(next, counter);
+        AttachVectorizeHint(builder_.CreateBr(cond_block), LoopBodyBlocks(function, body_block, first_nested_block));
+        builder_.SetInsertPoint(end_block);
+    }
+
+    if (saved_slot.has_value()) {
+        variables_[statement.variable_name] = *saved_slot;
+    } else {
+        variables_.erase(statement.variable_name);
+    }
+    if (saved_kind.has_value()) {
+        variable_kinds_[statement.variable_name] = *saved_kind;
+    } else {
+        variable_kinds_.erase(statement.variable_name);
+    }
+    return ok;
+}
+
+bool LlvmEmitter::EmitRangeCheckOrAbort(llvm::Value* out_of_range, const char* message) {
+    if (out_of_range == nullptr) {
+        error_ = "Error interno: condicion nula para chequeo de rango LLVM.";
         return false;
     }
 
@@ -685,6 +1214,22 @@ bool LlvmEmitter::EmitRangeCheckOrAbort(llvm::Value* out_of_range, const char* m
     builder_.CreateCondBr(out_of_range, fail_block, ok_block);
 
     builder_.SetInsertPoint(fail_block);
+    if (jit_error_ != nullptr) {
+        // JIT code runs inside the interpreter: hand the error back so that
+        // try/catch sees it as in interpret mode.
+        builder_.CreateStore(builder_.CreateGlobalStringPtr(message), jit_error_);
+        if (function->getReturnType()->isVoidTy()) {
+            builder_.CreateRetVoid();
+        } else {
+            builder_.CreateRet(llvm::Constant::getNullValue(function->getReturnType()));
+        }
+        builder_.SetInsertPoint(ok_block);
+        return true;
+    }
+
+    if (!EnsurePrintfFunction() || !EnsureExitFunction()) {
+        return false;
+    }
     llvm::Value* format = builder_.CreateGlobalStringPtr("%s\n");
     llvm::Value* text = builder_.CreateGlobalStringPtr(message);
     builder_.CreateCall(printf_function_, {format, text});
@@ -695,6 +1240,28 @@ bool LlvmEmitter::EmitRangeCheckOrAbort(llvm::Value* out_of_range, const char* m
     return true;
 }
 
+void LlvmEmitter::EmitReturnIfJitError() {
+    if (jit_error_ == nullptr) {
+        return;
+    }
+
+    llvm::Function* function = builder_.GetInsertBlock()->getParent();
+    llvm::Type* message_pointer = jit_error_->getValueType();
+    llvm::Value* error = builder_.CreateLoad(message_pointer, jit_error_, "callee.error");
+    llvm::Value* failed = builder_.CreateIsNotNull(error, "callee.failed");
+    llvm::BasicBlock* fail_block = llvm::BasicBlock::Create(context_, "callee.fail", function);
+    llvm::BasicBlock* ok_block = llvm::BasicBlock::Create(context_, "callee.ok", function);
+    builder_.CreateCondBr(failed, fail_block, ok_block);
+
+    builder_.SetInsertPoint(fail_block);
+    if (function->getReturnType()->isVoidTy()) {
+        builder_.CreateRetVoid();
+    } else {
+        builder_.CreateRet(llvm::Constant::getNullValue(function->getReturnType()));
+    }
+    builder_.SetInsertPoint(ok_block);
+}
+
 llvm::Value* LlvmEmitter::NormalizeForKind(llvm::Value* value, VariableNumericKind kind) {
     if (value == nullptr || kind == VariableNumericKind::Dynamic) {
         return value;
@@ -961,6 +1528,7 @@ bool LlvmEmitter::EmitUserFunctionCall(const frontend::CallExpr& call, bool requ
     }
 
     builder_.CreateCall(function_info.llvm_function, emitted_arguments);
+    EmitReturnIfJitError();
     if (out_value != nullptr) {
         *out_value = nullptr;
     }
@@ -990,6 +1558,11 @@ llvm::Value* LlvmEmitter::EmitNumericExpr(const frontend::Expr& expression) {
             return nullptr;
         }
 
+        if (list_variables_.find(variable->name) != list_variables_.end()) {
+            error_ = "Las listas solo se soportan por elemento o len() en AOT LLVM: " + variable->name;
+            return nullptr;
+        }
+
         auto found = variables_.find(variable->name);
         if (found == variables_.end()) {
             error_ = "Variable no definida: " + variable->name;
@@ -1013,12 +1586,26 @@ llvm::Value* LlvmEmitter::EmitNumericExpr(const frontend::Expr& expression) {
         return nullptr;
     }
 
-    if (dynamic_cast<const frontend::IndexExpr*>(&expression) != nullptr) {
-        error_ = "La indexacion de listas aun no se soporta en modo compile LLVM AOT.";
-        return nullptr;
+    if (const auto* index = dynamic_cast<const frontend::IndexExpr*>(&expression)) {
+        llvm::Value* element = EmitListElementPointer(*index);
+        if (element == nullptr) {
+            return nullptr;
+        }
+        return builder_.CreateLoad(builder_.getDoubleTy(), element, "list.elem");
     }
 
     if (const auto* call = dynamic_cast<const frontend::CallExpr*>(&expression)) {
+        if (call->callee == "len" && call->arguments.size() == 1 && call->arguments[0].value != nullptr) {
+            const auto* variable = dynamic_cast<const frontend::VariableExpr*>(call->arguments[0].value.get());
+            const auto list_it = variable == nullptr ? list_variables_.end() : list_variables_.find(variable->name);
+            if (list_it == list_variables_.end()) {
+                error_ = "len() en AOT LLVM solo acepta listas numericas.";
+                return nullptr;
+            }
+            llvm::Value* length = builder_.CreateLoad(builder_.getInt64Ty(), list_it->second.length, "list.len");
+            return builder_.CreateSIToFP(length, builder_.getDoubleTy(), "list.len.num");
+        }
+
         if (IsAotMathBuiltinName(call->callee)) {
             if (!math_module_imported_) {
                 error_ = call->callee + "() requiere 'import math;' en modo compile LLVM AOT.";
@@ -1115,7 +1702,7 @@ llvm::Value* LlvmEmitter::BoolToNumber(llvm::Value* bool_value) {
 }
 
 std::string LlvmEmitter::MangleFunctionName(const std::string& name) const {
-    return "clot_fn_" + name;
+    return symbol_prefix_ + name;
 }
 
 } // namespace clot::codegen::internal
@@ -0,0 +1,157 @@
+#include "clot/codegen/llvm_jit.hpp"
+
+#ifdef CLOT_HAS_LLVM
+
+#include "llvm_backend_internal.hpp"
+
+#include <mutex>
+#include <utility>
+
+#include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
+#include <llvm/Passes/OptimizationLevel.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Support/Error.h>
+
+#endif
+
+namespace clot::codegen {
+
+#ifdef CLOT_HAS_LLVM
+
+namespace {
+
+void OptimizeModule(llvm::Module* module) {
+    llvm::LoopAnalysisManager loop_analysis;
+    llvm::FunctionAnalysisManager function_analysis;
+    llvm::CGSCCAnalysisManager cgscc_analysis;
+    llvm::ModuleAnalysisManager module_analysis;
+
+    llvm::PassBuilder pass_builder;
+    pass_builder.registerModuleAnalyses(module_analysis);
+    pass_builder.registerCGSCCAnalyses(cgscc_analysis);
+    pass_builder.registerFunctionAnalyses(function_analysis);
+    pass_builder.registerLoopAnalyses(loop_analysis);
+    pass_builder.crossRegisterProxies(loop_analysis, function_analysis, cgscc_analysis, module_analysis);
+
+    llvm::ModulePassManager pipeline = pass_builder.buildPerModuleDefaultPipeline(llvm::OptimizationLevel::O2);
+    pipeline.run(*module, module_analysis);
+}
+
+}  // namespace
+
+struct LlvmJit::State {
+    std::mutex mutex;
+    std::unique_ptr<llvm::orc::LLJIT> jit;
+    std::string init_error;
+    unsigned long long next_module_id = 1;
+};
+
+LlvmJit::LlvmJit() : state_(std::make_unique<State>()) {
+    internal::InitializeNativeCodegen();
+
+    auto jit = llvm::orc::LLJITBuilder().create();
+    if (!jit) {
+        state_->init_error = "No se pudo crear LLJIT: " + llvm::toString(jit.takeError());
+        return;
+    }
+
+    // Generated code calls printf/exit and libm directly; resolve them from the
+    // running process instead of linking a runtime.
+    auto process_symbols = llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(
+        (*jit)->getDataLayout().getGlobalPrefix());
+    if (!process_symbols) {
+        state_->init_error = "No se pudo exponer simbolos del proceso al JIT: " +
+                             llvm::toString(process_symbols.takeError());
+        return;
+    }
+    (*jit)->getMainJITDylib().addGenerator(std::move(*process_symbols));
+    state_->jit = std::move(*jit);
+}
+
+LlvmJit::~LlvmJit() = default;
+
+bool LlvmJit::IsAvailable() {
+    return true;
+}
+
+bool LlvmJit::IsEligibleFunction(const frontend::FunctionDeclStmt& function, bool math_module_imported) {
+    return internal::IsAotSupportedFunction(function, math_module_imported);
+}
+
+bool LlvmJit::CompileFunction(
+    const frontend::FunctionDeclStmt& function,
+    bool math_module_imported,
+    NativeEntryPoint* out_entry,
+    std::string* out_error) {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    if (state_->jit == nullptr) {
+        *out_error = state_->init_error;
+        return false;
+    }
+
+    // Every compiled function gets its own symbol namespace so redefinitions of
+    // the same Clot name never collide inside the JITDylib.
+    const std::string prefix = "clot_jit_" + std::to_string(state_->next_module_id++) + "_";
+    const std::string entry_name = prefix + "entry";
+
+    internal::LlvmEmitter emitter("clot_jit_module");
+    emitter.SetSymbolPrefix(prefix);
+    if (!emitter.EmitJitFunction(function, math_module_imported, entry_name, out_error)) {
+        return false;
+    }
+
+    std::unique_ptr<llvm::LLVMContext> context;
+    std::unique_ptr<llvm::Module> module;
+    emitter.ReleaseModule(&context, &module);
+
+    module->setDataLayout(state_->jit->getDataLayout());
+    module->setTargetTriple(state_->jit->getTargetTriple().str());
+    OptimizeModule(module.get());
+
+    if (auto error = state_->jit->addIRModule(llvm::orc::ThreadSafeModule(std::move(module), std::move(context)))) {
+        *out_error = "No se pudo agregar modulo al JIT: " + llvm::toString(std::move(error));
+        return false;
+    }
+
+    auto symbol = state_->jit->lookup(entry_name);
+    if (!symbol) {
+        *out_error = "No se encontro simbolo JIT '" + entry_name + "': " + llvm::toString(symbol.takeError());
+        return false;
+    }
+
+    *out_entry = symbol->toPtr<NativeEntryPoint>();
+    return true;
+}
+
+#else
+
+struct LlvmJit::State {};
+
+LlvmJit::LlvmJit() : state_(std::make_unique<State>()) {}
+
+LlvmJit::~LlvmJit() = default;
+
+bool LlvmJit::IsAvailable() {
+    return false;
+}
+
+bool LlvmJit::IsEligibleFunction(const frontend::FunctionDeclStmt&, bool) {
+    return false;
+}
+
+bool LlvmJit::CompileFunction(
+    const frontend::FunctionDeclStmt&,
+    bool,
+    NativeEntryPoint*,
+    std::string* out_error) {
+    if (out_error != nullptr) {
+        *out_error = "Este binario se compilo sin soporte LLVM. Reconfigura con LLVM instalado.";
+    }
+    return false;
+}
+
+#endif
+
+}  // namespace clot::codegen
@@ -7,6 +7,7 @@
 #include <cstdlib>
 #include <filesystem>
 #include <string>
+#include <vector>
 
 #include <llvm/Support/raw_ostream.h>
 
@@ -27,45 +28,70 @@ std::string QuoteForShell(const std::string& value) {
     return quoted;
 }
 
-bool RuntimeBridgeSourcesExist(
-    const std::filesystem::path& bridge_source,
-    const std::filesystem::path& external_bridge_source,
-    const std::filesystem::path& parser_core_source,
-    const std::filesystem::path& parser_expression_source,
-    const std::filesystem::path& parser_statements_source,
-    const std::filesystem::path& source_loader_source,
-    const std::filesystem::path& tokenizer_source,
-    const std::filesystem::path& interpreter_source,
-    const std::filesystem::path& interpreter_builtins_source,
-    const std::filesystem::path& interpreter_state_source,
-    const std::filesystem::path& interpreter_modules_source,
-    const std::filesystem::path& i18n_source,
-    const std::filesystem::path& paths_source) {
-    return std::filesystem::exists(bridge_source) &&
-           std::filesystem::exists(external_bridge_source) &&
-           std::filesystem::exists(parser_core_source) &&
-           std::filesystem::exists(parser_expression_source) &&
-           std::filesystem::exists(parser_statements_source) &&
-           std::filesystem::exists(source_loader_source) &&
-           std::filesystem::exists(tokenizer_source) &&
-           std::filesystem::exists(interpreter_source) &&
-           std::filesystem::exists(interpreter_builtins_source) &&
-           std::filesystem::exists(interpreter_state_source) &&
-           std::filesystem::exists(interpreter_modules_source) &&
-           std::filesystem::exists(i18n_source) &&
-           std::filesystem::exists(paths_source);
+// Everything the full runtime bridge compiles next to the program's objects,
+// relative to the project root. The bridge itself comes first.
+constexpr const char* kRuntimeBridgeSources[] = {
+    "src/codegen/runtime_bridge.cpp",
+    "src/frontend/parser_core.cpp",
+    "src/frontend/parser_expression.cpp",
+    "src/frontend/parser_statements.cpp",
+    "src/frontend/source_loader.cpp",
+    "src/frontend/tokenizer.cpp",
+    "src/interpreter/interpreter.cpp",
+    "src/interpreter/interpreter_builtins.cpp",
+    "src/interpreter/interpreter_state.cpp",
+    "src/interpreter/interpreter_modules.cpp",
+    "src/interpreter/interpreter_ndarray.cpp",
+    "src/interpreter/interpreter_stats.cpp",
+    "src/interpreter/interpreter_dual.cpp",
+    "src/interpreter/interpreter_optimize.cpp",
+    "src/interpreter/interpreter_ml.cpp",
+    "src/interpreter/module_cache.cpp",
+    "src/interpreter/interpreter_snapshot.cpp",
+    "src/interpreter/interpreter_limits.cpp",
+    "src/runtime/i18n.cpp",
+    "src/runtime/output.cpp",
+    "src/runtime/paths.cpp",
+    "src/runtime/text_search.cpp",
+    "src/runtime/ndarray.cpp",
+    "src/runtime/ndarray_linalg.cpp",
+    "src/runtime/streaming_stats.cpp",
+    "src/runtime/dual.cpp",
+    "src/runtime/optimizer.cpp",
+    "src/runtime/ml.cpp",
+    "src/runtime/profiler.cpp",
+    "src/runtime/counters.cpp",
+    "src/runtime/timing.cpp",
+    "src/runtime/value_hash.cpp",
+    "src/runtime/heap.cpp",
+};
+
+std::vector<std::filesystem::path> RuntimeBridgeSources(const std::filesystem::path& root) {
+    std::vector<std::filesystem::path> sources;
+    for (const char* relative : kRuntimeBridgeSources) {
+        sources.push_back(root / std::filesystem::path(relative).make_preferred());
+    }
+    return sources;
 }
 
 }  // namespace
 
 bool LinkExecutable(
-    const std::string& object_path,
+    const std::vector<std::string>& object_paths,
     const std::string& executable_path,
     bool use_runtime_bridge,
     const CompileOptions& options,
     bool verbose,
     std::string* out_error) {
     std::string command = "clang++ ";
+    if (options.instrument) {
+        // Pulls in the LLVM profile runtime that the IRInstr counters write through.
+        command += "-fprofile-generate ";
+    }
+    std::string quoted_objects;
+    for (const std::string& object_path : object_paths) {
+        quoted_objects += QuoteForShell(object_path) + " ";
+    }
 
     if (use_runtime_bridge) {
         if (options.project_root.empty()) {
@@ -75,21 +101,8 @@ bool LinkExecutable(
 
         const std::filesystem::path root = std::filesystem::path(options.project_root);
         const std::filesystem::path include_dir = root / "include";
-        const std::filesystem::path bridge_source = root / "src" / "codegen" / "runtime_bridge.cpp";
         const std::filesystem::path external_bridge_source = root / "src" / "codegen" / "runtime_bridge_external.cpp";
-
-        const std::filesystem::path parser_core_source = root / "src" / "frontend" / "parser_core.cpp";
-        const std::filesystem::path parser_expression_source = root / "src" / "frontend" / "parser_expression.cpp";
-        const std::filesystem::path parser_statements_source = root / "src" / "frontend" / "parser_statements.cpp";
-
-        const std::filesystem::path source_loader_source = root / "src" / "frontend" / "source_loader.cpp";
-        const std::filesystem::path tokenizer_source = root / "src" / "frontend" / "tokenizer.cpp";
-        const std::filesystem::path interpreter_source = root / "src" / "interpreter" / "interpreter.cpp";
-        const std::filesystem::path interpreter_builtins_source = root / "src" / "interpreter" / "interpreter_builtins.cpp";
-        const std::filesystem::path interpreter_state_source = root / "src" / "interpreter" / "interpreter_state.cpp";
-        const std::filesystem::path interpreter_modules_source = root / "src" / "interpreter" / "interpreter_modules.cpp";
-        const std::filesystem::path i18n_source = root / "src" / "runtime" / "i18n.cpp";
-        const std::filesystem::path paths_source = root / "src" / "runtime" / "paths.cpp";
+        const std::vector<std::filesystem::path> bridge_sources = RuntimeBridgeSources(root);
 
         const bool use_external_bridge = options.runtime_bridge_mode == CompileOptions::RuntimeBridgeMode::External;
         if (use_external_bridge) {
@@ -97,22 +110,13 @@ bool LinkExecutable(
                 *out_error = "No se encontro runtime bridge externo LLVM en: " + external_bridge_source.string();
                 return false;
             }
-        } else if (!RuntimeBridgeSourcesExist(
-                       bridge_source,
-                       external_bridge_source,
-                       parser_core_source,
-                       parser_expression_source,
-                       parser_statements_source,
-                       source_loader_source,
-                       tokenizer_source,
-                       interpreter_source,
-                       interpreter_builtins_source,
-                       interpreter_state_source,
-                       interpreter_modules_source,
-                       i18n_source,
-                       paths_source)) {
-            *out_error = "No se encontraron archivos fuente para runtime bridge LLVM en: " + root.string();
-            return false;
+        } else {
+            for (const std::filesystem::path& source : bridge_sources) {
+                if (!std::filesystem::exists(source)) {
+                    *out_error = "No se encontraron archivos fuente para runtime bridge LLVM en: " + root.string();
+                    return false;
+                }
+            }
         }
 
         command += "-std=c++20 -O2 ";
@@ -120,30 +124,21 @@ bool LinkExecutable(
 #ifndef _WIN32
         command += "-no-pie ";
 #endif
-        command += QuoteForShell(object_path) + " ";
+        command += quoted_objects;
         if (use_external_bridge) {
             command += "-DCLOT_EXTERNAL_RUNTIME_BRIDGE_IMPL ";
             command += QuoteForShell(external_bridge_source.string()) + " ";
         } else {
-            command += QuoteForShell(bridge_source.string()) + " ";
-            command += QuoteForShell(parser_core_source.string()) + " ";
-            command += QuoteForShell(parser_expression_source.string()) + " ";
-            command += QuoteForShell(parser_statements_source.string()) + " ";
-            command += QuoteForShell(source_loader_source.string()) + " ";
-            command += QuoteForShell(tokenizer_source.string()) + " ";
-            command += QuoteForShell(interpreter_source.string()) + " ";
-            command += QuoteForShell(interpreter_builtins_source.string()) + " ";
-            command += QuoteForShell(interpreter_state_source.string()) + " ";
-            command += QuoteForShell(interpreter_modules_source.string()) + " ";
-            command += QuoteForShell(i18n_source.string()) + " ";
-            command += QuoteForShell(paths_source.string()) + " ";
+            for (const std::filesystem::path& source : bridge_sources) {
+                command += QuoteForShell(source.string()) + " ";
+            }
         }
         command += "-o " + QuoteForShell(executable_path);
     } else {
 #ifndef _WIN32
         command += "-no-pie ";
 #endif
-        command += QuoteForShell(object_path) + " -o " + QuoteForShell(executable_path);
+        command += quoted_objects + "-o " + QuoteForShell(executable_path);
     }
 
     if (verbose) {
@@ -0,0 +1,336 @@
+#include "llvm_backend_internal.hpp"
+
+#ifdef CLOT_HAS_LLVM
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/Support/SHA256.h>
+
+#ifndef CLOT_VERSION
+#define CLOT_VERSION "dev"
+#endif
+
+namespace clot::codegen::internal {
+
+namespace {
+
+// Bump when the emitter changes the code it produces for an unchanged AST, so
+// objects built by an older clot are never reused.
+constexpr const char* kObjectCacheFormat = "clot-object-cache-v1";
+
+// Length-prefixed serialization of the AOT subset. Two ASTs that lower to
+// different IR must never produce the same text, so every field read by the
+// emitter is written, and any node outside the subset makes the partition
+// uncacheable instead of guessing.
+class FingerprintWriter {
+  public:
+    void Tag(char tag) {
+        text_.push_back(tag);
+    }
+
+    void Text(const std::string& value) {
+        text_ += std::to_string(value.size());
+        text_.push_back(':');
+        text_ += value;
+    }
+
+    void Integer(long long value) {
+        text_ += std::to_string(value);
+        text_.push_back(';');
+    }
+
+    const std::string& str() const {
+        return text_;
+    }
+
+  private:
+    std::string text_;
+};
+
+void WriteAnnotation(const frontend::TypeAnnotation& annotation, FingerprintWriter* writer) {
+    writer->Tag('T');
+    writer->Integer(static_cast<long long>(annotation.base));
+    writer->Text(annotation.custom_name);
+    writer->Integer(static_cast<long long>(annotation.type_args.size()));
+    for (const auto& argument : annotation.type_args) {
+        WriteAnnotation(argument, writer);
+    }
+}
+
+bool WriteStatement(const frontend::Statement* statement, FingerprintWriter* writer);
+
+bool WriteExpr(const frontend::Expr* expression, FingerprintWriter* writer) {
+    if (expression == nullptr) {
+        writer->Tag('z');
+        return true;
+    }
+
+    if (const auto* number = dynamic_cast<const frontend::NumberExpr*>(expression)) {
+        std::uint64_t bits = 0;
+        std::memcpy(&bits, &number->value, sizeof(bits));
+        writer->Tag('n');
+        writer->Text(number->lexeme);
+        writer->Integer(number->is_integer_literal ? 1 : 0);
+        writer->Text(std::to_string(bits));
+        return true;
+    }
+
+    if (const auto* string_expr = dynamic_cast<const frontend::StringExpr*>(expression)) {
+        writer->Tag('s');
+        writer->Text(string_expr->value);
+        return true;
+    }
+
+    if (const auto* boolean = dynamic_cast<const frontend::BoolExpr*>(expression)) {
+        writer->Tag('b');
+        writer->Integer(boolean->value ? 1 : 0);
+        return true;
+    }
+
+    if (const auto* variable = dynamic_cast<const frontend::VariableExpr*>(expression)) {
+        writer->Tag('v');
+        writer->Text(variable->name);
+        return true;
+    }
+
+    if (const auto* list = dynamic_cast<const frontend::ListExpr*>(expression)) {
+        writer->Tag('l');
+        writer->Integer(static_cast<long long>(list->elements.size()));
+        for (const auto& element : list->elements) {
+            if (!WriteExpr(element.get(), writer)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    if (const auto* index = dynamic_cast<const frontend::IndexExpr*>(expression)) {
+        writer->Tag('i');
+        return WriteExpr(index->collection.get(), writer) && WriteExpr(index->index.get(), writer);
+    }
+
+    if (const auto* call = dynamic_cast<const frontend::CallExpr*>(expression)) {
+        writer->Tag('c');
+        writer->Text(call->callee);
+        writer->Integer(static_cast<long long>(call->arguments.size()));
+        for (const auto& argument : call->arguments) {
+            writer->Integer(argument.by_reference ? 1 : 0);
+            if (!WriteExpr(argument.value.get(), writer)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    if (const auto* unary = dynamic_cast<const frontend::UnaryExpr*>(expression)) {
+        writer->Tag('u');
+        writer->Integer(static_cast<long long>(unary->op));
+        return WriteExpr(unary->operand.get(), writer);
+    }
+
+    if (const auto* binary = dynamic_cast<const frontend::BinaryExpr*>(expression)) {
+        writer->Tag('x');
+        writer->Integer(static_cast<long long>(binary->op));
+        return WriteExpr(binary->lhs.get(), writer) && WriteExpr(binary->rhs.get(), writer);
+    }
+
+    return false;
+}
+
+bool WriteBlock(const std::vector<std::unique_ptr<frontend::Statement>>& block, FingerprintWriter* writer) {
+    writer->Tag('[');
+    writer->Integer(static_cast<long long>(block.size()));
+    for (const auto& statement : block) {
+        if (!WriteStatement(statement.get(), writer)) {
+            return false;
+        }
+    }
+    writer->Tag(']');
+    return true;
+}
+
+bool WriteFunctionSignature(const frontend::FunctionDeclStmt& function, FingerprintWriter* writer) {
+    writer->Tag('F');
+    writer->Text(function.name);
+    writer->Integer(static_cast<long long>(function.return_type));
+    WriteAnnotation(function.return_annotation, writer);
+    writer->Integer(static_cast<long long>(function.params.size()));
+    for (const auto& param : function.params) {
+        writer->Text(param.name);
+        writer->Integer(param.by_reference ? 1 : 0);
+        writer->Integer(static_cast<long long>(param.type_hint));
+        WriteAnnotation(param.type_annotation, writer);
+        if (!WriteExpr(param.default_value.get(), writer)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool WriteStatement(const frontend::Statement* statement, FingerprintWriter* writer) {
+    if (statement == nullptr) {
+        writer->Tag('Z');
+        return true;
+    }
+
+    if (const auto* assignment = dynamic_cast<const frontend::AssignmentStmt*>(statement)) {
+        writer->Tag('A');
+        writer->Text(assignment->name);
+        writer->Integer(static_cast<long long>(assignment->op));
+        writer->Integer(static_cast<long long>(assignment->declaration_type));
+        writer->Integer(assignment->is_const ? 1 : 0);
+        WriteAnnotation(assignment->type_annotation, writer);
+        return WriteExpr(assignment->expr.get(), writer);
+    }
+
+    if (const auto* print = dynamic_cast<const frontend::PrintStmt*>(statement)) {
+        writer->Tag('P');
+        writer->Integer(print->append_newline ? 1 : 0);
+        return WriteExpr(print->expr.get(), writer);
+    }
+
+    if (const auto* conditional = dynamic_cast<const frontend::IfStmt*>(statement)) {
+        writer->Tag('I');
+        return WriteExpr(conditional->condition.get(), writer) && WriteBlock(conditional->then_branch, writer) &&
+               WriteBlock(conditional->else_branch, writer);
+    }
+
+    if (const auto* while_stmt = dynamic_cast<const frontend::WhileStmt*>(statement)) {
+        writer->Tag('W');
+        return WriteExpr(while_stmt->condition.get(), writer) && WriteBlock(while_stmt->body, writer);
+    }
+
+    if (const auto* for_stmt = dynamic_cast<const frontend::ForStmt*>(statement)) {
+        writer->Tag('R');
+        return WriteStatement(for_stmt->initializer.get(), writer) && WriteExpr(for_stmt->condition.get(), writer) &&
+               WriteStatement(for_stmt->update.get(), writer) && WriteBlock(for_stmt->body, writer);
+    }
+
+    if (const auto* for_each = dynamic_cast<const frontend::ForEachStmt*>(statement)) {
+        writer->Tag('E');
+        writer->Text(for_each->variable_name);
+        writer->Integer(static_cast<long long>(for_each->variable_type));
+        writer->Integer(for_each->variable_is_const ? 1 : 0);
+        WriteAnnotation(for_each->variable_annotation, writer);
+        return WriteExpr(for_each->collection.get(), writer) && WriteBlock(for_each->body, writer);
+    }
+
+    if (const auto* mutation = dynamic_cast<const frontend::MutationStmt*>(statement)) {
+        writer->Tag('M');
+        writer->Integer(static_cast<long long>(mutation->op));
+        return WriteExpr(mutation->target.get(), writer) && WriteExpr(mutation->expr.get(), writer);
+    }
+
+    if (const auto* import_stmt = dynamic_cast<const frontend::ImportStmt*>(statement)) {
+        writer->Tag('U');
+        writer->Integer(static_cast<long long>(import_stmt->style));
+        writer->Text(import_stmt->module_name);
+        writer->Text(import_stmt->alias_name);
+        writer->Text(import_stmt->imported_symbol);
+        writer->Text(import_stmt->imported_alias);
+        return true;
+    }
+
+    if (const auto* expression_stmt = dynamic_cast<const frontend::ExpressionStmt*>(statement)) {
+        writer->Tag('X');
+        return WriteExpr(expression_stmt->expr.get(), writer);
+    }
+
+    if (const auto* function_decl = dynamic_cast<const frontend::FunctionDeclStmt*>(statement)) {
+        return WriteFunctionSignature(*function_decl, writer) && WriteBlock(function_decl->body, writer);
+    }
+
+    return false;
+}
+
+// SHA-256, so two fingerprints that differ can never be made to share a key
+// and pull a stale object out of a shared cache directory.
+std::string HashToKey(const std::string& text) {
+    const auto digest = llvm::SHA256::hash(
+        llvm::ArrayRef<std::uint8_t>(reinterpret_cast<const std::uint8_t*>(text.data()), text.size()));
+    return llvm::toHex(digest, /*LowerCase=*/true);
+}
+
+}  // namespace
+
+std::vector<CodegenPartition> PlanCodegenPartitions(const frontend::Program& program,
+                                                    const CompileOptions& options,
+                                                    const std::string& target_triple) {
+    // Every partition declares all user functions and emits calls against their
+    // signatures, so the signature table is part of every key. Changing one body
+    // only invalidates that function's object; changing a signature or the math
+    // import invalidates all of them.
+    FingerprintWriter shared;
+    shared.Text(kObjectCacheFormat);
+    shared.Text(CLOT_VERSION);
+    shared.Text(LLVM_VERSION_STRING);
+    shared.Text(target_triple);
+    shared.Integer(options.instrument ? 1 : 0);
+
+    // A new profile changes the optimized code of every partition.
+    bool shared_ok = true;
+    if (!options.profile_use_path.empty()) {
+        std::ifstream profile(options.profile_use_path, std::ios::binary);
+        const std::string profile_bytes((std::istreambuf_iterator<char>(profile)), std::istreambuf_iterator<char>());
+        shared_ok = profile.is_open();
+        shared.Text(HashToKey(profile_bytes));
+    }
+
+    bool math_imported = false;
+    std::vector<const frontend::FunctionDeclStmt*> functions;
+    for (const auto& statement : program.statements) {
+        if (statement != nullptr && ContainsMathImportInStatement(*statement)) {
+            math_imported = true;
+        }
+        if (const auto* function_decl = dynamic_cast<const frontend::FunctionDeclStmt*>(statement.get())) {
+            functions.push_back(function_decl);
+            shared_ok = WriteFunctionSignature(*function_decl, &shared) && shared_ok;
+        }
+    }
+    shared.Integer(math_imported ? 1 : 0);
+
+    std::vector<CodegenPartition> partitions;
+    partitions.reserve(functions.size() + 1);
+
+    for (const frontend::FunctionDeclStmt* function_decl : functions) {
+        FingerprintWriter writer;
+        writer.Tag('f');
+        CodegenPartition partition;
+        partition.function_name = function_decl->name;
+        if (shared_ok && WriteStatement(function_decl, &writer)) {
+            partition.cache_key = HashToKey(shared.str() + writer.str());
+        }
+        partitions.push_back(std::move(partition));
+    }
+
+    FingerprintWriter main_writer;
+    main_writer.Tag('m');
+    bool main_ok = shared_ok;
+    for (const auto& statement : program.statements) {
+        if (dynamic_cast<const frontend::FunctionDeclStmt*>(statement.get()) != nullptr) {
+            continue;
+        }
+        if (!WriteStatement(statement.get(), &main_writer)) {
+            main_ok = false;
+            break;
+        }
+    }
+
+    CodegenPartition main_partition;
+    if (main_ok) {
+        main_partition.cache_key = HashToKey(shared.str() + main_writer.str());
+    }
+    partitions.push_back(std::move(main_partition));
+    return partitions;
+}
+
+}  // namespace clot::codegen::internal
+
+#endif  // CLOT_HAS_LLVM
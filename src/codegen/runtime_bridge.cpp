@@ -8,6 +8,7 @@
 #include "clot/interpreter/interpreter.hpp"
 #include "clot/runtime/env.hpp"
 #include "clot/runtime/i18n.hpp"
+#include "clot/runtime/output.hpp"
 
 namespace {
 
@@ -31,6 +32,17 @@ extern "C" int clot_runtime_execute_source(const char* source_text, const char*
         }
     }
 
+    clot::runtime::OutputBuffering buffering = clot::runtime::OutputBuffering::Auto;
+    if (const auto env_buffering = clot::runtime::GetEnvVar("CLOT_OUTPUT_BUFFERING"); env_buffering) {
+        if (!clot::runtime::ParseOutputBuffering(*env_buffering, &buffering)) {
+            std::cerr << clot::runtime::TranslateDiagnostic(
+                             "Error: CLOT_OUTPUT_BUFFERING invalido (use auto, line, block o none): " + *env_buffering)
+                      << "\n";
+            return 1;
+        }
+    }
+    clot::runtime::ConfigureStdout(buffering);
+
     std::vector<std::string> lines;
     std::istringstream stream(source_text);
     std::string line;
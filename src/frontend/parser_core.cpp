@@ -56,6 +56,26 @@ bool Parser::ParseBlock(
 }
 
 bool Parser::ParseStatement(
+    std::size_t* line_index,
+    const std::vector<Token>& tokens,
+    std::vector<std::unique_ptr<Statement>>* out_statements,
+    Diagnostic* out_error) const {
+    const std::size_t first_line = *line_index + 1;
+    const std::size_t first_new = out_statements->size();
+    if (!ParseStatementKind(line_index, tokens, out_statements, out_error)) {
+        return false;
+    }
+
+    // Nested statements were stamped by their own ParseStatement call.
+    for (std::size_t i = first_new; i < out_statements->size(); ++i) {
+        if ((*out_statements)[i] != nullptr && (*out_statements)[i]->line == 0) {
+            (*out_statements)[i]->line = first_line;
+        }
+    }
+    return true;
+}
+
+bool Parser::ParseStatementKind(
     std::size_t* line_index,
     const std::vector<Token>& tokens,
     std::vector<std::unique_ptr<Statement>>* out_statements,
@@ -553,31 +553,18 @@ private:
         return true;
     }
 
-    static void AppendInterpolatedPiece(std::unique_ptr<Expr>* accumulator, std::unique_ptr<Expr> piece) {
-        if (accumulator == nullptr || piece == nullptr) {
-            return;
-        }
-
-        if (*accumulator == nullptr) {
-            *accumulator = std::move(piece);
-            return;
-        }
-
-        *accumulator = std::make_unique<BinaryExpr>(
-            BinaryOp::Add,
-            std::move(*accumulator),
-            std::move(piece));
-    }
-
-    // Parses an f-string literal, desugaring `{expr}` placeholders into string
-    // concatenation. Literal braces are written `{{` and `}}`.
+    // Parses an f-string literal into an InterpolatedStringExpr whose parts are
+    // the literal segments and the `{expr}` placeholders, in source order, so
+    // the interpreter can render it in one pass. Literal braces are written
+    // `{{` and `}}`.
     std::unique_ptr<Expr> ParseFString(const Token& token) {
         const std::string& raw_text = token.lexeme;
         if (raw_text.find('{') == std::string::npos && raw_text.find('}') == std::string::npos) {
             return std::make_unique<StringExpr>(raw_text);
         }
 
-        std::unique_ptr<Expr> expression;
+        std::vector<std::unique_ptr<Expr>> parts;
+        bool has_placeholder = false;
         std::string pending_text;
         std::size_t cursor = 0;
 
@@ -585,7 +572,7 @@ private:
             if (pending_text.empty()) {
                 return;
             }
-            AppendInterpolatedPiece(&expression, std::make_unique<StringExpr>(pending_text));
+            parts.push_back(std::make_unique<StringExpr>(pending_text));
             pending_text.clear();
         };
 
@@ -691,10 +678,8 @@ private:
                     return nullptr;
                 }
 
-                if (expression == nullptr) {
-                    expression = std::make_unique<StringExpr>("");
-                }
-                AppendInterpolatedPiece(&expression, std::move(interpolation_expression));
+                parts.push_back(std::move(interpolation_expression));
+                has_placeholder = true;
                 cursor = expression_cursor + 1;
                 continue;
             }
@@ -708,12 +693,13 @@ private:
             ++cursor;
         }
 
-        flush_pending_text();
-        if (expression == nullptr) {
-            return std::make_unique<StringExpr>(raw_text);
+        if (!has_placeholder) {
+            // Only escaped braces: the literal is a plain string.
+            return std::make_unique<StringExpr>(std::move(pending_text));
         }
 
-        return expression;
+        flush_pending_text();
+        return std::make_unique<InterpolatedStringExpr>(std::move(parts));
     }
 
     bool IsAtEnd() const {
@@ -2368,6 +2368,7 @@ bool Parser::ParseFor(std::size_t* line_index, const std::vector<Token>& tokens,
                 "for init/update solo permite declaraciones, mutaciones o expresiones simples.");
             return false;
         }
+        parsed[0]->line = header_line;
         *out_statement = std::move(parsed[0]);
         return true;
     };
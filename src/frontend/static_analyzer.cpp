@@ -449,6 +449,13 @@ private:
             return ExpressionFacts{TypeHint::String, false, 0.0};
         }
 
+        if (const auto* interpolated = dynamic_cast<const InterpolatedStringExpr*>(&expression)) {
+            for (const auto& part : interpolated->parts) {
+                InferExpression(*part, statement_id, symbols);
+            }
+            return ExpressionFacts{TypeHint::String, false, 0.0};
+        }
+
         if (const auto* boolean = dynamic_cast<const BoolExpr*>(&expression)) {
             return ExpressionFacts{
                 TypeHint::Bool,
@@ -882,6 +889,20 @@ private:
             return ExpressionFacts{TypeHint::Number, false, 0.0};
         }
 
+        if (call.callee == "now_ns" || call.callee == "cpu_time_ns") {
+            if (!call.arguments.empty()) {
+                AddError(statement_id, call.callee + "() no acepta argumentos.");
+            }
+            return ExpressionFacts{TypeHint::Number, false, 0.0};
+        }
+
+        if (call.callee == "bench") {
+            if (call.arguments.size() != 2 && call.arguments.size() != 3) {
+                AddError(statement_id, "bench(fn, iterations) requiere 2 o 3 argumentos.");
+            }
+            return ExpressionFacts{TypeHint::Unknown, false, 0.0};
+        }
+
         if (call.callee == "sleep_ms") {
             if (call.arguments.size() != 1) {
                 AddError(statement_id, "sleep_ms(ms) requiere 1 argumento.");
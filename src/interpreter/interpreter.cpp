@@ -4,16 +4,19 @@
 #include <chrono>
 #include <cctype>
 #include <cmath>
+#include <cstdio>
 #include <filesystem>
 #include <fstream>
 #include <functional>
 #include <iomanip>
-#include <iostream>
 #include <limits>
 #include <sstream>
 #include <thread>
 
+#include "clot/runtime/counters.hpp"
 #include "clot/runtime/i18n.hpp"
+#include "clot/runtime/output.hpp"
+#include "clot/runtime/profiler.hpp"
 
 namespace clot::interpreter {
 
@@ -21,6 +24,13 @@ namespace {
 
 using BigInt = runtime::Value::BigInt;
 
+// Calls, getters and setters copy the whole environment twice: once to
+// restore the caller and once as the callee's scope.
+void CountEnvironmentCopies(std::size_t slots) {
+    runtime::CountEvent(runtime::Counter::EnvironmentCopies, 2);
+    runtime::CountEvent(runtime::Counter::EnvironmentSlotsCopied, 2 * slots);
+}
+
 bool ReadNumeric(const runtime::Value& value, double* out_number, std::string* out_error) {
     bool ok = false;
     const double numeric = value.AsNumber(&ok);
@@ -254,12 +264,147 @@ frontend::TypeHint DeclarationTypeToTypeHint(frontend::DeclarationType declarati
     }
 }
 
+bool IsSideEffectFreeExpr(const frontend::Expr& expression) {
+    if (dynamic_cast<const frontend::NumberExpr*>(&expression) != nullptr ||
+        dynamic_cast<const frontend::BoolExpr*>(&expression) != nullptr ||
+        dynamic_cast<const frontend::StringExpr*>(&expression) != nullptr ||
+        dynamic_cast<const frontend::CharExpr*>(&expression) != nullptr ||
+        dynamic_cast<const frontend::NullExpr*>(&expression) != nullptr) {
+        return true;
+    }
+
+    if (const auto* variable = dynamic_cast<const frontend::VariableExpr*>(&expression)) {
+        // Dotted names may dispatch to class getters.
+        return variable->name.find('.') == std::string::npos;
+    }
+
+    if (const auto* unary = dynamic_cast<const frontend::UnaryExpr*>(&expression)) {
+        return unary->operand != nullptr && IsSideEffectFreeExpr(*unary->operand);
+    }
+
+    if (const auto* binary = dynamic_cast<const frontend::BinaryExpr*>(&expression)) {
+        return binary->lhs != nullptr && binary->rhs != nullptr && IsSideEffectFreeExpr(*binary->lhs) &&
+               IsSideEffectFreeExpr(*binary->rhs);
+    }
+
+    if (const auto* interpolated = dynamic_cast<const frontend::InterpolatedStringExpr*>(&expression)) {
+        for (const auto& part : interpolated->parts) {
+            if (part == nullptr || !IsSideEffectFreeExpr(*part)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    return false;
+}
+
 } // namespace
 
 void Interpreter::SetEntryFilePath(const std::string& file_path) {
     entry_file_path_ = std::filesystem::path(file_path);
 }
 
+void Interpreter::SetNativeCompileHook(NativeCompileHook hook, const TierUpPolicy& policy, NativeCompileLog log) {
+    native_compile_hook_ = std::move(hook);
+    native_compile_log_ = std::move(log);
+    tier_up_policy_ = policy;
+}
+
+void Interpreter::SetProfiler(runtime::Profiler* profiler) {
+    profiler_ = profiler;
+}
+
+void Interpreter::SetModuleCache(ModuleCache* cache) {
+    module_cache_ = cache;
+}
+
+Interpreter::TierStats Interpreter::CollectTierStats() const {
+    TierStats stats;
+    stats.profiled_functions = function_profiles_.size();
+    for (const auto& [declaration, profile] : function_profiles_) {
+        (void)declaration;
+        if (profile.tier == FunctionTier::Native) {
+            ++stats.native_functions;
+        }
+    }
+
+    stats.profiled_loops = loop_back_edges_.size();
+    for (const auto& [loop, back_edges] : loop_back_edges_) {
+        (void)loop;
+        stats.max_loop_back_edges = std::max(stats.max_loop_back_edges, back_edges);
+    }
+    return stats;
+}
+
+void Interpreter::FinishNativeCompiles() {
+    for (auto& [declaration, profile] : function_profiles_) {
+        (void)declaration;
+        if (profile.tier == FunctionTier::Compiling) {
+            (void)InstallNativeEntry(&profile, profile.pending_entry.get());
+        }
+    }
+}
+
+Interpreter::NativeFunctionEntry Interpreter::TierUpFunction(FunctionProfile* profile) {
+    switch (profile->tier) {
+    case FunctionTier::Native:
+        return profile->native_entry;
+    case FunctionTier::Rejected:
+        return nullptr;
+    case FunctionTier::Compiling:
+        if (profile->pending_entry.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            return nullptr;
+        }
+        return InstallNativeEntry(profile, profile->pending_entry.get());
+    case FunctionTier::Interpreted:
+        break;
+    }
+
+    if (profile->calls <= tier_up_policy_.call_threshold && profile->back_edges <= tier_up_policy_.back_edge_threshold) {
+        return nullptr;
+    }
+
+    const bool math_module_imported = imported_modules_.count("math") > 0;
+    if (!tier_up_policy_.background_compile) {
+        return InstallNativeEntry(profile, native_compile_hook_(*profile->declaration, math_module_imported));
+    }
+
+    // The AST outlives the interpreter run, so the compile thread can read it
+    // while this thread keeps interpreting; the entry is swapped in on a later call.
+    profile->pending_entry =
+        std::async(std::launch::async, native_compile_hook_, std::cref(*profile->declaration), math_module_imported);
+    profile->tier = FunctionTier::Compiling;
+    return nullptr;
+}
+
+Interpreter::NativeFunctionEntry Interpreter::InstallNativeEntry(FunctionProfile* profile, NativeCompileResult result) {
+    profile->native_entry = result.entry;
+    profile->tier = result.entry != nullptr ? FunctionTier::Native : FunctionTier::Rejected;
+    if (!result.note.empty() && native_compile_log_) {
+        native_compile_log_(result.note);
+    }
+    return profile->native_entry;
+}
+
+void Interpreter::NoteLoopBackEdge(const frontend::Statement& loop) {
+    if (!native_compile_hook_) {
+        return;
+    }
+
+    ++loop_back_edges_[&loop];
+    if (active_function_profiles_.empty()) {
+        return;
+    }
+
+    FunctionProfile* profile = active_function_profiles_.back();
+    ++profile->back_edges;
+    if (profile->tier == FunctionTier::Interpreted && profile->back_edges > tier_up_policy_.back_edge_threshold) {
+        // Start compiling while the loop keeps running so the next call is native.
+        (void)TierUpFunction(profile);
+    }
+}
+
 bool Interpreter::Execute(const frontend::Program& program, std::string* out_error) {
     environment_.clear();
     functions_.clear();
@@ -286,6 +431,16 @@ bool Interpreter::Execute(const frontend::Program& program, std::string* out_err
     next_async_task_id_ = 1;
     value_identity_cache_.clear();
     next_value_identity_id_ = 1;
+    function_profiles_.clear();
+    loop_back_edges_.clear();
+    active_function_profiles_.clear();
+    entry_program_ = &program;
+    if (resource_limits_enabled_) {
+        StartResourceBudget();
+    }
+    if (snapshot_ != nullptr) {
+        RestoreSnapshot();
+    }
 
     if (!entry_file_path_.empty()) {
         module_base_dirs_.push_back(entry_file_path_.parent_path());
@@ -315,23 +470,7 @@ bool Interpreter::Execute(const frontend::Program& program, std::string* out_err
     }
 
     if (!top_level_ok) {
-        if (pending_exception_.has_value()) {
-            RuntimeExceptionRecord uncaught = *pending_exception_;
-            pending_exception_.reset();
-
-            if (out_error != nullptr) {
-                std::string type_name = uncaught.type_name.empty() ? "RuntimeError" : uncaught.type_name;
-                std::string message = uncaught.message;
-                if (message.empty() && !out_error->empty()) {
-                    message = *out_error;
-                }
-                if (message.empty()) {
-                    message = "Exception lanzada.";
-                }
-
-                *out_error = "Excepcion no capturada: " + type_name + ": " + message;
-            }
-        }
+        ReportUncaughtException(out_error);
         return false;
     }
 
@@ -343,8 +482,57 @@ bool Interpreter::Execute(const frontend::Program& program, std::string* out_err
     return true;
 }
 
+void Interpreter::ReportUncaughtException(std::string* out_error) {
+    if (!pending_exception_.has_value()) {
+        return;
+    }
+    RuntimeExceptionRecord uncaught = *pending_exception_;
+    pending_exception_.reset();
+
+    if (out_error != nullptr) {
+        std::string type_name = uncaught.type_name.empty() ? "RuntimeError" : uncaught.type_name;
+        std::string message = uncaught.message;
+        if (message.empty() && !out_error->empty()) {
+            message = *out_error;
+        }
+        if (message.empty()) {
+            message = "Exception lanzada.";
+        }
+
+        *out_error = "Excepcion no capturada: " + type_name + ": " + message;
+    }
+}
+
+void Interpreter::RegisterNativeBuiltin(const std::string& name, NativeBuiltin builtin) {
+    native_builtins_[name] = std::move(builtin);
+}
+
+bool Interpreter::CallFunction(const std::string& name,
+                               const std::vector<runtime::Value>& arguments,
+                               runtime::Value* out_value,
+                               std::string* out_error) {
+    if (resource_limits_enabled_) {
+        StartResourceBudget();
+    }
+    runtime::Value result;
+    if (!InvokeFunctionValue(runtime::Value(runtime::Value::FunctionRef{name}), arguments, &result, out_error, false)) {
+        ReportUncaughtException(out_error);
+        return false;
+    }
+    *out_value = std::move(result);
+    return true;
+}
+
 bool Interpreter::ExecuteBlock(const std::vector<std::unique_ptr<frontend::Statement>>& statements,
                                std::string* out_error) {
+    // An empty loop body runs no statements, so each pass counts as one; without
+    // this `while true: endwhile` would never reach the statement limit.
+    if (resource_limits_enabled_ && statements.empty()) {
+        ++statements_executed_;
+        if (!CheckResourceLimits(out_error)) {
+            return false;
+        }
+    }
     defer_stack_.push_back({});
     bool ok = true;
 
@@ -393,6 +581,14 @@ bool Interpreter::ExecuteDeferredStatementsForCurrentBlock(std::string* out_erro
 }
 
 bool Interpreter::ExecuteStatement(const frontend::Statement& statement, std::string* out_error) {
+    runtime::CountEvent(runtime::Counter::StatementDispatches);
+    if (resource_limits_enabled_) {
+        ++statements_executed_;
+        if (!CheckResourceLimits(out_error)) {
+            return false;
+        }
+    }
+    const runtime::ProfileLineScope profile_line(profiler_, statement.line);
     if (const auto* assignment = dynamic_cast<const frontend::AssignmentStmt*>(&statement)) {
         runtime::Value value;
         bool has_value = false;
@@ -446,13 +642,11 @@ bool Interpreter::ExecuteStatement(const frontend::Statement& statement, std::st
             if (!EvaluateExpression(*print->expr, &value, out_error)) {
                 return false;
             }
-            std::cout << value.ToString();
+            runtime::WriteStdout(value.ToString());
         }
 
         if (print->append_newline) {
-            std::cout << std::endl;
-        } else {
-            std::cout << std::flush;
+            runtime::EndStdoutLine();
         }
         return true;
     }
@@ -473,6 +667,7 @@ bool Interpreter::ExecuteStatement(const frontend::Statement& statement, std::st
                 --loop_depth_;
                 return false;
             }
+            NoteLoopBackEdge(*while_stmt);
 
             if (break_signal_) {
                 break_signal_ = false;
@@ -1282,6 +1477,7 @@ bool Interpreter::ExecuteClassSetter(runtime::Value* instance,
         }
     }
 
+    CountEnvironmentCopies(environment_.size());
     auto caller_environment = environment_;
     auto local_environment = environment_;
     local_environment["this"] = runtime::VariableSlot{*instance, runtime::VariableKind::Dynamic};
@@ -1338,6 +1534,7 @@ bool Interpreter::TryExecuteClassGetter(runtime::Value* instance,
         return false;
     }
 
+    CountEnvironmentCopies(environment_.size());
     auto caller_environment = environment_;
     auto local_environment = environment_;
     local_environment["this"] = runtime::VariableSlot{*instance, runtime::VariableKind::Dynamic};
@@ -1441,9 +1638,17 @@ bool Interpreter::CollectForEachElements(const runtime::Value& collection,
         }
         return true;
     }
+    if (const auto* array = collection.AsNdArray()) {
+        const std::size_t count = array->Rank() == 0 ? 0 : array->Shape()[0];
+        out_elements->reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            out_elements->push_back(NdArrayItem(*array, i));
+        }
+        return true;
+    }
 
     if (out_error != nullptr) {
-        *out_error = "for-each requiere list, tuple, set, map, object, string o range.";
+        *out_error = "for-each requiere list, tuple, set, map, object, string, range o ndarray.";
     }
     return false;
 }
@@ -1472,6 +1677,7 @@ bool Interpreter::ExecuteFor(const frontend::ForStmt& statement, std::string* ou
             --loop_depth_;
             return false;
         }
+        NoteLoopBackEdge(statement);
 
         if (break_signal_) {
             break_signal_ = false;
@@ -1612,6 +1818,7 @@ bool Interpreter::ExecuteForEach(const frontend::ForEachStmt& statement, std::st
         if (!ExecuteBlock(statement.body, out_error)) {
             return false;
         }
+        NoteLoopBackEdge(statement);
 
         if (break_signal_) {
             break_signal_ = false;
@@ -1669,6 +1876,7 @@ bool Interpreter::ExecuteDoWhile(const frontend::DoWhileStmt& statement, std::st
             --loop_depth_;
             return false;
         }
+        NoteLoopBackEdge(statement);
 
         if (break_signal_) {
             break_signal_ = false;
@@ -1785,6 +1993,19 @@ std::string Interpreter::InferRuntimeExceptionTypeName(const std::string& runtim
         return static_cast<char>(std::tolower(ch));
     });
 
+    // First, so a limit hit inside an import or call keeps its type.
+    if (lowered.find("limite de memoria") != std::string::npos ||
+        lowered.find("memory limit") != std::string::npos) {
+        return "MemoryError";
+    }
+    if (lowered.find("limite de tiempo") != std::string::npos ||
+        lowered.find("time limit") != std::string::npos) {
+        return "TimeoutError";
+    }
+    if (lowered.find("limite de instrucciones") != std::string::npos ||
+        lowered.find("instruction limit") != std::string::npos) {
+        return "InstructionLimitError";
+    }
     if (lowered.find("assert") != std::string::npos) {
         return "AssertionError";
     }
@@ -1937,6 +2158,14 @@ bool Interpreter::ExceptionMatchesCatchType(const RuntimeExceptionRecord& except
         if (type_name == "IOError") {
             return "RuntimeError";
         }
+        if (type_name == "MemoryError" ||
+            type_name == "TimeoutError" ||
+            type_name == "InstructionLimitError") {
+            return "ResourceLimitError";
+        }
+        if (type_name == "ResourceLimitError") {
+            return "RuntimeError";
+        }
         if (type_name == "ModuleNotFoundError") {
             return "ImportError";
         }
@@ -2067,6 +2296,7 @@ bool Interpreter::ExecuteTryCatch(const frontend::TryCatchStmt& statement, std::
 
 bool Interpreter::EvaluateExpression(const frontend::Expr& expression, runtime::Value* out_value,
                                      std::string* out_error) {
+    runtime::CountEvent(runtime::Counter::ExpressionDispatches);
     if (const auto* number = dynamic_cast<const frontend::NumberExpr*>(&expression)) {
         if (number->is_integer_literal) {
             runtime::Value::BigInt integer;
@@ -2086,6 +2316,39 @@ bool Interpreter::EvaluateExpression(const frontend::Expr& expression, runtime::
         return true;
     }
 
+    if (const auto* interpolated = dynamic_cast<const frontend::InterpolatedStringExpr*>(&expression)) {
+        // Evaluate every placeholder first so the result is sized once and
+        // each part is appended without intermediate strings.
+        std::vector<runtime::Value> rendered;
+        rendered.reserve(interpolated->parts.size());
+        std::size_t capacity = 0;
+        for (const auto& part : interpolated->parts) {
+            if (const auto* literal = dynamic_cast<const frontend::StringExpr*>(part.get())) {
+                capacity += literal->value.size();
+                continue;
+            }
+            runtime::Value value;
+            if (!EvaluateExpression(*part, &value, out_error)) {
+                return false;
+            }
+            capacity += value.EstimatedTextSize();
+            rendered.push_back(std::move(value));
+        }
+
+        std::string text;
+        text.reserve(capacity);
+        std::size_t next_value = 0;
+        for (const auto& part : interpolated->parts) {
+            if (const auto* literal = dynamic_cast<const frontend::StringExpr*>(part.get())) {
+                text += literal->value;
+            } else {
+                rendered[next_value++].AppendTo(&text);
+            }
+        }
+        *out_value = runtime::Value(std::move(text));
+        return true;
+    }
+
     if (const auto* boolean = dynamic_cast<const frontend::BoolExpr*>(&expression)) {
         *out_value = runtime::Value(boolean->value);
         return true;
@@ -2192,6 +2455,25 @@ bool Interpreter::EvaluateExpression(const frontend::Expr& expression, runtime::
             return true;
         }
 
+        if (const auto* array = collection.AsNdArray()) {
+            std::size_t integer_index = 0;
+            if (!ReadListIndex(index_value, &integer_index, out_error)) {
+                return false;
+            }
+
+            if (array->Rank() == 0 || integer_index >= array->Shape()[0]) {
+                *out_error = "Indice fuera de rango en ndarray.";
+                return false;
+            }
+
+            *out_value = NdArrayItem(*array, integer_index);
+            return true;
+        }
+
+        if (const auto* dual = collection.AsDual()) {
+            return ReadDualMember(*dual, index_value, out_value, out_error);
+        }
+
         if (const auto* map = collection.AsMap()) {
             for (const auto& entry : *map) {
                 if (entry.first.Equals(index_value)) {
@@ -2246,7 +2528,7 @@ bool Interpreter::EvaluateExpression(const frontend::Expr& expression, runtime::
             return false;
         }
 
-        *out_error = "Solo se puede indexar list, tuple, range, map u object con [].";
+        *out_error = "Solo se puede indexar list, tuple, range, ndarray, map u object con [].";
         return false;
     }
 
@@ -2288,6 +2570,16 @@ bool Interpreter::EvaluateUnary(frontend::UnaryOp op, const runtime::Value& oper
         return true;
     }
 
+    if (const auto* array = operand.AsNdArray()) {
+        *out_value = runtime::Value(op == frontend::UnaryOp::Negate ? runtime::NdNegate(*array) : *array);
+        return true;
+    }
+
+    if (const auto* dual = operand.AsDual()) {
+        *out_value = runtime::Value(op == frontend::UnaryOp::Negate ? runtime::DualNegate(*dual) : *dual);
+        return true;
+    }
+
     BigInt integer;
     if (operand.AsBigInt(&integer)) {
         if (op == frontend::UnaryOp::Negate) {
@@ -2336,6 +2628,17 @@ bool Interpreter::EvaluateBinary(frontend::BinaryOp op, const runtime::Value& lh
         return true;
     }
 
+    if ((lhs.IsNdArray() || rhs.IsNdArray()) &&
+        (op == frontend::BinaryOp::Add || op == frontend::BinaryOp::Subtract || op == frontend::BinaryOp::Multiply ||
+         op == frontend::BinaryOp::Divide || op == frontend::BinaryOp::Modulo || op == frontend::BinaryOp::Power)) {
+        return EvaluateNdArrayBinary(op, lhs, rhs, out_value, out_error);
+    }
+
+    if ((lhs.IsDual() || rhs.IsDual()) && op != frontend::BinaryOp::In && op != frontend::BinaryOp::LogicalAnd &&
+        op != frontend::BinaryOp::LogicalOr) {
+        return EvaluateDualBinary(op, lhs, rhs, out_value, out_error);
+    }
+
     if (op == frontend::BinaryOp::Multiply) {
         const runtime::Value::List* lhs_list = lhs.AsList();
         const runtime::Value::List* rhs_list = rhs.AsList();
@@ -2366,7 +2669,15 @@ bool Interpreter::EvaluateBinary(frontend::BinaryOp op, const runtime::Value& lh
                 *out_error = "La repeticion de listas excede el tamano maximo permitido.";
                 return false;
             }
-            repeated.reserve(source->size() * repeat);
+            const std::size_t repeated_size = source->size() * repeat;
+            const std::uint64_t repeated_bytes =
+                repeated_size > std::numeric_limits<std::uint64_t>::max() / sizeof(runtime::Value)
+                    ? std::numeric_limits<std::uint64_t>::max()
+                    : repeated_size * sizeof(runtime::Value);
+            if (!ReserveHeap(repeated_bytes, out_error)) {
+                return false;
+            }
+            repeated.reserve(repeated_size);
             for (std::size_t i = 0; i < repeat; ++i) {
                 repeated.insert(repeated.end(), source->begin(), source->end());
             }
@@ -2698,7 +3009,11 @@ bool Interpreter::EvaluateBinary(frontend::BinaryOp op, const runtime::Value& lh
 bool Interpreter::ExecuteCall(const frontend::CallExpr& call, bool require_return_value, runtime::Value* out_value,
                               std::string* out_error) {
     bool was_builtin = false;
-    if (!ExecuteBuiltinCall(call, &was_builtin, out_value, out_error)) {
+    const bool builtin_ok = ExecuteBuiltinCall(call, &was_builtin, out_value, out_error);
+    if (was_builtin) {
+        runtime::CountBuiltinCall(call.callee);
+    }
+    if (!builtin_ok) {
         return false;
     }
     if (was_builtin) {
@@ -2721,8 +3036,9 @@ bool Interpreter::ExecuteCall(const frontend::CallExpr& call, bool require_retur
         }
 
         runtime::Value::List* list = receiver == nullptr ? nullptr : receiver->MutableList();
-        if (list == nullptr) {
-            *out_error = "append(value) requiere una lista como receptor.";
+        std::string* text = receiver == nullptr ? nullptr : receiver->MutableString();
+        if (list == nullptr && text == nullptr) {
+            *out_error = "append(value) requiere una lista o string como receptor.";
             return false;
         }
 
@@ -2731,7 +3047,11 @@ bool Interpreter::ExecuteCall(const frontend::CallExpr& call, bool require_retur
             return false;
         }
 
-        list->push_back(std::move(value));
+        if (text != nullptr) {
+            value.AppendTo(text);
+        } else {
+            list->push_back(std::move(value));
+        }
         *out_value = runtime::Value(nullptr);
         return true;
     }
@@ -2822,6 +3142,18 @@ bool Interpreter::ExecuteCall(const frontend::CallExpr& call, bool require_retur
             return true;
         }
 
+        if (const auto* receiver_text = receiver_value.AsStringValue()) {
+            return ExecuteStringMethod(*receiver_text, member_name, call, 2, out_value, out_error);
+        }
+
+        if (const auto* receiver_array = receiver_value.AsNdArray()) {
+            return ExecuteNdArrayMethod(*receiver_array, member_name, call, 2, out_value, out_error);
+        }
+
+        if (receiver_value.IsDual()) {
+            return ExecuteDualMethod(receiver_value, member_name, call, 2, out_value, out_error);
+        }
+
         if (!receiver_value.IsObject()) {
             *out_error = "Llamada de metodo requiere instancia de clase: " + member_name;
             return false;
@@ -2880,7 +3212,8 @@ bool Interpreter::ExecuteCall(const frontend::CallExpr& call, bool require_retur
             std::string resolve_error;
             if (ResolveMutableVariable(target_name, false, &target_list, &resolve_error)) {
                 runtime::Value::List* list = target_list == nullptr ? nullptr : target_list->MutableList();
-                if (list != nullptr) {
+                std::string* text = target_list == nullptr ? nullptr : target_list->MutableString();
+                if (list != nullptr || text != nullptr) {
                     if (call.arguments.size() != 1 || call.arguments[0].value == nullptr) {
                         *out_error = "append(value) requiere exactamente 1 argumento.";
                         return false;
@@ -2890,13 +3223,42 @@ bool Interpreter::ExecuteCall(const frontend::CallExpr& call, bool require_retur
                     if (!EvaluateExpression(*call.arguments[0].value, &value, out_error)) {
                         return false;
                     }
-                    list->push_back(std::move(value));
+                    if (text != nullptr) {
+                        value.AppendTo(text);
+                    } else {
+                        list->push_back(std::move(value));
+                    }
                     *out_value = runtime::Value(nullptr);
                     return true;
                 }
             }
         }
 
+        if (IsStringMethod(member_name)) {
+            runtime::Value target_value;
+            std::string ignored_resolve_error;
+            if (ResolveVariable(target_name, &target_value, &ignored_resolve_error) && target_value.IsString()) {
+                return ExecuteStringMethod(
+                    *target_value.AsStringValue(), member_name, call, 0, out_value, out_error);
+            }
+        }
+
+        if (IsNdArrayMethod(member_name)) {
+            runtime::Value target_value;
+            std::string ignored_resolve_error;
+            if (ResolveVariable(target_name, &target_value, &ignored_resolve_error) && target_value.IsNdArray()) {
+                return ExecuteNdArrayMethod(*target_value.AsNdArray(), member_name, call, 0, out_value, out_error);
+            }
+        }
+
+        if (IsDualMethod(member_name)) {
+            runtime::Value target_value;
+            std::string ignored_resolve_error;
+            if (ResolveVariable(target_name, &target_value, &ignored_resolve_error) && target_value.IsDual()) {
+                return ExecuteDualMethod(target_value, member_name, call, 0, out_value, out_error);
+            }
+        }
+
         if (target_name == "super") {
             if (class_execution_stack_.empty()) {
                 *out_error = "super.metodo(...) solo se permite dentro de metodos de clase.";
@@ -3131,6 +3493,44 @@ bool Interpreter::ExecuteCall(const frontend::CallExpr& call, bool require_retur
     return ExecuteUserFunction(*function_it->second, call, require_return_value, out_value, out_error);
 }
 
+bool Interpreter::InvokeFunctionValue(const runtime::Value& function,
+                                      const std::vector<runtime::Value>& arguments,
+                                      runtime::Value* out_value,
+                                      std::string* out_error,
+                                      bool require_return_value) {
+    const auto* function_ref = function.AsFunctionRefValue();
+    if (function_ref == nullptr || function_ref->name.empty()) {
+        *out_error = "Se esperaba una funcion.";
+        return false;
+    }
+    const auto function_it = functions_.find(function_ref->name);
+    if (function_it == functions_.end()) {
+        *out_error = "Funcion no definida: " + function_ref->name;
+        return false;
+    }
+
+    // Parameters are bound by evaluating argument expressions in the caller's
+    // scope, so each value is staged in a hidden variable for the call.
+    std::vector<std::string> staged_names;
+    std::vector<frontend::CallArgument> call_arguments;
+    staged_names.reserve(arguments.size());
+    call_arguments.reserve(arguments.size());
+    for (std::size_t i = 0; i < arguments.size(); ++i) {
+        staged_names.push_back("__clot_arg" + std::to_string(i) + "__");
+        environment_[staged_names.back()] = runtime::VariableSlot{arguments[i], runtime::VariableKind::Dynamic};
+        frontend::CallArgument argument;
+        argument.value = std::make_unique<frontend::VariableExpr>(staged_names.back());
+        call_arguments.push_back(std::move(argument));
+    }
+
+    const frontend::CallExpr call(function_ref->name, std::move(call_arguments));
+    const bool ok = ExecuteUserFunction(*function_it->second, call, require_return_value, out_value, out_error);
+    for (const auto& name : staged_names) {
+        environment_.erase(name);
+    }
+    return ok;
+}
+
 bool Interpreter::ExecuteClassCallable(const std::string& class_name,
                                        const std::string& callable_name,
                                        frontend::TypeHint return_type,
@@ -3152,6 +3552,7 @@ bool Interpreter::ExecuteClassCallable(const std::string& class_name,
         constructor_instance_stack_.push_back(bound_this);
     }
 
+    profiled_class_name_ = &class_name;
     const bool ok = ExecuteCallable(
         callable_name,
         return_type,
@@ -3194,6 +3595,22 @@ bool Interpreter::ExecuteCallable(const std::string& callable_name,
                                   std::string* out_error,
                                   runtime::Value* bound_this,
                                   std::size_t call_argument_offset) {
+    std::optional<runtime::ProfileFunctionScope> profile_function;
+    if (profiler_ != nullptr) {
+        std::string frame_name = callable_name;
+        if (profiled_class_name_ != nullptr) {
+            // Methods arrive as "obj.method", "Class.method" or
+            // "Class::__constructor__"; report them by defining class.
+            std::string member = callable_name.substr(callable_name.find_last_of(".:") + 1);
+            if (member == "__constructor__") {
+                member = "constructor";
+            }
+            frame_name = *profiled_class_name_ + "." + member;
+        }
+        profile_function.emplace(profiler_, frame_name);
+    }
+    profiled_class_name_ = nullptr;
+
     if (call.arguments.size() < call_argument_offset) {
         *out_error = "Error interno: indice de argumento invalido.";
         return false;
@@ -3212,6 +3629,7 @@ bool Interpreter::ExecuteCallable(const std::string& callable_name,
     };
 
     std::vector<RefBinding> refs;
+    CountEnvironmentCopies(environment_.size());
     auto caller_environment = environment_;
     auto local_environment = environment_;
 
@@ -3399,7 +3817,26 @@ bool Interpreter::ExecuteCallable(const std::string& callable_name,
 
 bool Interpreter::ExecuteUserFunction(const frontend::FunctionDeclStmt& function, const frontend::CallExpr& call,
                                       bool require_return_value, runtime::Value* out_value, std::string* out_error) {
-    return ExecuteCallable(
+    FunctionProfile* profile = nullptr;
+    if (native_compile_hook_) {
+        profile = &function_profiles_[&function];
+        profile->declaration = &function;
+        ++profile->calls;
+
+        if (const NativeFunctionEntry entry = TierUpFunction(profile); entry != nullptr) {
+            bool handled = false;
+            if (!TryExecuteNativeFunction(function, call, entry, &handled, out_value, out_error)) {
+                return false;
+            }
+            if (handled) {
+                return true;
+            }
+        }
+
+        active_function_profiles_.push_back(profile);
+    }
+
+    const bool ok = ExecuteCallable(
         function.name,
         function.return_type,
         function.return_annotation,
@@ -3410,6 +3847,90 @@ bool Interpreter::ExecuteUserFunction(const frontend::FunctionDeclStmt& function
         out_value,
         out_error,
         nullptr);
+
+    if (profile != nullptr) {
+        active_function_profiles_.pop_back();
+    }
+    return ok;
+}
+
+bool Interpreter::TryExecuteNativeFunction(const frontend::FunctionDeclStmt& function,
+                                           const frontend::CallExpr& call,
+                                           NativeFunctionEntry entry,
+                                           bool* out_handled,
+                                           runtime::Value* out_value,
+                                           std::string* out_error) {
+    *out_handled = false;
+    if (call.arguments.size() != function.params.size()) {
+        return true;
+    }
+
+    // Native code works on doubles only. Anything else (ints, strings, calls with
+    // possible side effects in the arguments) stays on the interpreted path so
+    // semantics never change; the pure arguments evaluated here are simply
+    // evaluated again by ExecuteCallable.
+    std::vector<double> cells(function.params.size(), 0.0);
+    std::vector<runtime::VariableSlot*> reference_targets(function.params.size(), nullptr);
+    for (std::size_t i = 0; i < function.params.size(); ++i) {
+        const frontend::CallArgument& argument = call.arguments[i];
+        if (argument.value == nullptr || !IsSideEffectFreeExpr(*argument.value)) {
+            return true;
+        }
+
+        if (function.params[i].by_reference) {
+            const auto* variable = dynamic_cast<const frontend::VariableExpr*>(argument.value.get());
+            if (variable == nullptr) {
+                return true;
+            }
+            const auto slot_it = environment_.find(variable->name);
+            if (slot_it == environment_.end() || slot_it->second.is_const || !slot_it->second.value.IsDouble() ||
+                (slot_it->second.kind != runtime::VariableKind::Dynamic &&
+                 slot_it->second.kind != runtime::VariableKind::Double)) {
+                return true;
+            }
+            bool numeric_ok = false;
+            cells[i] = slot_it->second.value.AsNumber(&numeric_ok);
+            reference_targets[i] = &slot_it->second;
+            continue;
+        }
+
+        if (argument.by_reference) {
+            return true;
+        }
+
+        runtime::Value evaluated;
+        std::string ignored_error;
+        if (!EvaluateExpression(*argument.value, &evaluated, &ignored_error) || !evaluated.IsDouble()) {
+            return true;
+        }
+        bool numeric_ok = false;
+        cells[i] = evaluated.AsNumber(&numeric_ok);
+    }
+
+    std::vector<double*> slots(cells.size(), nullptr);
+    for (std::size_t i = 0; i < cells.size(); ++i) {
+        slots[i] = &cells[i];
+    }
+
+    runtime::FlushStdout();
+    const char* native_error = entry(slots.data());
+    std::fflush(stdout);
+
+    for (std::size_t i = 0; i < reference_targets.size(); ++i) {
+        if (reference_targets[i] != nullptr) {
+            reference_targets[i]->value = runtime::Value(cells[i]);
+        }
+    }
+
+    *out_handled = true;
+    if (native_error != nullptr) {
+        *out_error = native_error;
+        return false;
+    }
+    if (out_value != nullptr) {
+        *out_value = runtime::Value(nullptr);
+    }
+    return true;
 }
 
 bool Interpreter::ExecuteSuperCall(const frontend::CallExpr& call, bool require_return_value, runtime::Value* out_value,
@@ -12,10 +12,18 @@
 #include <iomanip>
 #include <iostream>
 #include <limits>
+#include <random>
 #include <sstream>
 #include <string_view>
 #include <thread>
 
+#include "clot/runtime/output.hpp"
+#include "clot/runtime/parallel_sort.hpp"
+#include "clot/runtime/streaming_stats.hpp"
+#include "clot/runtime/text_search.hpp"
+#include "clot/runtime/timing.hpp"
+#include "clot/runtime/value_hash.hpp"
+
 namespace clot::interpreter {
 namespace {
 
@@ -166,6 +174,12 @@ std::string ValueTypeName(const runtime::Value& value) {
     if (value.IsFunctionRef()) {
         return "function";
     }
+    if (value.IsNdArray()) {
+        return "ndarray";
+    }
+    if (value.IsDual()) {
+        return "dual";
+    }
     return "object";
 }
 
@@ -218,137 +232,13 @@ bool MatchesBuiltinTypeName(const runtime::Value& value, const std::string& lowe
     if (lowered_type_name == "object") {
         return value.IsObject();
     }
-    return false;
-}
-
-std::uint64_t HashMix(std::uint64_t seed, std::uint64_t value) {
-    seed ^= value + 0x9E3779B97F4A7C15ULL + (seed << 6U) + (seed >> 2U);
-    return seed;
-}
-
-std::uint64_t HashBytes(std::string_view text) {
-    std::uint64_t hash = 1469598103934665603ULL;
-    for (unsigned char ch : text) {
-        hash ^= static_cast<std::uint64_t>(ch);
-        hash *= 1099511628211ULL;
-    }
-    return hash;
-}
-
-std::uint64_t HashValue(const runtime::Value& value, int depth = 0) {
-    if (depth > 128) {
-        return 0xDEADBEEFCAFEBABEULL;
-    }
-
-    if (value.IsNull()) {
-        return 0x0100000000000000ULL;
-    }
-
-    if (value.IsBool()) {
-        return value.AsBool() ? 0x0200000000000001ULL : 0x0200000000000000ULL;
-    }
-
-    if (value.IsNumber()) {
-        BigInt integer;
-        if (value.AsBigInt(&integer)) {
-            std::uint64_t hash = 0x0300000000000000ULL;
-            hash = HashMix(hash, HashBytes(integer.convert_to<std::string>()));
-            return hash;
-        }
-
-        runtime::Value::Decimal decimal;
-        if (value.AsDecimal(&decimal)) {
-            std::uint64_t hash = 0x0300000000000001ULL;
-            hash = HashMix(hash, HashBytes(decimal.ToString()));
-            return hash;
-        }
-
-        bool ok = false;
-        const double numeric = value.AsNumber(&ok);
-        std::uint64_t hash = 0x0300000000000002ULL;
-        if (ok) {
-            std::uint64_t bits = 0;
-            std::memcpy(&bits, &numeric, sizeof(bits));
-            hash = HashMix(hash, bits);
-        }
-        return hash;
-    }
-
-    if (value.IsChar()) {
-        const char character = *value.AsCharValue();
-        std::uint64_t hash = 0x0400000000000000ULL;
-        hash = HashMix(hash, static_cast<std::uint64_t>(static_cast<unsigned char>(character)));
-        return hash;
-    }
-
-    if (value.IsString()) {
-        std::uint64_t hash = 0x0500000000000000ULL;
-        hash = HashMix(hash, HashBytes(value.ToString()));
-        return hash;
-    }
-
-    if (const auto* list = value.AsList()) {
-        std::uint64_t hash = 0x0600000000000000ULL;
-        for (const auto& element : *list) {
-            hash = HashMix(hash, HashValue(element, depth + 1));
-        }
-        return hash;
+    if (lowered_type_name == "ndarray") {
+        return value.IsNdArray();
     }
-
-    if (const auto* tuple = value.AsTuple()) {
-        std::uint64_t hash = 0x0700000000000000ULL;
-        for (const auto& element : *tuple) {
-            hash = HashMix(hash, HashValue(element, depth + 1));
-        }
-        return hash;
+    if (lowered_type_name == "dual") {
+        return value.IsDual();
     }
-
-    if (const auto* set = value.AsSet()) {
-        std::vector<std::uint64_t> members;
-        members.reserve(set->size());
-        for (const auto& element : *set) {
-            members.push_back(HashValue(element, depth + 1));
-        }
-        std::sort(members.begin(), members.end());
-
-        std::uint64_t hash = 0x0800000000000000ULL;
-        for (const std::uint64_t member_hash : members) {
-            hash = HashMix(hash, member_hash);
-        }
-        return hash;
-    }
-
-    if (const auto* map = value.AsMap()) {
-        std::vector<std::uint64_t> entries;
-        entries.reserve(map->size());
-        for (const auto& entry : *map) {
-            std::uint64_t entry_hash = 0x0900000000000000ULL;
-            entry_hash = HashMix(entry_hash, HashValue(entry.first, depth + 1));
-            entry_hash = HashMix(entry_hash, HashValue(entry.second, depth + 1));
-            entries.push_back(entry_hash);
-        }
-        std::sort(entries.begin(), entries.end());
-
-        std::uint64_t hash = 0x0900000000000001ULL;
-        for (const std::uint64_t entry_hash : entries) {
-            hash = HashMix(hash, entry_hash);
-        }
-        return hash;
-    }
-
-    if (const auto* object = value.AsObject()) {
-        std::uint64_t hash = 0x0A00000000000000ULL;
-        for (const auto& entry : *object) {
-            hash = HashMix(hash, HashBytes(entry.first));
-            hash = HashMix(hash, HashValue(entry.second, depth + 1));
-        }
-        return hash;
-    }
-
-    const runtime::Value::FunctionRef* function = value.AsFunctionRefValue();
-    std::uint64_t hash = 0x0B00000000000000ULL;
-    hash = HashMix(hash, HashBytes(function != nullptr ? function->name : value.ToString()));
-    return hash;
+    return false;
 }
 
 BigInt AbsBigInt(const BigInt& value) {
@@ -769,6 +659,418 @@ bool RenderPrintfFormat(const std::string& format,
     return true;
 }
 
+BigInt BigIntPower(BigInt base, int exponent) {
+    BigInt result(1);
+    while (exponent > 0) {
+        if (exponent & 1) {
+            result *= base;
+        }
+        base *= base;
+        exponent >>= 1;
+    }
+    return result;
+}
+
+// The exact value of a finite double: mantissa * 2^exponent, written as
+// (mantissa * 5^-exponent) / 10^-exponent when the exponent is negative.
+runtime::Value::Decimal ExactDecimalFromDouble(double number) {
+    int exponent = 0;
+    const double fraction = std::frexp(number, &exponent);
+    BigInt coefficient(static_cast<long long>(std::ldexp(fraction, 53)));
+    exponent -= 53;
+    if (exponent >= 0) {
+        return runtime::Value::Decimal(coefficient * BigIntPower(BigInt(2), exponent), 0);
+    }
+    return runtime::Value::Decimal(coefficient * BigIntPower(BigInt(5), -exponent), -exponent);
+}
+
+// -1, 0 or 1 as `exact` is below, equal to or above `number` (not NaN).
+// Rounding to double is monotonic, so the exact expansion of `number` is only
+// needed when `exact` rounds to `number` itself (or cannot be rounded).
+int CompareExactWithDouble(const runtime::Value::Decimal& exact, double number) {
+    if (std::isinf(number)) {
+        return number > 0 ? -1 : 1;
+    }
+    double rounded = 0.0;
+    if (exact.ToDouble(&rounded) && rounded != number) {
+        return rounded < number ? -1 : 1;
+    }
+    const runtime::Value::Decimal other = ExactDecimalFromDouble(number);
+    if (exact < other) {
+        return -1;
+    }
+    return other < exact ? 1 : 0;
+}
+
+// Ordering used by sort/sorted/nth_element/top_k. Numbers compare exactly across
+// int, float, double and decimal (NaN sorts last), strings and chars by byte, bools
+// false < true, and lists/tuples lexicographically. Anything else is an error.
+bool LessForSort(const runtime::Value& lhs, const runtime::Value& rhs, bool* out_less, std::string* out_error) {
+    if (lhs.IsNumber() && rhs.IsNumber()) {
+        if (lhs.IsInteger() && rhs.IsInteger()) {
+            *out_less = *lhs.AsBigIntValue() < *rhs.AsBigIntValue();
+            return true;
+        }
+        const bool left_floating = lhs.IsDouble() || lhs.IsFloat();
+        const bool right_floating = rhs.IsDouble() || rhs.IsFloat();
+        if (left_floating && right_floating) {
+            const double left = lhs.AsNumber();
+            const double right = rhs.AsNumber();
+            *out_less = !std::isnan(left) && (std::isnan(right) || left < right);
+            return true;
+        }
+        if (left_floating || right_floating) {
+            // Exact, not through AsNumber(): rounding the int or decimal side
+            // to double would make 2^53 + 1 equal to 2^53.0 but not to 2^53,
+            // which is no strict weak ordering.
+            const double number = (left_floating ? lhs : rhs).AsNumber();
+            if (std::isnan(number)) {
+                *out_less = !left_floating;
+                return true;
+            }
+            const runtime::Value& other = left_floating ? rhs : lhs;
+            runtime::Value::Decimal exact;
+            if (other.IsInteger()) {
+                exact = runtime::Value::Decimal(*other.AsBigIntValue(), 0);
+            } else if (!ReadDecimal(other, &exact, out_error)) {
+                return false;
+            }
+            const int order = CompareExactWithDouble(exact, number);
+            *out_less = left_floating ? order > 0 : order < 0;
+            return true;
+        }
+        runtime::Value::Decimal left;
+        runtime::Value::Decimal right;
+        if (!ReadDecimal(lhs, &left, out_error) || !ReadDecimal(rhs, &right, out_error)) {
+            return false;
+        }
+        *out_less = left < right;
+        return true;
+    }
+
+    if (const auto* left = lhs.AsStringValue()) {
+        if (const auto* right = rhs.AsStringValue()) {
+            *out_less = *left < *right;
+            return true;
+        }
+    }
+
+    if (lhs.IsChar() && rhs.IsChar()) {
+        *out_less = static_cast<unsigned char>(*lhs.AsCharValue()) < static_cast<unsigned char>(*rhs.AsCharValue());
+        return true;
+    }
+
+    if (lhs.IsBool() && rhs.IsBool()) {
+        *out_less = !lhs.AsBool() && rhs.AsBool();
+        return true;
+    }
+
+    const std::vector<runtime::Value>* left_sequence = lhs.IsList() ? lhs.AsList() : lhs.AsTuple();
+    const std::vector<runtime::Value>* right_sequence = rhs.IsList() ? rhs.AsList() : rhs.AsTuple();
+    if (left_sequence != nullptr && right_sequence != nullptr && lhs.IsList() == rhs.IsList()) {
+        const std::size_t common = std::min(left_sequence->size(), right_sequence->size());
+        for (std::size_t i = 0; i < common; ++i) {
+            bool less = false;
+            if (!LessForSort((*left_sequence)[i], (*right_sequence)[i], &less, out_error)) {
+                return false;
+            }
+            if (less) {
+                *out_less = true;
+                return true;
+            }
+            if (!LessForSort((*right_sequence)[i], (*left_sequence)[i], &less, out_error)) {
+                return false;
+            }
+            if (less) {
+                *out_less = false;
+                return true;
+            }
+        }
+        *out_less = left_sequence->size() < right_sequence->size();
+        return true;
+    }
+
+    *out_error = "No se pueden ordenar juntos valores de tipo: " + ValueTypeName(lhs) + ", " + ValueTypeName(rhs) + ".";
+    return false;
+}
+
+enum class SortMode {
+    Full,
+    TopK,
+    Nth,
+};
+
+struct SortPlan {
+    SortMode mode = SortMode::Full;
+    std::size_t count = 0;  // TopK: prefix length. Nth: target position.
+    bool reverse = false;
+};
+
+// Sorts (key, original index) records according to `plan` and returns the
+// selected original indices in order. Ties always fall back to the original
+// index, so full, partial and nth selections agree with one stable order.
+template <typename Key, typename KeyLess>
+std::vector<std::size_t> OrderSortRecords(std::vector<std::pair<Key, std::size_t>> records,
+                                          const SortPlan& plan,
+                                          bool allow_parallel,
+                                          KeyLess key_less) {
+    auto less = [&](const std::pair<Key, std::size_t>& lhs, const std::pair<Key, std::size_t>& rhs) {
+        const Key& first = plan.reverse ? rhs.first : lhs.first;
+        const Key& second = plan.reverse ? lhs.first : rhs.first;
+        if (key_less(first, second)) {
+            return true;
+        }
+        if (key_less(second, first)) {
+            return false;
+        }
+        return lhs.second < rhs.second;
+    };
+
+    switch (plan.mode) {
+    case SortMode::Full:
+        if (allow_parallel) {
+            runtime::ParallelStableSort(&records, less);
+        } else {
+            std::sort(records.begin(), records.end(), less);
+        }
+        break;
+    case SortMode::TopK:
+        std::partial_sort(records.begin(), records.begin() + static_cast<std::ptrdiff_t>(plan.count), records.end(),
+                          less);
+        records.resize(plan.count);
+        break;
+    case SortMode::Nth:
+        std::nth_element(records.begin(), records.begin() + static_cast<std::ptrdiff_t>(plan.count), records.end(),
+                         less);
+        records = {records[plan.count]};
+        break;
+    }
+
+    std::vector<std::size_t> order;
+    order.reserve(records.size());
+    for (const auto& record : records) {
+        order.push_back(record.second);
+    }
+    return order;
+}
+
+// What the keys seen so far at one position hold, for CheckSortKeysComparable.
+// Sequences keep one entry per element position, so two keys that agree with
+// the shape are comparable at every position they share.
+struct SortKeyShape {
+    enum class Kind {
+        Unset,
+        Number,
+        String,
+        Char,
+        Bool,
+        List,
+        Tuple,
+        // Nothing LessForSort orders; fine only while no other key reaches it.
+        Other,
+    };
+
+    Kind kind = Kind::Unset;
+    const runtime::Value* sample = nullptr;
+    // Decimal keys compare against integers as decimals, which fails for
+    // integers outside the decimal range.
+    const runtime::Value* decimal_sample = nullptr;
+    const runtime::Value* wide_integer_sample = nullptr;
+    std::vector<SortKeyShape> elements;
+};
+
+SortKeyShape::Kind SortKeyKind(const runtime::Value& key) {
+    if (key.IsNumber()) {
+        return SortKeyShape::Kind::Number;
+    }
+    if (key.IsString()) {
+        return SortKeyShape::Kind::String;
+    }
+    if (key.IsChar()) {
+        return SortKeyShape::Kind::Char;
+    }
+    if (key.IsBool()) {
+        return SortKeyShape::Kind::Bool;
+    }
+    if (key.IsList()) {
+        return SortKeyShape::Kind::List;
+    }
+    if (key.IsTuple()) {
+        return SortKeyShape::Kind::Tuple;
+    }
+    return SortKeyShape::Kind::Other;
+}
+
+// Reports the error LessForSort would raise for `lhs` and `rhs`.
+bool RejectSortPair(const runtime::Value& lhs, const runtime::Value& rhs, std::string* out_error) {
+    bool ignored = false;
+    if (LessForSort(lhs, rhs, &ignored, out_error)) {
+        *out_error = "No se pueden ordenar juntos valores de tipo: " + ValueTypeName(lhs) + ", " +
+                     ValueTypeName(rhs) + ".";
+    }
+    return false;
+}
+
+bool MergeSortKeyShape(const runtime::Value& key, SortKeyShape* shape, std::string* out_error) {
+    const SortKeyShape::Kind kind = SortKeyKind(key);
+    if (shape->kind == SortKeyShape::Kind::Unset) {
+        shape->kind = kind;
+        shape->sample = &key;
+    } else if (shape->kind != kind || kind == SortKeyShape::Kind::Other) {
+        return RejectSortPair(*shape->sample, key, out_error);
+    }
+
+    if (kind == SortKeyShape::Kind::Number) {
+        runtime::Value::Decimal ignored;
+        if (key.IsDecimal() && shape->decimal_sample == nullptr) {
+            shape->decimal_sample = &key;
+        } else if (key.IsInteger() && !key.AsDecimal(&ignored) && shape->wide_integer_sample == nullptr) {
+            shape->wide_integer_sample = &key;
+        }
+        if (shape->decimal_sample != nullptr && shape->wide_integer_sample != nullptr) {
+            return RejectSortPair(*shape->decimal_sample, *shape->wide_integer_sample, out_error);
+        }
+        return true;
+    }
+
+    if (kind == SortKeyShape::Kind::List || kind == SortKeyShape::Kind::Tuple) {
+        const std::vector<runtime::Value>& elements = kind == SortKeyShape::Kind::List ? *key.AsList() : *key.AsTuple();
+        if (shape->elements.size() < elements.size()) {
+            shape->elements.resize(elements.size());
+        }
+        for (std::size_t i = 0; i < elements.size(); ++i) {
+            if (!MergeSortKeyShape(elements[i], &shape->elements[i], out_error)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Checks up front that LessForSort succeeds for every pair of keys, so the
+// sort itself runs with a comparator that cannot fail. Stricter than comparing
+// lazily: tuples must agree at every shared position, not only up to the first
+// one that differs.
+bool CheckSortKeysComparable(const std::vector<runtime::Value>& keys, std::string* out_error) {
+    SortKeyShape shape;
+    for (const runtime::Value& key : keys) {
+        if (!MergeSortKeyShape(key, &shape, out_error)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Homogeneous int64, double and string keys compare natively and may sort on
+// several threads; mixed or nested keys go through LessForSort on one thread.
+bool OrderSortKeys(const std::vector<runtime::Value>& keys,
+                   const SortPlan& plan,
+                   std::vector<std::size_t>* out_order,
+                   std::string* out_error) {
+    const bool all_integers = std::all_of(keys.begin(), keys.end(), [](const runtime::Value& key) {
+        long long ignored = 0;
+        return key.IsInteger() && runtime::Value::TryBigIntToInt64(*key.AsBigIntValue(), &ignored);
+    });
+    if (all_integers) {
+        std::vector<std::pair<long long, std::size_t>> records;
+        records.reserve(keys.size());
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            long long integer = 0;
+            runtime::Value::TryBigIntToInt64(*keys[i].AsBigIntValue(), &integer);
+            records.push_back({integer, i});
+        }
+        *out_order = OrderSortRecords(std::move(records), plan, true, std::less<long long>());
+        return true;
+    }
+
+    const bool all_floating = std::all_of(keys.begin(), keys.end(), [](const runtime::Value& key) {
+        return key.IsDouble() || key.IsFloat();
+    });
+    if (all_floating) {
+        std::vector<std::pair<double, std::size_t>> records;
+        records.reserve(keys.size());
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            records.push_back({keys[i].AsNumber(), i});
+        }
+        *out_order = OrderSortRecords(std::move(records), plan, true, [](double lhs, double rhs) {
+            return !std::isnan(lhs) && (std::isnan(rhs) || lhs < rhs);
+        });
+        return true;
+    }
+
+    const bool all_strings = std::all_of(keys.begin(), keys.end(), [](const runtime::Value& key) {
+        return key.IsString();
+    });
+    if (all_strings) {
+        std::vector<std::pair<const std::string*, std::size_t>> records;
+        records.reserve(keys.size());
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            records.push_back({keys[i].AsStringValue(), i});
+        }
+        *out_order = OrderSortRecords(std::move(records), plan, true, [](const std::string* lhs, const std::string* rhs) {
+            return *lhs < *rhs;
+        });
+        return true;
+    }
+
+    if (!CheckSortKeysComparable(keys, out_error)) {
+        return false;
+    }
+    std::vector<std::pair<const runtime::Value*, std::size_t>> records;
+    records.reserve(keys.size());
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        records.push_back({&keys[i], i});
+    }
+    *out_order = OrderSortRecords(std::move(records), plan, false,
+                                  [](const runtime::Value* lhs, const runtime::Value* rhs) {
+                                      bool less = false;
+                                      std::string unreachable;
+                                      LessForSort(*lhs, *rhs, &less, &unreachable);
+                                      return less;
+                                  });
+    return true;
+}
+
+struct StringMethodArity {
+    const char* name;
+    std::size_t min_arguments;
+    std::size_t max_arguments;
+};
+
+constexpr StringMethodArity kStringMethods[] = {
+    {"split", 0, 1},  {"join", 1, 1},   {"find", 1, 2},       {"replace", 2, 2}, {"strip", 0, 1},
+    {"lstrip", 0, 1}, {"rstrip", 0, 1}, {"startswith", 1, 1}, {"endswith", 1, 1}, {"count", 1, 1},
+};
+
+const StringMethodArity* FindStringMethod(const std::string& name) {
+    for (const auto& method : kStringMethods) {
+        if (name == method.name) {
+            return &method;
+        }
+    }
+    return nullptr;
+}
+
+bool IsAsciiSpace(char character) {
+    return character == ' ' || character == '\t' || character == '\n' || character == '\r' || character == '\f' ||
+           character == '\v';
+}
+
+// String method arguments accept a string or a single char.
+bool ReadTextArgument(const runtime::Value& value, std::string* out_text, std::string* out_error) {
+    if (const auto* text = value.AsStringValue()) {
+        *out_text = *text;
+        return true;
+    }
+    if (const auto* character = value.AsCharValue()) {
+        *out_text = std::string(1, *character);
+        return true;
+    }
+    *out_error = "Los metodos de string requieren argumentos string o char.";
+    return false;
+}
+
+
 } // namespace
 
 bool Interpreter::ExecuteBuiltinCall(const frontend::CallExpr& call, bool* out_was_builtin, runtime::Value* out_value,
@@ -792,6 +1094,45 @@ bool Interpreter::ExecuteBuiltinCall(const frontend::CallExpr& call, bool* out_w
         return EvaluateExpression(*call.arguments[index].value, out_argument, out_error);
     };
 
+    if (!native_builtins_.empty()) {
+        const auto native = native_builtins_.find(call.callee);
+        if (native != native_builtins_.end()) {
+            *out_was_builtin = true;
+            std::vector<runtime::Value> arguments(call.arguments.size());
+            for (std::size_t i = 0; i < arguments.size(); ++i) {
+                if (!evaluate_argument(i, &arguments[i])) {
+                    return false;
+                }
+            }
+            return native->second(arguments, out_value, out_error);
+        }
+    }
+
+    if (IsNdArrayBuiltin(call.callee)) {
+        *out_was_builtin = true;
+        return ExecuteNdArrayBuiltin(call, out_value, out_error);
+    }
+
+    if (IsStatsBuiltin(call.callee)) {
+        *out_was_builtin = true;
+        return ExecuteStatsBuiltin(call, out_value, out_error);
+    }
+
+    if (IsDualBuiltin(call.callee)) {
+        *out_was_builtin = true;
+        return ExecuteDualBuiltin(call, out_value, out_error);
+    }
+
+    if (IsOptimizeBuiltin(call.callee)) {
+        *out_was_builtin = true;
+        return ExecuteOptimizeBuiltin(call, out_value, out_error);
+    }
+
+    if (IsMlBuiltin(call.callee)) {
+        *out_was_builtin = true;
+        return ExecuteMlBuiltin(call, out_value, out_error);
+    }
+
     if (call.callee == "sum" && math_imported) {
         *out_was_builtin = true;
 
@@ -878,6 +1219,9 @@ bool Interpreter::ExecuteBuiltinCall(const frontend::CallExpr& call, bool* out_w
         if (!evaluate_argument(0, &value)) {
             return false;
         }
+        if (value.IsDual()) {
+            return ApplyDualMath(call.callee, {value}, out_value, out_error);
+        }
         double numeric = 0.0;
         if (!ReadNumeric(value, &numeric, out_error)) {
             return false;
@@ -902,6 +1246,9 @@ bool Interpreter::ExecuteBuiltinCall(const frontend::CallExpr& call, bool* out_w
         if (!evaluate_argument(0, &base_value) || !evaluate_argument(1, &exponent_value)) {
             return false;
         }
+        if (base_value.IsDual() || exponent_value.IsDual()) {
+            return ApplyDualMath(call.callee, {base_value, exponent_value}, out_value, out_error);
+        }
 
         BigInt base_integer;
         BigInt exponent_integer;
@@ -934,6 +1281,16 @@ bool Interpreter::ExecuteBuiltinCall(const frontend::CallExpr& call, bool* out_w
         if (!evaluate_argument(0, &x_value)) {
             return false;
         }
+        if (x_value.IsDual()) {
+            std::vector<runtime::Value> arguments{x_value};
+            if (call.arguments.size() == 2) {
+                arguments.emplace_back();
+                if (!evaluate_argument(1, &arguments.back())) {
+                    return false;
+                }
+            }
+            return ApplyDualMath(call.callee, arguments, out_value, out_error);
+        }
         double x = 0.0;
         if (!ReadNumeric(x_value, &x, out_error)) {
             return false;
@@ -976,6 +1333,9 @@ bool Interpreter::ExecuteBuiltinCall(const frontend::CallExpr& call, bool* out_w
         if (!evaluate_argument(0, &value)) {
             return false;
         }
+        if (value.IsDual()) {
+            return ApplyDualMath(call.callee, {value}, out_value, out_error);
+        }
         double numeric = 0.0;
         if (!ReadNumeric(value, &numeric, out_error)) {
             return false;
@@ -999,6 +1359,9 @@ bool Interpreter::ExecuteBuiltinCall(const frontend::CallExpr& call, bool* out_w
         if (!evaluate_argument(0, &value)) {
             return false;
         }
+        if (value.IsDual()) {
+            return ApplyDualMath(call.callee, {value}, out_value, out_error);
+        }
         double numeric = 0.0;
         if (!ReadNumeric(value, &numeric, out_error)) {
             return false;
@@ -1018,6 +1381,9 @@ bool Interpreter::ExecuteBuiltinCall(const frontend::CallExpr& call, bool* out_w
         if (!evaluate_argument(0, &value)) {
             return false;
         }
+        if (value.IsDual()) {
+            return ApplyDualMath(call.callee, {value}, out_value, out_error);
+        }
         BigInt integer;
         if (value.AsBigInt(&integer)) {
             *out_value = runtime::Value(AbsBigInt(integer));
@@ -1044,6 +1410,9 @@ bool Interpreter::ExecuteBuiltinCall(const frontend::CallExpr& call, bool* out_w
         if (!evaluate_argument(0, &value)) {
             return false;
         }
+        if (value.IsDual()) {
+            return ApplyDualMath(call.callee, {value}, out_value, out_error);
+        }
         double numeric = 0.0;
         if (!ReadNumeric(value, &numeric, out_error)) {
             return false;
@@ -1254,6 +1623,8 @@ bool Interpreter::ExecuteBuiltinCall(const frontend::CallExpr& call, bool* out_w
             size = map->size();
         } else if (const auto* object = value.AsObject()) {
             size = object->size();
+        } else if (const auto* array = value.AsNdArray()) {
+            size = array->Rank() == 0 ? 0 : array->Shape()[0];
         } else {
             *out_error = "len() requiere un string, list, tuple, set, map, object o char.";
             return false;
@@ -1438,6 +1809,171 @@ bool Interpreter::ExecuteBuiltinCall(const frontend::CallExpr& call, bool* out_w
         return true;
     }
 
+    // Key functions run once per element (decorate-sort-undecorate), never per
+    // comparison. `first_option` is the index of the optional key argument.
+    auto order_for_sort = [&](const std::vector<runtime::Value>& elements,
+                              std::size_t first_option,
+                              bool accepts_reverse,
+                              SortPlan plan,
+                              std::vector<std::size_t>* out_order) -> bool {
+        runtime::Value key_function(nullptr);
+        if (call.arguments.size() > first_option && !evaluate_argument(first_option, &key_function)) {
+            return false;
+        }
+        if (!key_function.IsNull() && !key_function.IsFunctionRef()) {
+            *out_error = "El argumento key debe ser una funcion o null.";
+            return false;
+        }
+        if (accepts_reverse && call.arguments.size() > first_option + 1) {
+            runtime::Value reverse;
+            if (!evaluate_argument(first_option + 1, &reverse)) {
+                return false;
+            }
+            if (!reverse.IsBool()) {
+                *out_error = "El argumento reverse debe ser bool.";
+                return false;
+            }
+            plan.reverse = plan.reverse != reverse.AsBool();
+        }
+
+        if (key_function.IsNull()) {
+            return OrderSortKeys(elements, plan, out_order, out_error);
+        }
+
+        std::vector<runtime::Value> keys;
+        keys.reserve(elements.size());
+        for (const auto& element : elements) {
+            runtime::Value key;
+            if (!InvokeFunctionValue(key_function, {element}, &key, out_error)) {
+                return false;
+            }
+            keys.push_back(std::move(key));
+        }
+        return OrderSortKeys(keys, plan, out_order, out_error);
+    };
+
+    if (call.callee == "sort") {
+        *out_was_builtin = true;
+        if (call.arguments.empty() || call.arguments.size() > 3) {
+            *out_error = "sort(list, key=null, reverse=false) requiere de 1 a 3 argumentos.";
+            return false;
+        }
+        if (call.arguments[0].value == nullptr) {
+            *out_error = "Error interno: argumento de llamada vacio.";
+            return false;
+        }
+
+        runtime::Value* receiver = nullptr;
+        if (!ResolveMutableTarget(*call.arguments[0].value, false, &receiver, out_error)) {
+            return false;
+        }
+        runtime::Value::List* list = receiver == nullptr ? nullptr : receiver->MutableList();
+        if (list == nullptr) {
+            *out_error = "sort(list) requiere una lista; usa sorted() para otros iterables.";
+            return false;
+        }
+
+        // The list reads as empty while its elements are being ordered.
+        std::vector<runtime::Value> elements = std::move(*list);
+        list->clear();
+        std::vector<std::size_t> order;
+        const bool ordered = order_for_sort(elements, 1, true, SortPlan{}, &order);
+
+        // Evaluating key/reverse or calling the key function swaps the
+        // environment, so the list slot is resolved again before writing back.
+        std::string resolve_error;
+        receiver = nullptr;
+        list = ResolveMutableTarget(*call.arguments[0].value, false, &receiver, &resolve_error) && receiver != nullptr
+                   ? receiver->MutableList()
+                   : nullptr;
+        if (list == nullptr) {
+            if (ordered) {
+                *out_error = "sort(list): la lista cambio durante el ordenamiento.";
+            }
+            return false;
+        }
+        if (!ordered) {
+            *list = std::move(elements);
+            return false;
+        }
+
+        list->reserve(order.size());
+        for (const std::size_t index : order) {
+            list->push_back(std::move(elements[index]));
+        }
+        *out_value = runtime::Value(nullptr);
+        return true;
+    }
+
+    if (call.callee == "sorted" || call.callee == "top_k" || call.callee == "nth_element") {
+        *out_was_builtin = true;
+        const bool is_sorted = call.callee == "sorted";
+        if (is_sorted && (call.arguments.empty() || call.arguments.size() > 3)) {
+            *out_error = "sorted(iterable, key=null, reverse=false) requiere de 1 a 3 argumentos.";
+            return false;
+        }
+        if (!is_sorted && (call.arguments.size() < 2 || call.arguments.size() > 3)) {
+            *out_error = call.callee == "top_k" ? "top_k(iterable, k, key=null) requiere 2 o 3 argumentos."
+                                                : "nth_element(iterable, n, key=null) requiere 2 o 3 argumentos.";
+            return false;
+        }
+
+        runtime::Value iterable;
+        if (!evaluate_argument(0, &iterable)) {
+            return false;
+        }
+        std::vector<runtime::Value> elements;
+        std::string iterable_error;
+        if (!CollectForEachElements(iterable, &elements, &iterable_error)) {
+            *out_error = call.callee + "() requiere un iterable (list, tuple, set, map, object o string).";
+            return false;
+        }
+
+        SortPlan plan;
+        if (!is_sorted) {
+            runtime::Value count_value;
+            long long count = 0;
+            if (!evaluate_argument(1, &count_value)) {
+                return false;
+            }
+            if (!count_value.IsInteger() || !ReadInteger64(count_value, &count) || count < 0) {
+                *out_error = call.callee + "() requiere un entero >= 0 como segundo argumento.";
+                return false;
+            }
+            if (call.callee == "top_k") {
+                // The k largest, largest first.
+                plan.mode = SortMode::TopK;
+                plan.reverse = true;
+                plan.count = std::min(static_cast<std::size_t>(count), elements.size());
+            } else {
+                if (static_cast<unsigned long long>(count) >= elements.size()) {
+                    *out_error = "nth_element(): indice fuera de rango.";
+                    return false;
+                }
+                plan.mode = SortMode::Nth;
+                plan.count = static_cast<std::size_t>(count);
+            }
+        }
+
+        std::vector<std::size_t> order;
+        if (!order_for_sort(elements, is_sorted ? 1 : 2, is_sorted, plan, &order)) {
+            return false;
+        }
+
+        if (plan.mode == SortMode::Nth) {
+            *out_value = std::move(elements[order.front()]);
+            return true;
+        }
+
+        runtime::Value::List result;
+        result.reserve(order.size());
+        for (const std::size_t index : order) {
+            result.push_back(std::move(elements[index]));
+        }
+        *out_value = runtime::Value(std::move(result));
+        return true;
+    }
+
     if (call.callee == "isinstance") {
         *out_was_builtin = true;
         if (call.arguments.size() != 2) {
@@ -1601,7 +2137,7 @@ bool Interpreter::ExecuteBuiltinCall(const frontend::CallExpr& call, bool* out_w
             return false;
         }
 
-        *out_value = runtime::Value(UnsignedToBigInt(HashValue(input)));
+        *out_value = runtime::Value(UnsignedToBigInt(runtime::HashValue(input)));
         return true;
     }
 
@@ -1617,7 +2153,7 @@ bool Interpreter::ExecuteBuiltinCall(const frontend::CallExpr& call, bool* out_w
             return false;
         }
 
-        const std::uint64_t fingerprint = HashValue(input);
+        const std::uint64_t fingerprint = runtime::HashValue(input);
         auto& bucket = value_identity_cache_[fingerprint];
         for (const auto& entry : bucket) {
             if (entry.first.Equals(input)) {
@@ -1905,10 +2441,10 @@ bool Interpreter::ExecuteBuiltinCall(const frontend::CallExpr& call, bool* out_w
             if (!evaluate_argument(0, &value)) {
                 return false;
             }
-            std::cout << value.ToString();
+            runtime::WriteStdout(value.ToString());
         }
 
-        std::cout << std::endl;
+        runtime::EndStdoutLine();
         *out_value = runtime::Value(0LL);
         return true;
     }
@@ -1943,7 +2479,7 @@ bool Interpreter::ExecuteBuiltinCall(const frontend::CallExpr& call, bool* out_w
             return false;
         }
 
-        std::cout << rendered << std::flush;
+        runtime::WriteStdout(rendered);
         *out_value = runtime::Value(static_cast<long long>(rendered.size()));
         return true;
     }
@@ -2059,6 +2595,129 @@ bool Interpreter::ExecuteBuiltinCall(const frontend::CallExpr& call, bool* out_w
         return true;
     }
 
+    if (call.callee == "now_ns") {
+        *out_was_builtin = true;
+        if (!call.arguments.empty()) {
+            *out_error = "now_ns() no acepta argumentos.";
+            return false;
+        }
+
+        // Monotonic: only differences between two readings are meaningful.
+        const auto now = std::chrono::steady_clock::now().time_since_epoch();
+        const auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+        *out_value = runtime::Value(static_cast<long long>(nanos));
+        return true;
+    }
+
+    if (call.callee == "cpu_time_ns") {
+        *out_was_builtin = true;
+        if (!call.arguments.empty()) {
+            *out_error = "cpu_time_ns() no acepta argumentos.";
+            return false;
+        }
+
+        const auto cpu_ns = runtime::ProcessCpuNanoseconds();
+        if (!cpu_ns.has_value()) {
+            *out_error = "cpu_time_ns() no esta disponible en esta plataforma.";
+            return false;
+        }
+        *out_value = runtime::Value(static_cast<long long>(*cpu_ns));
+        return true;
+    }
+
+    if (call.callee == "bench") {
+        *out_was_builtin = true;
+        if (call.arguments.size() != 2 && call.arguments.size() != 3) {
+            *out_error = "bench(fn, iterations) requiere 2 o 3 argumentos.";
+            return false;
+        }
+
+        runtime::Value function_value;
+        runtime::Value iterations_value;
+        if (!evaluate_argument(0, &function_value) || !evaluate_argument(1, &iterations_value)) {
+            return false;
+        }
+        if (!function_value.IsFunctionRef()) {
+            *out_error = "bench(fn, iterations) requiere una funcion como primer argumento.";
+            return false;
+        }
+
+        long long iterations = 0;
+        if (!ReadInteger64(iterations_value, &iterations) || iterations < 1) {
+            *out_error = "bench(fn, iterations) requiere iterations entero >= 1.";
+            return false;
+        }
+        // Default warmup: a tenth of the measured calls, between 1 and 1000.
+        long long warmup = std::clamp(iterations / 10, 1LL, 1000LL);
+        if (call.arguments.size() == 3) {
+            runtime::Value warmup_value;
+            if (!evaluate_argument(2, &warmup_value)) {
+                return false;
+            }
+            if (!ReadInteger64(warmup_value, &warmup) || warmup < 0) {
+                *out_error = "bench(fn, iterations, warmup) requiere warmup entero >= 0.";
+                return false;
+            }
+        }
+
+        runtime::Value ignored;
+        for (long long i = 0; i < warmup; ++i) {
+            if (!InvokeFunctionValue(function_value, {}, &ignored, out_error, false)) {
+                return false;
+            }
+        }
+
+        // min, max and mean stream; the median comes from every sample up to
+        // kBenchSampleLimit calls and from a uniform reservoir of that many
+        // (Algorithm R) past it, so memory stays bounded for any count.
+        constexpr std::size_t kBenchSampleLimit = 1 << 16;
+        std::vector<long long> samples;
+        samples.reserve(std::min(static_cast<std::size_t>(iterations), kBenchSampleLimit));
+        std::mt19937_64 reservoir_random(0x5EED);
+        runtime::RunningStats stats;
+        long long min_ns = std::numeric_limits<long long>::max();
+        long long max_ns = 0;
+        for (long long i = 0; i < iterations; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            if (!InvokeFunctionValue(function_value, {}, &ignored, out_error, false)) {
+                return false;
+            }
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+            const auto sample =
+                static_cast<long long>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+            stats.Add(static_cast<double>(sample));
+            min_ns = std::min(min_ns, sample);
+            max_ns = std::max(max_ns, sample);
+            if (samples.size() < kBenchSampleLimit) {
+                samples.push_back(sample);
+            } else {
+                const auto slot = std::uniform_int_distribution<long long>(0, i)(reservoir_random);
+                if (static_cast<std::size_t>(slot) < kBenchSampleLimit) {
+                    samples[static_cast<std::size_t>(slot)] = sample;
+                }
+            }
+        }
+
+        const std::size_t middle = samples.size() / 2;
+        std::nth_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(middle), samples.end());
+        long long median = samples[middle];
+        if (samples.size() % 2 == 0) {
+            const long long lower =
+                *std::max_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(middle));
+            median = (lower + median) / 2;
+        }
+
+        runtime::Value::Map result;
+        result.entries.push_back({runtime::Value("min_ns"), runtime::Value(min_ns)});
+        result.entries.push_back({runtime::Value("median_ns"), runtime::Value(median)});
+        result.entries.push_back({runtime::Value("mean_ns"), runtime::Value(stats.Mean())});
+        result.entries.push_back({runtime::Value("max_ns"), runtime::Value(max_ns)});
+        result.entries.push_back({runtime::Value("iterations"), runtime::Value(iterations)});
+        result.entries.push_back({runtime::Value("warmup"), runtime::Value(warmup)});
+        *out_value = runtime::Value(std::move(result));
+        return true;
+    }
+
     if (call.callee == "sleep_ms") {
         *out_was_builtin = true;
         if (call.arguments.size() != 1) {
@@ -2077,6 +2736,14 @@ bool Interpreter::ExecuteBuiltinCall(const frontend::CallExpr& call, bool* out_w
             return false;
         }
 
+        // A sleep past the time limit ends at the limit.
+        const std::optional<std::uint64_t> remaining_ms = RemainingWallMilliseconds();
+        if (remaining_ms.has_value() && static_cast<std::uint64_t>(delay_ms) >= *remaining_ms) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(*remaining_ms));
+            time_limit_exceeded_ = true;
+            return CheckResourceLimits(out_error);
+        }
+
         std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
         *out_value = runtime::Value(0LL);
         return true;
@@ -2185,4 +2852,197 @@ bool Interpreter::ExecuteBuiltinCall(const frontend::CallExpr& call, bool* out_w
 }
 
 
+bool Interpreter::IsStringMethod(const std::string& name) {
+    return FindStringMethod(name) != nullptr;
+}
+
+bool Interpreter::ExecuteStringMethod(const std::string& text,
+                                      const std::string& method,
+                                      const frontend::CallExpr& call,
+                                      std::size_t argument_offset,
+                                      runtime::Value* out_value,
+                                      std::string* out_error) {
+    const StringMethodArity* arity = FindStringMethod(method);
+    if (arity == nullptr) {
+        *out_error = "Metodo de string no definido: " + method;
+        return false;
+    }
+
+    const std::size_t provided = call.arguments.size() > argument_offset ? call.arguments.size() - argument_offset : 0;
+    if (provided < arity->min_arguments || provided > arity->max_arguments) {
+        *out_error = "Numero de argumentos invalido para string." + method + "().";
+        return false;
+    }
+
+    std::vector<runtime::Value> arguments(provided);
+    for (std::size_t i = 0; i < provided; ++i) {
+        const auto& argument = call.arguments[argument_offset + i];
+        if (argument.value == nullptr) {
+            *out_error = "Error interno: argumento de llamada vacio.";
+            return false;
+        }
+        if (!EvaluateExpression(*argument.value, &arguments[i], out_error)) {
+            return false;
+        }
+    }
+
+    const std::string_view view(text);
+
+    if (method == "split") {
+        runtime::Value::List parts;
+        if (arguments.empty() || arguments[0].IsNull()) {
+            // Runs of whitespace separate fields; no empty fields at the ends.
+            std::size_t index = 0;
+            while (index < text.size()) {
+                while (index < text.size() && IsAsciiSpace(text[index])) {
+                    ++index;
+                }
+                const std::size_t start = index;
+                while (index < text.size() && !IsAsciiSpace(text[index])) {
+                    ++index;
+                }
+                if (index > start) {
+                    parts.push_back(runtime::Value(text.substr(start, index - start)));
+                }
+            }
+        } else {
+            std::string separator;
+            if (!ReadTextArgument(arguments[0], &separator, out_error)) {
+                return false;
+            }
+            if (separator.empty()) {
+                *out_error = "El separador de split() no puede ser vacio.";
+                return false;
+            }
+            std::size_t start = 0;
+            while (true) {
+                const std::size_t found = runtime::FindSubstring(view, separator, start);
+                if (found == std::string_view::npos) {
+                    parts.push_back(runtime::Value(text.substr(start)));
+                    break;
+                }
+                parts.push_back(runtime::Value(text.substr(start, found - start)));
+                start = found + separator.size();
+            }
+        }
+        *out_value = runtime::Value(std::move(parts));
+        return true;
+    }
+
+    if (method == "join") {
+        std::vector<runtime::Value> elements;
+        std::string iterable_error;
+        if (!CollectForEachElements(arguments[0], &elements, &iterable_error)) {
+            *out_error = "join() requiere un iterable (list, tuple, set, map, object o string).";
+            return false;
+        }
+        std::size_t capacity = elements.empty() ? 0 : text.size() * (elements.size() - 1);
+        for (const auto& element : elements) {
+            capacity += element.EstimatedTextSize();
+        }
+        std::string joined;
+        joined.reserve(capacity);
+        for (std::size_t i = 0; i < elements.size(); ++i) {
+            if (i > 0) {
+                joined += text;
+            }
+            elements[i].AppendTo(&joined);
+        }
+        *out_value = runtime::Value(std::move(joined));
+        return true;
+    }
+
+    if (method == "find" || method == "count") {
+        std::string needle;
+        if (!ReadTextArgument(arguments[0], &needle, out_error)) {
+            return false;
+        }
+        if (method == "count") {
+            if (needle.empty()) {
+                *out_error = "count() requiere un texto a buscar no vacio.";
+                return false;
+            }
+            *out_value = runtime::Value(BigInt(static_cast<long long>(runtime::CountSubstring(view, needle))));
+            return true;
+        }
+
+        long long start = 0;
+        if (arguments.size() == 2 && (!arguments[1].IsInteger() || !ReadInteger64(arguments[1], &start) || start < 0)) {
+            *out_error = "find(): start debe ser un entero >= 0.";
+            return false;
+        }
+        const std::size_t found = runtime::FindSubstring(view, needle, static_cast<std::size_t>(start));
+        *out_value = runtime::Value(BigInt(found == std::string_view::npos ? -1LL : static_cast<long long>(found)));
+        return true;
+    }
+
+    if (method == "replace") {
+        std::string target;
+        std::string replacement;
+        if (!ReadTextArgument(arguments[0], &target, out_error) ||
+            !ReadTextArgument(arguments[1], &replacement, out_error)) {
+            return false;
+        }
+        if (target.empty()) {
+            *out_error = "replace() requiere un texto a buscar no vacio.";
+            return false;
+        }
+
+        std::size_t found = runtime::FindSubstring(view, target, 0);
+        if (found == std::string_view::npos) {
+            *out_value = runtime::Value(text);
+            return true;
+        }
+        std::string replaced;
+        replaced.reserve(replacement.size() > target.size() ? text.size() + text.size() / 4 : text.size());
+        std::size_t start = 0;
+        while (found != std::string_view::npos) {
+            replaced.append(text, start, found - start);
+            replaced += replacement;
+            start = found + target.size();
+            found = runtime::FindSubstring(view, target, start);
+        }
+        replaced.append(text, start, std::string::npos);
+        *out_value = runtime::Value(std::move(replaced));
+        return true;
+    }
+
+    if (method == "strip" || method == "lstrip" || method == "rstrip") {
+        std::string characters;
+        const bool custom = !arguments.empty() && !arguments[0].IsNull();
+        if (custom && !ReadTextArgument(arguments[0], &characters, out_error)) {
+            return false;
+        }
+        auto strippable = [&](char character) {
+            return custom ? characters.find(character) != std::string::npos : IsAsciiSpace(character);
+        };
+
+        std::size_t first = 0;
+        std::size_t last = text.size();
+        if (method != "rstrip") {
+            while (first < last && strippable(text[first])) {
+                ++first;
+            }
+        }
+        if (method != "lstrip") {
+            while (last > first && strippable(text[last - 1])) {
+                --last;
+            }
+        }
+        *out_value = runtime::Value(text.substr(first, last - first));
+        return true;
+    }
+
+    // startswith / endswith
+    std::string affix;
+    if (!ReadTextArgument(arguments[0], &affix, out_error)) {
+        return false;
+    }
+    const bool matches = affix.size() <= text.size() &&
+                         (method == "startswith" ? view.compare(0, affix.size(), affix) == 0
+                                                 : view.compare(text.size() - affix.size(), affix.size(), affix) == 0);
+    *out_value = runtime::Value(matches);
+    return true;
+}
+
 } // namespace clot::interpreter
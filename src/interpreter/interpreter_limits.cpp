@@ -0,0 +1,95 @@
+#include "clot/interpreter/interpreter.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "clot/runtime/heap.hpp"
+
+namespace clot::interpreter {
+namespace {
+
+// The clock is read once every this many checks: a statement costs well under
+// a microsecond, so the time limit overshoots by a fraction of a millisecond.
+constexpr std::uint64_t kClockCheckInterval = 256;
+
+std::uint64_t ElapsedMilliseconds(std::chrono::steady_clock::time_point since) {
+    const auto elapsed = std::chrono::steady_clock::now() - since;
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+}
+
+}  // namespace
+
+bool Interpreter::SetResourceLimits(const ResourceLimits& limits, std::string* out_error) {
+    if (limits.max_heap_bytes != 0) {
+        if (!runtime::HeapAccountingSupported()) {
+            *out_error = "El limite de memoria requiere el contador de heap, que este proceso no incluye.";
+            return false;
+        }
+        runtime::EnableHeapAccounting();
+    }
+    resource_limits_ = limits;
+    resource_limits_enabled_ = limits.max_heap_bytes != 0 || limits.max_wall_ms != 0 || limits.max_statements != 0;
+    return true;
+}
+
+void Interpreter::StartResourceBudget() {
+    statements_executed_ = 0;
+    limit_checks_ = 0;
+    time_limit_exceeded_ = false;
+    heap_baseline_ = runtime::TrackedHeapBytes();
+    run_started_ = std::chrono::steady_clock::now();
+}
+
+bool Interpreter::CheckResourceLimits(std::string* out_error) {
+    if (resource_limits_.max_statements != 0 && statements_executed_ > resource_limits_.max_statements) {
+        *out_error = "Limite de instrucciones excedido: el script supera " +
+                     std::to_string(resource_limits_.max_statements) + " sentencias ejecutadas.";
+        return false;
+    }
+
+    if (!ReserveHeap(0, out_error)) {
+        return false;
+    }
+
+    if (resource_limits_.max_wall_ms != 0) {
+        // Sticky, so a catch block cannot keep the run going.
+        if (!time_limit_exceeded_ && ++limit_checks_ % kClockCheckInterval == 0) {
+            time_limit_exceeded_ = ElapsedMilliseconds(run_started_) >= resource_limits_.max_wall_ms;
+        }
+        if (time_limit_exceeded_) {
+            *out_error = "Limite de tiempo excedido: el script supera " +
+                         std::to_string(resource_limits_.max_wall_ms) + " ms de ejecucion.";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Interpreter::ReserveHeap(std::uint64_t bytes, std::string* out_error) const {
+    if (resource_limits_.max_heap_bytes == 0) {
+        return true;
+    }
+
+    // Freeing state that predates the run can leave the difference negative.
+    const std::int64_t grown = runtime::TrackedHeapBytes() - heap_baseline_;
+    const std::uint64_t in_use = grown > 0 ? static_cast<std::uint64_t>(grown) : 0;
+    const std::uint64_t limit = resource_limits_.max_heap_bytes;
+    if (in_use <= limit && bytes <= limit - in_use) {
+        return true;
+    }
+
+    *out_error = "Limite de memoria excedido: el script usa mas de " + std::to_string(limit) + " bytes de heap.";
+    return false;
+}
+
+std::optional<std::uint64_t> Interpreter::RemainingWallMilliseconds() const {
+    if (resource_limits_.max_wall_ms == 0) {
+        return std::nullopt;
+    }
+    const std::uint64_t elapsed = ElapsedMilliseconds(run_started_);
+    return elapsed >= resource_limits_.max_wall_ms ? 0 : resource_limits_.max_wall_ms - elapsed;
+}
+
+}  // namespace clot::interpreter
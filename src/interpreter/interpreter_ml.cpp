@@ -0,0 +1,478 @@
+#include "clot/interpreter/interpreter.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "clot/runtime/ml.hpp"
+#include "clot/runtime/ndarray.hpp"
+
+namespace clot::interpreter {
+namespace {
+
+using runtime::MlActivation;
+using runtime::NdArray;
+
+struct MlBuiltinArity {
+    const char* name;
+    const char* signature;
+    std::size_t minimum;
+    std::size_t maximum;
+};
+
+constexpr MlBuiltinArity kMlBuiltins[] = {
+    {"ml_dense", "ml_dense(x, w, b, activation=\"none\")", 3, 4},
+    {"ml_dense_backward", "ml_dense_backward(x, w, y, grad_y, activation=\"none\")", 4, 5},
+    {"ml_activation", "ml_activation(x, activation)", 2, 2},
+    {"ml_activation_backward", "ml_activation_backward(y, grad_y, activation)", 3, 3},
+    {"ml_softmax", "ml_softmax(logits)", 1, 1},
+    {"ml_cross_entropy", "ml_cross_entropy(logits, labels)", 2, 2},
+    {"ml_accuracy", "ml_accuracy(logits, labels)", 2, 2},
+    {"ml_sgd", "ml_sgd(param, grad, learning_rate, momentum=0, velocity=null)", 3, 5},
+    {"ml_adam", "ml_adam(param, grad, state=null, options=null)", 2, 4},
+    {"ml_glorot", "ml_glorot(inputs, outputs, seed=0)", 2, 3},
+    {"ml_csv_open", "ml_csv_open(path, options=null)", 1, 2},
+    {"ml_csv_next", "ml_csv_next(reader, batch_size)", 2, 2},
+    {"ml_csv_reset", "ml_csv_reset(reader)", 1, 1},
+    {"ml_csv_close", "ml_csv_close(reader)", 1, 1},
+};
+
+const MlBuiltinArity* FindMlBuiltin(const std::string& name) {
+    for (const auto& builtin : kMlBuiltins) {
+        if (name == builtin.name) {
+            return &builtin;
+        }
+    }
+    return nullptr;
+}
+
+bool ReadArray(const runtime::Value& value,
+               const std::string& builtin,
+               const char* argument,
+               const NdArray** out_array,
+               std::string* out_error) {
+    *out_array = value.AsNdArray();
+    if (*out_array == nullptr) {
+        *out_error = builtin + "(): " + argument + " debe ser un ndarray.";
+        return false;
+    }
+    return true;
+}
+
+bool ReadActivation(const runtime::Value& value,
+                    const std::string& builtin,
+                    MlActivation* out_activation,
+                    std::string* out_error) {
+    if (!value.IsString() || !runtime::ParseMlActivation(value.ToString(), out_activation)) {
+        *out_error = builtin + "(): activacion desconocida (use \"none\", \"relu\", \"sigmoid\" o \"tanh\"): " +
+                     value.ToString();
+        return false;
+    }
+    return true;
+}
+
+bool ReadNumber(const runtime::Value& value,
+                const std::string& builtin,
+                const std::string& name,
+                double minimum,
+                double* out_number,
+                std::string* out_error) {
+    bool ok = value.IsNumber();
+    const double number = ok ? value.AsNumber(&ok) : 0.0;
+    if (!ok || !std::isfinite(number) || number < minimum) {
+        *out_error = builtin + "(): valor invalido para " + name + ".";
+        return false;
+    }
+    *out_number = number;
+    return true;
+}
+
+bool ReadCount(const runtime::Value& value,
+               const std::string& builtin,
+               const std::string& name,
+               long long minimum,
+               long long* out_count,
+               std::string* out_error) {
+    if (!value.IsInteger() || !runtime::Value::TryBigIntToInt64(*value.AsBigIntValue(), out_count) ||
+        *out_count < minimum) {
+        *out_error = builtin + "(): " + name + " debe ser un entero >= " + std::to_string(minimum) + ".";
+        return false;
+    }
+    return true;
+}
+
+// Optional ndarray argument or object field; null leaves `out_array` empty.
+bool ReadOptionalArray(const runtime::Value& value,
+                       const std::string& builtin,
+                       const char* argument,
+                       NdArray* out_array,
+                       std::string* out_error) {
+    if (value.IsNull()) {
+        *out_array = NdArray();
+        return true;
+    }
+    const NdArray* array = nullptr;
+    if (!ReadArray(value, builtin, argument, &array, out_error)) {
+        return false;
+    }
+    *out_array = *array;
+    return true;
+}
+
+const runtime::Value* FindField(const runtime::Value::Object& fields, const std::string& name) {
+    for (const auto& [field, value] : fields) {
+        if (field == name) {
+            return &value;
+        }
+    }
+    return nullptr;
+}
+
+}  // namespace
+
+bool Interpreter::IsMlBuiltin(const std::string& name) {
+    return FindMlBuiltin(name) != nullptr;
+}
+
+bool Interpreter::ExecuteMlBuiltin(const frontend::CallExpr& call, runtime::Value* out_value, std::string* out_error) {
+    const MlBuiltinArity* builtin = FindMlBuiltin(call.callee);
+    if (call.arguments.size() < builtin->minimum || call.arguments.size() > builtin->maximum) {
+        const std::string count =
+            builtin->minimum == builtin->maximum
+                ? std::to_string(builtin->minimum)
+                : "de " + std::to_string(builtin->minimum) + " a " + std::to_string(builtin->maximum);
+        *out_error = std::string(builtin->signature) + " requiere " + count +
+                     (builtin->maximum == 1 ? " argumento." : " argumentos.");
+        return false;
+    }
+
+    std::vector<runtime::Value> arguments(call.arguments.size());
+    for (std::size_t i = 0; i < call.arguments.size(); ++i) {
+        if (call.arguments[i].value == nullptr) {
+            *out_error = "Error interno: argumento de llamada vacio.";
+            return false;
+        }
+        if (!EvaluateExpression(*call.arguments[i].value, &arguments[i], out_error)) {
+            return false;
+        }
+    }
+    const std::string& name = call.callee;
+
+    if (name == "ml_dense" || name == "ml_dense_backward") {
+        const bool backward = name == "ml_dense_backward";
+        const NdArray* input = nullptr;
+        const NdArray* weights = nullptr;
+        const NdArray* third = nullptr;
+        if (!ReadArray(arguments[0], name, "x", &input, out_error) ||
+            !ReadArray(arguments[1], name, "w", &weights, out_error) ||
+            !ReadArray(arguments[2], name, backward ? "y" : "b", &third, out_error)) {
+            return false;
+        }
+        MlActivation activation = MlActivation::Identity;
+        const std::size_t activation_index = backward ? 4 : 3;
+        if (arguments.size() > activation_index &&
+            !ReadActivation(arguments[activation_index], name, &activation, out_error)) {
+            return false;
+        }
+        if (!backward) {
+            NdArray output;
+            if (!runtime::MlDenseForward(*input, *weights, *third, activation, &output, out_error)) {
+                return false;
+            }
+            *out_value = runtime::Value(std::move(output));
+            return true;
+        }
+
+        const NdArray* grad_output = nullptr;
+        runtime::MlDenseGradients gradients;
+        if (!ReadArray(arguments[3], name, "grad_y", &grad_output, out_error) ||
+            !runtime::MlDenseBackward(*input, *weights, *third, *grad_output, activation, &gradients, out_error)) {
+            return false;
+        }
+        runtime::Value::Object result;
+        result.emplace_back("dx", runtime::Value(std::move(gradients.input)));
+        result.emplace_back("dw", runtime::Value(std::move(gradients.weights)));
+        result.emplace_back("db", runtime::Value(std::move(gradients.bias)));
+        *out_value = runtime::Value(std::move(result));
+        return true;
+    }
+
+    if (name == "ml_activation") {
+        const NdArray* input = nullptr;
+        MlActivation activation = MlActivation::Identity;
+        if (!ReadArray(arguments[0], name, "x", &input, out_error) ||
+            !ReadActivation(arguments[1], name, &activation, out_error)) {
+            return false;
+        }
+        *out_value = runtime::Value(runtime::MlActivate(activation, *input));
+        return true;
+    }
+
+    if (name == "ml_activation_backward") {
+        const NdArray* output = nullptr;
+        const NdArray* grad_output = nullptr;
+        MlActivation activation = MlActivation::Identity;
+        NdArray grad;
+        if (!ReadArray(arguments[0], name, "y", &output, out_error) ||
+            !ReadArray(arguments[1], name, "grad_y", &grad_output, out_error) ||
+            !ReadActivation(arguments[2], name, &activation, out_error) ||
+            !runtime::MlActivationBackward(activation, *output, *grad_output, &grad, out_error)) {
+            return false;
+        }
+        *out_value = runtime::Value(std::move(grad));
+        return true;
+    }
+
+    if (name == "ml_softmax") {
+        const NdArray* logits = nullptr;
+        NdArray probabilities;
+        if (!ReadArray(arguments[0], name, "logits", &logits, out_error) ||
+            !runtime::MlSoftmax(*logits, &probabilities, out_error)) {
+            return false;
+        }
+        *out_value = runtime::Value(std::move(probabilities));
+        return true;
+    }
+
+    if (name == "ml_cross_entropy") {
+        const NdArray* logits = nullptr;
+        const NdArray* labels = nullptr;
+        double loss = 0.0;
+        NdArray grad;
+        if (!ReadArray(arguments[0], name, "logits", &logits, out_error) ||
+            !ReadArray(arguments[1], name, "labels", &labels, out_error) ||
+            !runtime::MlSoftmaxCrossEntropy(*logits, *labels, &loss, &grad, out_error)) {
+            return false;
+        }
+        runtime::Value::Object result;
+        result.emplace_back("loss", runtime::Value(loss));
+        result.emplace_back("grad", runtime::Value(std::move(grad)));
+        *out_value = runtime::Value(std::move(result));
+        return true;
+    }
+
+    if (name == "ml_accuracy") {
+        const NdArray* logits = nullptr;
+        const NdArray* labels = nullptr;
+        double accuracy = 0.0;
+        if (!ReadArray(arguments[0], name, "logits", &logits, out_error) ||
+            !ReadArray(arguments[1], name, "labels", &labels, out_error) ||
+            !runtime::MlAccuracy(*logits, *labels, &accuracy, out_error)) {
+            return false;
+        }
+        *out_value = runtime::Value(accuracy);
+        return true;
+    }
+
+    if (name == "ml_sgd") {
+        const NdArray* param = nullptr;
+        const NdArray* grad = nullptr;
+        double learning_rate = 0.0;
+        double momentum = 0.0;
+        NdArray velocity;
+        if (!ReadArray(arguments[0], name, "param", &param, out_error) ||
+            !ReadArray(arguments[1], name, "grad", &grad, out_error) ||
+            !ReadNumber(arguments[2], name, "learning_rate", 0.0, &learning_rate, out_error) ||
+            (arguments.size() > 3 && !ReadNumber(arguments[3], name, "momentum", 0.0, &momentum, out_error)) ||
+            (arguments.size() > 4 && !ReadOptionalArray(arguments[4], name, "velocity", &velocity, out_error))) {
+            return false;
+        }
+        NdArray next;
+        NdArray next_velocity;
+        if (!runtime::MlSgdStep(*param, *grad, velocity, learning_rate, momentum, &next, &next_velocity, out_error)) {
+            return false;
+        }
+        // Plain SGD has no state, so the updated parameter comes back alone.
+        if (momentum == 0.0) {
+            *out_value = runtime::Value(std::move(next));
+            return true;
+        }
+        runtime::Value::Object result;
+        result.emplace_back("param", runtime::Value(std::move(next)));
+        result.emplace_back("velocity", runtime::Value(std::move(next_velocity)));
+        *out_value = runtime::Value(std::move(result));
+        return true;
+    }
+
+    if (name == "ml_adam") {
+        const NdArray* param = nullptr;
+        const NdArray* grad = nullptr;
+        if (!ReadArray(arguments[0], name, "param", &param, out_error) ||
+            !ReadArray(arguments[1], name, "grad", &grad, out_error)) {
+            return false;
+        }
+
+        // state: null before the first step, then the {m, v, t} object the
+        // previous call returned.
+        NdArray first;
+        NdArray second;
+        long long step = 0;
+        if (arguments.size() > 2 && !arguments[2].IsNull()) {
+            const auto* fields = arguments[2].AsObject();
+            const runtime::Value* m = fields == nullptr ? nullptr : FindField(*fields, "m");
+            const runtime::Value* v = fields == nullptr ? nullptr : FindField(*fields, "v");
+            const runtime::Value* t = fields == nullptr ? nullptr : FindField(*fields, "t");
+            if (m == nullptr || v == nullptr || t == nullptr) {
+                *out_error = "ml_adam(): state debe ser null o un object {m, v, t}.";
+                return false;
+            }
+            if (!ReadOptionalArray(*m, name, "state.m", &first, out_error) ||
+                !ReadOptionalArray(*v, name, "state.v", &second, out_error) ||
+                !ReadCount(*t, name, "state.t", 0, &step, out_error)) {
+                return false;
+            }
+        }
+
+        runtime::MlAdamOptions options;
+        if (arguments.size() > 3 && !arguments[3].IsNull()) {
+            const auto* fields = arguments[3].AsObject();
+            if (fields == nullptr) {
+                *out_error = "ml_adam(): options debe ser un object o null.";
+                return false;
+            }
+            for (const auto& [field, value] : *fields) {
+                double* target = field == "learning_rate" ? &options.learning_rate
+                                 : field == "beta1"       ? &options.beta1
+                                 : field == "beta2"       ? &options.beta2
+                                 : field == "epsilon"     ? &options.epsilon
+                                                          : nullptr;
+                if (target == nullptr) {
+                    *out_error = "ml_adam(): opcion desconocida: " + field;
+                    return false;
+                }
+                if (!ReadNumber(value, name, field, 0.0, target, out_error)) {
+                    return false;
+                }
+            }
+            if (options.beta1 >= 1.0 || options.beta2 >= 1.0) {
+                *out_error = "ml_adam(): beta1 y beta2 deben ser menores que 1.";
+                return false;
+            }
+        }
+
+        const std::uint64_t next_step = static_cast<std::uint64_t>(step) + 1;
+        NdArray next;
+        NdArray next_first;
+        NdArray next_second;
+        if (!runtime::MlAdamStep(*param, *grad, first, second, next_step, options, &next, &next_first, &next_second,
+                                 out_error)) {
+            return false;
+        }
+        runtime::Value::Object state;
+        state.emplace_back("m", runtime::Value(std::move(next_first)));
+        state.emplace_back("v", runtime::Value(std::move(next_second)));
+        state.emplace_back("t", runtime::Value(static_cast<long long>(next_step)));
+        runtime::Value::Object result;
+        result.emplace_back("param", runtime::Value(std::move(next)));
+        result.emplace_back("state", runtime::Value(std::move(state)));
+        *out_value = runtime::Value(std::move(result));
+        return true;
+    }
+
+    if (name == "ml_glorot") {
+        long long inputs = 0;
+        long long outputs = 0;
+        long long seed = 0;
+        if (!ReadCount(arguments[0], name, "inputs", 1, &inputs, out_error) ||
+            !ReadCount(arguments[1], name, "outputs", 1, &outputs, out_error) ||
+            (arguments.size() > 2 && !ReadCount(arguments[2], name, "seed", 0, &seed, out_error))) {
+            return false;
+        }
+        *out_value = runtime::Value(runtime::MlGlorotUniform(static_cast<std::size_t>(inputs),
+                                                             static_cast<std::size_t>(outputs),
+                                                             static_cast<std::uint64_t>(seed)));
+        return true;
+    }
+
+    if (name == "ml_csv_open") {
+        // options: {delimiter, label_column}; label_column null reads
+        // features only.
+        runtime::MlCsvOptions options;
+        if (arguments.size() > 1 && !arguments[1].IsNull()) {
+            const auto* fields = arguments[1].AsObject();
+            if (fields == nullptr) {
+                *out_error = "ml_csv_open(): options debe ser un object o null.";
+                return false;
+            }
+            for (const auto& [field, value] : *fields) {
+                if (field == "delimiter") {
+                    const std::string text = value.ToString();
+                    if (!(value.IsString() || value.IsChar()) || text.size() != 1) {
+                        *out_error = "ml_csv_open(): delimiter debe ser un unico caracter.";
+                        return false;
+                    }
+                    options.delimiter = text[0];
+                } else if (field == "label_column") {
+                    long long column = 0;
+                    if (value.IsNull()) {
+                        options.has_labels = false;
+                    } else if (!value.IsInteger() ||
+                               !runtime::Value::TryBigIntToInt64(*value.AsBigIntValue(), &column)) {
+                        *out_error = "ml_csv_open(): label_column debe ser un entero o null.";
+                        return false;
+                    }
+                    options.label_column = static_cast<std::ptrdiff_t>(column);
+                } else {
+                    *out_error = "ml_csv_open(): opcion desconocida: " + field;
+                    return false;
+                }
+            }
+        }
+        auto reader = std::make_shared<runtime::MlCsvReader>();
+        if (!reader->Open(arguments[0].ToString(), options, out_error)) {
+            return false;
+        }
+        const long long id = next_ml_csv_reader_id_++;
+        ml_csv_readers_[id] = std::move(reader);
+        *out_value = runtime::Value(id);
+        return true;
+    }
+
+    // ml_csv_next / ml_csv_reset / ml_csv_close.
+    long long id = 0;
+    if (!ReadCount(arguments[0], name, "reader", 1, &id, out_error)) {
+        return false;
+    }
+    const auto reader = ml_csv_readers_.find(id);
+    if (reader == ml_csv_readers_.end()) {
+        *out_error = "Lector CSV no encontrado: " + std::to_string(id);
+        return false;
+    }
+    if (name == "ml_csv_close") {
+        ml_csv_readers_.erase(reader);
+        *out_value = runtime::Value(nullptr);
+        return true;
+    }
+    if (name == "ml_csv_reset") {
+        if (!reader->second->Rewind(out_error)) {
+            return false;
+        }
+        *out_value = runtime::Value(nullptr);
+        return true;
+    }
+
+    long long batch_size = 0;
+    if (!ReadCount(arguments[1], name, "batch_size", 1, &batch_size, out_error)) {
+        return false;
+    }
+    NdArray features;
+    NdArray labels;
+    bool done = false;
+    if (!reader->second->Next(static_cast<std::size_t>(batch_size), &features, &labels, &done, out_error)) {
+        return false;
+    }
+    if (done) {
+        *out_value = runtime::Value(nullptr);
+        return true;
+    }
+    runtime::Value::Object result;
+    result.emplace_back("x", runtime::Value(std::move(features)));
+    result.emplace_back("y", labels.Size() > 0 ? runtime::Value(std::move(labels)) : runtime::Value(nullptr));
+    *out_value = runtime::Value(std::move(result));
+    return true;
+}
+
+}  // namespace clot::interpreter
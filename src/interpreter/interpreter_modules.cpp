@@ -10,7 +10,10 @@
 
 #include "clot/frontend/parser.hpp"
 #include "clot/frontend/source_loader.hpp"
+#include "clot/interpreter/module_cache.hpp"
+#include "clot/runtime/counters.hpp"
 #include "clot/runtime/paths.hpp"
+#include "clot/runtime/profiler.hpp"
 
 namespace clot::interpreter {
 
@@ -44,8 +47,11 @@ void AddUniqueCandidate(
     if (candidates == nullptr) {
         return;
     }
+    // Candidates are built from the same roots, so comparing the native strings
+    // is enough; path::operator== compares element by element and made this
+    // quadratic scan dominate import time.
     for (const auto& existing : *candidates) {
-        if (existing == candidate) {
+        if (existing.native() == candidate.native()) {
             return;
         }
     }
@@ -178,17 +184,27 @@ bool Interpreter::ExecuteModuleFile(const std::filesystem::path& module_path,
         }
     }
 
-    std::vector<std::string> lines;
+    runtime::CountEvent(runtime::Counter::ModuleLoads);
+    std::shared_ptr<const frontend::Program> program;
+    frontend::Diagnostic diagnostic;
     std::string load_error;
-    if (!frontend::LoadSourceLines(module_path.string(), &lines, &load_error)) {
+    bool loaded = false;
+    if (module_cache_ != nullptr) {
+        loaded = module_cache_->Load(module_path, &program, &diagnostic, &load_error);
+    } else {
+        std::vector<std::string> lines;
+        if (frontend::LoadSourceLines(module_path.string(), &lines, &load_error)) {
+            frontend::Parser parser(std::move(lines));
+            auto parsed = std::make_shared<frontend::Program>();
+            loaded = parser.Parse(parsed.get(), &diagnostic);
+            program = std::move(parsed);
+        }
+    }
+    if (!loaded && !load_error.empty()) {
         *out_error = "Error importando modulo '" + module_path.string() + "': " + load_error;
         return false;
     }
-
-    frontend::Parser parser(std::move(lines));
-    auto program = std::make_unique<frontend::Program>();
-    frontend::Diagnostic diagnostic;
-    if (!parser.Parse(program.get(), &diagnostic)) {
+    if (!loaded) {
         *out_error =
             "Error de parseo importando modulo '" + module_path.string() + "' en linea " +
             std::to_string(diagnostic.line) +
@@ -197,13 +213,19 @@ bool Interpreter::ExecuteModuleFile(const std::filesystem::path& module_path,
     }
 
     module_base_dirs_.push_back(module_path.parent_path());
-    const bool executed = ExecuteBlock(program->statements, out_error);
+    bool executed = false;
+    {
+        const runtime::ProfileFunctionScope profile_module(
+            profiler_,
+            profiler_ != nullptr ? "<" + module_path.filename().string() + ">" : std::string());
+        executed = ExecuteBlock(program->statements, out_error);
+    }
     module_base_dirs_.pop_back();
     if (!executed) {
         return false;
     }
 
-    loaded_module_programs_.push_back(std::move(program));
+    loaded_module_programs_.push_back({module_path, std::move(program)});
 
     if (out_exports != nullptr) {
         for (const auto& entry : environment_) {
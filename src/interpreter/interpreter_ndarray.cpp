@@ -0,0 +1,735 @@
+#include "clot/interpreter/interpreter.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "clot/runtime/ndarray.hpp"
+#include "clot/runtime/ndarray_linalg.hpp"
+
+namespace clot::interpreter {
+namespace {
+
+using BigInt = runtime::Value::BigInt;
+using runtime::NdArray;
+using runtime::NdScalar;
+using runtime::NdType;
+
+struct NdArrayMethodArity {
+    const char* name;
+    std::size_t min_arguments;
+    std::size_t max_arguments;
+};
+
+constexpr NdArrayMethodArity kNdArrayMethods[] = {
+    {"shape", 0, 0},     {"ndim", 0, 0},   {"size", 0, 0},    {"dtype", 0, 0},  {"sum", 0, 0},
+    {"mean", 0, 0},      {"min", 0, 0},    {"max", 0, 0},     {"dot", 1, 1},    {"slice", 2, 4},
+    {"reshape", 1, 1},   {"transpose", 0, 0}, {"astype", 1, 1}, {"tolist", 0, 0},
+    {"lu", 0, 0},        {"qr", 0, 0},     {"cholesky", 0, 0}, {"eigh", 0, 0}, {"solve", 1, 1},
+    {"inv", 0, 0},       {"det", 0, 0},
+};
+
+const NdArrayMethodArity* FindNdArrayMethod(const std::string& name) {
+    for (const auto& method : kNdArrayMethods) {
+        if (name == method.name) {
+            return &method;
+        }
+    }
+    return nullptr;
+}
+
+runtime::Value ScalarToValue(const NdScalar& scalar) {
+    switch (scalar.type) {
+    case NdType::Int64:
+        return runtime::Value(static_cast<long long>(scalar.integer));
+    case NdType::Float32:
+        return runtime::Value(static_cast<float>(scalar.real));
+    case NdType::Float64:
+        break;
+    }
+    return runtime::Value(scalar.real);
+}
+
+runtime::Value SizeValue(std::size_t size) {
+    return runtime::Value(static_cast<long long>(size));
+}
+
+bool ReadInt64(const runtime::Value& value, std::int64_t* out_integer) {
+    BigInt integer;
+    long long narrowed = 0;
+    if (!value.AsBigInt(&integer) || !runtime::Value::TryBigIntToInt64(integer, &narrowed)) {
+        return false;
+    }
+    *out_integer = narrowed;
+    return true;
+}
+
+bool ReadNdType(const runtime::Value& value, NdType* out_type, std::string* out_error) {
+    if (!value.IsString() || !runtime::ParseNdType(*value.AsStringValue(), out_type)) {
+        *out_error = "dtype invalido: " + value.ToString() + ". Use float64, float32 o int64.";
+        return false;
+    }
+    return true;
+}
+
+// Bytes of a contiguous buffer of `shape`, saturating instead of wrapping.
+std::uint64_t StorageBytes(const std::vector<std::size_t>& shape, NdType type) {
+    std::uint64_t bytes = runtime::NdTypeSize(type);
+    for (const std::size_t extent : shape) {
+        if (extent != 0 && bytes > std::numeric_limits<std::uint64_t>::max() / extent) {
+            return std::numeric_limits<std::uint64_t>::max();
+        }
+        bytes *= extent;
+    }
+    return bytes;
+}
+
+// A shape is a non-negative integer or a list/tuple of them.
+bool ReadShape(const runtime::Value& value, std::vector<std::size_t>* out_shape, std::string* out_error) {
+    static const char* kError = "La forma de un ndarray debe ser un entero o una lista de enteros >= 0.";
+    out_shape->clear();
+    std::vector<runtime::Value> extents;
+    if (const auto* list = value.AsList()) {
+        extents = *list;
+    } else if (const auto* tuple = value.AsTuple()) {
+        extents = *tuple;
+    } else {
+        extents.push_back(value);
+    }
+    if (extents.empty()) {
+        *out_error = kError;
+        return false;
+    }
+    for (const auto& extent : extents) {
+        std::int64_t integer = 0;
+        if (!ReadInt64(extent, &integer) || integer < 0) {
+            *out_error = kError;
+            return false;
+        }
+        out_shape->push_back(static_cast<std::size_t>(integer));
+    }
+    return true;
+}
+
+// Walks a rectangular nest of lists/tuples in row-major order, recording the
+// shape from the first branch and checking every other branch against it.
+bool CollectNestedLeaves(const runtime::Value& value,
+                         std::size_t depth,
+                         std::vector<std::size_t>* shape,
+                         std::vector<const runtime::Value*>* leaves,
+                         std::string* out_error) {
+    const std::vector<runtime::Value>* items = value.AsList();
+    if (items == nullptr) {
+        items = value.AsTuple();
+    }
+
+    if (items == nullptr) {
+        if (depth != shape->size()) {
+            *out_error = "ndarray() requiere listas anidadas rectangulares.";
+            return false;
+        }
+        if (!value.IsNumber()) {
+            *out_error = "ndarray() solo admite elementos numericos: " + value.ToString();
+            return false;
+        }
+        leaves->push_back(&value);
+        return true;
+    }
+
+    if (depth == shape->size()) {
+        if (!leaves->empty()) {
+            *out_error = "ndarray() requiere listas anidadas rectangulares.";
+            return false;
+        }
+        shape->push_back(items->size());
+    } else if ((*shape)[depth] != items->size()) {
+        *out_error = "ndarray() requiere listas anidadas rectangulares.";
+        return false;
+    }
+
+    for (const auto& item : *items) {
+        if (!CollectNestedLeaves(item, depth + 1, shape, leaves, out_error)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool FillFromLeaves(const std::vector<const runtime::Value*>& leaves, NdArray* array, std::string* out_error) {
+    if (array->Type() == NdType::Int64) {
+        std::int64_t* target = array->MutableData<std::int64_t>();
+        for (const runtime::Value* leaf : leaves) {
+            if (!ReadInt64(*leaf, target)) {
+                *out_error = "Valor no representable como int64: " + leaf->ToString();
+                return false;
+            }
+            ++target;
+        }
+        return true;
+    }
+
+    bool ok = false;
+    if (array->Type() == NdType::Float32) {
+        float* target = array->MutableData<float>();
+        for (const runtime::Value* leaf : leaves) {
+            *target++ = static_cast<float>(leaf->AsNumber(&ok));
+        }
+        return true;
+    }
+    double* target = array->MutableData<double>();
+    for (const runtime::Value* leaf : leaves) {
+        *target++ = leaf->AsNumber(&ok);
+    }
+    return true;
+}
+
+// Builds an array from a (nested) list or tuple, a range or another ndarray.
+// Without an explicit dtype, all-integer data becomes int64 and anything else
+// float64.
+bool ValueToNdArray(const runtime::Value& data,
+                    const NdType* requested_type,
+                    NdArray* out_array,
+                    std::string* out_error) {
+    if (const auto* array = data.AsNdArray()) {
+        *out_array = requested_type == nullptr ? *array : array->AsType(*requested_type);
+        return true;
+    }
+
+    if (const auto* range = data.AsRange()) {
+        const BigInt length = data.RangeLength();
+        long long count = 0;
+        long long start = 0;
+        long long step = 0;
+        long long last = 0;
+        if (!runtime::Value::TryBigIntToInt64(length, &count) ||
+            !runtime::Value::TryBigIntToInt64(range->start, &start) ||
+            !runtime::Value::TryBigIntToInt64(range->step, &step) ||
+            (count > 0 && !runtime::Value::TryBigIntToInt64(data.RangeElementAt(length - BigInt(1)), &last))) {
+            *out_error = "Valor no representable como int64: " + data.ToString();
+            return false;
+        }
+        NdArray values = NdArray::Zeros(NdType::Int64, {static_cast<std::size_t>(count)});
+        std::int64_t* target = values.MutableData<std::int64_t>();
+        for (long long i = 0; i < count; ++i) {
+            target[i] = start + i * step;
+        }
+        *out_array = requested_type == nullptr ? std::move(values) : values.AsType(*requested_type);
+        return true;
+    }
+
+    if (!data.IsList() && !data.IsTuple()) {
+        *out_error = "ndarray() requiere una lista, tuple, range o ndarray.";
+        return false;
+    }
+
+    std::vector<std::size_t> shape;
+    std::vector<const runtime::Value*> leaves;
+    if (!CollectNestedLeaves(data, 0, &shape, &leaves, out_error)) {
+        return false;
+    }
+
+    NdType type = NdType::Int64;
+    if (requested_type != nullptr) {
+        type = *requested_type;
+    } else {
+        for (const runtime::Value* leaf : leaves) {
+            if (!leaf->IsInteger()) {
+                type = NdType::Float64;
+                break;
+            }
+        }
+    }
+
+    NdArray values = NdArray::Zeros(type, std::move(shape));
+    if (!FillFromLeaves(leaves, &values, out_error)) {
+        return false;
+    }
+    *out_array = std::move(values);
+    return true;
+}
+
+// Operand of an arithmetic expression with an ndarray on the other side.
+// Scalars adopt the array's dtype where they fit (NumPy's rule for Python
+// scalars), so `float32_array * 2.5` stays float32.
+bool OperandToNdArray(const runtime::Value& value, NdType peer_type, NdArray* out_array, std::string* out_error) {
+    if (value.IsNdArray() || value.IsList() || value.IsTuple() || value.IsRange()) {
+        return ValueToNdArray(value, nullptr, out_array, out_error);
+    }
+
+    if (!value.IsNumber()) {
+        *out_error = "Operacion no soportada entre ndarray y " + value.ToString();
+        return false;
+    }
+
+    NdScalar scalar;
+    std::int64_t integer = 0;
+    bool ok = false;
+    if (value.IsInteger() && ReadInt64(value, &integer)) {
+        scalar.type = peer_type;
+        scalar.integer = integer;
+        scalar.real = static_cast<double>(integer);
+    } else {
+        scalar.type = peer_type == NdType::Float32 ? NdType::Float32 : NdType::Float64;
+        scalar.real = value.AsNumber(&ok);
+    }
+    *out_array = NdArray::FromScalar(scalar);
+    return true;
+}
+
+runtime::Value NdArrayToList(const NdArray& array) {
+    runtime::Value::List items;
+    items.reserve(array.Shape()[0]);
+    for (std::size_t i = 0; i < array.Shape()[0]; ++i) {
+        if (array.Rank() == 1) {
+            items.push_back(ScalarToValue(array.At(i)));
+        } else {
+            items.push_back(NdArrayToList(array.Select(0, i)));
+        }
+    }
+    return runtime::Value(std::move(items));
+}
+
+// Python-style slice bounds: negative positions count from the end and
+// out-of-range positions are clamped.
+std::ptrdiff_t NormalizeSliceBound(std::int64_t position, std::size_t extent, std::ptrdiff_t step) {
+    const auto length = static_cast<std::int64_t>(extent);
+    if (position < 0) {
+        position += length;
+    }
+    const std::int64_t lower = step > 0 ? 0 : -1;
+    const std::int64_t upper = step > 0 ? length : length - 1;
+    if (position < lower) {
+        position = lower;
+    }
+    if (position > upper) {
+        position = upper;
+    }
+    return static_cast<std::ptrdiff_t>(position);
+}
+
+}  // namespace
+
+bool Interpreter::IsNdArrayBuiltin(const std::string& name) {
+    return name == "ndarray" || name == "nd_zeros" || name == "nd_ones" || name == "nd_full" ||
+           name == "nd_arange" || name == "nd_eye";
+}
+
+runtime::Value Interpreter::NdArrayItem(const runtime::NdArray& array, std::size_t index) {
+    if (array.Rank() == 1) {
+        return ScalarToValue(array.At(index));
+    }
+    return runtime::Value(array.Select(0, index));
+}
+
+bool Interpreter::ExecuteNdArrayBuiltin(const frontend::CallExpr& call,
+                                        runtime::Value* out_value,
+                                        std::string* out_error) {
+    std::vector<runtime::Value> arguments(call.arguments.size());
+    for (std::size_t i = 0; i < call.arguments.size(); ++i) {
+        if (call.arguments[i].value == nullptr) {
+            *out_error = "Error interno: argumento de llamada vacio.";
+            return false;
+        }
+        if (!EvaluateExpression(*call.arguments[i].value, &arguments[i], out_error)) {
+            return false;
+        }
+    }
+
+    if (call.callee == "ndarray") {
+        if (arguments.empty() || arguments.size() > 2) {
+            *out_error = "ndarray(data, dtype=null) requiere 1 o 2 argumentos.";
+            return false;
+        }
+        NdType type = NdType::Float64;
+        const bool has_type = arguments.size() == 2 && !arguments[1].IsNull();
+        if (has_type && !ReadNdType(arguments[1], &type, out_error)) {
+            return false;
+        }
+        NdArray array;
+        if (!ValueToNdArray(arguments[0], has_type ? &type : nullptr, &array, out_error)) {
+            return false;
+        }
+        *out_value = runtime::Value(std::move(array));
+        return true;
+    }
+
+    if (call.callee == "nd_zeros" || call.callee == "nd_ones" || call.callee == "nd_full") {
+        const bool is_full = call.callee == "nd_full";
+        const std::size_t required = is_full ? 2 : 1;
+        if (arguments.size() < required || arguments.size() > required + 1) {
+            *out_error = is_full ? "nd_full(shape, value, dtype=\"float64\") requiere 2 o 3 argumentos."
+                                 : call.callee + "(shape, dtype=\"float64\") requiere 1 o 2 argumentos.";
+            return false;
+        }
+        std::vector<std::size_t> shape;
+        if (!ReadShape(arguments[0], &shape, out_error)) {
+            return false;
+        }
+        NdType type = NdType::Float64;
+        if (arguments.size() > required && !ReadNdType(arguments[required], &type, out_error)) {
+            return false;
+        }
+        if (!ReserveHeap(StorageBytes(shape, type), out_error)) {
+            return false;
+        }
+
+        NdScalar fill;
+        fill.type = NdType::Int64;
+        fill.integer = call.callee == "nd_ones" ? 1 : 0;
+        if (is_full) {
+            if (!arguments[1].IsNumber()) {
+                *out_error = "nd_full() requiere un valor numerico.";
+                return false;
+            }
+            if (!ReadInt64(arguments[1], &fill.integer) || !arguments[1].IsInteger()) {
+                bool ok = false;
+                fill.type = NdType::Float64;
+                fill.real = arguments[1].AsNumber(&ok);
+            }
+        }
+        NdArray array = NdArray::Full(type, std::move(shape), fill);
+        *out_value = runtime::Value(std::move(array));
+        return true;
+    }
+
+    if (call.callee == "nd_eye") {
+        if (arguments.empty() || arguments.size() > 2) {
+            *out_error = "nd_eye(n, dtype=\"float64\") requiere 1 o 2 argumentos.";
+            return false;
+        }
+        std::int64_t size = 0;
+        if (!ReadInt64(arguments[0], &size) || size < 0) {
+            *out_error = "nd_eye() requiere un entero >= 0.";
+            return false;
+        }
+        NdType type = NdType::Float64;
+        if (arguments.size() == 2 && !ReadNdType(arguments[1], &type, out_error)) {
+            return false;
+        }
+        const auto extent = static_cast<std::size_t>(size);
+        if (!ReserveHeap(StorageBytes({extent, extent}, NdType::Int64), out_error)) {
+            return false;
+        }
+        NdArray identity = NdArray::Zeros(NdType::Int64, {extent, extent});
+        std::int64_t* target = identity.MutableData<std::int64_t>();
+        for (std::size_t i = 0; i < extent; ++i) {
+            target[i * extent + i] = 1;
+        }
+        *out_value = runtime::Value(identity.AsType(type));
+        return true;
+    }
+
+    // nd_arange(stop) / nd_arange(start, stop) / nd_arange(start, stop, step)
+    if (arguments.empty() || arguments.size() > 3) {
+        *out_error = "nd_arange(start, stop, step) requiere de 1 a 3 argumentos.";
+        return false;
+    }
+    bool all_integers = true;
+    std::vector<double> bounds;
+    for (const auto& argument : arguments) {
+        if (!argument.IsNumber()) {
+            *out_error = "nd_arange() requiere argumentos numericos.";
+            return false;
+        }
+        bool ok = false;
+        bounds.push_back(argument.AsNumber(&ok));
+        std::int64_t ignored = 0;
+        all_integers = all_integers && argument.IsInteger() && ReadInt64(argument, &ignored);
+    }
+    const double start = bounds.size() == 1 ? 0.0 : bounds[0];
+    const double stop = bounds.size() == 1 ? bounds[0] : bounds[1];
+    const double step = bounds.size() == 3 ? bounds[2] : 1.0;
+    if (step == 0.0 || !std::isfinite(start) || !std::isfinite(stop) || !std::isfinite(step)) {
+        *out_error = "nd_arange() requiere limites finitos y step distinto de 0.";
+        return false;
+    }
+    const double span = std::ceil((stop - start) / step);
+    const auto count = static_cast<std::size_t>(span > 0.0 ? span : 0.0);
+    if (!ReserveHeap(StorageBytes({count}, NdType::Int64), out_error)) {
+        return false;
+    }
+    NdArray values = NdArray::Zeros(all_integers ? NdType::Int64 : NdType::Float64, {count});
+    if (all_integers) {
+        std::int64_t* target = values.MutableData<std::int64_t>();
+        const auto first = static_cast<std::int64_t>(start);
+        const auto increment = static_cast<std::int64_t>(step);
+        for (std::size_t i = 0; i < count; ++i) {
+            target[i] = first + static_cast<std::int64_t>(i) * increment;
+        }
+    } else {
+        double* target = values.MutableData<double>();
+        for (std::size_t i = 0; i < count; ++i) {
+            target[i] = start + static_cast<double>(i) * step;
+        }
+    }
+    *out_value = runtime::Value(std::move(values));
+    return true;
+}
+
+bool Interpreter::IsNdArrayMethod(const std::string& name) {
+    return FindNdArrayMethod(name) != nullptr;
+}
+
+bool Interpreter::ExecuteNdArrayMethod(const runtime::NdArray& array,
+                                       const std::string& method,
+                                       const frontend::CallExpr& call,
+                                       std::size_t argument_offset,
+                                       runtime::Value* out_value,
+                                       std::string* out_error) {
+    const NdArrayMethodArity* arity = FindNdArrayMethod(method);
+    if (arity == nullptr) {
+        *out_error = "Metodo de ndarray no definido: " + method;
+        return false;
+    }
+
+    const std::size_t provided = call.arguments.size() > argument_offset ? call.arguments.size() - argument_offset : 0;
+    if (provided < arity->min_arguments || provided > arity->max_arguments) {
+        *out_error = "Numero de argumentos invalido para ndarray." + method + "().";
+        return false;
+    }
+
+    std::vector<runtime::Value> arguments(provided);
+    for (std::size_t i = 0; i < provided; ++i) {
+        const auto& argument = call.arguments[argument_offset + i];
+        if (argument.value == nullptr) {
+            *out_error = "Error interno: argumento de llamada vacio.";
+            return false;
+        }
+        if (!EvaluateExpression(*argument.value, &arguments[i], out_error)) {
+            return false;
+        }
+    }
+
+    if (method == "shape") {
+        runtime::Value::Tuple shape;
+        for (const std::size_t extent : array.Shape()) {
+            shape.elements.push_back(SizeValue(extent));
+        }
+        *out_value = runtime::Value(std::move(shape));
+        return true;
+    }
+    if (method == "ndim") {
+        *out_value = SizeValue(array.Rank());
+        return true;
+    }
+    if (method == "size") {
+        *out_value = SizeValue(array.Size());
+        return true;
+    }
+    if (method == "dtype") {
+        *out_value = runtime::Value(runtime::NdTypeName(array.Type()));
+        return true;
+    }
+
+    if (method == "sum" || method == "min" || method == "max" || method == "mean") {
+        NdScalar result;
+        bool ok = false;
+        if (method == "mean") {
+            ok = runtime::NdMean(array, &result, out_error);
+        } else {
+            const runtime::NdReduceOp op = method == "sum"   ? runtime::NdReduceOp::Sum
+                                           : method == "min" ? runtime::NdReduceOp::Min
+                                                             : runtime::NdReduceOp::Max;
+            ok = runtime::NdReduce(op, array, &result, out_error);
+        }
+        if (!ok) {
+            return false;
+        }
+        *out_value = ScalarToValue(result);
+        return true;
+    }
+
+    if (method == "dot") {
+        NdArray other;
+        if (!ValueToNdArray(arguments[0], nullptr, &other, out_error)) {
+            return false;
+        }
+        NdArray product;
+        NdScalar scalar;
+        bool is_scalar = false;
+        if (!runtime::NdDot(array, other, &product, &scalar, &is_scalar, out_error)) {
+            return false;
+        }
+        *out_value = is_scalar ? ScalarToValue(scalar) : runtime::Value(std::move(product));
+        return true;
+    }
+
+    if (method == "lu" || method == "qr" || method == "eigh") {
+        // Multi-part results come back as tuples: (P, L, U), (Q, R) and
+        // (eigenvalues, eigenvectors).
+        std::vector<NdArray> parts(method == "lu" ? 3 : 2);
+        const bool ok = method == "lu"   ? runtime::NdLu(array, &parts[0], &parts[1], &parts[2], out_error)
+                        : method == "qr" ? runtime::NdQr(array, &parts[0], &parts[1], out_error)
+                                         : runtime::NdEigh(array, &parts[0], &parts[1], out_error);
+        if (!ok) {
+            return false;
+        }
+        runtime::Value::Tuple result;
+        for (auto& part : parts) {
+            result.elements.emplace_back(std::move(part));
+        }
+        *out_value = runtime::Value(std::move(result));
+        return true;
+    }
+
+    if (method == "cholesky" || method == "inv" || method == "solve") {
+        NdArray result;
+        bool ok = false;
+        if (method == "cholesky") {
+            ok = runtime::NdCholesky(array, &result, out_error);
+        } else if (method == "inv") {
+            ok = runtime::NdInverse(array, &result, out_error);
+        } else {
+            NdArray rhs;
+            ok = ValueToNdArray(arguments[0], nullptr, &rhs, out_error) &&
+                 runtime::NdSolve(array, rhs, &result, out_error);
+        }
+        if (!ok) {
+            return false;
+        }
+        *out_value = runtime::Value(std::move(result));
+        return true;
+    }
+
+    if (method == "det") {
+        double determinant = 0.0;
+        if (!runtime::NdDeterminant(array, &determinant, out_error)) {
+            return false;
+        }
+        *out_value = runtime::Value(determinant);
+        return true;
+    }
+
+    if (method == "slice") {
+        // slice(start, stop, step=1, axis=0)
+        std::int64_t start = 0;
+        std::int64_t stop = 0;
+        std::int64_t step = 1;
+        std::int64_t axis = 0;
+        if (!ReadInt64(arguments[0], &start) || !ReadInt64(arguments[1], &stop) ||
+            (provided > 2 && !ReadInt64(arguments[2], &step)) || (provided > 3 && !ReadInt64(arguments[3], &axis))) {
+            *out_error = "ndarray.slice(start, stop, step, axis) requiere argumentos enteros.";
+            return false;
+        }
+        if (step == 0) {
+            *out_error = "ndarray.slice(): step no puede ser 0.";
+            return false;
+        }
+        if (axis < 0 || static_cast<std::size_t>(axis) >= array.Rank()) {
+            *out_error = "ndarray.slice(): eje fuera de rango.";
+            return false;
+        }
+        const std::size_t extent = array.Shape()[static_cast<std::size_t>(axis)];
+        const auto stride = static_cast<std::ptrdiff_t>(step);
+        *out_value = runtime::Value(array.Slice(static_cast<std::size_t>(axis),
+                                                NormalizeSliceBound(start, extent, stride),
+                                                NormalizeSliceBound(stop, extent, stride),
+                                                stride));
+        return true;
+    }
+
+    if (method == "reshape") {
+        // One extent may be -1 and is inferred from the others.
+        std::vector<runtime::Value> extents;
+        if (const auto* list = arguments[0].AsList()) {
+            extents = *list;
+        } else if (const auto* tuple = arguments[0].AsTuple()) {
+            extents = *tuple;
+        } else {
+            extents.push_back(arguments[0]);
+        }
+        std::vector<std::size_t> shape;
+        std::size_t known = 1;
+        std::size_t inferred_axis = extents.size();
+        for (std::size_t axis = 0; axis < extents.size(); ++axis) {
+            std::int64_t extent = 0;
+            if (!ReadInt64(extents[axis], &extent) || extent < -1 || (extent == -1 && inferred_axis != extents.size())) {
+                *out_error = "La forma de un ndarray debe ser un entero o una lista de enteros >= 0.";
+                return false;
+            }
+            if (extent == -1) {
+                inferred_axis = axis;
+                shape.push_back(0);
+                continue;
+            }
+            shape.push_back(static_cast<std::size_t>(extent));
+            known *= static_cast<std::size_t>(extent);
+        }
+        if (shape.empty()) {
+            *out_error = "La forma de un ndarray debe ser un entero o una lista de enteros >= 0.";
+            return false;
+        }
+        if (inferred_axis != extents.size() && known != 0) {
+            shape[inferred_axis] = array.Size() / known;
+        }
+        NdArray reshaped;
+        if (!array.Reshape(shape, &reshaped, out_error)) {
+            return false;
+        }
+        *out_value = runtime::Value(std::move(reshaped));
+        return true;
+    }
+
+    if (method == "transpose") {
+        *out_value = runtime::Value(array.Transpose());
+        return true;
+    }
+
+    if (method == "astype") {
+        NdType type = NdType::Float64;
+        if (!ReadNdType(arguments[0], &type, out_error)) {
+            return false;
+        }
+        *out_value = runtime::Value(array.AsType(type));
+        return true;
+    }
+
+    *out_value = NdArrayToList(array);
+    return true;
+}
+
+bool Interpreter::EvaluateNdArrayBinary(frontend::BinaryOp op,
+                                        const runtime::Value& lhs,
+                                        const runtime::Value& rhs,
+                                        runtime::Value* out_value,
+                                        std::string* out_error) const {
+    runtime::NdBinaryOp array_op = runtime::NdBinaryOp::Add;
+    switch (op) {
+    case frontend::BinaryOp::Add:
+        array_op = runtime::NdBinaryOp::Add;
+        break;
+    case frontend::BinaryOp::Subtract:
+        array_op = runtime::NdBinaryOp::Subtract;
+        break;
+    case frontend::BinaryOp::Multiply:
+        array_op = runtime::NdBinaryOp::Multiply;
+        break;
+    case frontend::BinaryOp::Divide:
+        array_op = runtime::NdBinaryOp::Divide;
+        break;
+    case frontend::BinaryOp::Power:
+        array_op = runtime::NdBinaryOp::Power;
+        break;
+    default:
+        *out_error = "Operador no soportado para ndarray.";
+        return false;
+    }
+
+    const NdType peer_type = lhs.IsNdArray() ? lhs.AsNdArray()->Type() : rhs.AsNdArray()->Type();
+    NdArray left;
+    NdArray right;
+    if (!OperandToNdArray(lhs, peer_type, &left, out_error) || !OperandToNdArray(rhs, peer_type, &right, out_error)) {
+        return false;
+    }
+
+    NdArray result;
+    if (!runtime::NdBinary(array_op, left, right, &result, out_error)) {
+        return false;
+    }
+    *out_value = runtime::Value(std::move(result));
+    return true;
+}
+
+}  // namespace clot::interpreter
@@ -0,0 +1,364 @@
+#include "clot/interpreter/interpreter.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "clot/runtime/ndarray.hpp"
+#include "clot/runtime/optimizer.hpp"
+
+namespace clot::interpreter {
+namespace {
+
+using runtime::NdArray;
+using runtime::NdType;
+
+enum class GradientSource {
+    Function,
+    Dual,
+    Numeric,
+};
+
+runtime::Value VectorValue(const std::vector<double>& values) {
+    NdArray array = NdArray::Uninitialized(NdType::Float64, {values.size()});
+    std::copy(values.begin(), values.end(), array.MutableData<double>());
+    return runtime::Value(std::move(array));
+}
+
+// Row-major k x n float64 array holding `points`.
+runtime::Value BatchValue(const std::vector<std::vector<double>>& points) {
+    const std::size_t columns = points.empty() ? 0 : points[0].size();
+    NdArray array = NdArray::Uninitialized(NdType::Float64, {points.size(), columns});
+    double* data = array.MutableData<double>();
+    for (const auto& point : points) {
+        data = std::copy(point.begin(), point.end(), data);
+    }
+    return runtime::Value(std::move(array));
+}
+
+// Flattened numbers of a list, tuple or ndarray; nested lists are flattened
+// row by row.
+bool ReadNumbers(const runtime::Value& value, std::vector<double>* out_numbers) {
+    if (const auto* array = value.AsNdArray()) {
+        const NdArray values = array->AsType(NdType::Float64).Contiguous();
+        out_numbers->insert(out_numbers->end(), values.Data<double>(), values.Data<double>() + values.Size());
+        return true;
+    }
+    const auto* elements = value.AsList();
+    if (elements == nullptr) {
+        elements = value.AsTuple();
+    }
+    if (elements == nullptr) {
+        bool ok = value.IsNumber();
+        const double number = ok ? value.AsNumber(&ok) : 0.0;
+        if (ok) {
+            out_numbers->push_back(number);
+        }
+        return ok;
+    }
+    for (const auto& element : *elements) {
+        if (!ReadNumbers(element, out_numbers)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// x0 as one start (a vector) or several (a k x n ndarray or a list of
+// lists); `out_multi` tells the two apart.
+bool ReadStarts(const runtime::Value& value,
+                std::vector<std::vector<double>>* out_starts,
+                bool* out_multi,
+                std::string* out_error) {
+    out_starts->clear();
+    *out_multi = false;
+    if (const auto* array = value.AsNdArray(); array != nullptr && array->Rank() == 2) {
+        *out_multi = true;
+        const NdArray values = array->AsType(NdType::Float64).Contiguous();
+        const std::size_t columns = array->Shape()[1];
+        for (std::size_t row = 0; row < array->Shape()[0]; ++row) {
+            const double* begin = values.Data<double>() + row * columns;
+            out_starts->emplace_back(begin, begin + columns);
+        }
+    } else if (const auto* list = value.AsList(); list != nullptr && !list->empty() && !(*list)[0].IsNumber()) {
+        *out_multi = true;
+        for (const auto& row : *list) {
+            out_starts->emplace_back();
+            if (row.IsNumber() || (!row.IsList() && !row.IsTuple()) || !ReadNumbers(row, &out_starts->back())) {
+                out_starts->clear();
+                break;
+            }
+        }
+    } else if (!value.IsNumber() && (!value.IsNdArray() || value.AsNdArray()->Rank() == 1)) {
+        out_starts->emplace_back();
+        if (!ReadNumbers(value, &out_starts->back())) {
+            out_starts->clear();
+        }
+    }
+
+    const bool valid = !out_starts->empty() && !(*out_starts)[0].empty() &&
+                       std::all_of(out_starts->begin(), out_starts->end(), [&](const std::vector<double>& start) {
+                           return start.size() == (*out_starts)[0].size();
+                       });
+    if (!valid) {
+        *out_error = "opt_minimize() requiere x0 como vector no vacio o matriz de puntos iniciales.";
+        return false;
+    }
+    return true;
+}
+
+bool ReadOptionNumber(const runtime::Value& value, const std::string& name, double minimum, double* out_number,
+                      std::string* out_error) {
+    bool ok = value.IsNumber();
+    const double number = ok ? value.AsNumber(&ok) : 0.0;
+    if (!ok || !std::isfinite(number) || number < minimum) {
+        *out_error = "opt_minimize(): valor invalido para la opcion: " + name;
+        return false;
+    }
+    *out_number = number;
+    return true;
+}
+
+}  // namespace
+
+bool Interpreter::IsOptimizeBuiltin(const std::string& name) {
+    return name == "opt_minimize";
+}
+
+bool Interpreter::ExecuteOptimizeBuiltin(const frontend::CallExpr& call,
+                                         runtime::Value* out_value,
+                                         std::string* out_error) {
+    std::vector<runtime::Value> arguments(call.arguments.size());
+    for (std::size_t i = 0; i < call.arguments.size(); ++i) {
+        if (call.arguments[i].value == nullptr) {
+            *out_error = "Error interno: argumento de llamada vacio.";
+            return false;
+        }
+        if (!EvaluateExpression(*call.arguments[i].value, &arguments[i], out_error)) {
+            return false;
+        }
+    }
+
+    if (arguments.size() < 2 || arguments.size() > 4) {
+        *out_error = "opt_minimize(f, x0, method=\"lbfgs\", options=null) requiere de 2 a 4 argumentos.";
+        return false;
+    }
+    const runtime::Value& objective = arguments[0];
+    if (!objective.IsFunctionRef()) {
+        *out_error = "Se esperaba una funcion.";
+        return false;
+    }
+    std::vector<std::vector<double>> starts;
+    bool multi_start = false;
+    if (!ReadStarts(arguments[1], &starts, &multi_start, out_error)) {
+        return false;
+    }
+
+    runtime::OptimizerOptions options;
+    if (arguments.size() >= 3 && !arguments[2].IsNull() &&
+        (!arguments[2].IsString() || !runtime::ParseOptimizerMethod(arguments[2].ToString(), &options.method))) {
+        *out_error = "opt_minimize(): metodo desconocido (use \"gd\", \"lbfgs\" o \"nelder_mead\"): " +
+                     arguments[2].ToString();
+        return false;
+    }
+
+    // options: {max_iterations, tolerance, learning_rate, memory, step,
+    // batch, gradient}. `gradient` is a function, "dual" or "numeric".
+    bool batch = false;
+    runtime::Value gradient_function(nullptr);
+    GradientSource gradient_source = GradientSource::Dual;
+    bool gradient_given = false;
+    if (arguments.size() == 4 && !arguments[3].IsNull()) {
+        const auto* fields = arguments[3].AsObject();
+        if (fields == nullptr) {
+            *out_error = "opt_minimize(): options debe ser un object o null.";
+            return false;
+        }
+        for (const auto& [name, value] : *fields) {
+            double number = 0.0;
+            if (name == "max_iterations" || name == "memory") {
+                if (!value.IsInteger() || !ReadOptionNumber(value, name, 0.0, &number, out_error)) {
+                    *out_error = "opt_minimize(): valor invalido para la opcion: " + name;
+                    return false;
+                }
+                (name == "memory" ? options.memory : options.max_iterations) = static_cast<std::size_t>(number);
+            } else if (name == "tolerance" || name == "learning_rate" || name == "step") {
+                if (!ReadOptionNumber(value, name, 0.0, &number, out_error)) {
+                    return false;
+                }
+                if (name == "tolerance") {
+                    options.tolerance = number;
+                } else if (name == "learning_rate") {
+                    options.learning_rate = number;
+                } else {
+                    options.simplex_step = number;
+                }
+            } else if (name == "batch") {
+                if (!value.IsBool()) {
+                    *out_error = "opt_minimize(): valor invalido para la opcion: " + name;
+                    return false;
+                }
+                batch = value.AsBool();
+            } else if (name == "gradient") {
+                gradient_given = true;
+                if (value.IsFunctionRef()) {
+                    gradient_function = value;
+                    gradient_source = GradientSource::Function;
+                } else if (value.IsString() && value.ToString() == "dual") {
+                    gradient_source = GradientSource::Dual;
+                } else if (value.IsString() && value.ToString() == "numeric") {
+                    gradient_source = GradientSource::Numeric;
+                } else {
+                    *out_error = "opt_minimize(): valor invalido para la opcion: " + name;
+                    return false;
+                }
+            } else {
+                *out_error = "opt_minimize(): opcion desconocida: " + name;
+                return false;
+            }
+        }
+    }
+    // Dual numbers cannot live in an ndarray batch, so batched runs default
+    // to finite differences.
+    if (batch && !gradient_given) {
+        gradient_source = GradientSource::Numeric;
+    }
+    if (batch && gradient_source == GradientSource::Dual) {
+        *out_error = "opt_minimize(): gradient \"dual\" no se admite con batch.";
+        return false;
+    }
+
+    const std::size_t dimension = starts[0].size();
+
+    // f(x) for every point: one call per point with an (n,) ndarray, or one
+    // call with a (k, n) ndarray in batch mode.
+    const auto evaluate_values = [&](const std::vector<std::vector<double>>& points, std::vector<double>* out_values,
+                                     std::string* error) {
+        out_values->clear();
+        runtime::Value result;
+        if (batch) {
+            if (!InvokeFunctionValue(objective, {BatchValue(points)}, &result, error)) {
+                return false;
+            }
+            if (!ReadNumbers(result, out_values) || result.IsNumber() || out_values->size() != points.size()) {
+                *error = "La funcion objetivo en batch debe devolver un valor por fila: " +
+                         std::to_string(points.size());
+                return false;
+            }
+            return true;
+        }
+        for (const auto& point : points) {
+            if (!InvokeFunctionValue(objective, {VectorValue(point)}, &result, error)) {
+                return false;
+            }
+            bool ok = result.IsNumber();
+            const double value = ok ? result.AsNumber(&ok) : 0.0;
+            if (!ok) {
+                *error = "La funcion objetivo debe devolver un numero.";
+                return false;
+            }
+            out_values->push_back(value);
+        }
+        return true;
+    };
+
+    const auto evaluate_gradients = [&](const std::vector<std::vector<double>>& points,
+                                        std::vector<std::vector<double>>* out_gradients,
+                                        std::string* error) {
+        out_gradients->assign(points.size(), {});
+        const auto invalid = [&]() {
+            *error = "La funcion gradient debe devolver " + std::to_string(dimension) + " valores por punto.";
+            return false;
+        };
+        runtime::Value result;
+        if (batch) {
+            std::vector<double> numbers;
+            if (!InvokeFunctionValue(gradient_function, {BatchValue(points)}, &result, error)) {
+                return false;
+            }
+            if (!ReadNumbers(result, &numbers) || numbers.size() != points.size() * dimension) {
+                return invalid();
+            }
+            for (std::size_t p = 0; p < points.size(); ++p) {
+                (*out_gradients)[p].assign(numbers.begin() + static_cast<std::ptrdiff_t>(p * dimension),
+                                           numbers.begin() + static_cast<std::ptrdiff_t>((p + 1) * dimension));
+            }
+            return true;
+        }
+        for (std::size_t p = 0; p < points.size(); ++p) {
+            if (!InvokeFunctionValue(gradient_function, {VectorValue(points[p])}, &result, error)) {
+                return false;
+            }
+            if (!ReadNumbers(result, &(*out_gradients)[p]) || (*out_gradients)[p].size() != dimension) {
+                return invalid();
+            }
+        }
+        return true;
+    };
+
+    runtime::BatchObjective batch_objective;
+    if (!runtime::OptimizerNeedsGradient(options.method) || gradient_source == GradientSource::Numeric) {
+        batch_objective = [&](const std::vector<std::vector<double>>& points, std::vector<double>* out_values,
+                              std::vector<std::vector<double>>* out_gradients, std::string* error) {
+            (void)out_gradients;
+            return evaluate_values(points, out_values, error);
+        };
+        if (runtime::OptimizerNeedsGradient(options.method)) {
+            batch_objective = runtime::NumericGradientObjective(std::move(batch_objective));
+        }
+    } else if (gradient_source == GradientSource::Function) {
+        batch_objective = [&](const std::vector<std::vector<double>>& points, std::vector<double>* out_values,
+                              std::vector<std::vector<double>>* out_gradients, std::string* error) {
+            return evaluate_values(points, out_values, error) && evaluate_gradients(points, out_gradients, error);
+        };
+    } else {
+        // Forward-mode: f receives a list of n seeded duals per point.
+        batch_objective = [&](const std::vector<std::vector<double>>& points, std::vector<double>* out_values,
+                              std::vector<std::vector<double>>* out_gradients, std::string* error) {
+            out_values->resize(points.size());
+            out_gradients->resize(points.size());
+            for (std::size_t p = 0; p < points.size(); ++p) {
+                if (!EvaluateDualGradient(objective, points[p], &(*out_values)[p], &(*out_gradients)[p], error)) {
+                    return false;
+                }
+            }
+            return true;
+        };
+    }
+
+    std::vector<runtime::OptimizerResult> results;
+    if (!runtime::Minimize(options, starts, batch_objective, &results, out_error)) {
+        return false;
+    }
+
+    const auto result_value = [](const runtime::OptimizerResult& result) {
+        runtime::Value::Object object;
+        object.push_back({"x", VectorValue(result.x)});
+        object.push_back({"value", runtime::Value(result.value)});
+        object.push_back({"iterations", runtime::Value(static_cast<long long>(result.iterations))});
+        object.push_back({"evaluations", runtime::Value(static_cast<long long>(result.evaluations))});
+        object.push_back({"converged", runtime::Value(result.converged)});
+        return object;
+    };
+
+    std::size_t best = 0;
+    for (std::size_t run = 1; run < results.size(); ++run) {
+        if (results[run].value < results[best].value || std::isnan(results[best].value)) {
+            best = run;
+        }
+    }
+    runtime::Value::Object object = result_value(results[best]);
+    if (multi_start) {
+        runtime::Value::List runs;
+        runs.reserve(results.size());
+        for (const auto& result : results) {
+            runs.emplace_back(result_value(result));
+        }
+        object.push_back({"runs", runtime::Value(std::move(runs))});
+    }
+    *out_value = runtime::Value(std::move(object));
+    return true;
+}
+
+}  // namespace clot::interpreter
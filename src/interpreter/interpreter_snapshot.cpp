@@ -0,0 +1,715 @@
+#include "clot/interpreter/interpreter.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "clot/frontend/parser.hpp"
+#include "clot/frontend/source_loader.hpp"
+#include "clot/runtime/ndarray.hpp"
+
+#ifndef CLOT_VERSION
+#define CLOT_VERSION "dev"
+#endif
+
+namespace clot::interpreter {
+
+// A snapshot file stores, in native byte order:
+//   "CLOTSNAP" u32 format, string clot version
+//   programs       [path, FNV-1a of the source]   (entry program first)
+//   environment    [name, slot]
+//   functions      [name, program, ordinal]        (likewise interfaces)
+//   classes        [name, program, ordinal, static fields, readonly names]
+//   imported modules, module exports, class aliases
+// ASTs are not serialized: each program is reparsed from its source, and
+// declarations are found again by their pre-order position in it. Files are
+// only readable by the build that wrote them.
+struct Interpreter::SnapshotState {
+    std::vector<LoadedModule> programs;
+    std::map<std::string, runtime::VariableSlot> environment;
+    std::map<std::string, const frontend::FunctionDeclStmt*> functions;
+    std::unordered_map<std::string, const frontend::InterfaceDeclStmt*> interfaces;
+    std::unordered_map<std::string, ClassRuntimeInfo> classes;
+    std::set<std::string> imported_modules;
+    std::unordered_map<std::string, ModuleExports> module_exports;
+    std::unordered_map<std::string, std::string> class_aliases;
+};
+
+namespace {
+
+constexpr char kSnapshotMagic[8] = {'C', 'L', 'O', 'T', 'S', 'N', 'A', 'P'};
+constexpr std::uint32_t kSnapshotFormat = 1;
+constexpr std::size_t kMaxValueDepth = 10000;
+
+enum class ValueTag : std::uint8_t {
+    Null,
+    Integer,
+    Double,
+    Float,
+    Decimal,
+    Char,
+    String,
+    Bool,
+    List,
+    Tuple,
+    Set,
+    Map,
+    Object,
+    FunctionRef,
+    Range,
+    NdArray,
+    Dual,
+};
+
+std::uint64_t HashSourceLines(const std::vector<std::string>& lines) {
+    std::uint64_t hash = 1469598103934665603ULL;
+    for (const auto& line : lines) {
+        for (const char character : line) {
+            hash = (hash ^ static_cast<unsigned char>(character)) * 1099511628211ULL;
+        }
+        hash = (hash ^ static_cast<unsigned char>('\n')) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Declarations of type T in pre-order, through every nested block. Writing and
+// reading use the same walk, so an index identifies one declaration.
+template <typename T>
+void CollectDeclarations(const std::vector<std::unique_ptr<frontend::Statement>>& statements,
+                         std::vector<const T*>* out_declarations) {
+    for (const auto& statement : statements) {
+        if (statement == nullptr) {
+            continue;
+        }
+        if (const auto* declaration = dynamic_cast<const T*>(statement.get())) {
+            out_declarations->push_back(declaration);
+        }
+        if (const auto* function = dynamic_cast<const frontend::FunctionDeclStmt*>(statement.get())) {
+            CollectDeclarations(function->body, out_declarations);
+        } else if (const auto* conditional = dynamic_cast<const frontend::IfStmt*>(statement.get())) {
+            CollectDeclarations(conditional->then_branch, out_declarations);
+            CollectDeclarations(conditional->else_branch, out_declarations);
+        } else if (const auto* try_catch = dynamic_cast<const frontend::TryCatchStmt*>(statement.get())) {
+            CollectDeclarations(try_catch->try_branch, out_declarations);
+            CollectDeclarations(try_catch->catch_branch, out_declarations);
+            CollectDeclarations(try_catch->finally_branch, out_declarations);
+        } else if (const auto* while_loop = dynamic_cast<const frontend::WhileStmt*>(statement.get())) {
+            CollectDeclarations(while_loop->body, out_declarations);
+        } else if (const auto* for_loop = dynamic_cast<const frontend::ForStmt*>(statement.get())) {
+            CollectDeclarations(for_loop->body, out_declarations);
+        } else if (const auto* foreach_loop = dynamic_cast<const frontend::ForEachStmt*>(statement.get())) {
+            CollectDeclarations(foreach_loop->body, out_declarations);
+        } else if (const auto* do_while = dynamic_cast<const frontend::DoWhileStmt*>(statement.get())) {
+            CollectDeclarations(do_while->body, out_declarations);
+        } else if (const auto* switch_stmt = dynamic_cast<const frontend::SwitchStmt*>(statement.get())) {
+            for (const auto& switch_case : switch_stmt->cases) {
+                CollectDeclarations(switch_case.body, out_declarations);
+            }
+        }
+    }
+}
+
+template <typename T>
+bool LocateDeclaration(const std::vector<const frontend::Program*>& programs,
+                       const T* declaration,
+                       std::uint32_t* out_program,
+                       std::uint32_t* out_ordinal) {
+    for (std::size_t program_index = 0; program_index < programs.size(); ++program_index) {
+        std::vector<const T*> declarations;
+        CollectDeclarations(programs[program_index]->statements, &declarations);
+        for (std::size_t ordinal = 0; ordinal < declarations.size(); ++ordinal) {
+            if (declarations[ordinal] == declaration) {
+                *out_program = static_cast<std::uint32_t>(program_index);
+                *out_ordinal = static_cast<std::uint32_t>(ordinal);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+class SnapshotWriter {
+public:
+    void U8(std::uint8_t value) { bytes_.push_back(static_cast<char>(value)); }
+    void U32(std::uint32_t value) { Raw(&value, sizeof(value)); }
+    void U64(std::uint64_t value) { Raw(&value, sizeof(value)); }
+    void I32(std::int32_t value) { Raw(&value, sizeof(value)); }
+    void F64(double value) { Raw(&value, sizeof(value)); }
+    void Count(std::size_t value) { U64(static_cast<std::uint64_t>(value)); }
+    void String(const std::string& text) {
+        Count(text.size());
+        Raw(text.data(), text.size());
+    }
+    void Raw(const void* data, std::size_t size) {
+        bytes_.append(static_cast<const char*>(data), size);
+    }
+
+    void Value(const runtime::Value& value) {
+        if (value.IsNull()) {
+            Tag(ValueTag::Null);
+        } else if (const auto* integer = value.AsBigIntValue()) {
+            Tag(ValueTag::Integer);
+            String(integer->ToString());
+        } else if (value.IsDouble() || value.IsFloat()) {
+            bool ok = false;
+            Tag(value.IsDouble() ? ValueTag::Double : ValueTag::Float);
+            F64(value.AsNumber(&ok));
+        } else if (const auto* decimal = value.AsDecimalValue()) {
+            Tag(ValueTag::Decimal);
+            String(decimal->Coefficient().ToString());
+            I32(decimal->Scale());
+        } else if (const auto* character = value.AsCharValue()) {
+            Tag(ValueTag::Char);
+            U8(static_cast<std::uint8_t>(*character));
+        } else if (const auto* text = value.AsStringValue()) {
+            Tag(ValueTag::String);
+            String(*text);
+        } else if (value.IsBool()) {
+            Tag(ValueTag::Bool);
+            U8(value.AsBool() ? 1 : 0);
+        } else if (const auto* list = value.AsList()) {
+            Tag(ValueTag::List);
+            Values(*list);
+        } else if (const auto* tuple = value.AsTuple()) {
+            Tag(ValueTag::Tuple);
+            Values(*tuple);
+        } else if (const auto* set = value.AsSet()) {
+            Tag(ValueTag::Set);
+            Values(*set);
+        } else if (const auto* map = value.AsMap()) {
+            Tag(ValueTag::Map);
+            Count(map->size());
+            for (const auto& entry : *map) {
+                Value(entry.first);
+                Value(entry.second);
+            }
+        } else if (const auto* object = value.AsObject()) {
+            Tag(ValueTag::Object);
+            Count(object->size());
+            for (const auto& entry : *object) {
+                String(entry.first);
+                Value(entry.second);
+            }
+        } else if (const auto* function = value.AsFunctionRefValue()) {
+            Tag(ValueTag::FunctionRef);
+            String(function->name);
+        } else if (const auto* range = value.AsRange()) {
+            Tag(ValueTag::Range);
+            String(range->start.ToString());
+            String(range->stop.ToString());
+            String(range->step.ToString());
+        } else if (const auto* array = value.AsNdArray()) {
+            Tag(ValueTag::NdArray);
+            const runtime::NdArray contiguous = array->Contiguous();
+            U8(static_cast<std::uint8_t>(contiguous.Type()));
+            Count(contiguous.Rank());
+            for (const std::size_t extent : contiguous.Shape()) {
+                Count(extent);
+            }
+            const std::size_t byte_count = contiguous.Size() * runtime::NdTypeSize(contiguous.Type());
+            if (byte_count > 0) {
+                Raw(contiguous.Data<char>(), byte_count);
+            }
+        } else if (const auto* dual = value.AsDual()) {
+            Tag(ValueTag::Dual);
+            F64(dual->Value());
+            Count(dual->Directions());
+            for (std::size_t i = 0; i < dual->Directions(); ++i) {
+                F64(dual->Tangent(i));
+            }
+        }
+    }
+
+    void Slot(const runtime::VariableSlot& slot) {
+        U8(static_cast<std::uint8_t>(slot.kind));
+        U8(slot.is_const ? 1 : 0);
+        Value(slot.value);
+    }
+
+    void Slots(const std::map<std::string, runtime::VariableSlot>& slots) {
+        Count(slots.size());
+        for (const auto& entry : slots) {
+            String(entry.first);
+            Slot(entry.second);
+        }
+    }
+
+    void Strings(const std::set<std::string>& strings) {
+        Count(strings.size());
+        for (const auto& text : strings) {
+            String(text);
+        }
+    }
+
+    const std::string& Bytes() const { return bytes_; }
+
+private:
+    void Tag(ValueTag tag) { U8(static_cast<std::uint8_t>(tag)); }
+    void Values(const std::vector<runtime::Value>& values) {
+        Count(values.size());
+        for (const auto& element : values) {
+            Value(element);
+        }
+    }
+
+    std::string bytes_;
+};
+
+// Reads what SnapshotWriter wrote. Any truncated or malformed field turns
+// ok() false and later reads return empty values.
+class SnapshotReader {
+public:
+    explicit SnapshotReader(std::string bytes) : bytes_(std::move(bytes)) {}
+
+    bool ok() const { return ok_; }
+    bool AtEnd() const { return position_ == bytes_.size(); }
+
+    std::uint8_t U8() {
+        std::uint8_t value = 0;
+        Raw(&value, sizeof(value));
+        return value;
+    }
+    std::uint32_t U32() {
+        std::uint32_t value = 0;
+        Raw(&value, sizeof(value));
+        return value;
+    }
+    std::uint64_t U64() {
+        std::uint64_t value = 0;
+        Raw(&value, sizeof(value));
+        return value;
+    }
+    std::int32_t I32() {
+        std::int32_t value = 0;
+        Raw(&value, sizeof(value));
+        return value;
+    }
+    double F64() {
+        double value = 0.0;
+        Raw(&value, sizeof(value));
+        return value;
+    }
+    // Element counts are bounded by the bytes left, one byte per element at least.
+    std::size_t Count() {
+        const std::uint64_t value = U64();
+        if (value > bytes_.size() - position_) {
+            ok_ = false;
+            return 0;
+        }
+        return static_cast<std::size_t>(value);
+    }
+    std::string String() {
+        const std::size_t size = Count();
+        std::string text;
+        if (ok_) {
+            text = bytes_.substr(position_, size);
+            position_ += size;
+        }
+        return text;
+    }
+    void Raw(void* out, std::size_t size) {
+        if (!ok_ || size > bytes_.size() - position_) {
+            ok_ = false;
+            return;
+        }
+        std::memcpy(out, bytes_.data() + position_, size);
+        position_ += size;
+    }
+
+    runtime::Value Value(std::size_t depth = 0) {
+        if (!ok_ || depth > kMaxValueDepth) {
+            ok_ = false;
+            return runtime::Value(nullptr);
+        }
+        switch (static_cast<ValueTag>(U8())) {
+            case ValueTag::Null:
+                return runtime::Value(nullptr);
+            case ValueTag::Integer:
+                return runtime::Value(Integer());
+            case ValueTag::Double:
+                return runtime::Value(F64());
+            case ValueTag::Float:
+                return runtime::Value(static_cast<float>(F64()));
+            case ValueTag::Decimal: {
+                runtime::BigInt coefficient = Integer();
+                const int scale = I32();
+                return runtime::Value(runtime::Decimal(std::move(coefficient), scale));
+            }
+            case ValueTag::Char:
+                return runtime::Value(static_cast<char>(U8()));
+            case ValueTag::String:
+                return runtime::Value(String());
+            case ValueTag::Bool:
+                return runtime::Value(U8() != 0);
+            case ValueTag::List:
+                return runtime::Value(Values(depth));
+            case ValueTag::Tuple:
+                return runtime::Value(runtime::Value::Tuple{Values(depth)});
+            case ValueTag::Set:
+                return runtime::Value(runtime::Value::Set{Values(depth)});
+            case ValueTag::Map: {
+                runtime::Value::Map map;
+                const std::size_t count = Count();
+                map.entries.reserve(count);
+                for (std::size_t i = 0; i < count && ok_; ++i) {
+                    runtime::Value key = Value(depth + 1);
+                    map.entries.emplace_back(std::move(key), Value(depth + 1));
+                }
+                return runtime::Value(std::move(map));
+            }
+            case ValueTag::Object: {
+                runtime::Value::Object object;
+                const std::size_t count = Count();
+                object.reserve(count);
+                for (std::size_t i = 0; i < count && ok_; ++i) {
+                    std::string key = String();
+                    object.emplace_back(std::move(key), Value(depth + 1));
+                }
+                return runtime::Value(std::move(object));
+            }
+            case ValueTag::FunctionRef:
+                return runtime::Value(runtime::Value::FunctionRef{String()});
+            case ValueTag::Range: {
+                runtime::Value::Range range;
+                range.start = Integer();
+                range.stop = Integer();
+                range.step = Integer();
+                if (range.step.IsZero()) {
+                    ok_ = false;
+                }
+                return runtime::Value(std::move(range));
+            }
+            case ValueTag::NdArray: {
+                const auto type = static_cast<runtime::NdType>(U8());
+                if (type != runtime::NdType::Float64 && type != runtime::NdType::Float32 &&
+                    type != runtime::NdType::Int64) {
+                    break;
+                }
+                std::vector<std::size_t> shape(Count());
+                std::size_t element_count = 1;
+                for (auto& extent : shape) {
+                    extent = Count();
+                    if (extent != 0 && element_count > std::numeric_limits<std::size_t>::max() / extent) {
+                        ok_ = false;
+                    }
+                    element_count *= extent;
+                }
+                const std::size_t byte_count = element_count * runtime::NdTypeSize(type);
+                if (!ok_ || byte_count > bytes_.size() - position_) {
+                    break;
+                }
+                runtime::NdArray array = runtime::NdArray::Uninitialized(type, std::move(shape));
+                if (byte_count > 0) {
+                    Raw(array.MutableData<char>(), byte_count);
+                }
+                return runtime::Value(std::move(array));
+            }
+            case ValueTag::Dual: {
+                const double value = F64();
+                const std::size_t directions = Count();
+                runtime::Dual dual(value, directions);
+                for (std::size_t i = 0; i < directions && ok_; ++i) {
+                    dual.Tangents()[i] = F64();
+                }
+                return runtime::Value(std::move(dual));
+            }
+        }
+        ok_ = false;
+        return runtime::Value(nullptr);
+    }
+
+    runtime::VariableSlot Slot() {
+        runtime::VariableSlot slot;
+        const std::uint8_t kind = U8();
+        if (kind > static_cast<std::uint8_t>(runtime::VariableKind::Function)) {
+            ok_ = false;
+        }
+        slot.kind = static_cast<runtime::VariableKind>(kind);
+        slot.is_const = U8() != 0;
+        slot.value = Value();
+        return slot;
+    }
+
+    std::map<std::string, runtime::VariableSlot> Slots() {
+        std::map<std::string, runtime::VariableSlot> slots;
+        const std::size_t count = Count();
+        for (std::size_t i = 0; i < count && ok_; ++i) {
+            std::string name = String();
+            slots[std::move(name)] = Slot();
+        }
+        return slots;
+    }
+
+    std::set<std::string> Strings() {
+        std::set<std::string> strings;
+        const std::size_t count = Count();
+        for (std::size_t i = 0; i < count && ok_; ++i) {
+            strings.insert(String());
+        }
+        return strings;
+    }
+
+private:
+    runtime::BigInt Integer() {
+        runtime::BigInt integer;
+        if (!runtime::BigInt::TryParse(String(), &integer)) {
+            ok_ = false;
+        }
+        return integer;
+    }
+
+    std::vector<runtime::Value> Values(std::size_t depth) {
+        std::vector<runtime::Value> values;
+        const std::size_t count = Count();
+        values.reserve(count);
+        for (std::size_t i = 0; i < count && ok_; ++i) {
+            values.push_back(Value(depth + 1));
+        }
+        return values;
+    }
+
+    std::string bytes_;
+    std::size_t position_ = 0;
+    bool ok_ = true;
+};
+
+// Resolves a (program, ordinal) pair written by LocateDeclaration.
+template <typename T>
+const T* DeclarationAt(SnapshotReader* reader, const std::vector<std::vector<const T*>>& table) {
+    const std::uint32_t program_index = reader->U32();
+    const std::uint32_t ordinal = reader->U32();
+    if (!reader->ok() || program_index >= table.size() || ordinal >= table[program_index].size()) {
+        return nullptr;
+    }
+    return table[program_index][ordinal];
+}
+
+std::string AbsolutePathString(const std::filesystem::path& path) {
+    std::error_code ec;
+    const std::filesystem::path canonical = std::filesystem::weakly_canonical(path, ec);
+    return ec ? std::filesystem::absolute(path, ec).lexically_normal().string() : canonical.string();
+}
+
+}  // namespace
+
+bool Interpreter::WriteSnapshot(const std::string& path, std::string* out_error) const {
+    if (entry_program_ == nullptr || entry_file_path_.empty()) {
+        *out_error = "El snapshot requiere haber ejecutado un programa desde un archivo.";
+        return false;
+    }
+    if (!async_tasks_.empty() || !ml_csv_readers_.empty()) {
+        *out_error = "El snapshot no puede guardar tareas async ni lectores CSV abiertos.";
+        return false;
+    }
+
+    // The entry program goes first; a snapshot taken from a snapshot-started
+    // run also lists the programs it restored, already in loaded_module_programs_.
+    std::vector<const frontend::Program*> programs = {entry_program_};
+    std::vector<std::filesystem::path> program_paths = {entry_file_path_};
+    for (const auto& module : loaded_module_programs_) {
+        programs.push_back(module.program.get());
+        program_paths.push_back(module.path);
+    }
+
+    SnapshotWriter writer;
+    writer.Raw(kSnapshotMagic, sizeof(kSnapshotMagic));
+    writer.U32(kSnapshotFormat);
+    writer.String(CLOT_VERSION);
+
+    writer.Count(programs.size());
+    for (const auto& program_path : program_paths) {
+        std::vector<std::string> lines;
+        std::string load_error;
+        if (!frontend::LoadSourceLines(program_path.string(), &lines, &load_error)) {
+            *out_error = "Error guardando snapshot: " + load_error;
+            return false;
+        }
+        writer.String(AbsolutePathString(program_path));
+        writer.U64(HashSourceLines(lines));
+    }
+
+    writer.Slots(environment_);
+
+    std::uint32_t program_index = 0;
+    std::uint32_t ordinal = 0;
+    writer.Count(functions_.size());
+    for (const auto& entry : functions_) {
+        if (!LocateDeclaration(programs, entry.second, &program_index, &ordinal)) {
+            *out_error = "Error guardando snapshot: no se encontro la declaracion de '" + entry.first + "'.";
+            return false;
+        }
+        writer.String(entry.first);
+        writer.U32(program_index);
+        writer.U32(ordinal);
+    }
+    writer.Count(interfaces_.size());
+    for (const auto& entry : interfaces_) {
+        if (!LocateDeclaration(programs, entry.second, &program_index, &ordinal)) {
+            *out_error = "Error guardando snapshot: no se encontro la declaracion de '" + entry.first + "'.";
+            return false;
+        }
+        writer.String(entry.first);
+        writer.U32(program_index);
+        writer.U32(ordinal);
+    }
+    writer.Count(classes_.size());
+    for (const auto& entry : classes_) {
+        if (!LocateDeclaration(programs, entry.second.declaration, &program_index, &ordinal)) {
+            *out_error = "Error guardando snapshot: no se encontro la declaracion de '" + entry.first + "'.";
+            return false;
+        }
+        writer.String(entry.first);
+        writer.U32(program_index);
+        writer.U32(ordinal);
+        writer.Slots(entry.second.static_fields);
+        writer.Strings(entry.second.readonly_static_fields);
+    }
+
+    writer.Strings(imported_modules_);
+    writer.Count(module_exports_cache_.size());
+    for (const auto& entry : module_exports_cache_) {
+        writer.String(entry.first);
+        writer.Slots(entry.second.variables);
+        writer.Strings(entry.second.functions);
+        writer.Strings(entry.second.classes);
+    }
+    writer.Count(class_aliases_.size());
+    for (const auto& entry : class_aliases_) {
+        writer.String(entry.first);
+        writer.String(entry.second);
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (file) {
+        file.write(writer.Bytes().data(), static_cast<std::streamsize>(writer.Bytes().size()));
+    }
+    if (!file) {
+        *out_error = "No se pudo escribir el snapshot: " + path;
+        return false;
+    }
+    return true;
+}
+
+bool Interpreter::LoadSnapshot(const std::string& path, std::string* out_error) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        *out_error = "No se pudo abrir el snapshot: " + path;
+        return false;
+    }
+    SnapshotReader reader(std::string{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()});
+
+    char magic[sizeof(kSnapshotMagic)] = {};
+    reader.Raw(magic, sizeof(magic));
+    const std::uint32_t format = reader.U32();
+    const std::string version = reader.String();
+    if (!reader.ok() || std::memcmp(magic, kSnapshotMagic, sizeof(magic)) != 0 || format != kSnapshotFormat ||
+        version != CLOT_VERSION) {
+        *out_error = "Snapshot invalido o de otra version de clot: " + path;
+        return false;
+    }
+
+    auto state = std::make_shared<SnapshotState>();
+    const std::size_t program_count = reader.Count();
+    std::vector<std::vector<const frontend::FunctionDeclStmt*>> function_decls(program_count);
+    std::vector<std::vector<const frontend::InterfaceDeclStmt*>> interface_decls(program_count);
+    std::vector<std::vector<const frontend::ClassDeclStmt*>> class_decls(program_count);
+    for (std::size_t i = 0; i < program_count && reader.ok(); ++i) {
+        const std::string program_path = reader.String();
+        const std::uint64_t source_hash = reader.U64();
+        if (!reader.ok()) {
+            break;
+        }
+
+        std::vector<std::string> lines;
+        std::string load_error;
+        if (!frontend::LoadSourceLines(program_path, &lines, &load_error)) {
+            *out_error = "Snapshot desactualizado: " + load_error;
+            return false;
+        }
+        if (HashSourceLines(lines) != source_hash) {
+            *out_error = "Snapshot desactualizado: " + program_path + " cambio desde que se creo.";
+            return false;
+        }
+        frontend::Parser parser(std::move(lines));
+        auto program = std::make_shared<frontend::Program>();
+        frontend::Diagnostic diagnostic;
+        if (!parser.Parse(program.get(), &diagnostic)) {
+            *out_error = "Snapshot desactualizado: " + program_path + " no se pudo parsear.";
+            return false;
+        }
+        CollectDeclarations(program->statements, &function_decls[i]);
+        CollectDeclarations(program->statements, &interface_decls[i]);
+        CollectDeclarations(program->statements, &class_decls[i]);
+        state->programs.push_back({program_path, std::move(program)});
+    }
+
+    state->environment = reader.Slots();
+    bool declarations_ok = true;
+    const std::size_t function_count = reader.Count();
+    for (std::size_t i = 0; i < function_count && reader.ok(); ++i) {
+        std::string name = reader.String();
+        const auto* declaration = DeclarationAt(&reader, function_decls);
+        declarations_ok = declarations_ok && declaration != nullptr;
+        state->functions[std::move(name)] = declaration;
+    }
+    const std::size_t interface_count = reader.Count();
+    for (std::size_t i = 0; i < interface_count && reader.ok(); ++i) {
+        std::string name = reader.String();
+        const auto* declaration = DeclarationAt(&reader, interface_decls);
+        declarations_ok = declarations_ok && declaration != nullptr;
+        state->interfaces[std::move(name)] = declaration;
+    }
+    const std::size_t class_count = reader.Count();
+    for (std::size_t i = 0; i < class_count && reader.ok(); ++i) {
+        std::string name = reader.String();
+        ClassRuntimeInfo info;
+        info.declaration = DeclarationAt(&reader, class_decls);
+        declarations_ok = declarations_ok && info.declaration != nullptr;
+        info.static_fields = reader.Slots();
+        info.readonly_static_fields = reader.Strings();
+        state->classes[std::move(name)] = std::move(info);
+    }
+
+    state->imported_modules = reader.Strings();
+    const std::size_t export_count = reader.Count();
+    for (std::size_t i = 0; i < export_count && reader.ok(); ++i) {
+        std::string module_id = reader.String();
+        ModuleExports exports;
+        exports.variables = reader.Slots();
+        exports.functions = reader.Strings();
+        exports.classes = reader.Strings();
+        state->module_exports[std::move(module_id)] = std::move(exports);
+    }
+    const std::size_t alias_count = reader.Count();
+    for (std::size_t i = 0; i < alias_count && reader.ok(); ++i) {
+        std::string alias = reader.String();
+        state->class_aliases[std::move(alias)] = reader.String();
+    }
+
+    if (!reader.ok() || !reader.AtEnd() || !declarations_ok) {
+        *out_error = "Snapshot invalido o de otra version de clot: " + path;
+        return false;
+    }
+    snapshot_ = std::move(state);
+    return true;
+}
+
+void Interpreter::RestoreSnapshot() {
+    environment_ = snapshot_->environment;
+    functions_ = snapshot_->functions;
+    interfaces_ = snapshot_->interfaces;
+    classes_ = snapshot_->classes;
+    imported_modules_ = snapshot_->imported_modules;
+    module_exports_cache_ = snapshot_->module_exports;
+    class_aliases_ = snapshot_->class_aliases;
+    loaded_module_programs_ = snapshot_->programs;
+}
+
+}  // namespace clot::interpreter
@@ -308,6 +308,16 @@ bool Interpreter::ResolveVariable(
         const std::string& segment = segments[index];
         const bool is_last = index + 1 == segments.size();
 
+        if (const auto* dual = current->AsDual()) {
+            runtime::Value member;
+            if (!ReadDualMember(*dual, runtime::Value(segment), &member, out_error)) {
+                return false;
+            }
+            temporary_values.push_back(std::move(member));
+            current = &temporary_values.back();
+            continue;
+        }
+
         std::string class_name;
         if (IsClassInstance(*current, &class_name)) {
             const frontend::ClassDeclStmt* class_decl = FindClass(class_name);
@@ -908,6 +918,17 @@ bool Interpreter::NormalizeValueForTypeAnnotation(
             expected_class_name = expected_alias->second;
         }
         if (FindClass(expected_class_name) == nullptr) {
+            // dual and Dual (the class the native type replaced) name dual numbers.
+            if (effective.custom_name == "dual" || effective.custom_name == "Dual") {
+                if (!value.IsDual()) {
+                    if (out_error != nullptr) {
+                        *out_error = "La expresion requiere un dual.";
+                    }
+                    return false;
+                }
+                *out_value = value;
+                return true;
+            }
             if (out_error != nullptr) {
                 *out_error = "Tipo de clase no definido: " + effective.custom_name;
             }
@@ -1260,6 +1281,15 @@ bool Interpreter::ApplyVariableMutation(
         target_kind = found->second.kind;
     }
 
+    if (op == frontend::AssignmentOp::AddAssign && target_kind == runtime::VariableKind::Dynamic) {
+        // `s += x` on a string grows the stored buffer in place, so building a
+        // string in a loop is amortized linear instead of copying per step.
+        if (std::string* text = found->second.value.MutableString()) {
+            value.AppendTo(text);
+            return true;
+        }
+    }
+
     runtime::Value value_to_store = value;
     if (op == frontend::AssignmentOp::AddAssign || op == frontend::AssignmentOp::SubAssign) {
         runtime::Value merged;
@@ -0,0 +1,223 @@
+#include "clot/interpreter/interpreter.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "clot/runtime/ndarray.hpp"
+#include "clot/runtime/streaming_stats.hpp"
+
+namespace clot::interpreter {
+namespace {
+
+using BigInt = runtime::Value::BigInt;
+using runtime::StatsAggregate;
+using runtime::StatsRequest;
+
+runtime::Value CountValue(std::uint64_t count) {
+    return runtime::Value(static_cast<long long>(count));
+}
+
+// Empty inputs have no mean, min, max or quantiles; they come back as null.
+runtime::Value SampleValue(const StatsAggregate& aggregate, double value) {
+    return aggregate.Summary().Count() == 0 ? runtime::Value(nullptr) : runtime::Value(value);
+}
+
+const std::vector<runtime::Value>* SequenceElements(const runtime::Value& value) {
+    if (const auto* list = value.AsList()) {
+        return list;
+    }
+    if (const auto* tuple = value.AsTuple()) {
+        return tuple;
+    }
+    return value.AsSet();
+}
+
+// One pass over `source`: a list, tuple, set, range or ndarray of numbers, or
+// a string naming a text file that is streamed without loading it. `column`
+// (null, or a 0-based CSV field) only applies to files.
+bool AggregateSource(const runtime::Value& source,
+                     const runtime::Value& column,
+                     const StatsRequest& request,
+                     StatsAggregate* out_aggregate,
+                     std::string* out_error) {
+    if (!column.IsNull() && !source.IsString()) {
+        *out_error = "El argumento column solo se admite cuando la fuente es una ruta de archivo.";
+        return false;
+    }
+
+    if (source.IsString()) {
+        long long field = -1;
+        if (!column.IsNull() && (!column.IsInteger() ||
+                                 !runtime::Value::TryBigIntToInt64(*column.AsBigIntValue(), &field) || field < 0)) {
+            *out_error = "El argumento column debe ser un entero >= 0 o null.";
+            return false;
+        }
+        return runtime::AggregateFile(source.ToString(), static_cast<std::ptrdiff_t>(field), ',', request,
+                                      out_aggregate, out_error);
+    }
+
+    if (const auto* range = source.AsRange()) {
+        long long count = 0;
+        if (!runtime::Value::TryBigIntToInt64(source.RangeLength(), &count)) {
+            *out_error = "Valor no representable como int64: " + source.ToString();
+            return false;
+        }
+        *out_aggregate = runtime::AggregateSequence(runtime::Value(range->start).AsNumber(),
+                                                    runtime::Value(range->step).AsNumber(),
+                                                    static_cast<std::size_t>(count),
+                                                    request);
+        return true;
+    }
+
+    if (const auto* array = source.AsNdArray()) {
+        const runtime::NdArray values = array->AsType(runtime::NdType::Float64).Contiguous();
+        *out_aggregate = runtime::AggregateValues(values.Data<double>(), values.Size(), request);
+        return true;
+    }
+
+    const auto* elements = SequenceElements(source);
+    if (elements == nullptr) {
+        *out_error = "Las funciones stats_* requieren list, tuple, set, range, ndarray o una ruta de archivo.";
+        return false;
+    }
+    std::vector<double> values;
+    values.reserve(elements->size());
+    for (std::size_t index = 0; index < elements->size(); ++index) {
+        const runtime::Value& element = (*elements)[index];
+        bool ok = element.IsNumber();
+        const double number = ok ? element.AsNumber(&ok) : 0.0;
+        if (!ok) {
+            *out_error = "Las funciones stats_* requieren valores numericos; elemento invalido en la posicion: " +
+                         std::to_string(index);
+            return false;
+        }
+        values.push_back(number);
+    }
+    *out_aggregate = runtime::AggregateValues(values.data(), values.size(), request);
+    return true;
+}
+
+bool ReadQuantile(const runtime::Value& value, double* out_quantile) {
+    bool ok = value.IsNumber();
+    *out_quantile = ok ? value.AsNumber(&ok) : 0.0;
+    return ok && *out_quantile >= 0.0 && *out_quantile <= 1.0;
+}
+
+}  // namespace
+
+bool Interpreter::IsStatsBuiltin(const std::string& name) {
+    return name == "stats_summary" || name == "stats_histogram" || name == "stats_quantiles";
+}
+
+bool Interpreter::ExecuteStatsBuiltin(const frontend::CallExpr& call,
+                                      runtime::Value* out_value,
+                                      std::string* out_error) {
+    std::vector<runtime::Value> arguments(call.arguments.size());
+    for (std::size_t i = 0; i < call.arguments.size(); ++i) {
+        if (call.arguments[i].value == nullptr) {
+            *out_error = "Error interno: argumento de llamada vacio.";
+            return false;
+        }
+        if (!EvaluateExpression(*call.arguments[i].value, &arguments[i], out_error)) {
+            return false;
+        }
+    }
+
+    StatsRequest request;
+    if (call.callee == "stats_summary") {
+        if (arguments.empty() || arguments.size() > 2) {
+            *out_error = "stats_summary(source, column=null) requiere 1 o 2 argumentos.";
+            return false;
+        }
+        StatsAggregate aggregate(request);
+        const runtime::Value column = arguments.size() == 2 ? arguments[1] : runtime::Value(nullptr);
+        if (!AggregateSource(arguments[0], column, request, &aggregate, out_error)) {
+            return false;
+        }
+        const runtime::RunningStats& summary = aggregate.Summary();
+        runtime::Value::Object result;
+        result.push_back({"count", CountValue(summary.Count())});
+        result.push_back({"sum", runtime::Value(summary.Sum())});
+        result.push_back({"mean", SampleValue(aggregate, summary.Mean())});
+        result.push_back({"variance", runtime::Value(summary.Variance())});
+        result.push_back({"stddev", runtime::Value(std::sqrt(summary.Variance()))});
+        result.push_back({"min", SampleValue(aggregate, summary.Min())});
+        result.push_back({"max", SampleValue(aggregate, summary.Max())});
+        result.push_back({"skipped", CountValue(aggregate.Skipped())});
+        *out_value = runtime::Value(std::move(result));
+        return true;
+    }
+
+    if (call.callee == "stats_histogram") {
+        if (arguments.size() < 4 || arguments.size() > 5) {
+            *out_error = "stats_histogram(source, bins, low, high, column=null) requiere 4 o 5 argumentos.";
+            return false;
+        }
+        long long bins = 0;
+        bool low_ok = arguments[2].IsNumber();
+        bool high_ok = arguments[3].IsNumber();
+        request.low = low_ok ? arguments[2].AsNumber(&low_ok) : 0.0;
+        request.high = high_ok ? arguments[3].AsNumber(&high_ok) : 0.0;
+        if (!arguments[1].IsInteger() || !runtime::Value::TryBigIntToInt64(*arguments[1].AsBigIntValue(), &bins) ||
+            bins <= 0 || !low_ok || !high_ok || !std::isfinite(request.low) || !std::isfinite(request.high) ||
+            !(request.low < request.high)) {
+            *out_error = "stats_histogram() requiere bins > 0 y limites finitos con low < high.";
+            return false;
+        }
+        request.histogram = true;
+        request.bins = static_cast<std::size_t>(bins);
+        StatsAggregate aggregate(request);
+        const runtime::Value column = arguments.size() == 5 ? arguments[4] : runtime::Value(nullptr);
+        if (!AggregateSource(arguments[0], column, request, &aggregate, out_error)) {
+            return false;
+        }
+        runtime::Value::List counts;
+        counts.reserve(request.bins);
+        for (const std::uint64_t count : aggregate.Histogram().Counts()) {
+            counts.push_back(CountValue(count));
+        }
+        runtime::Value::Object result;
+        result.push_back({"counts", runtime::Value(std::move(counts))});
+        result.push_back({"underflow", CountValue(aggregate.Histogram().Underflow())});
+        result.push_back({"overflow", CountValue(aggregate.Histogram().Overflow())});
+        *out_value = runtime::Value(std::move(result));
+        return true;
+    }
+
+    // stats_quantiles(source, q, column=null): q is one quantile or a list.
+    if (arguments.size() < 2 || arguments.size() > 3) {
+        *out_error = "stats_quantiles(source, q, column=null) requiere 2 o 3 argumentos.";
+        return false;
+    }
+    std::vector<double> quantiles;
+    const auto* requested = SequenceElements(arguments[1]);
+    const std::vector<runtime::Value> single{arguments[1]};
+    for (const auto& value : requested == nullptr ? single : *requested) {
+        double quantile = 0.0;
+        if (!ReadQuantile(value, &quantile)) {
+            *out_error = "stats_quantiles() requiere cuantiles numericos entre 0 y 1.";
+            return false;
+        }
+        quantiles.push_back(quantile);
+    }
+    request.quantiles = true;
+    StatsAggregate aggregate(request);
+    const runtime::Value column = arguments.size() == 3 ? arguments[2] : runtime::Value(nullptr);
+    if (!AggregateSource(arguments[0], column, request, &aggregate, out_error)) {
+        return false;
+    }
+    if (requested == nullptr) {
+        *out_value = SampleValue(aggregate, aggregate.Quantile(quantiles.front()));
+        return true;
+    }
+    runtime::Value::List result;
+    for (const double quantile : quantiles) {
+        result.push_back(SampleValue(aggregate, aggregate.Quantile(quantile)));
+    }
+    *out_value = runtime::Value(std::move(result));
+    return true;
+}
+
+}  // namespace clot::interpreter
@@ -0,0 +1,67 @@
+#include "clot/interpreter/module_cache.hpp"
+
+#include <system_error>
+#include <utility>
+
+#include "clot/frontend/source_loader.hpp"
+
+namespace clot::interpreter {
+
+bool ModuleCache::Load(
+    const std::filesystem::path& path,
+    std::shared_ptr<const frontend::Program>* out_program,
+    frontend::Diagnostic* out_diagnostic,
+    std::string* out_error) {
+    out_error->clear();
+
+    std::error_code ec;
+    const std::filesystem::path canonical = std::filesystem::weakly_canonical(path, ec);
+    const std::string key = ec ? path.lexically_normal().string() : canonical.string();
+
+    // A file that cannot be stat'ed is never served from the cache; the load
+    // below reports why.
+    const std::filesystem::file_time_type modified = std::filesystem::last_write_time(path, ec);
+    const bool stat_ok = !ec;
+    const std::uintmax_t size = stat_ok ? std::filesystem::file_size(path, ec) : 0;
+    const bool have_stamp = stat_ok && !ec;
+
+    if (have_stamp) {
+        const auto found = entries_.find(key);
+        if (found != entries_.end() && found->second.modified == modified && found->second.size == size) {
+            *out_program = found->second.program;
+            return true;
+        }
+    }
+
+    std::vector<std::string> lines;
+    if (!frontend::LoadSourceLines(path.string(), &lines, out_error)) {
+        entries_.erase(key);
+        return false;
+    }
+
+    frontend::Parser parser(std::move(lines));
+    auto program = std::make_shared<frontend::Program>();
+    if (!parser.Parse(program.get(), out_diagnostic)) {
+        entries_.erase(key);
+        return false;
+    }
+
+    parsed_paths_.push_back(path);
+    if (have_stamp) {
+        entries_[key] = Entry{modified, size, program};
+    }
+    *out_program = std::move(program);
+    return true;
+}
+
+std::vector<std::filesystem::path> ModuleCache::TakeParsedPaths() {
+    std::vector<std::filesystem::path> paths;
+    paths.swap(parsed_paths_);
+    return paths;
+}
+
+std::size_t ModuleCache::Size() const {
+    return entries_.size();
+}
+
+}  // namespace clot::interpreter
@@ -0,0 +1,182 @@
+#include "clot/runtime/counters.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <iterator>
+#include <mutex>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include "clot/runtime/i18n.hpp"
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace clot::runtime {
+
+namespace {
+
+struct CounterName {
+    const char* json;
+    const char* spanish;
+    const char* english;
+};
+
+constexpr CounterName kCounterNames[] = {
+    {"environment_copies", "copias de entorno", "environment copies"},
+    {"environment_slots_copied", "variables copiadas con el entorno", "variables copied with environments"},
+    {"value_copies", "copias de Value", "Value copies"},
+    {"bigint_strings", "cadenas de digitos BigInt", "BigInt digit strings"},
+    {"statement_dispatches", "despachos de sentencias", "statement dispatches"},
+    {"expression_dispatches", "despachos de expresiones", "expression dispatches"},
+    {"module_loads", "modulos cargados", "modules loaded"},
+};
+static_assert(std::size(kCounterNames) == static_cast<std::size_t>(Counter::Count));
+
+std::mutex& BuiltinCallsMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::map<std::string, std::uint64_t>& BuiltinCalls() {
+    static std::map<std::string, std::uint64_t> calls;
+    return calls;
+}
+
+std::optional<std::uint64_t> PeakRssBytes() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<std::uint64_t>(counters.PeakWorkingSetSize);
+    }
+    return std::nullopt;
+#else
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return std::nullopt;
+    }
+#if defined(__APPLE__)
+    return static_cast<std::uint64_t>(usage.ru_maxrss);
+#else
+    return static_cast<std::uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+// Bytes the allocator currently has handed out (arena plus mmapped chunks).
+std::optional<std::uint64_t> HeapBytes() {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    const struct mallinfo2 info = mallinfo2();
+    return static_cast<std::uint64_t>(info.uordblks) + static_cast<std::uint64_t>(info.hblkhd);
+#else
+    return std::nullopt;
+#endif
+}
+
+std::string JsonString(const std::string& text) {
+    std::string out = "\"";
+    for (const char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+        }
+        out += c;
+    }
+    return out + "\"";
+}
+
+std::string JsonOptional(const std::optional<std::uint64_t>& value) {
+    return value.has_value() ? std::to_string(*value) : "null";
+}
+
+}  // namespace
+
+void EnableCounters(bool enabled) {
+    if (enabled) {
+        for (auto& value : counters_detail::values) {
+            value.store(0, std::memory_order_relaxed);
+        }
+        const std::lock_guard<std::mutex> lock(BuiltinCallsMutex());
+        BuiltinCalls().clear();
+    }
+    counters_detail::enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void CountBuiltinCall(const std::string& name) {
+    if (!CountersEnabled()) {
+        return;
+    }
+    const std::lock_guard<std::mutex> lock(BuiltinCallsMutex());
+    ++BuiltinCalls()[name];
+}
+
+CounterReport CollectCounters() {
+    CounterReport report;
+    for (std::size_t i = 0; i < static_cast<std::size_t>(Counter::Count); ++i) {
+        report.values[i] = counters_detail::values[i].load(std::memory_order_relaxed);
+    }
+    {
+        const std::lock_guard<std::mutex> lock(BuiltinCallsMutex());
+        report.builtin_calls = BuiltinCalls();
+    }
+    report.peak_rss_bytes = PeakRssBytes();
+    report.heap_bytes = HeapBytes();
+    return report;
+}
+
+std::string FormatCounterReport(const CounterReport& report) {
+    const auto row = [](std::ostringstream& out, const std::string& label, const std::string& value) {
+        out << "  " << std::left << std::setw(40) << label << std::right << std::setw(16) << value << "\n";
+    };
+    const auto optional_text = [](const std::optional<std::uint64_t>& value) {
+        return value.has_value() ? std::to_string(*value) : Tr("n/d", "n/a");
+    };
+
+    std::ostringstream out;
+    out << Tr("Estadisticas de ejecucion:\n", "Runtime statistics:\n");
+    for (std::size_t i = 0; i < static_cast<std::size_t>(Counter::Count); ++i) {
+        row(out, Tr(kCounterNames[i].spanish, kCounterNames[i].english), std::to_string(report.values[i]));
+    }
+    row(out, Tr("RSS maximo (bytes)", "peak RSS (bytes)"), optional_text(report.peak_rss_bytes));
+    row(out, Tr("heap en uso (bytes)", "heap in use (bytes)"), optional_text(report.heap_bytes));
+
+    out << Tr("Llamadas a builtins:\n", "Builtin calls:\n");
+    std::vector<std::pair<std::string, std::uint64_t>> calls(report.builtin_calls.begin(), report.builtin_calls.end());
+    std::stable_sort(calls.begin(), calls.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.second > rhs.second;
+    });
+    for (const auto& [name, count] : calls) {
+        row(out, name, std::to_string(count));
+    }
+    return out.str();
+}
+
+std::string FormatCounterReportJson(const CounterReport& report) {
+    std::string json = "{";
+    for (std::size_t i = 0; i < static_cast<std::size_t>(Counter::Count); ++i) {
+        json += JsonString(kCounterNames[i].json) + ":" + std::to_string(report.values[i]) + ",";
+    }
+    json += "\"peak_rss_bytes\":" + JsonOptional(report.peak_rss_bytes) + ",";
+    json += "\"heap_bytes\":" + JsonOptional(report.heap_bytes) + ",";
+    json += "\"builtin_calls\":{";
+    bool first = true;
+    for (const auto& [name, count] : report.builtin_calls) {
+        if (!first) {
+            json += ",";
+        }
+        first = false;
+        json += JsonString(name) + ":" + std::to_string(count);
+    }
+    json += "}}\n";
+    return json;
+}
+
+}  // namespace clot::runtime
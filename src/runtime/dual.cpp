@@ -0,0 +1,177 @@
+#include "clot/runtime/dual.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace clot::runtime {
+
+namespace {
+
+// out = a * lhs' + b * rhs', where either operand may be a constant.
+void CombineTangents(double a, const Dual& lhs, double b, const Dual& rhs, Dual* out) {
+    double* tangents = out->Tangents();
+    const std::size_t directions = out->Directions();
+    if (lhs.Directions() == directions && rhs.Directions() == directions) {
+        const double* left = lhs.Tangents();
+        const double* right = rhs.Tangents();
+        for (std::size_t i = 0; i < directions; ++i) {
+            tangents[i] = a * left[i] + b * right[i];
+        }
+        return;
+    }
+    for (std::size_t i = 0; i < directions; ++i) {
+        tangents[i] = a * lhs.Tangent(i) + b * rhs.Tangent(i);
+    }
+}
+
+bool HasTangent(const Dual& dual) {
+    const double* tangents = dual.Tangents();
+    return std::any_of(tangents, tangents + dual.Directions(), [](double tangent) { return tangent != 0.0; });
+}
+
+}  // namespace
+
+Dual::Dual(double value, std::size_t directions) : value_(value), directions_(directions) {
+    if (directions_ > kInlineDirections) {
+        heap_.assign(directions_, 0.0);
+    }
+}
+
+bool Dual::Equals(const Dual& other) const {
+    const std::size_t directions = std::max(directions_, other.directions_);
+    if (value_ != other.value_) {
+        return false;
+    }
+    for (std::size_t i = 0; i < directions; ++i) {
+        if (Tangent(i) != other.Tangent(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool DualBinary(DualBinaryOp op, const Dual& lhs, const Dual& rhs, Dual* out_dual, std::string* out_error) {
+    if (lhs.Directions() != 0 && rhs.Directions() != 0 && lhs.Directions() != rhs.Directions()) {
+        *out_error = "Numeros duales con distinta cantidad de direcciones: " + std::to_string(lhs.Directions()) +
+                     ", " + std::to_string(rhs.Directions()) + ".";
+        return false;
+    }
+
+    const double x = lhs.Value();
+    const double y = rhs.Value();
+    const std::size_t directions = std::max(lhs.Directions(), rhs.Directions());
+    switch (op) {
+    case DualBinaryOp::Add:
+        *out_dual = Dual(x + y, directions);
+        CombineTangents(1.0, lhs, 1.0, rhs, out_dual);
+        return true;
+    case DualBinaryOp::Subtract:
+        *out_dual = Dual(x - y, directions);
+        CombineTangents(1.0, lhs, -1.0, rhs, out_dual);
+        return true;
+    case DualBinaryOp::Multiply:
+        *out_dual = Dual(x * y, directions);
+        CombineTangents(y, lhs, x, rhs, out_dual);
+        return true;
+    case DualBinaryOp::Divide:
+        if (y == 0.0) {
+            *out_error = "Division por cero.";
+            return false;
+        }
+        *out_dual = Dual(x / y, directions);
+        CombineTangents(1.0 / y, lhs, -x / (y * y), rhs, out_dual);
+        return true;
+    case DualBinaryOp::Power: {
+        // d(x^y) = y x^(y-1) dx + x^y ln(x) dy. The second term only exists
+        // for a varying exponent, so x^c stays defined for x <= 0.
+        const double value = std::pow(x, y);
+        const double dx = y == 0.0 ? 0.0 : y * std::pow(x, y - 1.0);
+        const double dy = HasTangent(rhs) ? value * std::log(x) : 0.0;
+        *out_dual = Dual(value, directions);
+        CombineTangents(dx, lhs, dy, rhs, out_dual);
+        return true;
+    }
+    }
+    return false;
+}
+
+Dual DualNegate(const Dual& operand) {
+    Dual result(-operand.Value(), operand.Directions());
+    CombineTangents(-1.0, operand, 0.0, operand, &result);
+    return result;
+}
+
+bool DualApply(DualFunction function,
+               const std::string& name,
+               const Dual& operand,
+               Dual* out_dual,
+               std::string* out_error) {
+    const double x = operand.Value();
+    double value = 0.0;
+    double derivative = 0.0;
+    switch (function) {
+    case DualFunction::Sqrt:
+        if (x < 0.0) {
+            *out_error = "sqrt(x) requiere x >= 0.";
+            return false;
+        }
+        value = std::sqrt(x);
+        derivative = 0.5 / value;
+        break;
+    case DualFunction::Exp:
+        value = std::exp(x);
+        derivative = value;
+        break;
+    case DualFunction::Ln:
+        if (x <= 0.0) {
+            *out_error = "ln(x) requiere x > 0.";
+            return false;
+        }
+        value = std::log(x);
+        derivative = 1.0 / x;
+        break;
+    case DualFunction::Log10:
+        if (x <= 0.0) {
+            *out_error = "log(x) requiere x > 0.";
+            return false;
+        }
+        value = std::log10(x);
+        derivative = 1.0 / (x * std::log(10.0));
+        break;
+    case DualFunction::Abs:
+        value = std::fabs(x);
+        derivative = x < 0.0 ? -1.0 : (x > 0.0 ? 1.0 : 0.0);
+        break;
+    case DualFunction::Sin:
+        value = std::sin(x);
+        derivative = std::cos(x);
+        break;
+    case DualFunction::Cos:
+        value = std::cos(x);
+        derivative = -std::sin(x);
+        break;
+    case DualFunction::Tan:
+        value = std::tan(x);
+        derivative = 1.0 + value * value;
+        break;
+    case DualFunction::Asin:
+    case DualFunction::Acos:
+        if (x < -1.0 || x > 1.0) {
+            *out_error = name + "(x) requiere -1 <= x <= 1.";
+            return false;
+        }
+        value = function == DualFunction::Asin ? std::asin(x) : std::acos(x);
+        derivative = (function == DualFunction::Asin ? 1.0 : -1.0) / std::sqrt(1.0 - x * x);
+        break;
+    case DualFunction::Atan:
+        value = std::atan(x);
+        derivative = 1.0 / (1.0 + x * x);
+        break;
+    }
+
+    *out_dual = Dual(value, operand.Directions());
+    CombineTangents(derivative, operand, 0.0, operand, out_dual);
+    return true;
+}
+
+}  // namespace clot::runtime
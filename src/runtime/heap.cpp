@@ -0,0 +1,13 @@
+#include "clot/runtime/heap.hpp"
+
+namespace clot::runtime {
+
+bool HeapAccountingSupported() {
+    return heap_detail::hooks_installed.load(std::memory_order_relaxed);
+}
+
+void EnableHeapAccounting() {
+    heap_detail::enabled.store(HeapAccountingSupported(), std::memory_order_relaxed);
+}
+
+}  // namespace clot::runtime
@@ -0,0 +1,187 @@
+#include "clot/runtime/heap.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// Replacement global operator new and delete for heap accounting. Built into
+// the clot executable only, never into libclot: a process has one set of
+// these, so a library that brought its own would collide with an embedding
+// host's replacement and charge the host's allocations to the script. A host
+// that wants clot_context_set_limits to accept a heap limit compiles this file
+// into its own executable.
+
+#if defined(_WIN32)
+#include <malloc.h>
+#define CLOT_HEAP_ACCOUNTING 1
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#define CLOT_HEAP_ACCOUNTING 1
+#elif defined(__linux__)
+#include <malloc.h>
+#define CLOT_HEAP_ACCOUNTING 1
+#endif
+
+#if defined(CLOT_HEAP_ACCOUNTING)
+
+namespace {
+
+using clot::runtime::heap_detail::bytes;
+using clot::runtime::heap_detail::enabled;
+
+std::size_t UsableSize(void* pointer, std::size_t alignment) {
+#if defined(_WIN32)
+    return alignment == 0 ? _msize(pointer) : _aligned_msize(pointer, alignment, 0);
+#elif defined(__APPLE__)
+    (void)alignment;
+    return malloc_size(pointer);
+#else
+    (void)alignment;
+    return malloc_usable_size(pointer);
+#endif
+}
+
+void* RawAllocate(std::size_t size, std::size_t alignment) {
+    if (alignment == 0) {
+        return std::malloc(size);
+    }
+#if defined(_WIN32)
+    return _aligned_malloc(size, alignment);
+#else
+    void* pointer = nullptr;
+    if (alignment < sizeof(void*)) {
+        alignment = sizeof(void*);
+    }
+    return posix_memalign(&pointer, alignment, size) == 0 ? pointer : nullptr;
+#endif
+}
+
+// `alignment` is 0 for the plain forms. Follows the standard loop: on failure
+// call the new-handler, and give up (nullptr) when there is none.
+void* Allocate(std::size_t size, std::size_t alignment) {
+    if (size == 0) {
+        size = 1;
+    }
+    while (true) {
+        void* pointer = RawAllocate(size, alignment);
+        if (pointer != nullptr) {
+            if (enabled.load(std::memory_order_relaxed)) {
+                bytes.fetch_add(static_cast<std::int64_t>(UsableSize(pointer, alignment)), std::memory_order_relaxed);
+            }
+            return pointer;
+        }
+        const std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) {
+            return nullptr;
+        }
+        handler();
+    }
+}
+
+void* AllocateOrThrow(std::size_t size, std::size_t alignment) {
+    void* pointer = Allocate(size, alignment);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* AllocateNoThrow(std::size_t size, std::size_t alignment) noexcept {
+    try {
+        return Allocate(size, alignment);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void Release(void* pointer, std::size_t alignment) noexcept {
+    if (pointer == nullptr) {
+        return;
+    }
+    if (enabled.load(std::memory_order_relaxed)) {
+        bytes.fetch_sub(static_cast<std::int64_t>(UsableSize(pointer, alignment)), std::memory_order_relaxed);
+    }
+#if defined(_WIN32)
+    if (alignment != 0) {
+        _aligned_free(pointer);
+        return;
+    }
+#endif
+    std::free(pointer);
+}
+
+std::size_t AlignmentOf(std::align_val_t alignment) {
+    return static_cast<std::size_t>(alignment);
+}
+
+// Tells HeapAccountingSupported() that these operators are the ones linked.
+[[maybe_unused]] const bool kHooksRegistered = [] {
+    clot::runtime::heap_detail::hooks_installed.store(true, std::memory_order_relaxed);
+    return true;
+}();
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+    return AllocateOrThrow(size, 0);
+}
+void* operator new[](std::size_t size) {
+    return AllocateOrThrow(size, 0);
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return AllocateNoThrow(size, 0);
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return AllocateNoThrow(size, 0);
+}
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return AllocateOrThrow(size, AlignmentOf(alignment));
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return AllocateOrThrow(size, AlignmentOf(alignment));
+}
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return AllocateNoThrow(size, AlignmentOf(alignment));
+}
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return AllocateNoThrow(size, AlignmentOf(alignment));
+}
+
+void operator delete(void* pointer) noexcept {
+    Release(pointer, 0);
+}
+void operator delete[](void* pointer) noexcept {
+    Release(pointer, 0);
+}
+void operator delete(void* pointer, std::size_t) noexcept {
+    Release(pointer, 0);
+}
+void operator delete[](void* pointer, std::size_t) noexcept {
+    Release(pointer, 0);
+}
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+    Release(pointer, 0);
+}
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+    Release(pointer, 0);
+}
+void operator delete(void* pointer, std::align_val_t alignment) noexcept {
+    Release(pointer, AlignmentOf(alignment));
+}
+void operator delete[](void* pointer, std::align_val_t alignment) noexcept {
+    Release(pointer, AlignmentOf(alignment));
+}
+void operator delete(void* pointer, std::size_t, std::align_val_t alignment) noexcept {
+    Release(pointer, AlignmentOf(alignment));
+}
+void operator delete[](void* pointer, std::size_t, std::align_val_t alignment) noexcept {
+    Release(pointer, AlignmentOf(alignment));
+}
+void operator delete(void* pointer, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    Release(pointer, AlignmentOf(alignment));
+}
+void operator delete[](void* pointer, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    Release(pointer, AlignmentOf(alignment));
+}
+
+#endif  // CLOT_HEAP_ACCOUNTING
@@ -32,14 +32,67 @@ std::string TranslateSpanishToEnglish(const std::string& text) {
     static constexpr std::pair<const char*, const char*> kPrefixRules[] = {
         {"Falta valor para --mode.", "Missing value for --mode."},
         {"Falta valor para --emit.", "Missing value for --emit."},
+        {"Falta valor para --profile.", "Missing value for --profile."},
+        {"Falta valor para --stats-json.", "Missing value for --stats-json."},
         {"Falta valor para --output.", "Missing value for --output."},
         {"Falta valor para --target.", "Missing value for --target."},
         {"Falta valor para --lang.", "Missing value for --lang."},
         {"Falta valor para --runtime-bridge.", "Missing value for --runtime-bridge."},
+        {"Falta valor para --jit-threshold.", "Missing value for --jit-threshold."},
+        {"Falta valor para --jobs.", "Missing value for --jobs."},
+        {"Falta valor para --object-cache.", "Missing value for --object-cache."},
+        {"Falta valor para --profile-use.", "Missing value for --profile-use."},
+        {"Falta valor para --output-buffering.", "Missing value for --output-buffering."},
+        {"Falta valor para --socket.", "Missing value for --socket."},
+        {"Falta valor para --snapshot.", "Missing value for --snapshot."},
+        {"Falta valor para --snapshot-write.", "Missing value for --snapshot-write."},
+        {"--snapshot solo admite --mode interpret o jit.", "--snapshot only supports --mode interpret or jit."},
+        {"El snapshot requiere haber ejecutado un programa desde un archivo.",
+         "A snapshot requires a program run from a file."},
+        {"El snapshot no puede guardar tareas async ni lectores CSV abiertos.",
+         "A snapshot cannot save async tasks or open CSV readers."},
+        {"Error guardando snapshot: no se encontro la declaracion de '",
+         "Error saving snapshot: could not find the declaration of '"},
+        {"Error guardando snapshot: ", "Error saving snapshot: "},
+        {"No se pudo escribir el snapshot: ", "Could not write the snapshot: "},
+        {"No se pudo abrir el snapshot: ", "Could not open the snapshot: "},
+        {"Snapshot invalido o de otra version de clot: ", "Invalid snapshot or from another clot version: "},
+        {"Snapshot desactualizado: ", "Stale snapshot: "},
+        {"Falta valor para --max-heap.", "Missing value for --max-heap."},
+        {"Falta valor para --max-time.", "Missing value for --max-time."},
+        {"Falta valor para --max-statements.", "Missing value for --max-statements."},
+        {"--max-heap, --max-time y --max-statements solo admiten --mode interpret.",
+         "--max-heap, --max-time and --max-statements only support --mode interpret."},
+        {"El limite de memoria requiere el contador de heap, que este proceso no incluye.",
+         "The memory limit needs the heap counter, which this process does not include."},
+        {"Limite de memoria excedido: el script usa mas de ", "Memory limit exceeded: the script uses more than "},
+        {"Limite de tiempo excedido: el script supera ", "Time limit exceeded: the script runs longer than "},
+        {"Limite de instrucciones excedido: el script supera ",
+         "Instruction limit exceeded: the script runs more than "},
+        {"serve no recibe archivo de entrada.", "serve does not take an input file."},
+        {"--stop solo se usa con serve.", "--stop is only valid with serve."},
+        {"--server solo admite --mode interpret.", "--server only supports --mode interpret."},
+        {"clot serve requiere sockets Unix (POSIX).", "clot serve requires Unix sockets (POSIX)."},
+        {"Ruta de socket invalida o demasiado larga: ", "Invalid or too long socket path: "},
+        {"No se pudo conectar con clot serve en: ", "Could not connect to clot serve at: "},
+        {"La ruta de clot serve no es un socket: ", "The clot serve path is not a socket: "},
+        {"El socket de clot serve pertenece a otro usuario: ", "The clot serve socket belongs to another user: "},
+        {"clot serve corre como otro usuario en: ", "clot serve runs as another user at: "},
+        {"No se pudo crear el socket de clot serve.", "Could not create the clot serve socket."},
+        {"Ya hay un servidor clot serve en: ", "A clot serve server is already running at: "},
+        {"No se pudo escuchar en: ", "Could not listen on: "},
+        {"No se pudo enviar la solicitud a clot serve.", "Could not send the request to clot serve."},
+        {"clot serve cerro la conexion sin responder.", "clot serve closed the connection without replying."},
+        {"No se pudo cambiar al directorio: ", "Could not change to directory: "},
         {"Modo invalido: ", "Invalid mode: "},
+        {"Umbral JIT invalido: ", "Invalid JIT threshold: "},
+        {"Cantidad de hilos invalida: ", "Invalid job count: "},
         {"Emit invalido: ", "Invalid emit kind: "},
         {"Runtime bridge invalido. Use static o external.", "Invalid runtime bridge. Use static or external."},
         {"Idioma invalido. Use es o en.", "Invalid language. Use es or en."},
+        {"Buffering de salida invalido. Use auto, line, block o none.", "Invalid output buffering. Use auto, line, block, or none."},
+        {"Error: CLOT_OUTPUT_BUFFERING invalido (use auto, line, block o none): ",
+         "Error: Invalid CLOT_OUTPUT_BUFFERING (use auto, line, block, or none): "},
         {"Opcion desconocida: ", "Unknown option: "},
         {"Se recibieron multiples archivos de entrada.", "Multiple input files were provided."},
         {"No se encontro archivo .clot de entrada.", "No input .clot file was found."},
@@ -257,6 +310,142 @@ std::string TranslateSpanishToEnglish(const std::string& text) {
          "all() requires an iterable (list, tuple, set, map, object, or string)."},
         {"any() requiere un iterable (list, tuple, set, map, object o string).",
          "any() requires an iterable (list, tuple, set, map, object, or string)."},
+        {"sort(list, key=null, reverse=false) requiere de 1 a 3 argumentos.",
+         "sort(list, key=null, reverse=false) requires 1 to 3 arguments."},
+        {"sorted(iterable, key=null, reverse=false) requiere de 1 a 3 argumentos.",
+         "sorted(iterable, key=null, reverse=false) requires 1 to 3 arguments."},
+        {"top_k(iterable, k, key=null) requiere 2 o 3 argumentos.",
+         "top_k(iterable, k, key=null) requires 2 or 3 arguments."},
+        {"nth_element(iterable, n, key=null) requiere 2 o 3 argumentos.",
+         "nth_element(iterable, n, key=null) requires 2 or 3 arguments."},
+        {"sort(list) requiere una lista; usa sorted() para otros iterables.",
+         "sort(list) requires a list; use sorted() for other iterables."},
+        {"sort(list): la lista cambio durante el ordenamiento.", "sort(list): the list changed while sorting."},
+        {"sorted() requiere un iterable (list, tuple, set, map, object o string).",
+         "sorted() requires an iterable (list, tuple, set, map, object, or string)."},
+        {"top_k() requiere un iterable (list, tuple, set, map, object o string).",
+         "top_k() requires an iterable (list, tuple, set, map, object, or string)."},
+        {"nth_element() requiere un iterable (list, tuple, set, map, object o string).",
+         "nth_element() requires an iterable (list, tuple, set, map, object, or string)."},
+        {"top_k() requiere un entero >= 0 como segundo argumento.",
+         "top_k() requires an integer >= 0 as second argument."},
+        {"nth_element() requiere un entero >= 0 como segundo argumento.",
+         "nth_element() requires an integer >= 0 as second argument."},
+        {"nth_element(): indice fuera de rango.", "nth_element(): index out of range."},
+        {"El argumento key debe ser una funcion o null.", "The key argument must be a function or null."},
+        {"El argumento reverse debe ser bool.", "The reverse argument must be a bool."},
+        {"No se pueden ordenar juntos valores de tipo: ", "Cannot order values of these types together: "},
+        {"Se esperaba una funcion.", "Expected a function."},
+        {"Metodo de string no definido: ", "Undefined string method: "},
+        {"Numero de argumentos invalido para string.", "Invalid number of arguments for string."},
+        {"Los metodos de string requieren argumentos string o char.",
+         "String methods require string or char arguments."},
+        {"El separador de split() no puede ser vacio.", "The split() separator cannot be empty."},
+        {"ndarray(data, dtype=null) requiere 1 o 2 argumentos.", "ndarray(data, dtype=null) requires 1 or 2 arguments."},
+        {"nd_zeros(shape, dtype=\"float64\") requiere 1 o 2 argumentos.",
+         "nd_zeros(shape, dtype=\"float64\") requires 1 or 2 arguments."},
+        {"nd_ones(shape, dtype=\"float64\") requiere 1 o 2 argumentos.",
+         "nd_ones(shape, dtype=\"float64\") requires 1 or 2 arguments."},
+        {"nd_full(shape, value, dtype=\"float64\") requiere 2 o 3 argumentos.",
+         "nd_full(shape, value, dtype=\"float64\") requires 2 or 3 arguments."},
+        {"nd_eye(n, dtype=\"float64\") requiere 1 o 2 argumentos.",
+         "nd_eye(n, dtype=\"float64\") requires 1 or 2 arguments."},
+        {"nd_arange(start, stop, step) requiere de 1 a 3 argumentos.",
+         "nd_arange(start, stop, step) requires 1 to 3 arguments."},
+        {"nd_full() requiere un valor numerico.", "nd_full() requires a numeric value."},
+        {"nd_eye() requiere un entero >= 0.", "nd_eye() requires an integer >= 0."},
+        {"nd_arange() requiere argumentos numericos.", "nd_arange() requires numeric arguments."},
+        {"nd_arange() requiere limites finitos y step distinto de 0.",
+         "nd_arange() requires finite bounds and a non-zero step."},
+        {"dtype invalido: ", "Invalid dtype: "},
+        {"La forma de un ndarray debe ser un entero o una lista de enteros >= 0.",
+         "An ndarray shape must be an integer or a list of integers >= 0."},
+        {"ndarray() requiere listas anidadas rectangulares.", "ndarray() requires rectangular nested lists."},
+        {"ndarray() solo admite elementos numericos: ", "ndarray() only accepts numeric elements: "},
+        {"ndarray() requiere una lista, tuple, range o ndarray.", "ndarray() requires a list, tuple, range, or ndarray."},
+        {"Valor no representable como int64: ", "Value not representable as int64: "},
+        {"Operacion no soportada entre ndarray y ", "Unsupported operation between ndarray and "},
+        {"Operador no soportado para ndarray.", "Operator not supported for ndarray."},
+        {"Formas incompatibles para broadcasting: ", "Incompatible shapes for broadcasting: "},
+        {"reshape(): la forma nueva no conserva el numero de elementos: ",
+         "reshape(): the new shape does not keep the number of elements: "},
+        {"min() no admite un ndarray vacio.", "min() does not accept an empty ndarray."},
+        {"max() no admite un ndarray vacio.", "max() does not accept an empty ndarray."},
+        {"mean() no admite un ndarray vacio.", "mean() does not accept an empty ndarray."},
+        {"dot() solo admite ndarrays de 1 o 2 dimensiones.", "dot() only accepts ndarrays with 1 or 2 dimensions."},
+        {"dot(): dimensiones incompatibles: ", "dot(): incompatible dimensions: "},
+        {"Metodo de ndarray no definido: ", "Undefined ndarray method: "},
+        {"Numero de argumentos invalido para ndarray.", "Invalid number of arguments for ndarray."},
+        {"Metodo de dual no definido: ", "Undefined dual method: "},
+        {"Numero de argumentos invalido para dual.", "Invalid number of arguments for dual."},
+        {"ndarray.slice(start, stop, step, axis) requiere argumentos enteros.",
+         "ndarray.slice(start, stop, step, axis) requires integer arguments."},
+        {"ndarray.slice(): step no puede ser 0.", "ndarray.slice(): step cannot be 0."},
+        {"ndarray.slice(): eje fuera de rango.", "ndarray.slice(): axis out of range."},
+        {"Se requiere una matriz (ndarray de 2 dimensiones) en ", "A matrix (2-dimensional ndarray) is required in "},
+        {"Matriz no cuadrada en ", "Non-square matrix in "},
+        {"Matriz singular en ", "Singular matrix in "},
+        {"solve(): dimensiones incompatibles: ", "solve(): incompatible dimensions: "},
+        {"cholesky(): la matriz no es definida positiva.", "cholesky(): the matrix is not positive definite."},
+        {"eigh(): el metodo QL no convergio.", "eigh(): the QL method did not converge."},
+        {"stats_summary(source, column=null) requiere 1 o 2 argumentos.",
+         "stats_summary(source, column=null) requires 1 or 2 arguments."},
+        {"stats_histogram(source, bins, low, high, column=null) requiere 4 o 5 argumentos.",
+         "stats_histogram(source, bins, low, high, column=null) requires 4 or 5 arguments."},
+        {"stats_quantiles(source, q, column=null) requiere 2 o 3 argumentos.",
+         "stats_quantiles(source, q, column=null) requires 2 or 3 arguments."},
+        {"stats_histogram() requiere bins > 0 y limites finitos con low < high.",
+         "stats_histogram() requires bins > 0 and finite bounds with low < high."},
+        {"stats_quantiles() requiere cuantiles numericos entre 0 y 1.",
+         "stats_quantiles() requires numeric quantiles between 0 and 1."},
+        {"El argumento column solo se admite cuando la fuente es una ruta de archivo.",
+         "The column argument is only accepted when the source is a file path."},
+        {"El argumento column debe ser un entero >= 0 o null.", "The column argument must be an integer >= 0 or null."},
+        {"Las funciones stats_* requieren list, tuple, set, range, ndarray o una ruta de archivo.",
+         "The stats_* functions require a list, tuple, set, range, ndarray, or file path."},
+        {"dual(value, tangent=0) requiere 1 o 2 argumentos.", "dual(value, tangent=0) requires 1 or 2 arguments."},
+        {"dual(value, tangent=0) requiere un valor numerico.", "dual(value, tangent=0) requires a numeric value."},
+        {"dual_seed(point) requiere 1 argumento.", "dual_seed(point) requires 1 argument."},
+        {"dual_gradient(f, point) requiere 2 argumentos.", "dual_gradient(f, point) requires 2 arguments."},
+        {"Operador no soportado para numeros duales.", "Operator not supported for dual numbers."},
+        {"La funcion a derivar debe devolver un numero o un dual.",
+         "The function to differentiate must return a number or a dual."},
+        {"Numeros duales con distinta cantidad de direcciones: ", "Dual numbers with different direction counts: "},
+        {"Propiedad no encontrada en dual: ", "Property not found on dual: "},
+        {"opt_minimize(f, x0, method=\"lbfgs\", options=null) requiere de 2 a 4 argumentos.",
+         "opt_minimize(f, x0, method=\"lbfgs\", options=null) requires 2 to 4 arguments."},
+        {"opt_minimize() requiere x0 como vector no vacio o matriz de puntos iniciales.",
+         "opt_minimize() requires x0 as a non-empty vector or a matrix of start points."},
+        {"opt_minimize(): metodo desconocido (use \"gd\", \"lbfgs\" o \"nelder_mead\"): ",
+         "opt_minimize(): unknown method (use \"gd\", \"lbfgs\", or \"nelder_mead\"): "},
+        {"opt_minimize(): options debe ser un object o null.", "opt_minimize(): options must be an object or null."},
+        {"opt_minimize(): valor invalido para la opcion: ", "opt_minimize(): invalid value for option: "},
+        {"opt_minimize(): opcion desconocida: ", "opt_minimize(): unknown option: "},
+        {"opt_minimize(): gradient \"dual\" no se admite con batch.",
+         "opt_minimize(): gradient \"dual\" is not supported with batch."},
+        {"ml_adam(): state debe ser null o un object {m, v, t}.",
+         "ml_adam(): state must be null or an object {m, v, t}."},
+        {"ml_adam(): beta1 y beta2 deben ser menores que 1.", "ml_adam(): beta1 and beta2 must be less than 1."},
+        {"ml_csv_open(): delimiter debe ser un unico caracter.",
+         "ml_csv_open(): delimiter must be a single character."},
+        {"ml_csv_open(): label_column debe ser un entero o null.",
+         "ml_csv_open(): label_column must be an integer or null."},
+        {"ml_csv_next(): valor no numerico en ", "ml_csv_next(): non-numeric value at "},
+        {"ml_csv_next(): numero de columnas distinto en ", "ml_csv_next(): column count mismatch at "},
+        {"ml_csv_next(): label_column fuera de rango para ", "ml_csv_next(): label_column out of range for "},
+        {"ml_cross_entropy(): el lote esta vacio.", "ml_cross_entropy(): the batch is empty."},
+        {"Lector CSV no encontrado: ", "CSV reader not found: "},
+        {"La funcion objetivo debe devolver un numero.", "The objective function must return a number."},
+        {"La funcion objetivo en batch debe devolver un valor por fila: ",
+         "The batched objective function must return one value per row: "},
+        {"La funcion gradient debe devolver ", "The gradient function must return "},
+        {"Las funciones stats_* requieren valores numericos; elemento invalido en la posicion: ",
+         "The stats_* functions require numeric values; invalid element at position: "},
+        {"join() requiere un iterable (list, tuple, set, map, object o string).",
+         "join() requires an iterable (list, tuple, set, map, object, or string)."},
+        {"count() requiere un texto a buscar no vacio.", "count() requires a non-empty search text."},
+        {"replace() requiere un texto a buscar no vacio.", "replace() requires a non-empty search text."},
+        {"find(): start debe ser un entero >= 0.", "find(): start must be an integer >= 0."},
         {"isinstance(value, type_name) requiere 2 argumentos.", "isinstance(value, type_name) requires 2 arguments."},
         {"isinstance(): type_name debe ser string, char, list, tuple o set.",
          "isinstance(): type_name must be string, char, list, tuple, or set."},
@@ -281,6 +470,23 @@ std::string TranslateSpanishToEnglish(const std::string& text) {
         {"append_file(path, content) requiere 2 argumentos.", "append_file(path, content) requires 2 arguments."},
         {"file_exists(path) requiere 1 argumento.", "file_exists(path) requires 1 argument."},
         {"now_ms() no acepta argumentos.", "now_ms() does not accept arguments."},
+        {"now_ns() no acepta argumentos.", "now_ns() does not accept arguments."},
+        {"cpu_time_ns() no acepta argumentos.", "cpu_time_ns() does not accept arguments."},
+        {"cpu_time_ns() no esta disponible en esta plataforma.", "cpu_time_ns() is not available on this platform."},
+        {"bench(fn, iterations) requiere 2 o 3 argumentos.", "bench(fn, iterations) requires 2 or 3 arguments."},
+        {"bench(fn, iterations) requiere una funcion como primer argumento.",
+         "bench(fn, iterations) requires a function as its first argument."},
+        {"bench(fn, iterations) requiere iterations entero >= 1.", "bench(fn, iterations) requires integer iterations >= 1."},
+        {"bench(fn, iterations, warmup) requiere warmup entero >= 0.",
+         "bench(fn, iterations, warmup) requires integer warmup >= 0."},
+        {"clot_context_register_builtin requiere nombre y funcion.",
+         "clot_context_register_builtin requires a name and a function."},
+        {"clot_context_run requiere un programa.", "clot_context_run requires a program."},
+        {"clot_context_call requiere el nombre de la funcion.", "clot_context_call requires the function name."},
+        {"clot_context_call requiere ejecutar un programa antes.", "clot_context_call requires running a program first."},
+        {"Excepcion interna desconocida.", "Unknown internal exception."},
+        {"Excepcion interna: ", "Internal exception: "},
+        {"Memoria insuficiente.", "Out of memory."},
         {"sleep_ms(ms) requiere 1 argumento.", "sleep_ms(ms) requires 1 argument."},
         {"sleep_ms(ms) requiere entero >= 0.", "sleep_ms(ms) requires integer >= 0."},
         {"async_read_file(path) requiere 1 argumento.", "async_read_file(path) requires 1 argument."},
@@ -305,12 +511,14 @@ std::string TranslateSpanishToEnglish(const std::string& text) {
         {"Valor map[", "Map value["},
         {"Propiedad object.", "Object property."},
         {"Error interno: salida nula en for-each.", "Internal error: null output in for-each."},
-        {"for-each requiere list, tuple, set, map, object, string o range.",
-         "for-each requires list, tuple, set, map, object, string, or range."},
+        {"for-each requiere list, tuple, set, map, object, string, range o ndarray.",
+         "for-each requires list, tuple, set, map, object, string, range, or ndarray."},
         {"Operador 'in' requiere list, tuple, set, map, object, string o range a la derecha.",
          "Operator 'in' requires list, tuple, set, map, object, string, or range on the right-hand side."},
         {"Solo se puede indexar una lista con [].", "Only lists can be indexed with []."},
-        {"Solo se puede indexar list, tuple, range, map u object con [].", "Only list, tuple, range, map, or object can be indexed with []."},
+        {"Solo se puede indexar list, tuple, range, ndarray, map u object con [].",
+         "Only list, tuple, range, ndarray, map, or object can be indexed with []."},
+        {"Indice fuera de rango en ndarray.", "ndarray index out of bounds."},
         {"El indice de lista debe ser un entero finito.", "List index must be a finite integer."},
         {"Indice fuera de rango en lista.", "List index out of bounds."},
         {"Indice fuera de rango en tuple.", "Tuple index out of bounds."},
@@ -325,6 +533,7 @@ std::string TranslateSpanishToEnglish(const std::string& text) {
         {"Valor fuera de rango para byte (0-255).", "Value out of range for byte (0-255)."},
         {"Valor no finito para double.", "Non-finite value for double."},
         {"La expresion requiere un decimal.", "Expression requires a decimal."},
+        {"La expresion requiere un dual.", "Expression requires a dual."},
         {"La expresion requiere un list.", "Expression requires a list."},
         {"La expresion requiere un object.", "Expression requires an object."},
         {"La expresion requiere un string.", "Expression requires a string."},
@@ -382,6 +591,7 @@ std::string TranslateSpanishToEnglish(const std::string& text) {
         {"Error de runtime bridge externo: fallo al escribir archivo temporal.",
          "External runtime bridge error: failed to write temporary file."},
         {"No se pudo abrir el archivo: ", "Could not open file: "},
+        {"No se pudo escribir el perfil: ", "Could not write the profile: "},
         {"Error leyendo el archivo: ", "Error reading file: "},
         {"Error escribiendo el archivo: ", "Error writing file: "},
         {"No se pudo crear la funcion main.", "Failed to create main function."},
@@ -422,9 +632,21 @@ std::string TranslateSpanishToEnglish(const std::string& text) {
         {"Funcion no definida en modo compile LLVM AOT: ", "Undefined function in LLVM AOT compile mode: "},
         {"Referencia por propiedad no soportada en AOT LLVM: ", "Property reference is not supported in LLVM AOT: "},
         {"Acceso por propiedad no soportado en AOT LLVM: ", "Property access is not supported in LLVM AOT: "},
+        {"Las listas solo se soportan por elemento o len() en AOT LLVM: ", "Lists are only supported by element or len() in LLVM AOT: "},
+        {"len() en AOT LLVM solo acepta listas numericas.", "len() in LLVM AOT only accepts numeric lists."},
+        {"La indexacion en AOT LLVM solo se soporta sobre listas numericas.", "Indexing in LLVM AOT is only supported on numeric lists."},
+        {"for-each en AOT LLVM solo recorre listas numericas.", "for-each in LLVM AOT only iterates numeric lists."},
+        {"Mutacion no soportada en AOT LLVM.", "Mutation is not supported in LLVM AOT."},
+        {"Mutacion vacia en emision LLVM.", "Empty mutation in LLVM emission."},
+        {"No se pudo crear el cache de objetos '", "Could not create object cache '"},
+        {"No se pudo guardar objeto en cache '", "Could not store object in cache '"},
+        {"--instrument y --profile-use no se pueden combinar.", "--instrument and --profile-use cannot be combined."},
+        {"--instrument requiere --emit exe.", "--instrument requires --emit exe."},
+        {"--profile-use requiere --emit exe u obj.", "--profile-use requires --emit exe or obj."},
+        {"PGO requiere el subconjunto AOT; este programa usa runtime bridge.", "PGO requires the AOT subset; this program uses the runtime bridge."},
+        {"No se encontro el perfil PGO: ", "PGO profile not found: "},
         {"Las listas aun no se soportan en modo compile LLVM AOT.", "Lists are not yet supported in LLVM AOT compile mode."},
         {"Los objetos aun no se soportan en modo compile LLVM AOT.", "Objects are not yet supported in LLVM AOT compile mode."},
-        {"La indexacion de listas aun no se soporta en modo compile LLVM AOT.", "List indexing is not yet supported in LLVM AOT compile mode."},
         {"No se puede pasar '&' a parametro por valor en llamada '", "Cannot pass '&' to value parameter in call '"},
         {"Parametro por referencia en '", "Reference parameter in '"},
         {"Las declaraciones tipadas solo aceptan '='.", "Typed declarations only accept '='."},
@@ -435,6 +657,11 @@ std::string TranslateSpanishToEnglish(const std::string& text) {
         {"Funcion no soportada en modo compile LLVM AOT: ", "Unsupported function in LLVM AOT compile mode: "},
         {"Llamada no soportada en modo compile LLVM AOT: ", "Unsupported call in LLVM AOT compile mode: "},
         {"Expresion no soportada en backend LLVM.", "Unsupported expression in LLVM backend."},
+        {"No se pudo crear LLJIT: ", "Could not create LLJIT: "},
+        {"No se pudo exponer simbolos del proceso al JIT: ", "Could not expose process symbols to the JIT: "},
+        {"No se pudo agregar modulo al JIT: ", "Could not add module to the JIT: "},
+        {"No se encontro simbolo JIT '", "JIT symbol not found '"},
+        {"LLVM genero un modulo JIT invalido para '", "LLVM generated an invalid JIT module for '"},
         {"Operador 'in' no soportado en modo compile LLVM AOT; usa runtime bridge.",
          "Operator 'in' is not supported in LLVM AOT compile mode; use runtime bridge."},
         {"Este binario se compilo sin soporte LLVM. Reconfigura con LLVM instalado.", "This binary was built without LLVM support. Reconfigure with LLVM installed."},
@@ -607,7 +834,7 @@ std::string TranslateSpanishToEnglish(const std::string& text) {
          "Invalid string interpolation: unmatched '}'."},
         {"append(value) requiere exactamente 1 argumento.", "append(value) requires exactly 1 argument."},
         {"Error interno: argumento vacio en append().", "Internal error: empty argument in append()."},
-        {"append(value) requiere una lista como receptor.", "append(value) requires a list as receiver."},
+        {"append(value) requiere una lista o string como receptor.", "append(value) requires a list or string as receiver."},
         {"La repeticion de listas requiere un entero >= 0.",
          "List repetition requires an integer >= 0."},
         {"La repeticion de listas excede el maximo de 1000000 repeticiones.",
@@ -632,6 +859,11 @@ std::string TranslateSpanishToEnglish(const std::string& text) {
     ReplaceAll(&translated, ", linea ", ", line ");
     ReplaceAll(&translated, " en linea ", " at line ");
     ReplaceAll(&translated, "No se pudo abrir el archivo: ", "Could not open file: ");
+    ReplaceAll(&translated, " cambio desde que se creo.", " changed since it was created.");
+    ReplaceAll(&translated, " no se pudo parsear.", " could not be parsed.");
+    ReplaceAll(&translated, " bytes de heap.", " bytes of heap.");
+    ReplaceAll(&translated, " ms de ejecucion.", " ms.");
+    ReplaceAll(&translated, " sentencias ejecutadas.", " statements.");
     ReplaceAll(&translated, "Error leyendo el archivo: ", "Error reading file: ");
     ReplaceAll(&translated, "Error escribiendo el archivo: ", "Error writing file: ");
     ReplaceAll(&translated, "Variable no definida: ", "Undefined variable: ");
@@ -643,6 +875,34 @@ std::string TranslateSpanishToEnglish(const std::string& text) {
     ReplaceAll(&translated, "() requiere 1 o 2 argumentos.", "() requires 1 or 2 arguments.");
     ReplaceAll(&translated, "(x) requiere 1 argumento.", "(x) requires 1 argument.");
     ReplaceAll(&translated, "(x) requiere -1 <= x <= 1.", "(x) requires -1 <= x <= 1.");
+    ReplaceAll(&translated, "() requiere un list, tuple o ndarray de numeros.",
+               "() requires a list, tuple, or ndarray of numbers.");
+    ReplaceAll(&translated, "() no admite numeros duales.", "() does not accept dual numbers.");
+    ReplaceAll(&translated, " valores por punto.", " values per point.");
+    ReplaceAll(&translated, ") requiere 1 argumento.", ") requires 1 argument.");
+    ReplaceAll(&translated, ") requiere 2 argumentos.", ") requires 2 arguments.");
+    ReplaceAll(&translated, ") requiere 3 argumentos.", ") requires 3 arguments.");
+    ReplaceAll(&translated, ") requiere de 1 a 2 argumentos.", ") requires 1 to 2 arguments.");
+    ReplaceAll(&translated, ") requiere de 2 a 3 argumentos.", ") requires 2 to 3 arguments.");
+    ReplaceAll(&translated, ") requiere de 2 a 4 argumentos.", ") requires 2 to 4 arguments.");
+    ReplaceAll(&translated, ") requiere de 3 a 4 argumentos.", ") requires 3 to 4 arguments.");
+    ReplaceAll(&translated, ") requiere de 3 a 5 argumentos.", ") requires 3 to 5 arguments.");
+    ReplaceAll(&translated, ") requiere de 4 a 5 argumentos.", ") requires 4 to 5 arguments.");
+    ReplaceAll(&translated, " debe ser un ndarray.", " must be an ndarray.");
+    ReplaceAll(&translated, " debe ser una matriz (ndarray de 2 dimensiones)", " must be a matrix (2-dimensional ndarray)");
+    ReplaceAll(&translated, "; forma ", "; shape ");
+    ReplaceAll(&translated, "(): formas incompatibles: ", "(): incompatible shapes: ");
+    ReplaceAll(&translated, "(): activacion desconocida (use \"none\", \"relu\", \"sigmoid\" o \"tanh\"): ",
+               "(): unknown activation (use \"none\", \"relu\", \"sigmoid\", or \"tanh\"): ");
+    ReplaceAll(&translated, "(): valor invalido para ", "(): invalid value for ");
+    ReplaceAll(&translated, " debe ser un entero >= ", " must be an integer >= ");
+    ReplaceAll(&translated, "(): options debe ser un object o null.", "(): options must be an object or null.");
+    ReplaceAll(&translated, "(): opcion desconocida: ", "(): unknown option: ");
+    ReplaceAll(&translated, "(): etiqueta fuera de rango en la fila ", "(): label out of range in row ");
+    ReplaceAll(&translated, "(): las etiquetas deben ser un vector de ", "(): labels must be a vector of ");
+    ReplaceAll(&translated, " clases o una matriz ", " classes or a matrix ");
+    ReplaceAll(&translated, "; se esperaban ", "; expected ");
+    ReplaceAll(&translated, " columnas: ", " columns: ");
     ReplaceAll(&translated, "() requiere import math para evitar fallo en runtime.",
                "() requires import math to avoid runtime failure.");
     ReplaceAll(&translated, "() requiere 'import math;' en modo compile LLVM AOT.",
@@ -651,6 +911,7 @@ std::string TranslateSpanishToEnglish(const std::string& text) {
     ReplaceAll(&translated, " requiere una variable.", " requires a variable.");
     ReplaceAll(&translated, " requiere argumento explicito.", " requires an explicit argument.");
     ReplaceAll(&translated, " no retorno ningun valor.", " did not return any value.");
+    ReplaceAll(&translated, "' no es elegible para JIT LLVM.", "' is not eligible for the LLVM JIT.");
     ReplaceAll(&translated, " no retorna valor utilizable en expresion.",
                " does not return a usable value in expression.");
     ReplaceAll(&translated, " debe retornar un valor de tipo '", " must return a value of type '");
@@ -0,0 +1,1066 @@
+#include "clot/runtime/ml.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include "clot/runtime/ndarray_linalg.hpp"
+#include "ndarray_internal.hpp"
+
+namespace clot::runtime {
+
+namespace {
+
+using namespace internal;
+
+// Fewest elements worth giving a thread of their own.
+constexpr std::size_t kParallelMlThreshold = std::size_t{1} << 16;
+
+// Slices for `rows` rows of `columns` elements each.
+std::size_t ChunkCount(std::size_t rows, std::size_t columns) {
+    const std::size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t work = rows * std::max<std::size_t>(columns, 1);
+    return std::max<std::size_t>(1, std::min({hardware, work / kParallelMlThreshold, rows}));
+}
+
+// Runs body(begin, end, chunk) over `chunks` equal slices of [0, count), one
+// thread per slice.
+template <typename Body>
+void RunChunks(std::size_t count, std::size_t chunks, Body body) {
+    if (chunks <= 1) {
+        body(std::size_t{0}, count, std::size_t{0});
+        return;
+    }
+    std::vector<std::thread> workers;
+    workers.reserve(chunks);
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+        workers.emplace_back([&, chunk]() { body(count * chunk / chunks, count * (chunk + 1) / chunks, chunk); });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+NdArray Float32(const NdArray& array) {
+    return array.AsType(NdType::Float32).Contiguous();
+}
+
+template <MlActivation kActivation>
+float ScalarActivate(float x) {
+    if constexpr (kActivation == MlActivation::Relu) {
+        return x > 0.0f ? x : 0.0f;
+    } else if constexpr (kActivation == MlActivation::Sigmoid) {
+        return 1.0f / (1.0f + std::exp(-x));
+    } else if constexpr (kActivation == MlActivation::Tanh) {
+        return std::tanh(x);
+    } else {
+        return x;
+    }
+}
+
+template <MlActivation kActivation>
+float ScalarDerivative(float y) {
+    if constexpr (kActivation == MlActivation::Relu) {
+        return y > 0.0f ? 1.0f : 0.0f;
+    } else if constexpr (kActivation == MlActivation::Sigmoid) {
+        return y * (1.0f - y);
+    } else if constexpr (kActivation == MlActivation::Tanh) {
+        return 1.0f - y * y;
+    } else {
+        return 1.0f;
+    }
+}
+
+// Adam coefficients, in the order the kernels read them.
+enum AdamCoefficient {
+    kAdamBeta1,
+    kAdamBeta2,
+    kAdamStepSize,     // learning_rate / (1 - beta1^t)
+    kAdamCorrection2,  // 1 / (1 - beta2^t)
+    kAdamEpsilon,
+    kAdamCoefficientCount,
+};
+
+CLOT_NDARRAY_INLINE void AdamElement(const float* coefficients,
+                                     float param,
+                                     float grad,
+                                     float first,
+                                     float second,
+                                     float* out_param,
+                                     float* out_first,
+                                     float* out_second) {
+    first = coefficients[kAdamBeta1] * first + (1.0f - coefficients[kAdamBeta1]) * grad;
+    second = coefficients[kAdamBeta2] * second + (1.0f - coefficients[kAdamBeta2]) * grad * grad;
+    *out_first = first;
+    *out_second = second;
+    *out_param = param - coefficients[kAdamStepSize] * first /
+                             (std::sqrt(second * coefficients[kAdamCorrection2]) + coefficients[kAdamEpsilon]);
+}
+
+#ifdef CLOT_NDARRAY_VECTOR
+
+template <std::size_t kBytes>
+using FloatVector = typename VectorOf<float, kBytes>::Type;
+template <std::size_t kBytes>
+using IntVector = typename VectorOf<std::int32_t, kBytes>::Type;
+
+// exp(x) for a float vector: x = n ln2 + r with |r| <= ln2 / 2, the Cephes
+// expf polynomial for e^r and the exponent bits for 2^n. Within a few ulp of
+// std::exp; inputs are clamped to the range where the result is finite.
+template <std::size_t kBytes>
+CLOT_NDARRAY_INLINE FloatVector<kBytes> ExpVector(FloatVector<kBytes> x) {
+    using Vec = FloatVector<kBytes>;
+    using IVec = IntVector<kBytes>;
+    const Vec high = SplatVector<Vec>(88.3762626647949f);
+    const Vec low = SplatVector<Vec>(-87.3365447504019f);
+    x = x > high ? high : x;
+    x = x < low ? low : x;
+
+    const Vec scaled = x * 1.44269504088896341f + 0.5f;
+    Vec n = __builtin_convertvector(__builtin_convertvector(scaled, IVec), Vec);
+    n = n > scaled ? n - 1.0f : n;
+    const Vec r = x - n * 0.693359375f + n * 2.12194440e-4f;
+
+    Vec p = SplatVector<Vec>(1.9875691500e-4f);
+    p = p * r + 1.3981999507e-3f;
+    p = p * r + 8.3334519073e-3f;
+    p = p * r + 4.1665795894e-2f;
+    p = p * r + 1.6666665459e-1f;
+    p = p * r + 5.0000001201e-1f;
+    p = p * r * r + r + 1.0f;
+
+    const IVec exponent = (__builtin_convertvector(n, IVec) + 127) << 23;
+    Vec scale;
+    __builtin_memcpy(&scale, &exponent, sizeof(scale));
+    return p * scale;
+}
+
+template <MlActivation kActivation, std::size_t kBytes>
+CLOT_NDARRAY_INLINE FloatVector<kBytes> ActivateVector(FloatVector<kBytes> x) {
+    using Vec = FloatVector<kBytes>;
+    if constexpr (kActivation == MlActivation::Relu) {
+        const Vec zero = SplatVector<Vec>(0.0f);
+        return x > zero ? x : zero;
+    } else if constexpr (kActivation == MlActivation::Sigmoid) {
+        return 1.0f / (1.0f + ExpVector<kBytes>(-x));
+    } else if constexpr (kActivation == MlActivation::Tanh) {
+        // tanh(x) = 2 sigmoid(2x) - 1.
+        return 2.0f / (1.0f + ExpVector<kBytes>(-2.0f * x)) - 1.0f;
+    } else {
+        return x;
+    }
+}
+
+template <MlActivation kActivation, std::size_t kBytes>
+CLOT_NDARRAY_INLINE FloatVector<kBytes> DerivativeVector(FloatVector<kBytes> y) {
+    using Vec = FloatVector<kBytes>;
+    if constexpr (kActivation == MlActivation::Relu) {
+        const Vec zero = SplatVector<Vec>(0.0f);
+        return y > zero ? SplatVector<Vec>(1.0f) : zero;
+    } else if constexpr (kActivation == MlActivation::Sigmoid) {
+        return y * (1.0f - y);
+    } else if constexpr (kActivation == MlActivation::Tanh) {
+        return 1.0f - y * y;
+    } else {
+        return SplatVector<Vec>(1.0f);
+    }
+}
+
+#endif  // CLOT_NDARRAY_VECTOR
+
+// The loops below process whole vectors at the kernel width and finish the
+// tail (or everything, at kScalarWidth) with the scalar formulas.
+
+// out = act(input + bias); `bias` has `count` elements or is null.
+template <MlActivation kActivation, std::size_t kBytes>
+CLOT_NDARRAY_INLINE void ActivateLoop(const float* input, const float* bias, float* out, std::size_t count) {
+    std::size_t i = 0;
+#ifdef CLOT_NDARRAY_VECTOR
+    if constexpr (kBytes != kScalarWidth) {
+        using Vec = FloatVector<kBytes>;
+        constexpr std::size_t kLanes = VectorOf<float, kBytes>::kLanes;
+        for (; i + kLanes <= count; i += kLanes) {
+            Vec x = LoadVector<Vec>(input + i);
+            if (bias != nullptr) {
+                x += LoadVector<Vec>(bias + i);
+            }
+            StoreVector(out + i, ActivateVector<kActivation, kBytes>(x));
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        out[i] = ScalarActivate<kActivation>(bias == nullptr ? input[i] : input[i] + bias[i]);
+    }
+}
+
+template <MlActivation kActivation, std::size_t kBytes>
+CLOT_NDARRAY_INLINE void BackwardLoop(const float* output, const float* grad, float* out, std::size_t count) {
+    std::size_t i = 0;
+#ifdef CLOT_NDARRAY_VECTOR
+    if constexpr (kBytes != kScalarWidth) {
+        using Vec = FloatVector<kBytes>;
+        constexpr std::size_t kLanes = VectorOf<float, kBytes>::kLanes;
+        for (; i + kLanes <= count; i += kLanes) {
+            StoreVector(out + i, LoadVector<Vec>(grad + i) *
+                                     DerivativeVector<kActivation, kBytes>(LoadVector<Vec>(output + i)));
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        out[i] = grad[i] * ScalarDerivative<kActivation>(output[i]);
+    }
+}
+
+// out = exp(input - shift); returns the sum of out.
+template <std::size_t kBytes>
+CLOT_NDARRAY_INLINE double ExpSumLoop(const float* input, float shift, float* out, std::size_t count) {
+    std::size_t i = 0;
+    double sum = 0.0;
+#ifdef CLOT_NDARRAY_VECTOR
+    if constexpr (kBytes != kScalarWidth) {
+        using Vec = FloatVector<kBytes>;
+        constexpr std::size_t kLanes = VectorOf<float, kBytes>::kLanes;
+        Vec partial = SplatVector<Vec>(0.0f);
+        for (; i + kLanes <= count; i += kLanes) {
+            const Vec value = ExpVector<kBytes>(LoadVector<Vec>(input + i) - shift);
+            StoreVector(out + i, value);
+            partial += value;
+        }
+        for (std::size_t lane = 0; lane < kLanes; ++lane) {
+            sum += partial[lane];
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        out[i] = std::exp(input[i] - shift);
+        sum += out[i];
+    }
+    return sum;
+}
+
+template <std::size_t kBytes>
+CLOT_NDARRAY_INLINE float MaxLoop(const float* input, std::size_t count) {
+    std::size_t i = 0;
+    float best = -std::numeric_limits<float>::infinity();
+#ifdef CLOT_NDARRAY_VECTOR
+    if constexpr (kBytes != kScalarWidth) {
+        using Vec = FloatVector<kBytes>;
+        constexpr std::size_t kLanes = VectorOf<float, kBytes>::kLanes;
+        Vec partial = SplatVector<Vec>(best);
+        for (; i + kLanes <= count; i += kLanes) {
+            const Vec value = LoadVector<Vec>(input + i);
+            partial = value > partial ? value : partial;
+        }
+        for (std::size_t lane = 0; lane < kLanes; ++lane) {
+            best = std::max(best, partial[lane]);
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        best = std::max(best, input[i]);
+    }
+    return best;
+}
+
+// out = (data * factor - target) * scale, with `target` null for zeros. The
+// softmax normalization and the cross-entropy gradient both have this form.
+template <std::size_t kBytes>
+CLOT_NDARRAY_INLINE void ScaleLoop(const float* data,
+                                   float factor,
+                                   const float* target,
+                                   float scale,
+                                   float* out,
+                                   std::size_t count) {
+    std::size_t i = 0;
+#ifdef CLOT_NDARRAY_VECTOR
+    if constexpr (kBytes != kScalarWidth) {
+        using Vec = FloatVector<kBytes>;
+        constexpr std::size_t kLanes = VectorOf<float, kBytes>::kLanes;
+        for (; i + kLanes <= count; i += kLanes) {
+            Vec value = LoadVector<Vec>(data + i) * factor;
+            if (target != nullptr) {
+                value -= LoadVector<Vec>(target + i);
+            }
+            StoreVector(out + i, value * scale);
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        out[i] = (data[i] * factor - (target == nullptr ? 0.0f : target[i])) * scale;
+    }
+}
+
+// Heavy-ball SGD; with a null `velocity` the plain step param - lr * grad.
+template <std::size_t kBytes>
+CLOT_NDARRAY_INLINE void SgdLoop(const float* param,
+                                 const float* grad,
+                                 const float* velocity,
+                                 float learning_rate,
+                                 float momentum,
+                                 float* out_param,
+                                 float* out_velocity,
+                                 std::size_t count) {
+    std::size_t i = 0;
+#ifdef CLOT_NDARRAY_VECTOR
+    if constexpr (kBytes != kScalarWidth) {
+        using Vec = FloatVector<kBytes>;
+        constexpr std::size_t kLanes = VectorOf<float, kBytes>::kLanes;
+        for (; i + kLanes <= count; i += kLanes) {
+            Vec step = LoadVector<Vec>(grad + i);
+            if (velocity != nullptr) {
+                step += momentum * LoadVector<Vec>(velocity + i);
+                StoreVector(out_velocity + i, step);
+            }
+            StoreVector(out_param + i, LoadVector<Vec>(param + i) - learning_rate * step);
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        float step = grad[i];
+        if (velocity != nullptr) {
+            step += momentum * velocity[i];
+            out_velocity[i] = step;
+        }
+        out_param[i] = param[i] - learning_rate * step;
+    }
+}
+
+template <std::size_t kBytes>
+CLOT_NDARRAY_INLINE void AdamLoop(const float* param,
+                                  const float* grad,
+                                  const float* first,
+                                  const float* second,
+                                  const float* coefficients,
+                                  float* out_param,
+                                  float* out_first,
+                                  float* out_second,
+                                  std::size_t count) {
+    std::size_t i = 0;
+#ifdef CLOT_NDARRAY_VECTOR
+    if constexpr (kBytes != kScalarWidth) {
+        using Vec = FloatVector<kBytes>;
+        constexpr std::size_t kLanes = VectorOf<float, kBytes>::kLanes;
+        const float beta1 = coefficients[kAdamBeta1];
+        const float beta2 = coefficients[kAdamBeta2];
+        for (; i + kLanes <= count; i += kLanes) {
+            const Vec g = LoadVector<Vec>(grad + i);
+            const Vec m = beta1 * LoadVector<Vec>(first + i) + (1.0f - beta1) * g;
+            const Vec v = beta2 * LoadVector<Vec>(second + i) + (1.0f - beta2) * g * g;
+            StoreVector(out_first + i, m);
+            StoreVector(out_second + i, v);
+            // Vector extensions have no square root; the lanes compile to
+            // scalar sqrt instructions of the same width.
+            Vec root = v * coefficients[kAdamCorrection2];
+            for (std::size_t lane = 0; lane < kLanes; ++lane) {
+                root[lane] = std::sqrt(root[lane]);
+            }
+            StoreVector(out_param + i, LoadVector<Vec>(param + i) -
+                                           coefficients[kAdamStepSize] * m / (root + coefficients[kAdamEpsilon]));
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        AdamElement(coefficients, param[i], grad[i], first[i], second[i], out_param + i, out_first + i,
+                    out_second + i);
+    }
+}
+
+struct MlKernelSet {
+    void (*activate[4])(const float* input, const float* bias, float* out, std::size_t count);
+    void (*backward[4])(const float* output, const float* grad, float* out, std::size_t count);
+    double (*exp_sum)(const float* input, float shift, float* out, std::size_t count);
+    float (*max)(const float* input, std::size_t count);
+    void (*scale)(const float* data, float factor, const float* target, float scale, float* out, std::size_t count);
+    void (*sgd)(const float* param,
+                const float* grad,
+                const float* velocity,
+                float learning_rate,
+                float momentum,
+                float* out_param,
+                float* out_velocity,
+                std::size_t count);
+    void (*adam)(const float* param,
+                 const float* grad,
+                 const float* first,
+                 const float* second,
+                 const float* coefficients,
+                 float* out_param,
+                 float* out_first,
+                 float* out_second,
+                 std::size_t count);
+};
+
+// Out-of-line instances of the loops, for the kernel table.
+template <MlActivation kActivation, std::size_t kBytes>
+void PortableActivate(const float* input, const float* bias, float* out, std::size_t count) {
+    ActivateLoop<kActivation, kBytes>(input, bias, out, count);
+}
+
+template <MlActivation kActivation, std::size_t kBytes>
+void PortableBackward(const float* output, const float* grad, float* out, std::size_t count) {
+    BackwardLoop<kActivation, kBytes>(output, grad, out, count);
+}
+
+template <std::size_t kBytes>
+double PortableExpSum(const float* input, float shift, float* out, std::size_t count) {
+    return ExpSumLoop<kBytes>(input, shift, out, count);
+}
+
+template <std::size_t kBytes>
+float PortableMax(const float* input, std::size_t count) {
+    return MaxLoop<kBytes>(input, count);
+}
+
+template <std::size_t kBytes>
+void PortableScale(const float* data, float factor, const float* target, float scale, float* out, std::size_t count) {
+    ScaleLoop<kBytes>(data, factor, target, scale, out, count);
+}
+
+template <std::size_t kBytes>
+void PortableSgd(const float* param,
+                 const float* grad,
+                 const float* velocity,
+                 float learning_rate,
+                 float momentum,
+                 float* out_param,
+                 float* out_velocity,
+                 std::size_t count) {
+    SgdLoop<kBytes>(param, grad, velocity, learning_rate, momentum, out_param, out_velocity, count);
+}
+
+template <std::size_t kBytes>
+void PortableAdam(const float* param,
+                  const float* grad,
+                  const float* first,
+                  const float* second,
+                  const float* coefficients,
+                  float* out_param,
+                  float* out_first,
+                  float* out_second,
+                  std::size_t count) {
+    AdamLoop<kBytes>(param, grad, first, second, coefficients, out_param, out_first, out_second, count);
+}
+
+template <std::size_t kBytes>
+MlKernelSet PortableKernels() {
+    return MlKernelSet{
+        {PortableActivate<MlActivation::Identity, kBytes>, PortableActivate<MlActivation::Relu, kBytes>,
+         PortableActivate<MlActivation::Sigmoid, kBytes>, PortableActivate<MlActivation::Tanh, kBytes>},
+        {PortableBackward<MlActivation::Identity, kBytes>, PortableBackward<MlActivation::Relu, kBytes>,
+         PortableBackward<MlActivation::Sigmoid, kBytes>, PortableBackward<MlActivation::Tanh, kBytes>},
+        PortableExpSum<kBytes>,
+        PortableMax<kBytes>,
+        PortableScale<kBytes>,
+        PortableSgd<kBytes>,
+        PortableAdam<kBytes>,
+    };
+}
+
+#ifdef CLOT_NDARRAY_AVX2
+
+template <MlActivation kActivation>
+__attribute__((target("avx2"))) void Avx2Activate(const float* input, const float* bias, float* out, std::size_t count) {
+    ActivateLoop<kActivation, kAvx2Width>(input, bias, out, count);
+}
+
+template <MlActivation kActivation>
+__attribute__((target("avx2"))) void Avx2Backward(const float* output,
+                                                  const float* grad,
+                                                  float* out,
+                                                  std::size_t count) {
+    BackwardLoop<kActivation, kAvx2Width>(output, grad, out, count);
+}
+
+__attribute__((target("avx2"))) double Avx2ExpSum(const float* input, float shift, float* out, std::size_t count) {
+    return ExpSumLoop<kAvx2Width>(input, shift, out, count);
+}
+
+__attribute__((target("avx2"))) float Avx2Max(const float* input, std::size_t count) {
+    return MaxLoop<kAvx2Width>(input, count);
+}
+
+__attribute__((target("avx2"))) void Avx2Scale(const float* data,
+                                               float factor,
+                                               const float* target,
+                                               float scale,
+                                               float* out,
+                                               std::size_t count) {
+    ScaleLoop<kAvx2Width>(data, factor, target, scale, out, count);
+}
+
+__attribute__((target("avx2"))) void Avx2Sgd(const float* param,
+                                             const float* grad,
+                                             const float* velocity,
+                                             float learning_rate,
+                                             float momentum,
+                                             float* out_param,
+                                             float* out_velocity,
+                                             std::size_t count) {
+    SgdLoop<kAvx2Width>(param, grad, velocity, learning_rate, momentum, out_param, out_velocity, count);
+}
+
+__attribute__((target("avx2"))) void Avx2Adam(const float* param,
+                                              const float* grad,
+                                              const float* first,
+                                              const float* second,
+                                              const float* coefficients,
+                                              float* out_param,
+                                              float* out_first,
+                                              float* out_second,
+                                              std::size_t count) {
+    AdamLoop<kAvx2Width>(param, grad, first, second, coefficients, out_param, out_first, out_second, count);
+}
+
+#endif  // CLOT_NDARRAY_AVX2
+
+const MlKernelSet& Kernels() {
+    static const MlKernelSet kernels = []() {
+        switch (SelectedKernelLevel()) {
+        case KernelLevel::Scalar:
+            return PortableKernels<kScalarWidth>();
+        case KernelLevel::Avx2:
+#ifdef CLOT_NDARRAY_AVX2
+            return MlKernelSet{
+                {Avx2Activate<MlActivation::Identity>, Avx2Activate<MlActivation::Relu>,
+                 Avx2Activate<MlActivation::Sigmoid>, Avx2Activate<MlActivation::Tanh>},
+                {Avx2Backward<MlActivation::Identity>, Avx2Backward<MlActivation::Relu>,
+                 Avx2Backward<MlActivation::Sigmoid>, Avx2Backward<MlActivation::Tanh>},
+                Avx2ExpSum,
+                Avx2Max,
+                Avx2Scale,
+                Avx2Sgd,
+                Avx2Adam,
+            };
+#endif
+        case KernelLevel::Portable:
+            break;
+        }
+#ifdef CLOT_NDARRAY_VECTOR
+        return PortableKernels<kPortableWidth>();
+#else
+        return PortableKernels<kScalarWidth>();
+#endif
+    }();
+    return kernels;
+}
+
+std::size_t ActivationIndex(MlActivation activation) {
+    return static_cast<std::size_t>(activation);
+}
+
+bool RequireMatrix(const NdArray& array, const char* name, const char* argument, std::string* out_error) {
+    if (array.Rank() != 2) {
+        *out_error = std::string(name) + "(): " + argument + " debe ser una matriz (ndarray de 2 dimensiones); forma " +
+                     NdShapeToString(array.Shape()) + ".";
+        return false;
+    }
+    return true;
+}
+
+bool RequireSameShape(const NdArray& lhs, const NdArray& rhs, const char* name, std::string* out_error) {
+    if (lhs.Shape() != rhs.Shape()) {
+        *out_error = std::string(name) + "(): formas incompatibles: " + NdShapeToString(lhs.Shape()) + ", " +
+                     NdShapeToString(rhs.Shape()) + ".";
+        return false;
+    }
+    return true;
+}
+
+// Applies `loop(begin, end)` to a contiguous element range, split across
+// threads when it is large.
+template <typename Loop>
+void ForEachRange(std::size_t count, Loop loop) {
+    RunChunks(count, ChunkCount(count, 1), [&](std::size_t begin, std::size_t end, std::size_t) { loop(begin, end); });
+}
+
+// (batch, classes) float32 targets from either label form: class indices
+// become one-hot rows, so both share one pass.
+bool ReadTargets(const char* name, const NdArray& logits, const NdArray& labels, NdArray* out_targets,
+                 std::string* out_error) {
+    const std::size_t rows = logits.Shape()[0];
+    const std::size_t columns = logits.Shape()[1];
+    if (labels.Rank() == 1 && labels.Shape()[0] == rows) {
+        NdArray targets = NdArray::Zeros(NdType::Float32, {rows, columns});
+        float* data = targets.MutableData<float>();
+        for (std::size_t row = 0; row < rows; ++row) {
+            const double label = labels.At(row).AsDouble();
+            if (!(label >= 0.0) || label >= static_cast<double>(columns) || label != std::floor(label)) {
+                *out_error = std::string(name) + "(): etiqueta fuera de rango en la fila " + std::to_string(row) + ".";
+                return false;
+            }
+            data[row * columns + static_cast<std::size_t>(label)] = 1.0f;
+        }
+        *out_targets = std::move(targets);
+        return true;
+    }
+    if (labels.Shape() == logits.Shape()) {
+        *out_targets = Float32(labels);
+        return true;
+    }
+    *out_error = std::string(name) + "(): las etiquetas deben ser un vector de " + std::to_string(rows) +
+                 " clases o una matriz " + NdShapeToString(logits.Shape()) + "; forma " +
+                 NdShapeToString(labels.Shape()) + ".";
+    return false;
+}
+
+bool ParseCsvFloat(std::string_view text, float* out_value) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r')) {
+        text.remove_suffix(1);
+    }
+    if (!text.empty() && text.front() == '+') {
+        text.remove_prefix(1);
+    }
+    if (text.empty()) {
+        return false;
+    }
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), *out_value);
+    return error == std::errc() && end == text.data() + text.size();
+}
+
+bool IsBlank(std::string_view line) {
+    return line.find_first_not_of(" \t\r") == std::string_view::npos;
+}
+
+}  // namespace
+
+bool ParseMlActivation(std::string_view name, MlActivation* out_activation) {
+    if (name == "none") {
+        *out_activation = MlActivation::Identity;
+    } else if (name == "relu") {
+        *out_activation = MlActivation::Relu;
+    } else if (name == "sigmoid") {
+        *out_activation = MlActivation::Sigmoid;
+    } else if (name == "tanh") {
+        *out_activation = MlActivation::Tanh;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+NdArray MlActivate(MlActivation activation, const NdArray& input) {
+    const NdArray values = Float32(input);
+    NdArray result = NdArray::Uninitialized(NdType::Float32, values.Shape());
+    const float* source = values.Data<float>();
+    float* target = result.MutableData<float>();
+    const auto kernel = Kernels().activate[ActivationIndex(activation)];
+    ForEachRange(values.Size(), [&](std::size_t begin, std::size_t end) {
+        kernel(source + begin, nullptr, target + begin, end - begin);
+    });
+    return result;
+}
+
+bool MlActivationBackward(MlActivation activation,
+                          const NdArray& output,
+                          const NdArray& grad_output,
+                          NdArray* out_grad,
+                          std::string* out_error) {
+    if (!RequireSameShape(output, grad_output, "ml_activation_backward", out_error)) {
+        return false;
+    }
+    const NdArray values = Float32(output);
+    const NdArray grad = Float32(grad_output);
+    NdArray result = NdArray::Uninitialized(NdType::Float32, values.Shape());
+    const auto kernel = Kernels().backward[ActivationIndex(activation)];
+    float* target = result.MutableData<float>();
+    ForEachRange(values.Size(), [&](std::size_t begin, std::size_t end) {
+        kernel(values.Data<float>() + begin, grad.Data<float>() + begin, target + begin, end - begin);
+    });
+    *out_grad = std::move(result);
+    return true;
+}
+
+bool MlDenseForward(const NdArray& input,
+                    const NdArray& weights,
+                    const NdArray& bias,
+                    MlActivation activation,
+                    NdArray* out_output,
+                    std::string* out_error) {
+    if (!RequireMatrix(input, "ml_dense", "x", out_error) || !RequireMatrix(weights, "ml_dense", "w", out_error)) {
+        return false;
+    }
+    const std::size_t rows = input.Shape()[0];
+    const std::size_t columns = weights.Shape()[1];
+    if (input.Shape()[1] != weights.Shape()[0] || bias.Rank() != 1 || bias.Shape()[0] != columns) {
+        *out_error = "ml_dense(): formas incompatibles: x " + NdShapeToString(input.Shape()) + ", w " +
+                     NdShapeToString(weights.Shape()) + ", b " + NdShapeToString(bias.Shape()) + ".";
+        return false;
+    }
+
+    // NdMatMul accepts strided operands, so only the dtype needs converting.
+    NdArray result = NdMatMul(input.AsType(NdType::Float32), weights.AsType(NdType::Float32));
+    const NdArray row_bias = Float32(bias);
+    float* data = result.MutableData<float>();
+    const auto kernel = Kernels().activate[ActivationIndex(activation)];
+    RunChunks(rows, ChunkCount(rows, columns), [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t row = begin; row < end; ++row) {
+            float* values = data + row * columns;
+            kernel(values, row_bias.Data<float>(), values, columns);
+        }
+    });
+    *out_output = std::move(result);
+    return true;
+}
+
+bool MlDenseBackward(const NdArray& input,
+                     const NdArray& weights,
+                     const NdArray& output,
+                     const NdArray& grad_output,
+                     MlActivation activation,
+                     MlDenseGradients* out_gradients,
+                     std::string* out_error) {
+    if (!RequireMatrix(input, "ml_dense_backward", "x", out_error) ||
+        !RequireMatrix(weights, "ml_dense_backward", "w", out_error) ||
+        !RequireSameShape(output, grad_output, "ml_dense_backward", out_error)) {
+        return false;
+    }
+    const std::size_t rows = input.Shape()[0];
+    if (input.Shape()[1] != weights.Shape()[0] || output.Rank() != 2 || output.Shape()[0] != rows ||
+        output.Shape()[1] != weights.Shape()[1]) {
+        *out_error = "ml_dense_backward(): formas incompatibles: x " + NdShapeToString(input.Shape()) + ", w " +
+                     NdShapeToString(weights.Shape()) + ", y " + NdShapeToString(output.Shape()) + ".";
+        return false;
+    }
+
+    NdArray delta;
+    if (!MlActivationBackward(activation, output, grad_output, &delta, out_error)) {
+        return false;
+    }
+    const NdArray x = input.AsType(NdType::Float32);
+    out_gradients->weights = NdMatMul(x.Transpose(), delta);
+    out_gradients->input = NdMatMul(delta, weights.AsType(NdType::Float32).Transpose());
+    // Column sums of delta, as a (1, batch) x (batch, out) product so they
+    // share the threaded GEMM.
+    NdArray ones = NdArray::Full(NdType::Float32, {1, rows}, NdScalar{NdType::Float32, 1.0, 0});
+    NdArray bias;
+    NdMatMul(ones, delta).Reshape({weights.Shape()[1]}, &bias, out_error);
+    out_gradients->bias = std::move(bias);
+    return true;
+}
+
+bool MlSoftmax(const NdArray& logits, NdArray* out_probabilities, std::string* out_error) {
+    if (!RequireMatrix(logits, "ml_softmax", "logits", out_error)) {
+        return false;
+    }
+    const NdArray values = Float32(logits);
+    const std::size_t rows = values.Shape()[0];
+    const std::size_t columns = values.Shape()[1];
+    NdArray result = NdArray::Uninitialized(NdType::Float32, values.Shape());
+    const MlKernelSet& kernels = Kernels();
+    float* data = result.MutableData<float>();
+    RunChunks(rows, ChunkCount(rows, columns), [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t row = begin; row < end; ++row) {
+            const float* source = values.Data<float>() + row * columns;
+            float* target = data + row * columns;
+            const double sum = kernels.exp_sum(source, kernels.max(source, columns), target, columns);
+            kernels.scale(target, static_cast<float>(1.0 / sum), nullptr, 1.0f, target, columns);
+        }
+    });
+    *out_probabilities = std::move(result);
+    return true;
+}
+
+bool MlSoftmaxCrossEntropy(const NdArray& logits,
+                           const NdArray& labels,
+                           double* out_loss,
+                           NdArray* out_grad,
+                           std::string* out_error) {
+    if (!RequireMatrix(logits, "ml_cross_entropy", "logits", out_error)) {
+        return false;
+    }
+    const NdArray values = Float32(logits);
+    const std::size_t rows = values.Shape()[0];
+    const std::size_t columns = values.Shape()[1];
+    if (rows == 0) {
+        *out_error = "ml_cross_entropy(): el lote esta vacio.";
+        return false;
+    }
+
+    NdArray targets;
+    if (!ReadTargets("ml_cross_entropy", values, labels, &targets, out_error)) {
+        return false;
+    }
+
+    NdArray grad = NdArray::Uninitialized(NdType::Float32, values.Shape());
+    float* grad_data = grad.MutableData<float>();
+    const MlKernelSet& kernels = Kernels();
+    const std::size_t chunks = ChunkCount(rows, columns);
+    std::vector<double> losses(chunks, 0.0);
+    const float batch_scale = 1.0f / static_cast<float>(rows);
+    RunChunks(rows, chunks, [&](std::size_t begin, std::size_t end, std::size_t chunk) {
+        for (std::size_t row = begin; row < end; ++row) {
+            const float* source = values.Data<float>() + row * columns;
+            const float* target = targets.Data<float>() + row * columns;
+            float* out = grad_data + row * columns;
+            const float shift = kernels.max(source, columns);
+            const double sum = kernels.exp_sum(source, shift, out, columns);
+            // loss = -sum_j t_j (z_j - shift - log(sum)); the gradient is
+            // (p * sum_j t_j - t) / batch.
+            const double log_sum = std::log(sum);
+            double weight = 0.0;
+            double loss = 0.0;
+            for (std::size_t column = 0; column < columns; ++column) {
+                if (target[column] != 0.0f) {
+                    weight += target[column];
+                    loss -= target[column] * (static_cast<double>(source[column]) - shift - log_sum);
+                }
+            }
+            losses[chunk] += loss;
+            kernels.scale(out, static_cast<float>(weight / sum), target, batch_scale, out, columns);
+        }
+    });
+
+    double total = 0.0;
+    for (const double loss : losses) {
+        total += loss;
+    }
+    *out_loss = total / static_cast<double>(rows);
+    *out_grad = std::move(grad);
+    return true;
+}
+
+bool MlAccuracy(const NdArray& logits, const NdArray& labels, double* out_accuracy, std::string* out_error) {
+    if (!RequireMatrix(logits, "ml_accuracy", "logits", out_error)) {
+        return false;
+    }
+    const NdArray values = Float32(logits);
+    NdArray targets;
+    if (!ReadTargets("ml_accuracy", values, labels, &targets, out_error)) {
+        return false;
+    }
+    const std::size_t rows = values.Shape()[0];
+    const std::size_t columns = values.Shape()[1];
+    std::size_t hits = 0;
+    for (std::size_t row = 0; row < rows && columns > 0; ++row) {
+        const float* predicted = values.Data<float>() + row * columns;
+        const float* expected = targets.Data<float>() + row * columns;
+        hits += std::max_element(predicted, predicted + columns) - predicted ==
+                std::max_element(expected, expected + columns) - expected;
+    }
+    *out_accuracy = rows == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(rows);
+    return true;
+}
+
+bool MlSgdStep(const NdArray& param,
+               const NdArray& grad,
+               const NdArray& velocity,
+               double learning_rate,
+               double momentum,
+               NdArray* out_param,
+               NdArray* out_velocity,
+               std::string* out_error) {
+    if (!RequireSameShape(param, grad, "ml_sgd", out_error)) {
+        return false;
+    }
+    const bool with_velocity = momentum > 0.0;
+    const NdArray values = Float32(param);
+    const NdArray gradient = Float32(grad);
+    NdArray previous = with_velocity && velocity.Size() > 0 ? Float32(velocity)
+                                                             : NdArray::Zeros(NdType::Float32, values.Shape());
+    if (with_velocity && !RequireSameShape(values, previous, "ml_sgd", out_error)) {
+        return false;
+    }
+
+    NdArray next = NdArray::Uninitialized(NdType::Float32, values.Shape());
+    NdArray next_velocity = with_velocity ? NdArray::Uninitialized(NdType::Float32, values.Shape()) : NdArray();
+    float* param_data = next.MutableData<float>();
+    float* velocity_data = with_velocity ? next_velocity.MutableData<float>() : nullptr;
+    const auto kernel = Kernels().sgd;
+    ForEachRange(values.Size(), [&](std::size_t begin, std::size_t end) {
+        kernel(values.Data<float>() + begin, gradient.Data<float>() + begin,
+               with_velocity ? previous.Data<float>() + begin : nullptr, static_cast<float>(learning_rate),
+               static_cast<float>(momentum), param_data + begin, with_velocity ? velocity_data + begin : nullptr,
+               end - begin);
+    });
+    *out_param = std::move(next);
+    *out_velocity = with_velocity ? std::move(next_velocity) : NdArray();
+    return true;
+}
+
+bool MlAdamStep(const NdArray& param,
+                const NdArray& grad,
+                const NdArray& first_moment,
+                const NdArray& second_moment,
+                std::uint64_t step,
+                const MlAdamOptions& options,
+                NdArray* out_param,
+                NdArray* out_first_moment,
+                NdArray* out_second_moment,
+                std::string* out_error) {
+    if (!RequireSameShape(param, grad, "ml_adam", out_error)) {
+        return false;
+    }
+    const NdArray values = Float32(param);
+    const NdArray gradient = Float32(grad);
+    const NdArray first =
+        first_moment.Size() > 0 ? Float32(first_moment) : NdArray::Zeros(NdType::Float32, values.Shape());
+    const NdArray second =
+        second_moment.Size() > 0 ? Float32(second_moment) : NdArray::Zeros(NdType::Float32, values.Shape());
+    if (!RequireSameShape(values, first, "ml_adam", out_error) ||
+        !RequireSameShape(values, second, "ml_adam", out_error)) {
+        return false;
+    }
+
+    const double t = static_cast<double>(std::max<std::uint64_t>(step, 1));
+    float coefficients[kAdamCoefficientCount];
+    coefficients[kAdamBeta1] = static_cast<float>(options.beta1);
+    coefficients[kAdamBeta2] = static_cast<float>(options.beta2);
+    coefficients[kAdamStepSize] = static_cast<float>(options.learning_rate / (1.0 - std::pow(options.beta1, t)));
+    coefficients[kAdamCorrection2] = static_cast<float>(1.0 / (1.0 - std::pow(options.beta2, t)));
+    coefficients[kAdamEpsilon] = static_cast<float>(options.epsilon);
+
+    NdArray next = NdArray::Uninitialized(NdType::Float32, values.Shape());
+    NdArray next_first = NdArray::Uninitialized(NdType::Float32, values.Shape());
+    NdArray next_second = NdArray::Uninitialized(NdType::Float32, values.Shape());
+    float* param_data = next.MutableData<float>();
+    float* first_data = next_first.MutableData<float>();
+    float* second_data = next_second.MutableData<float>();
+    const auto kernel = Kernels().adam;
+    ForEachRange(values.Size(), [&](std::size_t begin, std::size_t end) {
+        kernel(values.Data<float>() + begin, gradient.Data<float>() + begin, first.Data<float>() + begin,
+               second.Data<float>() + begin, coefficients, param_data + begin, first_data + begin,
+               second_data + begin, end - begin);
+    });
+    *out_param = std::move(next);
+    *out_first_moment = std::move(next_first);
+    *out_second_moment = std::move(next_second);
+    return true;
+}
+
+NdArray MlGlorotUniform(std::size_t inputs, std::size_t outputs, std::uint64_t seed) {
+    NdArray result = NdArray::Uninitialized(NdType::Float32, {inputs, outputs});
+    const double limit = std::sqrt(6.0 / static_cast<double>(std::max<std::size_t>(inputs + outputs, 1)));
+    std::mt19937_64 generator(seed);
+    float* data = result.MutableData<float>();
+    for (std::size_t i = 0; i < inputs * outputs; ++i) {
+        // Drawn from the raw 64-bit output so the weights do not depend on
+        // the standard library's distribution implementation.
+        const double unit = static_cast<double>(generator() >> 11) * 0x1.0p-53;
+        data[i] = static_cast<float>((2.0 * unit - 1.0) * limit);
+    }
+    return result;
+}
+
+bool MlCsvReader::Open(const std::string& path, const MlCsvOptions& options, std::string* out_error) {
+    path_ = path;
+    options_ = options;
+    stream_.open(path, std::ios::binary);
+    if (!stream_) {
+        *out_error = "No se pudo abrir el archivo: " + path;
+        return false;
+    }
+
+    // The first non-blank line is a header when it does not parse as numbers.
+    std::string line;
+    data_start_ = stream_.tellg();
+    while (std::getline(stream_, line)) {
+        ++line_number_;
+        if (IsBlank(line)) {
+            continue;
+        }
+        std::string ignored;
+        if (!ParseRow(line, &fields_, &ignored)) {
+            data_start_ = stream_.tellg();
+            data_start_line_ = line_number_;
+        }
+        break;
+    }
+    return Rewind(out_error);
+}
+
+bool MlCsvReader::Rewind(std::string* out_error) {
+    stream_.clear();
+    stream_.seekg(data_start_);
+    if (!stream_) {
+        *out_error = "Error leyendo el archivo: " + path_;
+        return false;
+    }
+    line_number_ = data_start_line_;
+    return true;
+}
+
+bool MlCsvReader::ParseRow(std::string_view line, std::vector<float>* out_fields, std::string* out_error) const {
+    out_fields->clear();
+    std::size_t start = 0;
+    while (true) {
+        const std::size_t end = line.find(options_.delimiter, start);
+        float value = 0.0f;
+        const std::string_view field = line.substr(start, end == std::string_view::npos ? end : end - start);
+        if (!ParseCsvFloat(field, &value)) {
+            *out_error = "ml_csv_next(): valor no numerico en " + path_ + ":" + std::to_string(line_number_) + ": " +
+                         std::string(field);
+            return false;
+        }
+        out_fields->push_back(value);
+        if (end == std::string_view::npos) {
+            return true;
+        }
+        start = end + 1;
+    }
+}
+
+bool MlCsvReader::Next(std::size_t batch_size,
+                       NdArray* out_features,
+                       NdArray* out_labels,
+                       bool* out_done,
+                       std::string* out_error) {
+    std::vector<float> features;
+    std::vector<float> labels;
+    std::size_t rows = 0;
+    std::string line;
+    while (rows < batch_size && std::getline(stream_, line)) {
+        ++line_number_;
+        if (IsBlank(line)) {
+            continue;
+        }
+        if (!ParseRow(line, &fields_, out_error)) {
+            return false;
+        }
+        if (columns_ == 0) {
+            columns_ = fields_.size();
+        }
+        if (fields_.size() != columns_) {
+            *out_error = "ml_csv_next(): numero de columnas distinto en " + path_ + ":" +
+                         std::to_string(line_number_) + ": " + std::to_string(fields_.size()) + "; se esperaban " +
+                         std::to_string(columns_) + ".";
+            return false;
+        }
+        if (options_.has_labels) {
+            const std::ptrdiff_t column = options_.label_column < 0
+                                              ? static_cast<std::ptrdiff_t>(columns_) + options_.label_column
+                                              : options_.label_column;
+            if (column < 0 || column >= static_cast<std::ptrdiff_t>(columns_)) {
+                *out_error = "ml_csv_next(): label_column fuera de rango para " + std::to_string(columns_) +
+                             " columnas: " + std::to_string(options_.label_column);
+                return false;
+            }
+            labels.push_back(fields_[static_cast<std::size_t>(column)]);
+            fields_.erase(fields_.begin() + column);
+        }
+        features.insert(features.end(), fields_.begin(), fields_.end());
+        ++rows;
+    }
+
+    *out_done = rows == 0;
+    if (*out_done) {
+        return true;
+    }
+    const std::size_t width = features.size() / rows;
+    *out_features = NdArray::Uninitialized(NdType::Float32, {rows, width});
+    std::copy(features.begin(), features.end(), out_features->MutableData<float>());
+    if (options_.has_labels) {
+        *out_labels = NdArray::Uninitialized(NdType::Float32, {rows});
+        std::copy(labels.begin(), labels.end(), out_labels->MutableData<float>());
+    }
+    return true;
+}
+
+}  // namespace clot::runtime
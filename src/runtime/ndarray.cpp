@@ -0,0 +1,971 @@
+#include "clot/runtime/ndarray.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <new>
+#include <sstream>
+#include <type_traits>
+#include <utility>
+
+#include "clot/runtime/env.hpp"
+#include "clot/runtime/ndarray_linalg.hpp"
+#include "ndarray_internal.hpp"
+
+namespace clot::runtime {
+
+namespace {
+
+using namespace internal;
+
+constexpr std::size_t kStorageAlignment = 64;
+
+std::shared_ptr<void> AllocateStorage(std::size_t bytes, bool zero_fill) {
+    void* memory = ::operator new(std::max<std::size_t>(bytes, 1), std::align_val_t{kStorageAlignment});
+    if (zero_fill) {
+        std::memset(memory, 0, bytes);
+    }
+    return std::shared_ptr<void>(memory, [](void* pointer) {
+        ::operator delete(pointer, std::align_val_t{kStorageAlignment});
+    });
+}
+
+std::size_t ShapeSize(const std::vector<std::size_t>& shape) {
+    std::size_t size = 1;
+    for (const std::size_t extent : shape) {
+        size *= extent;
+    }
+    return size;
+}
+
+std::vector<std::ptrdiff_t> RowMajorStrides(const std::vector<std::size_t>& shape) {
+    std::vector<std::ptrdiff_t> strides(shape.size());
+    std::ptrdiff_t stride = 1;
+    for (std::size_t axis = shape.size(); axis-- > 0;) {
+        strides[axis] = stride;
+        stride *= static_cast<std::ptrdiff_t>(shape[axis]);
+    }
+    return strides;
+}
+
+// Calls visit(offset) for every element in row-major order; `offset` is in
+// elements, relative to the first element of the array.
+template <typename Visit>
+void ForEachOffset(const std::vector<std::size_t>& shape, const std::vector<std::ptrdiff_t>& strides, Visit&& visit) {
+    const std::size_t total = ShapeSize(shape);
+    std::vector<std::size_t> index(shape.size(), 0);
+    std::ptrdiff_t offset = 0;
+    for (std::size_t visited = 0; visited < total; ++visited) {
+        visit(offset);
+        for (std::size_t axis = shape.size(); axis-- > 0;) {
+            offset += strides[axis];
+            if (++index[axis] < shape[axis]) {
+                break;
+            }
+            offset -= strides[axis] * static_cast<std::ptrdiff_t>(shape[axis]);
+            index[axis] = 0;
+        }
+    }
+}
+
+template <typename T>
+NdScalar MakeScalar(T value) {
+    NdScalar scalar;
+    if constexpr (std::is_same_v<T, std::int64_t>) {
+        scalar.type = NdType::Int64;
+        scalar.integer = value;
+    } else {
+        scalar.type = std::is_same_v<T, float> ? NdType::Float32 : NdType::Float64;
+        scalar.real = static_cast<double>(value);
+    }
+    return scalar;
+}
+
+// Float to int64 conversions saturate and map NaN to 0 instead of being UB.
+template <typename To, typename From>
+To ConvertElement(From value) {
+    if constexpr (std::is_same_v<To, std::int64_t> && std::is_floating_point_v<From>) {
+        if (std::isnan(value)) {
+            return 0;
+        }
+        if (value <= static_cast<From>(std::numeric_limits<std::int64_t>::min())) {
+            return std::numeric_limits<std::int64_t>::min();
+        }
+        if (value >= static_cast<From>(std::numeric_limits<std::int64_t>::max())) {
+            return std::numeric_limits<std::int64_t>::max();
+        }
+    }
+    return static_cast<To>(value);
+}
+
+template <typename T>
+T ScalarAs(const NdScalar& scalar) {
+    if (scalar.type == NdType::Int64) {
+        return ConvertElement<T>(scalar.integer);
+    }
+    return ConvertElement<T>(scalar.real);
+}
+
+NdScalar ReadElement(const NdArray& array, std::ptrdiff_t offset) {
+    return WithElementType(array.Type(), [&](auto tag) {
+        using T = decltype(tag);
+        return MakeScalar(array.Data<T>()[offset]);
+    });
+}
+
+// Works for scalars and GCC/Clang vector types alike.
+template <NdBinaryOp kOp, typename V>
+CLOT_NDARRAY_INLINE V Combine(V lhs, V rhs) {
+    if constexpr (kOp == NdBinaryOp::Add) {
+        return lhs + rhs;
+    } else if constexpr (kOp == NdBinaryOp::Subtract) {
+        return lhs - rhs;
+    } else if constexpr (kOp == NdBinaryOp::Multiply) {
+        return lhs * rhs;
+    } else {
+        return lhs / rhs;
+    }
+}
+
+template <bool kMax, typename V>
+CLOT_NDARRAY_INLINE V Pick(V candidate, V best) {
+    if constexpr (kMax) {
+        return candidate > best ? candidate : best;
+    } else {
+        return candidate < best ? candidate : best;
+    }
+}
+
+// out[i] = lhs[i * lhs_step] op rhs[i * rhs_step]. Steps of 0 (a broadcast
+// operand) and 1 take the vector path; any other step runs the scalar loop.
+template <NdBinaryOp kOp, typename T, std::size_t kBytes>
+CLOT_NDARRAY_INLINE void BinaryLoopFor(const T* lhs,
+                                       std::ptrdiff_t lhs_step,
+                                       const T* rhs,
+                                       std::ptrdiff_t rhs_step,
+                                       T* out,
+                                       std::size_t count) {
+    std::size_t index = 0;
+#ifdef CLOT_NDARRAY_VECTOR
+    if constexpr (kBytes != kScalarWidth) {
+        using Vec = typename VectorOf<T, kBytes>::Type;
+        constexpr std::size_t kLanes = VectorOf<T, kBytes>::kLanes;
+        if (lhs_step == 1 && rhs_step == 1) {
+            for (; index + kLanes <= count; index += kLanes) {
+                StoreVector(out + index,
+                            Combine<kOp>(LoadVector<Vec>(lhs + index), LoadVector<Vec>(rhs + index)));
+            }
+        } else if (lhs_step == 1 && rhs_step == 0) {
+            const Vec right = SplatVector<Vec>(*rhs);
+            for (; index + kLanes <= count; index += kLanes) {
+                StoreVector(out + index, Combine<kOp>(LoadVector<Vec>(lhs + index), right));
+            }
+        } else if (lhs_step == 0 && rhs_step == 1) {
+            const Vec left = SplatVector<Vec>(*lhs);
+            for (; index + kLanes <= count; index += kLanes) {
+                StoreVector(out + index, Combine<kOp>(left, LoadVector<Vec>(rhs + index)));
+            }
+        }
+    }
+#endif
+    for (; index < count; ++index) {
+        const auto position = static_cast<std::ptrdiff_t>(index);
+        out[index] = Combine<kOp>(lhs[position * lhs_step], rhs[position * rhs_step]);
+    }
+}
+
+template <typename T, std::size_t kBytes>
+CLOT_NDARRAY_INLINE void BinaryLoop(NdBinaryOp op,
+                                    const T* lhs,
+                                    std::ptrdiff_t lhs_step,
+                                    const T* rhs,
+                                    std::ptrdiff_t rhs_step,
+                                    T* out,
+                                    std::size_t count) {
+    using A = ArithmeticType<T>;
+    const A* left = reinterpret_cast<const A*>(lhs);
+    const A* right = reinterpret_cast<const A*>(rhs);
+    A* target = reinterpret_cast<A*>(out);
+    switch (op) {
+    case NdBinaryOp::Add:
+        BinaryLoopFor<NdBinaryOp::Add, A, kBytes>(left, lhs_step, right, rhs_step, target, count);
+        return;
+    case NdBinaryOp::Subtract:
+        BinaryLoopFor<NdBinaryOp::Subtract, A, kBytes>(left, lhs_step, right, rhs_step, target, count);
+        return;
+    case NdBinaryOp::Multiply:
+        BinaryLoopFor<NdBinaryOp::Multiply, A, kBytes>(left, lhs_step, right, rhs_step, target, count);
+        return;
+    case NdBinaryOp::Divide:
+    case NdBinaryOp::Power:
+        // NdBinary promotes int64 operands to float64 for these two.
+        if constexpr (std::is_floating_point_v<T>) {
+            if (op == NdBinaryOp::Divide) {
+                BinaryLoopFor<NdBinaryOp::Divide, T, kBytes>(lhs, lhs_step, rhs, rhs_step, out, count);
+                return;
+            }
+            for (std::size_t index = 0; index < count; ++index) {
+                const auto position = static_cast<std::ptrdiff_t>(index);
+                out[index] = static_cast<T>(std::pow(lhs[position * lhs_step], rhs[position * rhs_step]));
+            }
+        }
+        return;
+    }
+}
+
+template <typename T, std::size_t kBytes>
+CLOT_NDARRAY_INLINE T SumLoop(const T* data, std::size_t count) {
+    using A = ArithmeticType<T>;
+    const A* values = reinterpret_cast<const A*>(data);
+    A total{};
+    std::size_t index = 0;
+#ifdef CLOT_NDARRAY_VECTOR
+    if constexpr (kBytes != kScalarWidth) {
+        using Vec = typename VectorOf<A, kBytes>::Type;
+        constexpr std::size_t kLanes = VectorOf<A, kBytes>::kLanes;
+        if (count >= kLanes) {
+            Vec accumulator{};
+            for (; index + kLanes <= count; index += kLanes) {
+                accumulator += LoadVector<Vec>(values + index);
+            }
+            for (std::size_t lane = 0; lane < kLanes; ++lane) {
+                total += accumulator[lane];
+            }
+        }
+    }
+#endif
+    for (; index < count; ++index) {
+        total += values[index];
+    }
+    return static_cast<T>(total);
+}
+
+template <typename T, std::size_t kBytes>
+CLOT_NDARRAY_INLINE T DotLoop(const T* lhs, const T* rhs, std::size_t count) {
+    using A = ArithmeticType<T>;
+    const A* left = reinterpret_cast<const A*>(lhs);
+    const A* right = reinterpret_cast<const A*>(rhs);
+    A total{};
+    std::size_t index = 0;
+#ifdef CLOT_NDARRAY_VECTOR
+    if constexpr (kBytes != kScalarWidth) {
+        using Vec = typename VectorOf<A, kBytes>::Type;
+        constexpr std::size_t kLanes = VectorOf<A, kBytes>::kLanes;
+        if (count >= kLanes) {
+            Vec accumulator{};
+            for (; index + kLanes <= count; index += kLanes) {
+                accumulator += LoadVector<Vec>(left + index) * LoadVector<Vec>(right + index);
+            }
+            for (std::size_t lane = 0; lane < kLanes; ++lane) {
+                total += accumulator[lane];
+            }
+        }
+    }
+#endif
+    for (; index < count; ++index) {
+        total += left[index] * right[index];
+    }
+    return static_cast<T>(total);
+}
+
+// Smallest (or largest) of `count` >= 1 elements. A NaN anywhere wins, as in
+// NumPy.
+template <bool kMax, typename T, std::size_t kBytes>
+CLOT_NDARRAY_INLINE T ExtremeLoop(const T* data, std::size_t count) {
+    T best = data[0];
+    bool saw_nan = false;
+    std::size_t index = 0;
+#ifdef CLOT_NDARRAY_VECTOR
+    if constexpr (kBytes != kScalarWidth) {
+        using Vec = typename VectorOf<T, kBytes>::Type;
+        constexpr std::size_t kLanes = VectorOf<T, kBytes>::kLanes;
+        if (count >= kLanes) {
+            Vec accumulator = LoadVector<Vec>(data);
+            decltype(accumulator != accumulator) nan_lanes{};
+            if constexpr (std::is_floating_point_v<T>) {
+                nan_lanes = accumulator != accumulator;
+            }
+            for (index = kLanes; index + kLanes <= count; index += kLanes) {
+                const Vec values = LoadVector<Vec>(data + index);
+                if constexpr (std::is_floating_point_v<T>) {
+                    nan_lanes |= values != values;
+                }
+                accumulator = Pick<kMax>(values, accumulator);
+            }
+            best = accumulator[0];
+            for (std::size_t lane = 0; lane < kLanes; ++lane) {
+                best = Pick<kMax>(static_cast<T>(accumulator[lane]), best);
+                saw_nan = saw_nan || nan_lanes[lane] != 0;
+            }
+        }
+    }
+#endif
+    for (; index < count; ++index) {
+        if constexpr (std::is_floating_point_v<T>) {
+            saw_nan = saw_nan || std::isnan(data[index]);
+        }
+        best = Pick<kMax>(data[index], best);
+    }
+    if constexpr (std::is_floating_point_v<T>) {
+        if (saw_nan) {
+            return std::numeric_limits<T>::quiet_NaN();
+        }
+    }
+    return best;
+}
+
+template <typename T>
+struct KernelSet {
+    void (*binary)(NdBinaryOp, const T*, std::ptrdiff_t, const T*, std::ptrdiff_t, T*, std::size_t);
+    T (*sum)(const T*, std::size_t);
+    T (*min)(const T*, std::size_t);
+    T (*max)(const T*, std::size_t);
+    T (*dot)(const T*, const T*, std::size_t);
+};
+
+template <typename T, std::size_t kBytes>
+void PortableBinary(NdBinaryOp op,
+                    const T* lhs,
+                    std::ptrdiff_t lhs_step,
+                    const T* rhs,
+                    std::ptrdiff_t rhs_step,
+                    T* out,
+                    std::size_t count) {
+    BinaryLoop<T, kBytes>(op, lhs, lhs_step, rhs, rhs_step, out, count);
+}
+
+template <typename T, std::size_t kBytes>
+T PortableSum(const T* data, std::size_t count) {
+    return SumLoop<T, kBytes>(data, count);
+}
+
+template <bool kMax, typename T, std::size_t kBytes>
+T PortableExtreme(const T* data, std::size_t count) {
+    return ExtremeLoop<kMax, T, kBytes>(data, count);
+}
+
+template <typename T, std::size_t kBytes>
+T PortableDot(const T* lhs, const T* rhs, std::size_t count) {
+    return DotLoop<T, kBytes>(lhs, rhs, count);
+}
+
+template <typename T, std::size_t kBytes>
+KernelSet<T> PortableKernels() {
+    return KernelSet<T>{
+        PortableBinary<T, kBytes>,
+        PortableSum<T, kBytes>,
+        PortableExtreme<false, T, kBytes>,
+        PortableExtreme<true, T, kBytes>,
+        PortableDot<T, kBytes>,
+    };
+}
+
+#ifdef CLOT_NDARRAY_AVX2
+
+template <typename T>
+__attribute__((target("avx2"))) void Avx2Binary(NdBinaryOp op,
+                                                const T* lhs,
+                                                std::ptrdiff_t lhs_step,
+                                                const T* rhs,
+                                                std::ptrdiff_t rhs_step,
+                                                T* out,
+                                                std::size_t count) {
+    BinaryLoop<T, kAvx2Width>(op, lhs, lhs_step, rhs, rhs_step, out, count);
+}
+
+template <typename T>
+__attribute__((target("avx2"))) T Avx2Sum(const T* data, std::size_t count) {
+    return SumLoop<T, kAvx2Width>(data, count);
+}
+
+template <bool kMax, typename T>
+__attribute__((target("avx2"))) T Avx2Extreme(const T* data, std::size_t count) {
+    return ExtremeLoop<kMax, T, kAvx2Width>(data, count);
+}
+
+template <typename T>
+__attribute__((target("avx2"))) T Avx2Dot(const T* lhs, const T* rhs, std::size_t count) {
+    return DotLoop<T, kAvx2Width>(lhs, rhs, count);
+}
+
+#endif  // CLOT_NDARRAY_AVX2
+
+template <typename T>
+const KernelSet<T>& Kernels() {
+    static const KernelSet<T> kernels = []() {
+        switch (SelectedKernelLevel()) {
+        case KernelLevel::Scalar:
+            return PortableKernels<T, kScalarWidth>();
+        case KernelLevel::Avx2:
+#ifdef CLOT_NDARRAY_AVX2
+            return KernelSet<T>{Avx2Binary<T>, Avx2Sum<T>, Avx2Extreme<false, T>, Avx2Extreme<true, T>, Avx2Dot<T>};
+#endif
+        case KernelLevel::Portable:
+            break;
+        }
+#ifdef CLOT_NDARRAY_VECTOR
+        return PortableKernels<T, kPortableWidth>();
+#else
+        return PortableKernels<T, kScalarWidth>();
+#endif
+    }();
+    return kernels;
+}
+
+NdType PromoteTypes(NdType lhs, NdType rhs) {
+    return lhs == rhs ? lhs : NdType::Float64;
+}
+
+bool BroadcastShape(const std::vector<std::size_t>& lhs,
+                    const std::vector<std::size_t>& rhs,
+                    std::vector<std::size_t>* out_shape) {
+    const std::size_t rank = std::max(lhs.size(), rhs.size());
+    out_shape->assign(rank, 1);
+    for (std::size_t axis = 0; axis < rank; ++axis) {
+        const std::size_t left = axis < rank - lhs.size() ? 1 : lhs[axis - (rank - lhs.size())];
+        const std::size_t right = axis < rank - rhs.size() ? 1 : rhs[axis - (rank - rhs.size())];
+        if (left != right && left != 1 && right != 1) {
+            return false;
+        }
+        (*out_shape)[axis] = left == 1 ? right : left;
+    }
+    return true;
+}
+
+// Strides that walk `array` over `shape`: missing leading axes and axes of
+// extent 1 get stride 0, so the same element is reused along them.
+std::vector<std::ptrdiff_t> BroadcastStrides(const NdArray& array, const std::vector<std::size_t>& shape) {
+    std::vector<std::ptrdiff_t> strides(shape.size(), 0);
+    const std::size_t skipped = shape.size() - array.Rank();
+    for (std::size_t axis = 0; axis < array.Rank(); ++axis) {
+        if (array.Shape()[axis] != 1) {
+            strides[skipped + axis] = array.Strides()[axis];
+        }
+    }
+    return strides;
+}
+
+// Drops axes of extent 1 and merges neighbouring axes that both operands walk
+// as one run, so fully contiguous inputs become a single long kernel call.
+void CollapseAxes(std::vector<std::size_t>* shape,
+                  std::vector<std::ptrdiff_t>* lhs_strides,
+                  std::vector<std::ptrdiff_t>* rhs_strides) {
+    std::vector<std::size_t> merged_shape;
+    std::vector<std::ptrdiff_t> merged_lhs;
+    std::vector<std::ptrdiff_t> merged_rhs;
+    for (std::size_t axis = shape->size(); axis-- > 0;) {
+        const std::size_t extent = (*shape)[axis];
+        if (extent == 1) {
+            continue;
+        }
+        if (!merged_shape.empty()) {
+            const auto inner = static_cast<std::ptrdiff_t>(merged_shape.back());
+            if ((*lhs_strides)[axis] == merged_lhs.back() * inner && (*rhs_strides)[axis] == merged_rhs.back() * inner) {
+                merged_shape.back() *= extent;
+                continue;
+            }
+        }
+        merged_shape.push_back(extent);
+        merged_lhs.push_back((*lhs_strides)[axis]);
+        merged_rhs.push_back((*rhs_strides)[axis]);
+    }
+    std::reverse(merged_shape.begin(), merged_shape.end());
+    std::reverse(merged_lhs.begin(), merged_lhs.end());
+    std::reverse(merged_rhs.begin(), merged_rhs.end());
+    *shape = std::move(merged_shape);
+    *lhs_strides = std::move(merged_lhs);
+    *rhs_strides = std::move(merged_rhs);
+}
+
+template <typename T>
+void RunBinary(NdBinaryOp op, const NdArray& lhs, const NdArray& rhs, NdArray* result) {
+    std::vector<std::size_t> shape = result->Shape();
+    if (ShapeSize(shape) == 0) {
+        return;
+    }
+    std::vector<std::ptrdiff_t> lhs_strides = BroadcastStrides(lhs, shape);
+    std::vector<std::ptrdiff_t> rhs_strides = BroadcastStrides(rhs, shape);
+    CollapseAxes(&shape, &lhs_strides, &rhs_strides);
+
+    const KernelSet<T>& kernels = Kernels<T>();
+    const T* left = lhs.Data<T>();
+    const T* right = rhs.Data<T>();
+    T* out = result->MutableData<T>();
+    if (shape.empty()) {
+        kernels.binary(op, left, 0, right, 0, out, 1);
+        return;
+    }
+
+    // One kernel call per innermost row; the outer axes advance an odometer.
+    const std::size_t rank = shape.size();
+    const std::size_t inner = shape.back();
+    const std::size_t rows = ShapeSize(shape) / inner;
+    std::vector<std::size_t> index(rank - 1, 0);
+    std::ptrdiff_t lhs_offset = 0;
+    std::ptrdiff_t rhs_offset = 0;
+    for (std::size_t row = 0; row < rows; ++row) {
+        kernels.binary(op, left + lhs_offset, lhs_strides.back(), right + rhs_offset, rhs_strides.back(), out, inner);
+        out += inner;
+        for (std::size_t axis = rank - 1; axis-- > 0;) {
+            lhs_offset += lhs_strides[axis];
+            rhs_offset += rhs_strides[axis];
+            if (++index[axis] < shape[axis]) {
+                break;
+            }
+            lhs_offset -= lhs_strides[axis] * static_cast<std::ptrdiff_t>(shape[axis]);
+            rhs_offset -= rhs_strides[axis] * static_cast<std::ptrdiff_t>(shape[axis]);
+            index[axis] = 0;
+        }
+    }
+}
+
+std::string FormatReal(double value, int precision) {
+    std::ostringstream stream;
+    stream << std::setprecision(precision) << value;
+    std::string text = stream.str();
+    if (text.find('.') != std::string::npos && text.find('e') == std::string::npos) {
+        while (!text.empty() && text.back() == '0') {
+            text.pop_back();
+        }
+        if (!text.empty() && text.back() == '.') {
+            text.pop_back();
+        }
+    }
+    return text.empty() ? "0" : text;
+}
+
+void AppendScalar(const NdScalar& scalar, std::string* text) {
+    switch (scalar.type) {
+    case NdType::Int64:
+        text->append(std::to_string(scalar.integer));
+        return;
+    case NdType::Float32:
+        text->append(FormatReal(scalar.real, 7));
+        return;
+    case NdType::Float64:
+        text->append(FormatReal(scalar.real, 15));
+        return;
+    }
+}
+
+void AppendAxis(const NdArray& array, std::size_t axis, std::ptrdiff_t offset, std::string* text) {
+    if (axis == array.Rank()) {
+        AppendScalar(ReadElement(array, offset), text);
+        return;
+    }
+    text->push_back('[');
+    for (std::size_t i = 0; i < array.Shape()[axis]; ++i) {
+        if (i > 0) {
+            text->append(", ");
+        }
+        AppendAxis(array, axis + 1, offset + static_cast<std::ptrdiff_t>(i) * array.Strides()[axis], text);
+    }
+    text->push_back(']');
+}
+
+}  // namespace
+
+namespace internal {
+
+KernelLevel SelectedKernelLevel() {
+    static const KernelLevel level = []() {
+        const std::string requested = GetEnvVar("CLOT_NDARRAY_KERNEL").value_or("");
+        if (requested == "scalar") {
+            return KernelLevel::Scalar;
+        }
+#ifdef CLOT_NDARRAY_AVX2
+        if (requested != "sse2" && __builtin_cpu_supports("avx2")) {
+            return KernelLevel::Avx2;
+        }
+#endif
+#ifdef CLOT_NDARRAY_VECTOR
+        return KernelLevel::Portable;
+#else
+        return KernelLevel::Scalar;
+#endif
+    }();
+    return level;
+}
+
+double DotFloat64(const double* lhs, const double* rhs, std::size_t count) {
+    return Kernels<double>().dot(lhs, rhs, count);
+}
+
+}  // namespace internal
+
+const char* NdTypeName(NdType type) {
+    switch (type) {
+    case NdType::Float32:
+        return "float32";
+    case NdType::Int64:
+        return "int64";
+    case NdType::Float64:
+        break;
+    }
+    return "float64";
+}
+
+bool ParseNdType(std::string_view name, NdType* out_type) {
+    if (name == "float64" || name == "double") {
+        *out_type = NdType::Float64;
+        return true;
+    }
+    if (name == "float32" || name == "float") {
+        *out_type = NdType::Float32;
+        return true;
+    }
+    if (name == "int64" || name == "int" || name == "long") {
+        *out_type = NdType::Int64;
+        return true;
+    }
+    return false;
+}
+
+std::size_t NdTypeSize(NdType type) {
+    return type == NdType::Float32 ? sizeof(float) : sizeof(double);
+}
+
+std::string NdShapeToString(const std::vector<std::size_t>& shape) {
+    std::string text = "(";
+    for (std::size_t axis = 0; axis < shape.size(); ++axis) {
+        if (axis > 0) {
+            text += ", ";
+        }
+        text += std::to_string(shape[axis]);
+    }
+    if (shape.size() == 1) {
+        text += ",";
+    }
+    text += ")";
+    return text;
+}
+
+NdArray::NdArray() : shape_{0}, strides_{1} {}
+
+NdArray NdArray::Zeros(NdType type, std::vector<std::size_t> shape) {
+    NdArray array;
+    array.type_ = type;
+    array.storage_ = AllocateStorage(ShapeSize(shape) * NdTypeSize(type), true);
+    array.strides_ = RowMajorStrides(shape);
+    array.shape_ = std::move(shape);
+    return array;
+}
+
+NdArray NdArray::Uninitialized(NdType type, std::vector<std::size_t> shape) {
+    NdArray array;
+    array.type_ = type;
+    array.storage_ = AllocateStorage(ShapeSize(shape) * NdTypeSize(type), false);
+    array.strides_ = RowMajorStrides(shape);
+    array.shape_ = std::move(shape);
+    return array;
+}
+
+NdArray NdArray::Full(NdType type, std::vector<std::size_t> shape, const NdScalar& value) {
+    NdArray array = Uninitialized(type, std::move(shape));
+    WithElementType(type, [&](auto tag) {
+        using T = decltype(tag);
+        T* data = array.MutableData<T>();
+        std::fill(data, data + array.Size(), ScalarAs<T>(value));
+    });
+    return array;
+}
+
+NdArray NdArray::FromScalar(const NdScalar& value) {
+    NdArray array = Zeros(value.type, {});
+    WithElementType(value.type, [&](auto tag) {
+        using T = decltype(tag);
+        *array.MutableData<T>() = ScalarAs<T>(value);
+    });
+    return array;
+}
+
+std::size_t NdArray::Size() const {
+    return ShapeSize(shape_);
+}
+
+bool NdArray::IsContiguous() const {
+    if (Size() == 0) {
+        return true;
+    }
+    std::ptrdiff_t expected = 1;
+    for (std::size_t axis = shape_.size(); axis-- > 0;) {
+        if (shape_[axis] != 1 && strides_[axis] != expected) {
+            return false;
+        }
+        expected *= static_cast<std::ptrdiff_t>(shape_[axis]);
+    }
+    return true;
+}
+
+void* NdArray::ElementPointer(std::ptrdiff_t offset) const {
+    return static_cast<unsigned char*>(storage_.get()) + offset * static_cast<std::ptrdiff_t>(NdTypeSize(type_));
+}
+
+NdScalar NdArray::At(std::size_t flat_index) const {
+    std::ptrdiff_t offset = 0;
+    for (std::size_t axis = shape_.size(); axis-- > 0;) {
+        offset += static_cast<std::ptrdiff_t>(flat_index % shape_[axis]) * strides_[axis];
+        flat_index /= shape_[axis];
+    }
+    return ReadElement(*this, offset);
+}
+
+NdArray NdArray::Slice(std::size_t axis, std::ptrdiff_t start, std::ptrdiff_t stop, std::ptrdiff_t step) const {
+    std::ptrdiff_t count = 0;
+    if (step > 0 && stop > start) {
+        count = (stop - start + step - 1) / step;
+    } else if (step < 0 && start > stop) {
+        count = (start - stop - step - 1) / -step;
+    }
+
+    NdArray view = *this;
+    if (count > 0) {
+        view.offset_ += start * strides_[axis];
+    }
+    view.shape_[axis] = static_cast<std::size_t>(count);
+    view.strides_[axis] *= step;
+    return view;
+}
+
+NdArray NdArray::Select(std::size_t axis, std::size_t index) const {
+    NdArray view = *this;
+    view.offset_ += static_cast<std::ptrdiff_t>(index) * strides_[axis];
+    view.shape_.erase(view.shape_.begin() + static_cast<std::ptrdiff_t>(axis));
+    view.strides_.erase(view.strides_.begin() + static_cast<std::ptrdiff_t>(axis));
+    return view;
+}
+
+NdArray NdArray::Transpose() const {
+    NdArray view = *this;
+    std::reverse(view.shape_.begin(), view.shape_.end());
+    std::reverse(view.strides_.begin(), view.strides_.end());
+    return view;
+}
+
+bool NdArray::Reshape(const std::vector<std::size_t>& shape, NdArray* out_array, std::string* out_error) const {
+    if (ShapeSize(shape) != Size()) {
+        *out_error = "reshape(): la forma nueva no conserva el numero de elementos: " + NdShapeToString(shape_) +
+                     ", " + NdShapeToString(shape) + ".";
+        return false;
+    }
+    NdArray reshaped = Contiguous();
+    reshaped.shape_ = shape;
+    reshaped.strides_ = RowMajorStrides(shape);
+    *out_array = std::move(reshaped);
+    return true;
+}
+
+NdArray NdArray::Contiguous() const {
+    if (IsContiguous()) {
+        return *this;
+    }
+    return WithElementType(type_, [&](auto tag) {
+        using T = decltype(tag);
+        NdArray copy = Uninitialized(type_, shape_);
+        const T* source = Data<T>();
+        T* target = copy.MutableData<T>();
+        ForEachOffset(shape_, strides_, [&](std::ptrdiff_t offset) { *target++ = source[offset]; });
+        return copy;
+    });
+}
+
+NdArray NdArray::AsType(NdType type) const {
+    if (type == type_) {
+        return *this;
+    }
+    NdArray converted = Uninitialized(type, shape_);
+    WithElementType(type_, [&](auto source_tag) {
+        using From = decltype(source_tag);
+        WithElementType(type, [&](auto target_tag) {
+            using To = decltype(target_tag);
+            const From* source = Data<From>();
+            To* target = converted.MutableData<To>();
+            ForEachOffset(shape_, strides_, [&](std::ptrdiff_t offset) {
+                *target++ = ConvertElement<To>(source[offset]);
+            });
+        });
+    });
+    return converted;
+}
+
+bool NdArray::Equals(const NdArray& other) const {
+    if (shape_ != other.shape_) {
+        return false;
+    }
+    const NdArray lhs = Contiguous();
+    const NdArray rhs = other.Contiguous();
+    for (std::size_t i = 0; i < lhs.Size(); ++i) {
+        const NdScalar left = ReadElement(lhs, static_cast<std::ptrdiff_t>(i));
+        const NdScalar right = ReadElement(rhs, static_cast<std::ptrdiff_t>(i));
+        if (left.type == NdType::Int64 && right.type == NdType::Int64) {
+            if (left.integer != right.integer) {
+                return false;
+            }
+        } else if (!(left.AsDouble() == right.AsDouble())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string NdArray::ToString() const {
+    std::string text = "ndarray(";
+    AppendAxis(*this, 0, 0, &text);
+    text += ", \"";
+    text += NdTypeName(type_);
+    text += "\")";
+    return text;
+}
+
+bool NdBinary(NdBinaryOp op, const NdArray& lhs, const NdArray& rhs, NdArray* out_array, std::string* out_error) {
+    std::vector<std::size_t> shape;
+    if (!BroadcastShape(lhs.Shape(), rhs.Shape(), &shape)) {
+        *out_error = "Formas incompatibles para broadcasting: " + NdShapeToString(lhs.Shape()) + ", " +
+                     NdShapeToString(rhs.Shape()) + ".";
+        return false;
+    }
+
+    NdType type = PromoteTypes(lhs.Type(), rhs.Type());
+    if (type == NdType::Int64 && (op == NdBinaryOp::Divide || op == NdBinaryOp::Power)) {
+        type = NdType::Float64;
+    }
+
+    const NdArray left = lhs.AsType(type);
+    const NdArray right = rhs.AsType(type);
+    NdArray result = NdArray::Uninitialized(type, std::move(shape));
+    WithElementType(type, [&](auto tag) {
+        using T = decltype(tag);
+        RunBinary<T>(op, left, right, &result);
+    });
+    *out_array = std::move(result);
+    return true;
+}
+
+NdArray NdNegate(const NdArray& operand) {
+    NdArray result = NdArray::Uninitialized(operand.Type(), operand.Shape());
+    WithElementType(operand.Type(), [&](auto tag) {
+        using T = decltype(tag);
+        using A = ArithmeticType<T>;
+        const T* source = operand.Data<T>();
+        T* target = result.MutableData<T>();
+        ForEachOffset(operand.Shape(), operand.Strides(), [&](std::ptrdiff_t offset) {
+            *target++ = static_cast<T>(-static_cast<A>(source[offset]));
+        });
+    });
+    return result;
+}
+
+bool NdReduce(NdReduceOp op, const NdArray& operand, NdScalar* out_value, std::string* out_error) {
+    const std::size_t count = operand.Size();
+    if (op != NdReduceOp::Sum && count == 0) {
+        *out_error = op == NdReduceOp::Min ? "min() no admite un ndarray vacio." : "max() no admite un ndarray vacio.";
+        return false;
+    }
+
+    const NdArray data = operand.Contiguous();
+    *out_value = WithElementType(data.Type(), [&](auto tag) {
+        using T = decltype(tag);
+        const KernelSet<T>& kernels = Kernels<T>();
+        switch (op) {
+        case NdReduceOp::Min:
+            return MakeScalar(kernels.min(data.Data<T>(), count));
+        case NdReduceOp::Max:
+            return MakeScalar(kernels.max(data.Data<T>(), count));
+        case NdReduceOp::Sum:
+            break;
+        }
+        return MakeScalar(kernels.sum(data.Data<T>(), count));
+    });
+    return true;
+}
+
+bool NdMean(const NdArray& operand, NdScalar* out_value, std::string* out_error) {
+    const std::size_t count = operand.Size();
+    if (count == 0) {
+        *out_error = "mean() no admite un ndarray vacio.";
+        return false;
+    }
+
+    // int64 elements are averaged in float64 so the sum cannot wrap.
+    const NdArray data = operand.Type() == NdType::Int64 ? operand.AsType(NdType::Float64) : operand;
+    NdScalar total;
+    if (!NdReduce(NdReduceOp::Sum, data, &total, out_error)) {
+        return false;
+    }
+    if (total.type == NdType::Float32) {
+        total.real = static_cast<double>(static_cast<float>(total.real) / static_cast<float>(count));
+    } else {
+        total.real /= static_cast<double>(count);
+    }
+    *out_value = total;
+    return true;
+}
+
+bool NdDot(const NdArray& lhs,
+           const NdArray& rhs,
+           NdArray* out_array,
+           NdScalar* out_scalar,
+           bool* out_is_scalar,
+           std::string* out_error) {
+    const std::size_t lhs_rank = lhs.Rank();
+    const std::size_t rhs_rank = rhs.Rank();
+    if (lhs_rank < 1 || lhs_rank > 2 || rhs_rank < 1 || rhs_rank > 2) {
+        *out_error = "dot() solo admite ndarrays de 1 o 2 dimensiones.";
+        return false;
+    }
+
+    const std::size_t inner = lhs.Shape().back();
+    if (inner != rhs.Shape()[0]) {
+        *out_error = "dot(): dimensiones incompatibles: " + NdShapeToString(lhs.Shape()) + ", " +
+                     NdShapeToString(rhs.Shape()) + ".";
+        return false;
+    }
+
+    const NdType type = PromoteTypes(lhs.Type(), rhs.Type());
+    if (lhs_rank == 2 && rhs_rank == 2) {
+        *out_is_scalar = false;
+        *out_array = NdMatMul(lhs.AsType(type), rhs.AsType(type));
+        return true;
+    }
+
+    // Vector products are memory bound: rows of `left` and columns of `rhs` (rows of `right`) are both walked
+    // with unit stride, so every output element is one vectorized dot kernel.
+    const NdArray left = lhs.AsType(type).Contiguous();
+    const NdArray right = (rhs_rank == 2 ? rhs.Transpose() : rhs).AsType(type).Contiguous();
+    const std::size_t rows = lhs_rank == 2 ? lhs.Shape()[0] : 1;
+    const std::size_t columns = rhs_rank == 2 ? rhs.Shape()[1] : 1;
+
+    std::vector<std::size_t> shape;
+    if (lhs_rank == 2) {
+        shape.push_back(rows);
+    }
+    if (rhs_rank == 2) {
+        shape.push_back(columns);
+    }
+
+    *out_is_scalar = shape.empty();
+    NdArray result = NdArray::Uninitialized(type, shape);
+    WithElementType(type, [&](auto tag) {
+        using T = decltype(tag);
+        const KernelSet<T>& kernels = Kernels<T>();
+        const T* left_data = left.Data<T>();
+        const T* right_data = right.Data<T>();
+        T* target = result.MutableData<T>();
+        for (std::size_t row = 0; row < rows; ++row) {
+            for (std::size_t column = 0; column < columns; ++column) {
+                *target++ = kernels.dot(left_data + row * inner, right_data + column * inner, inner);
+            }
+        }
+    });
+
+    if (*out_is_scalar) {
+        *out_scalar = result.At(0);
+    } else {
+        *out_array = std::move(result);
+    }
+    return true;
+}
+
+}  // namespace clot::runtime
@@ -0,0 +1,100 @@
+#ifndef CLOT_RUNTIME_NDARRAY_INTERNAL_HPP
+#define CLOT_RUNTIME_NDARRAY_INTERNAL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "clot/runtime/ndarray.hpp"
+
+#if defined(__GNUC__) || defined(__clang__)
+#define CLOT_NDARRAY_VECTOR 1
+#define CLOT_NDARRAY_INLINE __attribute__((always_inline)) inline
+#if defined(__x86_64__) || defined(__i386__)
+#define CLOT_NDARRAY_AVX2 1
+#endif
+// The vector helpers pass 32-byte vectors by value. They are always inlined,
+// so the AVX calling convention never applies and GCC's ABI note is noise.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+#else
+#define CLOT_NDARRAY_INLINE inline
+#endif
+
+// Shared by ndarray.cpp (elementwise kernels) and ndarray_linalg.cpp (GEMM and
+// decompositions).
+namespace clot::runtime::internal {
+
+// Vector widths in bytes. 0 selects the plain scalar loops; 16 is one SSE2 /
+// NEON register and 32 one AVX2 register.
+constexpr std::size_t kScalarWidth = 0;
+constexpr std::size_t kPortableWidth = 16;
+constexpr std::size_t kAvx2Width = 32;
+
+enum class KernelLevel {
+    Scalar,
+    Portable,
+    Avx2,
+};
+
+// Picked once per process: AVX2 when the CPU has it, 16-byte vectors
+// otherwise. CLOT_NDARRAY_KERNEL=scalar|sse2 caps the level, which lets the
+// fallbacks be exercised on AVX2 machines.
+KernelLevel SelectedKernelLevel();
+
+// Contiguous float64 dot product through the selected kernel.
+double DotFloat64(const double* lhs, const double* rhs, std::size_t count);
+
+template <typename Visit>
+decltype(auto) WithElementType(NdType type, Visit&& visit) {
+    switch (type) {
+    case NdType::Float32:
+        return visit(float{});
+    case NdType::Int64:
+        return visit(std::int64_t{});
+    case NdType::Float64:
+        break;
+    }
+    return visit(double{});
+}
+
+// int64 add/subtract/multiply/sum run on uint64 so overflow wraps instead of
+// being undefined.
+template <typename T>
+using ArithmeticType = std::conditional_t<std::is_same_v<T, std::int64_t>, std::uint64_t, T>;
+
+#ifdef CLOT_NDARRAY_VECTOR
+
+template <typename T, std::size_t kBytes>
+struct VectorOf {
+    typedef T Type __attribute__((vector_size(kBytes)));
+    static constexpr std::size_t kLanes = kBytes / sizeof(T);
+};
+
+template <typename Vec, typename T>
+CLOT_NDARRAY_INLINE Vec LoadVector(const T* source) {
+    Vec value;
+    __builtin_memcpy(&value, source, sizeof(Vec));
+    return value;
+}
+
+template <typename Vec, typename T>
+CLOT_NDARRAY_INLINE void StoreVector(T* target, Vec value) {
+    __builtin_memcpy(target, &value, sizeof(Vec));
+}
+
+template <typename Vec, typename T>
+CLOT_NDARRAY_INLINE Vec SplatVector(T value) {
+    Vec vector{};
+    for (std::size_t lane = 0; lane < sizeof(Vec) / sizeof(T); ++lane) {
+        vector[lane] = value;
+    }
+    return vector;
+}
+
+#endif  // CLOT_NDARRAY_VECTOR
+
+}  // namespace clot::runtime::internal
+
+#endif  // CLOT_RUNTIME_NDARRAY_INTERNAL_HPP
@@ -0,0 +1,881 @@
+#include "clot/runtime/ndarray_linalg.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ndarray_internal.hpp"
+
+namespace clot::runtime {
+
+namespace {
+
+using namespace internal;
+
+// Products with fewer multiply-adds than this run on the calling thread.
+constexpr std::size_t kParallelGemmThreshold = std::size_t{1} << 21;
+
+// Panel width of the blocked LU; the trailing update of each panel is a GEMM.
+constexpr std::size_t kLuBlock = 64;
+
+// Strided read-only operand of a GEMM. Strides are in elements, as in NdArray.
+template <typename A>
+struct MatrixView {
+    const A* data;
+    std::ptrdiff_t row_stride;
+    std::ptrdiff_t column_stride;
+
+    A operator()(std::size_t row, std::size_t column) const {
+        return data[static_cast<std::ptrdiff_t>(row) * row_stride +
+                    static_cast<std::ptrdiff_t>(column) * column_stride];
+    }
+};
+
+// C += alpha * A * B, with A rows x depth, B depth x columns and C a row-major
+// block whose rows are `c_stride` elements apart.
+template <typename A>
+struct GemmProblem {
+    MatrixView<A> a;
+    MatrixView<A> b;
+    A* c;
+    std::size_t c_stride;
+    std::size_t rows;
+    std::size_t columns;
+    std::size_t depth;
+    A alpha;
+};
+
+// Register tile of the micro kernel: kRows x kColumns accumulators, held as
+// kRows * kVectors vectors. Six rows by two AVX2 vectors uses 12 of the 16 ymm
+// registers, leaving room for the B row and the broadcast A element.
+template <typename A, std::size_t kBytes>
+struct GemmTile {
+    static constexpr std::size_t kLanes = kBytes == kScalarWidth ? 1 : kBytes / sizeof(A);
+    static constexpr std::size_t kVectors = kBytes == kScalarWidth ? 4 : 2;
+    static constexpr std::size_t kRows = kBytes == kScalarWidth ? 4 : 6;
+    static constexpr std::size_t kColumns = kVectors * kLanes;
+
+    // Cache blocking: a packed kDepth x kColumns sliver of B stays in L1, a
+    // packed kRowBlock x kDepth block of A (about 128 KiB) in L2.
+    static constexpr std::size_t kDepth = 256;
+    static constexpr std::size_t kRowBlock = (std::size_t{128} * 1024 / (kDepth * sizeof(A))) / kRows * kRows;
+    static constexpr std::size_t kColumnBlock = 2048;
+};
+
+template <typename A, std::size_t kBytes>
+struct LaneVector {
+    using Type = A;
+};
+
+#ifdef CLOT_NDARRAY_VECTOR
+template <typename A>
+struct LaneVector<A, kPortableWidth> {
+    using Type = typename VectorOf<A, kPortableWidth>::Type;
+};
+
+template <typename A>
+struct LaneVector<A, kAvx2Width> {
+    using Type = typename VectorOf<A, kAvx2Width>::Type;
+};
+#endif
+
+template <typename A, std::size_t kBytes>
+CLOT_NDARRAY_INLINE typename LaneVector<A, kBytes>::Type Broadcast(A value) {
+    if constexpr (kBytes == kScalarWidth) {
+        return value;
+    } else {
+#ifdef CLOT_NDARRAY_VECTOR
+        return SplatVector<typename LaneVector<A, kBytes>::Type>(value);
+#endif
+    }
+}
+
+template <typename A, std::size_t kBytes>
+CLOT_NDARRAY_INLINE typename LaneVector<A, kBytes>::Type LoadLanes(const A* source) {
+    typename LaneVector<A, kBytes>::Type value;
+    __builtin_memcpy(&value, source, sizeof(value));
+    return value;
+}
+
+template <typename A, std::size_t kBytes>
+CLOT_NDARRAY_INLINE void StoreLanes(A* target, typename LaneVector<A, kBytes>::Type value) {
+    __builtin_memcpy(target, &value, sizeof(value));
+}
+
+// Copies rows [row, row + rows) x depth [depth_begin, depth_begin + depth) of
+// A, scaled by alpha, as kRows-row slivers stored depth-major. Rows past the
+// end are zero so the micro kernel never needs a partial-row variant.
+template <typename A, std::size_t kBytes>
+CLOT_NDARRAY_INLINE void PackA(const GemmProblem<A>& problem,
+                               std::size_t row,
+                               std::size_t rows,
+                               std::size_t depth_begin,
+                               std::size_t depth,
+                               A* out) {
+    constexpr std::size_t kRows = GemmTile<A, kBytes>::kRows;
+    for (std::size_t sliver = 0; sliver < rows; sliver += kRows) {
+        const std::size_t live = std::min(kRows, rows - sliver);
+        for (std::size_t k = 0; k < depth; ++k) {
+            for (std::size_t r = 0; r < kRows; ++r) {
+                *out++ = r < live ? problem.alpha * problem.a(row + sliver + r, depth_begin + k) : A{};
+            }
+        }
+    }
+}
+
+// Same for a depth x columns panel of B, as kColumns-wide slivers.
+template <typename A, std::size_t kBytes>
+CLOT_NDARRAY_INLINE void PackB(const GemmProblem<A>& problem,
+                               std::size_t depth_begin,
+                               std::size_t depth,
+                               std::size_t column,
+                               std::size_t columns,
+                               A* out) {
+    constexpr std::size_t kColumns = GemmTile<A, kBytes>::kColumns;
+    for (std::size_t sliver = 0; sliver < columns; sliver += kColumns) {
+        const std::size_t live = std::min(kColumns, columns - sliver);
+        for (std::size_t k = 0; k < depth; ++k) {
+            for (std::size_t c = 0; c < kColumns; ++c) {
+                *out++ = c < live ? problem.b(depth_begin + k, column + sliver + c) : A{};
+            }
+        }
+    }
+}
+
+// Accumulates one packed A sliver times one packed B sliver in registers and
+// adds the tile to C; `rows` and `columns` trim the tile at the matrix edge.
+template <typename A, std::size_t kBytes>
+CLOT_NDARRAY_INLINE void MicroKernel(std::size_t depth,
+                                     const A* packed_a,
+                                     const A* packed_b,
+                                     A* c,
+                                     std::size_t c_stride,
+                                     std::size_t rows,
+                                     std::size_t columns) {
+    using Tile = GemmTile<A, kBytes>;
+    using Vec = typename LaneVector<A, kBytes>::Type;
+    Vec accumulators[Tile::kRows][Tile::kVectors] = {};
+    for (std::size_t k = 0; k < depth; ++k) {
+        Vec b[Tile::kVectors];
+        for (std::size_t v = 0; v < Tile::kVectors; ++v) {
+            b[v] = LoadLanes<A, kBytes>(packed_b + v * Tile::kLanes);
+        }
+        for (std::size_t r = 0; r < Tile::kRows; ++r) {
+            const Vec a = Broadcast<A, kBytes>(packed_a[r]);
+            for (std::size_t v = 0; v < Tile::kVectors; ++v) {
+                accumulators[r][v] += a * b[v];
+            }
+        }
+        packed_a += Tile::kRows;
+        packed_b += Tile::kColumns;
+    }
+
+    if (rows == Tile::kRows && columns == Tile::kColumns) {
+        for (std::size_t r = 0; r < Tile::kRows; ++r) {
+            for (std::size_t v = 0; v < Tile::kVectors; ++v) {
+                A* target = c + r * c_stride + v * Tile::kLanes;
+                StoreLanes<A, kBytes>(target, LoadLanes<A, kBytes>(target) + accumulators[r][v]);
+            }
+        }
+        return;
+    }
+    A tile[Tile::kRows * Tile::kColumns];
+    for (std::size_t r = 0; r < Tile::kRows; ++r) {
+        for (std::size_t v = 0; v < Tile::kVectors; ++v) {
+            StoreLanes<A, kBytes>(tile + r * Tile::kColumns + v * Tile::kLanes, accumulators[r][v]);
+        }
+    }
+    for (std::size_t r = 0; r < rows; ++r) {
+        for (std::size_t column = 0; column < columns; ++column) {
+            c[r * c_stride + column] += tile[r * Tile::kColumns + column];
+        }
+    }
+}
+
+// Goto-style loop nest over rows [row_begin, row_end) of C.
+template <typename A, std::size_t kBytes>
+CLOT_NDARRAY_INLINE void GemmRows(const GemmProblem<A>& problem, std::size_t row_begin, std::size_t row_end) {
+    using Tile = GemmTile<A, kBytes>;
+    std::vector<A> packed_a(Tile::kRowBlock * Tile::kDepth);
+    std::vector<A> packed_b(Tile::kDepth * Tile::kColumnBlock);
+    for (std::size_t column = 0; column < problem.columns; column += Tile::kColumnBlock) {
+        const std::size_t columns = std::min(Tile::kColumnBlock, problem.columns - column);
+        for (std::size_t k = 0; k < problem.depth; k += Tile::kDepth) {
+            const std::size_t depth = std::min(Tile::kDepth, problem.depth - k);
+            PackB<A, kBytes>(problem, k, depth, column, columns, packed_b.data());
+            for (std::size_t row = row_begin; row < row_end; row += Tile::kRowBlock) {
+                const std::size_t rows = std::min(Tile::kRowBlock, row_end - row);
+                PackA<A, kBytes>(problem, row, rows, k, depth, packed_a.data());
+                for (std::size_t tile_column = 0; tile_column < columns; tile_column += Tile::kColumns) {
+                    for (std::size_t tile_row = 0; tile_row < rows; tile_row += Tile::kRows) {
+                        MicroKernel<A, kBytes>(depth,
+                                               packed_a.data() + tile_row * depth,
+                                               packed_b.data() + tile_column * depth,
+                                               problem.c + (row + tile_row) * problem.c_stride + column + tile_column,
+                                               problem.c_stride,
+                                               std::min(Tile::kRows, rows - tile_row),
+                                               std::min(Tile::kColumns, columns - tile_column));
+                    }
+                }
+            }
+        }
+    }
+}
+
+template <typename A>
+using GemmFunction = void (*)(const GemmProblem<A>&, std::size_t, std::size_t);
+
+template <typename A, std::size_t kBytes>
+void PortableGemmRows(const GemmProblem<A>& problem, std::size_t row_begin, std::size_t row_end) {
+    GemmRows<A, kBytes>(problem, row_begin, row_end);
+}
+
+#ifdef CLOT_NDARRAY_AVX2
+template <typename A>
+__attribute__((target("avx2,fma"))) void Avx2GemmRows(const GemmProblem<A>& problem,
+                                                      std::size_t row_begin,
+                                                      std::size_t row_end) {
+    GemmRows<A, kAvx2Width>(problem, row_begin, row_end);
+}
+#endif
+
+template <typename A>
+GemmFunction<A> GemmKernel() {
+    static const GemmFunction<A> kernel = []() -> GemmFunction<A> {
+        switch (SelectedKernelLevel()) {
+        case KernelLevel::Scalar:
+            return PortableGemmRows<A, kScalarWidth>;
+        case KernelLevel::Avx2:
+#ifdef CLOT_NDARRAY_AVX2
+            // The AVX2 micro kernel is also built for FMA, which every AVX2
+            // CPU but a few early VIA parts has.
+            if (__builtin_cpu_supports("fma")) {
+                return Avx2GemmRows<A>;
+            }
+#endif
+            break;
+        case KernelLevel::Portable:
+            break;
+        }
+#ifdef CLOT_NDARRAY_VECTOR
+        return PortableGemmRows<A, kPortableWidth>;
+#else
+        return PortableGemmRows<A, kScalarWidth>;
+#endif
+    }();
+    return kernel;
+}
+
+// Splits the rows of C into one band per hardware thread (in whole register
+// tiles) once the product is large enough to pay for the threads. Each band
+// packs its own copy of B, so the bands share nothing but read-only inputs.
+template <typename A>
+void RunGemm(const GemmProblem<A>& problem) {
+    if (problem.rows == 0 || problem.columns == 0 || problem.depth == 0) {
+        return;
+    }
+    const GemmFunction<A> kernel = GemmKernel<A>();
+    const std::size_t work = problem.rows * problem.columns * problem.depth;
+    const std::size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    constexpr std::size_t kRowQuantum = 16;
+    const std::size_t bands =
+        work < kParallelGemmThreshold ? 1 : std::min(hardware, (problem.rows + kRowQuantum - 1) / kRowQuantum);
+    if (bands <= 1) {
+        kernel(problem, 0, problem.rows);
+        return;
+    }
+
+    const std::size_t band_rows = ((problem.rows + bands - 1) / bands + kRowQuantum - 1) / kRowQuantum * kRowQuantum;
+    std::vector<std::thread> workers;
+    workers.reserve(bands);
+    for (std::size_t begin = 0; begin < problem.rows; begin += band_rows) {
+        const std::size_t end = std::min(problem.rows, begin + band_rows);
+        workers.emplace_back([&problem, kernel, begin, end]() { kernel(problem, begin, end); });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+bool RequireMatrix(const NdArray& matrix, const char* name, bool square, std::string* out_error) {
+    if (matrix.Rank() != 2) {
+        *out_error = std::string("Se requiere una matriz (ndarray de 2 dimensiones) en ") + name + "().";
+        return false;
+    }
+    if (square && matrix.Shape()[0] != matrix.Shape()[1]) {
+        *out_error = std::string("Matriz no cuadrada en ") + name + "(): " + NdShapeToString(matrix.Shape()) + ".";
+        return false;
+    }
+    return true;
+}
+
+// Fresh contiguous float64 copy that the caller may overwrite; arrays are
+// otherwise immutable and may share their buffer.
+NdArray WritableFloat64(const NdArray& array) {
+    const NdArray source = array.AsType(NdType::Float64).Contiguous();
+    NdArray copy = NdArray::Uninitialized(NdType::Float64, source.Shape());
+    if (source.Size() != 0) {
+        std::memcpy(copy.MutableData<double>(), source.Data<double>(), source.Size() * sizeof(double));
+    }
+    return copy;
+}
+
+// Blocked right-looking LU with partial pivoting, in place on the row-major
+// n x n `a`: each kLuBlock-column panel is factored unblocked, the rows to its
+// right are solved against the panel's unit lower triangle, and the trailing
+// matrix is updated with one GEMM. `order[i]` ends up as the original index of
+// row i. Returns the permutation parity (+1 or -1).
+int LuFactor(double* a, std::size_t n, std::vector<std::size_t>* order) {
+    order->resize(n);
+    std::iota(order->begin(), order->end(), std::size_t{0});
+    int parity = 1;
+    for (std::size_t block = 0; block < n; block += kLuBlock) {
+        const std::size_t block_end = std::min(n, block + kLuBlock);
+        for (std::size_t j = block; j < block_end; ++j) {
+            std::size_t pivot = j;
+            double largest = std::fabs(a[j * n + j]);
+            for (std::size_t i = j + 1; i < n; ++i) {
+                const double candidate = std::fabs(a[i * n + j]);
+                if (candidate > largest) {
+                    largest = candidate;
+                    pivot = i;
+                }
+            }
+            if (pivot != j) {
+                std::swap_ranges(a + j * n, a + j * n + n, a + pivot * n);
+                std::swap((*order)[j], (*order)[pivot]);
+                parity = -parity;
+            }
+            const double diagonal = a[j * n + j];
+            if (diagonal == 0.0) {
+                continue;
+            }
+            for (std::size_t i = j + 1; i < n; ++i) {
+                double* row = a + i * n;
+                const double factor = (row[j] /= diagonal);
+                if (factor == 0.0) {
+                    continue;
+                }
+                const double* pivot_row = a + j * n;
+                for (std::size_t column = j + 1; column < block_end; ++column) {
+                    row[column] -= factor * pivot_row[column];
+                }
+            }
+        }
+        if (block_end == n) {
+            break;
+        }
+
+        for (std::size_t j = block; j < block_end; ++j) {
+            const double* source = a + j * n;
+            for (std::size_t i = j + 1; i < block_end; ++i) {
+                double* row = a + i * n;
+                const double factor = row[j];
+                for (std::size_t column = block_end; column < n; ++column) {
+                    row[column] -= factor * source[column];
+                }
+            }
+        }
+
+        const auto stride = static_cast<std::ptrdiff_t>(n);
+        RunGemm(GemmProblem<double>{
+            MatrixView<double>{a + block_end * n + block, stride, 1},
+            MatrixView<double>{a + block * n + block_end, stride, 1},
+            a + block_end * n + block_end,
+            n,
+            n - block_end,
+            n - block_end,
+            block_end - block,
+            -1.0,
+        });
+    }
+    return parity;
+}
+
+bool HasZeroPivot(const double* lu, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        if (lu[i * n + i] == 0.0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Overwrites the row-major n x columns `x` with the solution of L·U·X = x.
+void LuSubstitute(const double* lu, std::size_t n, double* x, std::size_t columns) {
+    for (std::size_t i = 0; i < n; ++i) {
+        double* row = x + i * columns;
+        for (std::size_t j = 0; j < i; ++j) {
+            const double factor = lu[i * n + j];
+            if (factor == 0.0) {
+                continue;
+            }
+            const double* source = x + j * columns;
+            for (std::size_t column = 0; column < columns; ++column) {
+                row[column] -= factor * source[column];
+            }
+        }
+    }
+    for (std::size_t i = n; i-- > 0;) {
+        double* row = x + i * columns;
+        for (std::size_t j = i + 1; j < n; ++j) {
+            const double factor = lu[i * n + j];
+            if (factor == 0.0) {
+                continue;
+            }
+            const double* source = x + j * columns;
+            for (std::size_t column = 0; column < columns; ++column) {
+                row[column] -= factor * source[column];
+            }
+        }
+        const double diagonal = lu[i * n + i];
+        for (std::size_t column = 0; column < columns; ++column) {
+            row[column] /= diagonal;
+        }
+    }
+}
+
+// Shared by solve() and inv(): factors `matrix` and solves for the row-major
+// n x columns `rhs`, which is consumed.
+bool SolveFactored(const NdArray& matrix,
+                   const NdArray& rhs,
+                   std::size_t columns,
+                   const char* name,
+                   NdArray* out_solution,
+                   std::string* out_error) {
+    const std::size_t n = matrix.Shape()[0];
+    NdArray lu = WritableFloat64(matrix);
+    std::vector<std::size_t> order;
+    LuFactor(lu.MutableData<double>(), n, &order);
+    if (HasZeroPivot(lu.Data<double>(), n)) {
+        *out_error = std::string("Matriz singular en ") + name + "().";
+        return false;
+    }
+
+    std::vector<std::size_t> shape = rhs.Shape();
+    NdArray solution = NdArray::Uninitialized(NdType::Float64, shape);
+    const double* source = rhs.Data<double>();
+    double* target = solution.MutableData<double>();
+    for (std::size_t i = 0; i < n; ++i) {
+        std::copy_n(source + order[i] * columns, columns, target + i * columns);
+    }
+    LuSubstitute(lu.Data<double>(), n, target, columns);
+    *out_solution = std::move(solution);
+    return true;
+}
+
+// Householder tridiagonalization (tred2) followed by the implicit QL method
+// with shifts (tql2), after the EISPACK routines as adapted by JAMA. `v` is the
+// row-major n x n symmetric input and ends up holding the eigenvectors as
+// columns; `d` receives the eigenvalues in ascending order.
+bool SymmetricEigen(double* v, std::size_t n, std::vector<double>* d_values) {
+    std::vector<double>& d = *d_values;
+    std::vector<double> e(n, 0.0);
+    d.assign(n, 0.0);
+    auto at = [v, n](std::size_t row, std::size_t column) -> double& { return v[row * n + column]; };
+
+    for (std::size_t j = 0; j < n; ++j) {
+        d[j] = at(n - 1, j);
+    }
+    for (std::size_t i = n - 1; i > 0; --i) {
+        double scale = 0.0;
+        double h = 0.0;
+        for (std::size_t k = 0; k < i; ++k) {
+            scale += std::fabs(d[k]);
+        }
+        if (scale == 0.0) {
+            e[i] = d[i - 1];
+            for (std::size_t j = 0; j < i; ++j) {
+                d[j] = at(i - 1, j);
+                at(i, j) = 0.0;
+                at(j, i) = 0.0;
+            }
+        } else {
+            for (std::size_t k = 0; k < i; ++k) {
+                d[k] /= scale;
+                h += d[k] * d[k];
+            }
+            double f = d[i - 1];
+            double g = std::sqrt(h);
+            if (f > 0) {
+                g = -g;
+            }
+            e[i] = scale * g;
+            h -= f * g;
+            d[i - 1] = f - g;
+            for (std::size_t j = 0; j < i; ++j) {
+                e[j] = 0.0;
+            }
+            for (std::size_t j = 0; j < i; ++j) {
+                f = d[j];
+                at(j, i) = f;
+                g = e[j] + at(j, j) * f;
+                for (std::size_t k = j + 1; k < i; ++k) {
+                    g += at(k, j) * d[k];
+                    e[k] += at(k, j) * f;
+                }
+                e[j] = g;
+            }
+            f = 0.0;
+            for (std::size_t j = 0; j < i; ++j) {
+                e[j] /= h;
+                f += e[j] * d[j];
+            }
+            const double hh = f / (h + h);
+            for (std::size_t j = 0; j < i; ++j) {
+                e[j] -= hh * d[j];
+            }
+            for (std::size_t j = 0; j < i; ++j) {
+                f = d[j];
+                g = e[j];
+                for (std::size_t k = j; k < i; ++k) {
+                    at(k, j) -= f * e[k] + g * d[k];
+                }
+                d[j] = at(i - 1, j);
+                at(i, j) = 0.0;
+            }
+        }
+        d[i] = h;
+    }
+
+    // Accumulate the transformations.
+    for (std::size_t i = 0; i + 1 < n; ++i) {
+        at(n - 1, i) = at(i, i);
+        at(i, i) = 1.0;
+        const double h = d[i + 1];
+        if (h != 0.0) {
+            for (std::size_t k = 0; k <= i; ++k) {
+                d[k] = at(k, i + 1) / h;
+            }
+            for (std::size_t j = 0; j <= i; ++j) {
+                double g = 0.0;
+                for (std::size_t k = 0; k <= i; ++k) {
+                    g += at(k, i + 1) * at(k, j);
+                }
+                for (std::size_t k = 0; k <= i; ++k) {
+                    at(k, j) -= g * d[k];
+                }
+            }
+        }
+        for (std::size_t k = 0; k <= i; ++k) {
+            at(k, i + 1) = 0.0;
+        }
+    }
+    for (std::size_t j = 0; j < n; ++j) {
+        d[j] = at(n - 1, j);
+        at(n - 1, j) = 0.0;
+    }
+    at(n - 1, n - 1) = 1.0;
+    e[0] = 0.0;
+
+    // Implicit QL iterations on the tridiagonal (d, e).
+    for (std::size_t i = 1; i < n; ++i) {
+        e[i - 1] = e[i];
+    }
+    e[n - 1] = 0.0;
+
+    const double epsilon = std::numeric_limits<double>::epsilon();
+    constexpr int kMaxIterations = 64;
+    double f = 0.0;
+    double tst1 = 0.0;
+    for (std::size_t l = 0; l < n; ++l) {
+        tst1 = std::max(tst1, std::fabs(d[l]) + std::fabs(e[l]));
+        std::size_t m = l;
+        while (m < n - 1 && std::fabs(e[m]) > epsilon * tst1) {
+            ++m;
+        }
+        if (m > l) {
+            int iterations = 0;
+            do {
+                if (++iterations > kMaxIterations) {
+                    return false;
+                }
+                double g = d[l];
+                double p = (d[l + 1] - g) / (2.0 * e[l]);
+                double r = std::hypot(p, 1.0);
+                if (p < 0) {
+                    r = -r;
+                }
+                d[l] = e[l] / (p + r);
+                d[l + 1] = e[l] * (p + r);
+                const double dl1 = d[l + 1];
+                double h = g - d[l];
+                for (std::size_t i = l + 2; i < n; ++i) {
+                    d[i] -= h;
+                }
+                f += h;
+
+                p = d[m];
+                double c = 1.0;
+                double c2 = c;
+                double c3 = c;
+                const double el1 = e[l + 1];
+                double s = 0.0;
+                double s2 = 0.0;
+                for (std::size_t i = m; i-- > l;) {
+                    c3 = c2;
+                    c2 = c;
+                    s2 = s;
+                    g = c * e[i];
+                    h = c * p;
+                    r = std::hypot(p, e[i]);
+                    e[i + 1] = s * r;
+                    s = e[i] / r;
+                    c = p / r;
+                    p = c * d[i] - s * g;
+                    d[i + 1] = h + s * (c * g + s * d[i]);
+                    for (std::size_t k = 0; k < n; ++k) {
+                        h = at(k, i + 1);
+                        at(k, i + 1) = s * at(k, i) + c * h;
+                        at(k, i) = c * at(k, i) - s * h;
+                    }
+                }
+                p = -s * s2 * c3 * el1 * e[l] / dl1;
+                e[l] = s * p;
+                d[l] = c * p;
+            } while (std::fabs(e[l]) > epsilon * tst1);
+        }
+        d[l] += f;
+        e[l] = 0.0;
+    }
+
+    // Selection sort into ascending order, moving eigenvector columns along.
+    for (std::size_t i = 0; i + 1 < n; ++i) {
+        std::size_t smallest = i;
+        for (std::size_t j = i + 1; j < n; ++j) {
+            if (d[j] < d[smallest]) {
+                smallest = j;
+            }
+        }
+        if (smallest != i) {
+            std::swap(d[i], d[smallest]);
+            for (std::size_t k = 0; k < n; ++k) {
+                std::swap(at(k, i), at(k, smallest));
+            }
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+NdArray NdMatMul(const NdArray& lhs, const NdArray& rhs) {
+    const std::size_t rows = lhs.Shape()[0];
+    const std::size_t depth = lhs.Shape()[1];
+    const std::size_t columns = rhs.Shape()[1];
+    NdArray result = NdArray::Zeros(lhs.Type(), {rows, columns});
+    WithElementType(lhs.Type(), [&](auto tag) {
+        using T = decltype(tag);
+        using A = ArithmeticType<T>;
+        RunGemm(GemmProblem<A>{
+            MatrixView<A>{reinterpret_cast<const A*>(lhs.Data<T>()), lhs.Strides()[0], lhs.Strides()[1]},
+            MatrixView<A>{reinterpret_cast<const A*>(rhs.Data<T>()), rhs.Strides()[0], rhs.Strides()[1]},
+            reinterpret_cast<A*>(result.MutableData<T>()),
+            columns,
+            rows,
+            columns,
+            depth,
+            A{1},
+        });
+    });
+    return result;
+}
+
+bool NdLu(const NdArray& matrix, NdArray* out_p, NdArray* out_l, NdArray* out_u, std::string* out_error) {
+    if (!RequireMatrix(matrix, "lu", true, out_error)) {
+        return false;
+    }
+    const std::size_t n = matrix.Shape()[0];
+    NdArray lu = WritableFloat64(matrix);
+    std::vector<std::size_t> order;
+    LuFactor(lu.MutableData<double>(), n, &order);
+
+    NdArray permutation = NdArray::Zeros(NdType::Float64, {n, n});
+    NdArray lower = NdArray::Zeros(NdType::Float64, {n, n});
+    NdArray upper = NdArray::Zeros(NdType::Float64, {n, n});
+    const double* factors = lu.Data<double>();
+    double* p = permutation.MutableData<double>();
+    double* l = lower.MutableData<double>();
+    double* u = upper.MutableData<double>();
+    for (std::size_t i = 0; i < n; ++i) {
+        p[order[i] * n + i] = 1.0;
+        std::copy_n(factors + i * n, i, l + i * n);
+        l[i * n + i] = 1.0;
+        std::copy(factors + i * n + i, factors + i * n + n, u + i * n + i);
+    }
+    *out_p = std::move(permutation);
+    *out_l = std::move(lower);
+    *out_u = std::move(upper);
+    return true;
+}
+
+bool NdQr(const NdArray& matrix, NdArray* out_q, NdArray* out_r, std::string* out_error) {
+    if (!RequireMatrix(matrix, "qr", false, out_error)) {
+        return false;
+    }
+    const std::size_t m = matrix.Shape()[0];
+    const std::size_t n = matrix.Shape()[1];
+    const std::size_t k = std::min(m, n);
+
+    // Works on Aᵀ so every column of A, and every Householder vector stored in
+    // it, is a contiguous row.
+    NdArray transposed = WritableFloat64(matrix.Transpose());
+    double* columns = transposed.MutableData<double>();
+    std::vector<double> diagonal(k, 0.0);
+    std::vector<double> tau(k, 0.0);
+    for (std::size_t j = 0; j < k; ++j) {
+        double* v = columns + j * m + j;
+        const std::size_t length = m - j;
+        const double norm = std::sqrt(DotFloat64(v, v, length));
+        if (norm == 0.0) {
+            continue;
+        }
+        const double alpha = v[0] > 0 ? -norm : norm;
+        v[0] -= alpha;
+        diagonal[j] = alpha;
+        tau[j] = 2.0 / DotFloat64(v, v, length);
+        for (std::size_t c = j + 1; c < n; ++c) {
+            double* target = columns + c * m + j;
+            const double scale = tau[j] * DotFloat64(v, target, length);
+            for (std::size_t i = 0; i < length; ++i) {
+                target[i] -= scale * v[i];
+            }
+        }
+    }
+
+    NdArray r = NdArray::Zeros(NdType::Float64, {k, n});
+    double* r_data = r.MutableData<double>();
+    for (std::size_t i = 0; i < k; ++i) {
+        r_data[i * n + i] = tau[i] == 0.0 ? columns[i * m + i] : diagonal[i];
+        for (std::size_t c = i + 1; c < n; ++c) {
+            r_data[i * n + c] = columns[c * m + i];
+        }
+    }
+
+    // Q = H0·H1·…·H(k-1)·I[:, :k], built transposed (one row per column of Q)
+    // by applying the reflectors in reverse order.
+    NdArray q_transposed = NdArray::Zeros(NdType::Float64, {k, m});
+    double* q_rows = q_transposed.MutableData<double>();
+    for (std::size_t i = 0; i < k; ++i) {
+        q_rows[i * m + i] = 1.0;
+    }
+    for (std::size_t j = k; j-- > 0;) {
+        if (tau[j] == 0.0) {
+            continue;
+        }
+        const double* v = columns + j * m + j;
+        const std::size_t length = m - j;
+        for (std::size_t c = 0; c < k; ++c) {
+            double* target = q_rows + c * m + j;
+            const double scale = tau[j] * DotFloat64(v, target, length);
+            for (std::size_t i = 0; i < length; ++i) {
+                target[i] -= scale * v[i];
+            }
+        }
+    }
+    *out_q = q_transposed.Transpose().Contiguous();
+    *out_r = std::move(r);
+    return true;
+}
+
+bool NdCholesky(const NdArray& matrix, NdArray* out_lower, std::string* out_error) {
+    if (!RequireMatrix(matrix, "cholesky", true, out_error)) {
+        return false;
+    }
+    const std::size_t n = matrix.Shape()[0];
+    const NdArray source = matrix.AsType(NdType::Float64).Contiguous();
+    const double* a = source.Data<double>();
+    NdArray lower = NdArray::Zeros(NdType::Float64, {n, n});
+    double* l = lower.MutableData<double>();
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j <= i; ++j) {
+            const double sum = a[i * n + j] - DotFloat64(l + i * n, l + j * n, j);
+            if (i != j) {
+                l[i * n + j] = sum / l[j * n + j];
+                continue;
+            }
+            if (!(sum > 0.0)) {
+                *out_error = "cholesky(): la matriz no es definida positiva.";
+                return false;
+            }
+            l[i * n + i] = std::sqrt(sum);
+        }
+    }
+    *out_lower = std::move(lower);
+    return true;
+}
+
+bool NdEigh(const NdArray& matrix, NdArray* out_values, NdArray* out_vectors, std::string* out_error) {
+    if (!RequireMatrix(matrix, "eigh", true, out_error)) {
+        return false;
+    }
+    const std::size_t n = matrix.Shape()[0];
+    NdArray vectors = WritableFloat64(matrix);
+    double* v = vectors.MutableData<double>();
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = i + 1; j < n; ++j) {
+            v[i * n + j] = v[j * n + i];
+        }
+    }
+
+    std::vector<double> eigenvalues;
+    if (n != 0 && !SymmetricEigen(v, n, &eigenvalues)) {
+        *out_error = "eigh(): el metodo QL no convergio.";
+        return false;
+    }
+    NdArray values = NdArray::Uninitialized(NdType::Float64, {n});
+    std::copy(eigenvalues.begin(), eigenvalues.end(), values.MutableData<double>());
+    *out_values = std::move(values);
+    *out_vectors = std::move(vectors);
+    return true;
+}
+
+bool NdSolve(const NdArray& matrix, const NdArray& rhs, NdArray* out_solution, std::string* out_error) {
+    if (!RequireMatrix(matrix, "solve", true, out_error)) {
+        return false;
+    }
+    const std::size_t n = matrix.Shape()[0];
+    if (rhs.Rank() < 1 || rhs.Rank() > 2 || rhs.Shape()[0] != n) {
+        *out_error = "solve(): dimensiones incompatibles: " + NdShapeToString(matrix.Shape()) + ", " +
+                     NdShapeToString(rhs.Shape()) + ".";
+        return false;
+    }
+    const std::size_t columns = rhs.Rank() == 2 ? rhs.Shape()[1] : 1;
+    return SolveFactored(matrix, rhs.AsType(NdType::Float64).Contiguous(), columns, "solve", out_solution, out_error);
+}
+
+bool NdInverse(const NdArray& matrix, NdArray* out_inverse, std::string* out_error) {
+    if (!RequireMatrix(matrix, "inv", true, out_error)) {
+        return false;
+    }
+    const std::size_t n = matrix.Shape()[0];
+    NdArray identity = NdArray::Zeros(NdType::Float64, {n, n});
+    double* diagonal = identity.MutableData<double>();
+    for (std::size_t i = 0; i < n; ++i) {
+        diagonal[i * n + i] = 1.0;
+    }
+    return SolveFactored(matrix, identity, n, "inv", out_inverse, out_error);
+}
+
+bool NdDeterminant(const NdArray& matrix, double* out_value, std::string* out_error) {
+    if (!RequireMatrix(matrix, "det", true, out_error)) {
+        return false;
+    }
+    const std::size_t n = matrix.Shape()[0];
+    NdArray lu = WritableFloat64(matrix);
+    std::vector<std::size_t> order;
+    double determinant = LuFactor(lu.MutableData<double>(), n, &order);
+    const double* factors = lu.Data<double>();
+    for (std::size_t i = 0; i < n; ++i) {
+        determinant *= factors[i * n + i];
+    }
+    *out_value = determinant;
+    return true;
+}
+
+}  // namespace clot::runtime
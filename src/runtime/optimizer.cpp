@@ -0,0 +1,596 @@
+#include "clot/runtime/optimizer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <utility>
+
+namespace clot::runtime {
+
+namespace {
+
+// Fewest vector elements touched per round worth giving a thread of its own.
+constexpr std::size_t kParallelOptimizerThreshold = std::size_t{1} << 15;
+
+// Sufficient-decrease constant of the Armijo line search.
+constexpr double kArmijo = 1e-4;
+
+double Dot(const std::vector<double>& lhs, const std::vector<double>& rhs) {
+    return std::inner_product(lhs.begin(), lhs.end(), rhs.begin(), 0.0);
+}
+
+double MaxAbs(const std::vector<double>& values) {
+    double result = 0.0;
+    for (const double value : values) {
+        result = std::max(result, std::fabs(value));
+    }
+    return result;
+}
+
+// Ask/tell optimizer: Pending() lists the points whose value (and gradient,
+// for gradient methods) the next Tell() expects, in the same order.
+class Optimizer {
+public:
+    virtual ~Optimizer() = default;
+
+    bool Done() const { return done_; }
+    const std::vector<std::vector<double>>& Pending() const { return pending_; }
+    const OptimizerResult& Result() const { return result_; }
+
+    void Tell(const double* values, const std::vector<double>* gradients) {
+        result_.evaluations += pending_.size();
+        Step(values, gradients);
+    }
+
+protected:
+    void Finish(bool converged) {
+        result_.converged = converged;
+        pending_.clear();
+        done_ = true;
+    }
+
+    virtual void Step(const double* values, const std::vector<double>* gradients) = 0;
+
+    OptimizerOptions options_;
+    std::vector<std::vector<double>> pending_;
+    OptimizerResult result_;
+    bool done_ = false;
+};
+
+// Gradient descent and L-BFGS share the backtracking Armijo line search;
+// they differ in the search direction and the first trial step.
+class LineSearchOptimizer : public Optimizer {
+public:
+    LineSearchOptimizer(const OptimizerOptions& options, std::vector<double> start) {
+        options_ = options;
+        pending_.push_back(std::move(start));
+    }
+
+protected:
+    virtual void Direction(std::vector<double>* out_direction) = 0;
+    virtual double InitialStep() = 0;
+    virtual void Accepted(const std::vector<double>& step, const std::vector<double>& gradient_change) {
+        (void)step;
+        (void)gradient_change;
+    }
+    virtual void Reset() {}
+
+    const std::vector<double>& Gradient() const { return gradient_; }
+    double LastStep() const { return last_step_; }
+
+    void Step(const double* values, const std::vector<double>* gradients) override {
+        const double value = values[0];
+        const std::vector<double>& gradient = gradients[0];
+
+        if (!searching_) {
+            result_.x = std::move(pending_[0]);
+            result_.value = value;
+            gradient_ = gradient;
+            if (!std::isfinite(value)) {
+                Finish(false);
+                return;
+            }
+            BeginIteration();
+            return;
+        }
+
+        if (std::isfinite(value) && value <= result_.value + kArmijo * step_ * slope_) {
+            std::vector<double>& trial = pending_[0];
+            std::vector<double> step(trial.size());
+            std::vector<double> gradient_change(trial.size());
+            for (std::size_t i = 0; i < trial.size(); ++i) {
+                step[i] = trial[i] - result_.x[i];
+                gradient_change[i] = gradient[i] - gradient_[i];
+            }
+            const double previous = result_.value;
+            result_.x = std::move(trial);
+            result_.value = value;
+            gradient_ = gradient;
+            last_step_ = step_;
+            ++result_.iterations;
+            Accepted(step, gradient_change);
+
+            // No decrease left at this value's precision: stop, converged only
+            // if the gradient test passes too.
+            if (previous - value <= std::numeric_limits<double>::epsilon() * std::fabs(value)) {
+                Finish(MaxAbs(gradient_) <= options_.tolerance);
+                return;
+            }
+            BeginIteration();
+            return;
+        }
+
+        step_ *= 0.5;
+        const double scale = std::max(1.0, MaxAbs(result_.x));
+        if (step_ * MaxAbs(direction_) <= std::numeric_limits<double>::epsilon() * scale) {
+            Finish(MaxAbs(gradient_) <= options_.tolerance);
+            return;
+        }
+        SetTrial();
+    }
+
+private:
+    void BeginIteration() {
+        searching_ = true;
+        if (MaxAbs(gradient_) <= options_.tolerance) {
+            Finish(true);
+            return;
+        }
+        if (result_.iterations >= options_.max_iterations) {
+            Finish(false);
+            return;
+        }
+
+        Direction(&direction_);
+        slope_ = Dot(gradient_, direction_);
+        if (!(slope_ < 0.0)) {
+            // Not a descent direction (curvature pairs gone stale): restart
+            // from steepest descent.
+            Reset();
+            for (std::size_t i = 0; i < direction_.size(); ++i) {
+                direction_[i] = -gradient_[i];
+            }
+            slope_ = -Dot(gradient_, gradient_);
+        }
+        step_ = InitialStep();
+        SetTrial();
+    }
+
+    void SetTrial() {
+        std::vector<double> trial(result_.x.size());
+        for (std::size_t i = 0; i < trial.size(); ++i) {
+            trial[i] = result_.x[i] + step_ * direction_[i];
+        }
+        pending_.assign(1, std::move(trial));
+    }
+
+    std::vector<double> gradient_;
+    std::vector<double> direction_;
+    double slope_ = 0.0;
+    double step_ = 0.0;
+    double last_step_ = 0.0;
+    bool searching_ = false;
+};
+
+class GradientDescent : public LineSearchOptimizer {
+public:
+    using LineSearchOptimizer::LineSearchOptimizer;
+
+protected:
+    void Direction(std::vector<double>* out_direction) override {
+        out_direction->resize(Gradient().size());
+        for (std::size_t i = 0; i < Gradient().size(); ++i) {
+            (*out_direction)[i] = -Gradient()[i];
+        }
+    }
+
+    double InitialStep() override {
+        return result_.iterations == 0 ? options_.learning_rate : 2.0 * LastStep();
+    }
+};
+
+// Limited-memory BFGS with the two-loop recursion, scaled by
+// s·y / y·y of the newest pair.
+class Lbfgs : public LineSearchOptimizer {
+public:
+    using LineSearchOptimizer::LineSearchOptimizer;
+
+protected:
+    void Direction(std::vector<double>* out_direction) override {
+        std::vector<double>& q = *out_direction;
+        q = Gradient();
+        std::vector<double> alpha(pairs_.size());
+        for (std::size_t k = pairs_.size(); k-- > 0;) {
+            alpha[k] = pairs_[k].rho * Dot(pairs_[k].s, q);
+            for (std::size_t i = 0; i < q.size(); ++i) {
+                q[i] -= alpha[k] * pairs_[k].y[i];
+            }
+        }
+        if (!pairs_.empty()) {
+            const Pair& newest = pairs_.back();
+            const double gamma = Dot(newest.s, newest.y) / Dot(newest.y, newest.y);
+            for (double& element : q) {
+                element *= gamma;
+            }
+        }
+        for (std::size_t k = 0; k < pairs_.size(); ++k) {
+            const double beta = pairs_[k].rho * Dot(pairs_[k].y, q);
+            for (std::size_t i = 0; i < q.size(); ++i) {
+                q[i] += (alpha[k] - beta) * pairs_[k].s[i];
+            }
+        }
+        for (double& element : q) {
+            element = -element;
+        }
+    }
+
+    double InitialStep() override {
+        if (pairs_.empty()) {
+            return options_.learning_rate / std::max(1.0, std::sqrt(Dot(Gradient(), Gradient())));
+        }
+        return 1.0;
+    }
+
+    void Accepted(const std::vector<double>& step, const std::vector<double>& gradient_change) override {
+        const double sy = Dot(step, gradient_change);
+        const double yy = Dot(gradient_change, gradient_change);
+        // Skip pairs without positive curvature; they would break the
+        // positive definiteness of the inverse Hessian estimate.
+        if (!(sy > std::numeric_limits<double>::epsilon() * yy) || options_.memory == 0) {
+            return;
+        }
+        if (pairs_.size() == options_.memory) {
+            pairs_.pop_front();
+        }
+        pairs_.push_back(Pair{step, gradient_change, 1.0 / sy});
+    }
+
+    void Reset() override { pairs_.clear(); }
+
+private:
+    struct Pair {
+        std::vector<double> s;
+        std::vector<double> y;
+        double rho = 0.0;
+    };
+
+    std::deque<Pair> pairs_;
+};
+
+// Nelder-Mead simplex search with the standard coefficients (reflection 1,
+// expansion 2, contraction and shrink 1/2). Non-finite values count as +inf.
+class NelderMead : public Optimizer {
+public:
+    NelderMead(const OptimizerOptions& options, std::vector<double> start) {
+        options_ = options;
+        const std::size_t n = start.size();
+        pending_.push_back(start);
+        for (std::size_t i = 0; i < n; ++i) {
+            std::vector<double> vertex = start;
+            vertex[i] += options_.simplex_step * std::max(std::fabs(start[i]), 1.0);
+            pending_.push_back(std::move(vertex));
+        }
+    }
+
+protected:
+    void Step(const double* values, const std::vector<double>* gradients) override {
+        (void)gradients;
+        switch (phase_) {
+        case Phase::Initial:
+        case Phase::Shrink:
+            if (phase_ == Phase::Initial) {
+                vertices_ = std::move(pending_);
+                values_.assign(vertices_.size(), 0.0);
+                for (std::size_t i = 0; i < vertices_.size(); ++i) {
+                    values_[i] = Finite(values[i]);
+                }
+            } else {
+                for (std::size_t i = 1; i < vertices_.size(); ++i) {
+                    vertices_[i] = std::move(pending_[i - 1]);
+                    values_[i] = Finite(values[i - 1]);
+                }
+            }
+            BeginIteration();
+            return;
+        case Phase::Reflect: {
+            reflected_ = std::move(pending_[0]);
+            reflected_value_ = Finite(values[0]);
+            const std::size_t worst = vertices_.size() - 1;
+            if (reflected_value_ < values_[0]) {
+                Propose(Phase::Expand, 2.0);
+            } else if (reflected_value_ < values_[worst - 1]) {
+                Replace(std::move(reflected_), reflected_value_);
+            } else if (reflected_value_ < values_[worst]) {
+                Propose(Phase::ContractOutside, 0.5);
+            } else {
+                Propose(Phase::ContractInside, -0.5);
+            }
+            return;
+        }
+        case Phase::Expand:
+            if (Finite(values[0]) < reflected_value_) {
+                Replace(std::move(pending_[0]), Finite(values[0]));
+            } else {
+                Replace(std::move(reflected_), reflected_value_);
+            }
+            return;
+        case Phase::ContractOutside:
+        case Phase::ContractInside: {
+            const double value = Finite(values[0]);
+            const double bound = phase_ == Phase::ContractOutside ? reflected_value_ : values_.back();
+            if (value <= bound) {
+                Replace(std::move(pending_[0]), value);
+            } else {
+                Shrink();
+            }
+            return;
+        }
+        }
+    }
+
+private:
+    enum class Phase {
+        Initial,
+        Reflect,
+        Expand,
+        ContractOutside,
+        ContractInside,
+        Shrink,
+    };
+
+    static double Finite(double value) {
+        return std::isfinite(value) ? value : std::numeric_limits<double>::infinity();
+    }
+
+    void BeginIteration() {
+        std::vector<std::size_t> order(vertices_.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(),
+                         [&](std::size_t lhs, std::size_t rhs) { return values_[lhs] < values_[rhs]; });
+        std::vector<std::vector<double>> vertices(vertices_.size());
+        std::vector<double> values(values_.size());
+        for (std::size_t i = 0; i < order.size(); ++i) {
+            vertices[i] = std::move(vertices_[order[i]]);
+            values[i] = values_[order[i]];
+        }
+        vertices_ = std::move(vertices);
+        values_ = std::move(values);
+
+        result_.x = vertices_[0];
+        result_.value = values_[0];
+
+        double spread = 0.0;
+        for (std::size_t i = 1; i < vertices_.size(); ++i) {
+            for (std::size_t j = 0; j < vertices_[i].size(); ++j) {
+                spread = std::max(spread, std::fabs(vertices_[i][j] - vertices_[0][j]));
+            }
+        }
+        if (values_.back() - values_[0] <= options_.tolerance && spread <= std::sqrt(options_.tolerance)) {
+            Finish(true);
+            return;
+        }
+        if (result_.iterations >= options_.max_iterations) {
+            Finish(false);
+            return;
+        }
+        ++result_.iterations;
+
+        const std::size_t n = vertices_[0].size();
+        centroid_.assign(n, 0.0);
+        for (std::size_t i = 0; i + 1 < vertices_.size(); ++i) {
+            for (std::size_t j = 0; j < n; ++j) {
+                centroid_[j] += vertices_[i][j];
+            }
+        }
+        for (double& element : centroid_) {
+            element /= static_cast<double>(n);
+        }
+        Propose(Phase::Reflect, 1.0);
+    }
+
+    // centroid + coefficient * (centroid - worst)
+    void Propose(Phase phase, double coefficient) {
+        const std::vector<double>& worst = vertices_.back();
+        std::vector<double> point(centroid_.size());
+        for (std::size_t j = 0; j < point.size(); ++j) {
+            point[j] = centroid_[j] + coefficient * (centroid_[j] - worst[j]);
+        }
+        phase_ = phase;
+        pending_.assign(1, std::move(point));
+    }
+
+    void Replace(std::vector<double> vertex, double value) {
+        vertices_.back() = std::move(vertex);
+        values_.back() = value;
+        BeginIteration();
+    }
+
+    void Shrink() {
+        pending_.clear();
+        for (std::size_t i = 1; i < vertices_.size(); ++i) {
+            std::vector<double> vertex(vertices_[i].size());
+            for (std::size_t j = 0; j < vertex.size(); ++j) {
+                vertex[j] = vertices_[0][j] + 0.5 * (vertices_[i][j] - vertices_[0][j]);
+            }
+            pending_.push_back(std::move(vertex));
+        }
+        phase_ = Phase::Shrink;
+    }
+
+    Phase phase_ = Phase::Initial;
+    std::vector<std::vector<double>> vertices_;
+    std::vector<double> values_;
+    std::vector<double> centroid_;
+    std::vector<double> reflected_;
+    double reflected_value_ = 0.0;
+};
+
+std::unique_ptr<Optimizer> CreateOptimizer(const OptimizerOptions& options, std::vector<double> start) {
+    switch (options.method) {
+    case OptimizerMethod::GradientDescent:
+        return std::make_unique<GradientDescent>(options, std::move(start));
+    case OptimizerMethod::Lbfgs:
+        return std::make_unique<Lbfgs>(options, std::move(start));
+    case OptimizerMethod::NelderMead:
+        break;
+    }
+    return std::make_unique<NelderMead>(options, std::move(start));
+}
+
+// Runs step(index) for every index in [0, count) on up to one thread per
+// hardware thread, in contiguous slices.
+template <typename Step>
+void ForEachRun(std::size_t count, std::size_t work, Step step) {
+    const std::size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t threads = std::min({hardware, count, std::max<std::size_t>(1, work / kParallelOptimizerThreshold)});
+    if (threads <= 1) {
+        for (std::size_t index = 0; index < count; ++index) {
+            step(index);
+        }
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+    for (std::size_t thread = 0; thread < threads; ++thread) {
+        workers.emplace_back([&, thread]() {
+            for (std::size_t index = count * thread / threads; index < count * (thread + 1) / threads; ++index) {
+                step(index);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+}  // namespace
+
+bool ParseOptimizerMethod(std::string_view name, OptimizerMethod* out_method) {
+    if (name == "gd") {
+        *out_method = OptimizerMethod::GradientDescent;
+    } else if (name == "lbfgs") {
+        *out_method = OptimizerMethod::Lbfgs;
+    } else if (name == "nelder_mead") {
+        *out_method = OptimizerMethod::NelderMead;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool OptimizerNeedsGradient(OptimizerMethod method) {
+    return method != OptimizerMethod::NelderMead;
+}
+
+BatchObjective NumericGradientObjective(BatchObjective objective) {
+    return [objective = std::move(objective)](const std::vector<std::vector<double>>& points,
+                                              std::vector<double>* out_values,
+                                              std::vector<std::vector<double>>* out_gradients,
+                                              std::string* out_error) {
+        if (out_gradients == nullptr) {
+            return objective(points, out_values, nullptr, out_error);
+        }
+
+        // Point p expands to p, p + h_0 e_0, p - h_0 e_0, p + h_1 e_1, ...
+        const double scale = std::cbrt(std::numeric_limits<double>::epsilon());
+        std::vector<std::vector<double>> expanded;
+        std::vector<std::vector<double>> steps(points.size());
+        for (std::size_t p = 0; p < points.size(); ++p) {
+            const std::vector<double>& point = points[p];
+            expanded.push_back(point);
+            steps[p].resize(point.size());
+            for (std::size_t i = 0; i < point.size(); ++i) {
+                const double h = scale * std::max(1.0, std::fabs(point[i]));
+                std::vector<double> forward = point;
+                std::vector<double> backward = point;
+                forward[i] += h;
+                backward[i] -= h;
+                // The step actually taken, after rounding.
+                steps[p][i] = forward[i] - backward[i];
+                expanded.push_back(std::move(forward));
+                expanded.push_back(std::move(backward));
+            }
+        }
+
+        std::vector<double> values;
+        if (!objective(expanded, &values, nullptr, out_error)) {
+            return false;
+        }
+        out_values->resize(points.size());
+        out_gradients->resize(points.size());
+        std::size_t next = 0;
+        for (std::size_t p = 0; p < points.size(); ++p) {
+            (*out_values)[p] = values[next++];
+            std::vector<double>& gradient = (*out_gradients)[p];
+            gradient.resize(points[p].size());
+            for (std::size_t i = 0; i < gradient.size(); ++i) {
+                gradient[i] = (values[next] - values[next + 1]) / steps[p][i];
+                next += 2;
+            }
+        }
+        return true;
+    };
+}
+
+bool Minimize(const OptimizerOptions& options,
+              const std::vector<std::vector<double>>& starts,
+              const BatchObjective& objective,
+              std::vector<OptimizerResult>* out_results,
+              std::string* out_error) {
+    std::vector<std::unique_ptr<Optimizer>> runs;
+    runs.reserve(starts.size());
+    for (const auto& start : starts) {
+        runs.push_back(CreateOptimizer(options, start));
+    }
+    const bool needs_gradient = OptimizerNeedsGradient(options.method);
+    const std::size_t dimension = starts.empty() ? 0 : starts[0].size();
+    const std::size_t work_per_run = dimension * (options.method == OptimizerMethod::Lbfgs ? 4 * options.memory + 4 : 4);
+
+    std::vector<std::vector<double>> points;
+    std::vector<double> values;
+    std::vector<std::vector<double>> gradients;
+    std::vector<std::size_t> active;
+    std::vector<std::size_t> offsets;
+    while (true) {
+        points.clear();
+        active.clear();
+        offsets.clear();
+        for (std::size_t run = 0; run < runs.size(); ++run) {
+            if (runs[run]->Done()) {
+                continue;
+            }
+            active.push_back(run);
+            offsets.push_back(points.size());
+            const auto& pending = runs[run]->Pending();
+            points.insert(points.end(), pending.begin(), pending.end());
+        }
+        if (active.empty()) {
+            break;
+        }
+
+        values.clear();
+        gradients.clear();
+        if (!objective(points, &values, needs_gradient ? &gradients : nullptr, out_error)) {
+            return false;
+        }
+
+        ForEachRun(active.size(), active.size() * work_per_run, [&](std::size_t index) {
+            const std::size_t offset = offsets[index];
+            runs[active[index]]->Tell(values.data() + offset, needs_gradient ? gradients.data() + offset : nullptr);
+        });
+    }
+
+    out_results->clear();
+    out_results->reserve(runs.size());
+    for (const auto& run : runs) {
+        out_results->push_back(run->Result());
+    }
+    return true;
+}
+
+}  // namespace clot::runtime
@@ -0,0 +1,164 @@
+#include "clot/runtime/output.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <streambuf>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace clot::runtime {
+
+namespace {
+
+constexpr std::size_t kStdoutBufferSize = 64 * 1024;
+
+// std::cout's own filebuf ignores pubsetbuf once it is open (libstdc++ keeps
+// its 8 KiB BUFSIZ buffer), so ConfigureStdout swaps in this one: every
+// write(2) it issues is a full 64 KiB block, except on flush.
+class StdoutBuffer : public std::streambuf {
+public:
+    StdoutBuffer() {
+        setp(buffer_, buffer_ + kStdoutBufferSize);
+    }
+
+protected:
+    int_type overflow(int_type ch) override {
+        if (!Drain()) {
+            return traits_type::eof();
+        }
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    std::streamsize xsputn(const char* data, std::streamsize count) override {
+        std::streamsize written = 0;
+        while (written < count) {
+            if (pptr() == epptr() && !Drain()) {
+                return written;
+            }
+            const std::streamsize room = epptr() - pptr();
+            const std::streamsize chunk = count - written < room ? count - written : room;
+            std::memcpy(pptr(), data + written, static_cast<std::size_t>(chunk));
+            pbump(static_cast<int>(chunk));
+            written += chunk;
+        }
+        return written;
+    }
+
+    int sync() override {
+        return Drain() ? 0 : -1;
+    }
+
+private:
+    bool Drain() {
+        const char* next = pbase();
+        while (next < pptr()) {
+#ifdef _WIN32
+            const int result = _write(1, next, static_cast<unsigned int>(pptr() - next));
+#else
+            const ssize_t result = ::write(STDOUT_FILENO, next, static_cast<std::size_t>(pptr() - next));
+#endif
+            if (result < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                setp(buffer_, buffer_ + kStdoutBufferSize);
+                return false;
+            }
+            next += result;
+        }
+        setp(buffer_, buffer_ + kStdoutBufferSize);
+        return true;
+    }
+
+    char buffer_[kStdoutBufferSize];
+};
+
+// Until ConfigureStdout runs (embedders, tests) keep the old per-line flush.
+OutputBuffering g_stdout_mode = OutputBuffering::Line;
+
+bool StdoutIsTerminal() {
+#ifdef _WIN32
+    return _isatty(_fileno(stdout)) != 0;
+#else
+    return isatty(STDOUT_FILENO) != 0;
+#endif
+}
+
+void FlushStdoutAtExit() {
+    std::cout.flush();
+}
+
+}  // namespace
+
+bool ParseOutputBuffering(const std::string& text, OutputBuffering* out_mode) {
+    if (text == "auto") {
+        *out_mode = OutputBuffering::Auto;
+    } else if (text == "line") {
+        *out_mode = OutputBuffering::Line;
+    } else if (text == "block" || text == "full") {
+        *out_mode = OutputBuffering::Block;
+    } else if (text == "none" || text == "unbuffered") {
+        *out_mode = OutputBuffering::None;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void ConfigureStdout(OutputBuffering mode) {
+    if (mode == OutputBuffering::Auto) {
+        mode = StdoutIsTerminal() ? OutputBuffering::Line : OutputBuffering::Block;
+    }
+    g_stdout_mode = mode;
+
+    // Never destroyed: static destructors may still print through std::cout.
+    static StdoutBuffer* const buffer = new StdoutBuffer();
+    if (std::cout.rdbuf() != buffer) {
+        std::cout.flush();
+        std::fflush(stdout);
+        std::ios::sync_with_stdio(false);
+        std::cout.rdbuf(buffer);
+    }
+    if (mode == OutputBuffering::None) {
+        std::cout.setf(std::ios::unitbuf);
+    } else {
+        std::cout.unsetf(std::ios::unitbuf);
+    }
+
+    // Static destructors flush std::cout too, but std::exit from native code
+    // (AOT range checks) must not depend on destruction order.
+    static const bool registered = std::atexit(FlushStdoutAtExit) == 0;
+    (void)registered;
+}
+
+void WriteStdout(std::string_view text) {
+    std::cout.write(text.data(), static_cast<std::streamsize>(text.size()));
+    if (g_stdout_mode == OutputBuffering::Line && text.find('\n') != std::string_view::npos) {
+        std::cout.flush();
+    }
+}
+
+void EndStdoutLine() {
+    std::cout.put('\n');
+    if (g_stdout_mode == OutputBuffering::Line) {
+        std::cout.flush();
+    }
+}
+
+void FlushStdout() {
+    std::cout.flush();
+    std::fflush(stdout);
+}
+
+}  // namespace clot::runtime
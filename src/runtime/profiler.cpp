@@ -0,0 +1,272 @@
+#include "clot/runtime/profiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+
+#include "clot/runtime/i18n.hpp"
+
+namespace clot::runtime {
+
+namespace {
+
+std::uint64_t Elapsed(std::int64_t start_ns, std::int64_t now_ns) {
+    return now_ns > start_ns ? static_cast<std::uint64_t>(now_ns - start_ns) : 0;
+}
+
+std::string Milliseconds(std::uint64_t nanoseconds) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(3) << static_cast<double>(nanoseconds) / 1e6;
+    return out.str();
+}
+
+bool WriteTextFile(const std::string& path, const std::string& text, std::string* out_error) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (file) {
+        file << text;
+    }
+    if (!file) {
+        *out_error = "No se pudo escribir el perfil: " + path;
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+Profiler::Profiler(std::string root_name) {
+    nodes_.push_back(StackNode{});
+    PushFunction(FunctionId(root_name), NowNanoseconds());
+}
+
+std::int64_t Profiler::NowNanoseconds() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+std::size_t Profiler::FunctionId(std::string_view name) {
+    const std::string key(name);
+    const auto found = function_ids_.find(key);
+    if (found != function_ids_.end()) {
+        return found->second;
+    }
+    const std::size_t id = functions_.size();
+    functions_.push_back(FunctionEntry{FunctionStats{key, 0, 0, 0}, 0});
+    function_ids_.emplace(key, id);
+    return id;
+}
+
+void Profiler::PushFunction(std::size_t function, std::int64_t now) {
+    std::size_t node = 0;
+    if (!call_stack_.empty()) {
+        StackNode& parent = nodes_[call_stack_.back().node];
+        const auto child = parent.children.find(function);
+        if (child != parent.children.end()) {
+            node = child->second;
+        } else {
+            node = nodes_.size();
+            parent.children.emplace(function, node);
+            // Invalidates `parent`.
+            nodes_.push_back(StackNode{function, call_stack_.back().node, 0, {}});
+        }
+    } else {
+        nodes_[0].function = function;
+    }
+
+    FunctionEntry& entry = functions_[function];
+    ++entry.stats.calls;
+    ++entry.active;
+    call_stack_.push_back(Frame{function, node, now, 0});
+}
+
+void Profiler::PopFunction(std::int64_t now) {
+    const Frame frame = call_stack_.back();
+    call_stack_.pop_back();
+
+    const std::uint64_t inclusive = Elapsed(frame.start_ns, now);
+    const std::uint64_t exclusive = inclusive > frame.child_ns ? inclusive - frame.child_ns : 0;
+    FunctionEntry& entry = functions_[frame.id];
+    entry.stats.exclusive_ns += exclusive;
+    if (--entry.active == 0) {
+        entry.stats.inclusive_ns += inclusive;
+    }
+    nodes_[frame.node].self_ns += exclusive;
+
+    if (!call_stack_.empty()) {
+        call_stack_.back().child_ns += inclusive;
+    } else {
+        total_ns_ = inclusive;
+    }
+}
+
+void Profiler::PopLine(std::int64_t now) {
+    const Frame frame = line_stack_.back();
+    line_stack_.pop_back();
+
+    const std::uint64_t inclusive = Elapsed(frame.start_ns, now);
+    LineEntry& entry = lines_[frame.id];
+    entry.stats.exclusive_ns += inclusive > frame.child_ns ? inclusive - frame.child_ns : 0;
+    if (--entry.active == 0) {
+        entry.stats.inclusive_ns += inclusive;
+    }
+
+    if (!line_stack_.empty()) {
+        line_stack_.back().child_ns += inclusive;
+    }
+}
+
+void Profiler::EnterFunction(std::string_view name) {
+    if (stopped_) {
+        return;
+    }
+    const std::size_t function = FunctionId(name);
+    PushFunction(function, NowNanoseconds());
+}
+
+void Profiler::LeaveFunction() {
+    // The root frame is only closed by Stop().
+    if (stopped_ || call_stack_.size() <= 1) {
+        return;
+    }
+    PopFunction(NowNanoseconds());
+}
+
+void Profiler::EnterLine(std::size_t line) {
+    if (stopped_) {
+        return;
+    }
+    const std::size_t function = call_stack_.back().id;
+    const std::uint64_t key = (static_cast<std::uint64_t>(function) << 32) ^ static_cast<std::uint64_t>(line);
+    std::size_t id = 0;
+    const auto found = line_ids_.find(key);
+    if (found != line_ids_.end()) {
+        id = found->second;
+    } else {
+        id = lines_.size();
+        lines_.push_back(LineEntry{LineStats{functions_[function].stats.name, line, 0, 0, 0}, 0});
+        line_ids_.emplace(key, id);
+    }
+
+    LineEntry& entry = lines_[id];
+    ++entry.stats.hits;
+    ++entry.active;
+    line_stack_.push_back(Frame{id, 0, NowNanoseconds(), 0});
+}
+
+void Profiler::LeaveLine() {
+    if (stopped_ || line_stack_.empty()) {
+        return;
+    }
+    PopLine(NowNanoseconds());
+}
+
+void Profiler::Stop() {
+    if (stopped_) {
+        return;
+    }
+    const std::int64_t now = NowNanoseconds();
+    while (!line_stack_.empty()) {
+        PopLine(now);
+    }
+    while (!call_stack_.empty()) {
+        PopFunction(now);
+    }
+    stopped_ = true;
+}
+
+std::vector<Profiler::FunctionStats> Profiler::Functions() const {
+    std::vector<FunctionStats> result;
+    result.reserve(functions_.size());
+    for (const FunctionEntry& entry : functions_) {
+        result.push_back(entry.stats);
+    }
+    std::stable_sort(result.begin(), result.end(), [](const FunctionStats& lhs, const FunctionStats& rhs) {
+        return lhs.exclusive_ns > rhs.exclusive_ns;
+    });
+    return result;
+}
+
+std::vector<Profiler::LineStats> Profiler::Lines() const {
+    std::vector<LineStats> result;
+    result.reserve(lines_.size());
+    for (const LineEntry& entry : lines_) {
+        result.push_back(entry.stats);
+    }
+    std::stable_sort(result.begin(), result.end(), [](const LineStats& lhs, const LineStats& rhs) {
+        return lhs.exclusive_ns > rhs.exclusive_ns;
+    });
+    return result;
+}
+
+std::string Profiler::CollapsedStacks() const {
+    std::vector<std::string> stacks;
+    for (std::size_t index = 0; index < nodes_.size(); ++index) {
+        const std::uint64_t microseconds = nodes_[index].self_ns / 1000;
+        if (microseconds == 0) {
+            continue;
+        }
+
+        std::vector<std::size_t> path;
+        for (std::size_t node = index;; node = nodes_[node].parent) {
+            path.push_back(nodes_[node].function);
+            if (node == 0) {
+                break;
+            }
+        }
+
+        std::string stack;
+        for (auto it = path.rbegin(); it != path.rend(); ++it) {
+            if (!stack.empty()) {
+                stack += ';';
+            }
+            // ';' separates frames and the last space starts the weight.
+            for (const char c : functions_[*it].stats.name) {
+                stack += (c == ';' || c == ' ') ? '_' : c;
+            }
+        }
+        stacks.push_back(stack + " " + std::to_string(microseconds));
+    }
+
+    std::sort(stacks.begin(), stacks.end());
+    std::string text;
+    for (const std::string& stack : stacks) {
+        text += stack;
+        text += '\n';
+    }
+    return text;
+}
+
+std::string Profiler::Summary() const {
+    std::ostringstream out;
+    out << Tr("Perfil de ejecucion: ", "Execution profile: ") << Milliseconds(total_ns_) << " ms\n\n";
+
+    out << Tr("Funciones por tiempo exclusivo:\n", "Functions by exclusive time:\n");
+    out << std::setw(14) << Tr("excl. ms", "excl. ms") << std::setw(14) << Tr("incl. ms", "incl. ms")
+        << std::setw(12) << Tr("llamadas", "calls") << "  " << Tr("funcion", "function") << "\n";
+    for (const FunctionStats& function : Functions()) {
+        out << std::setw(14) << Milliseconds(function.exclusive_ns) << std::setw(14)
+            << Milliseconds(function.inclusive_ns) << std::setw(12) << function.calls << "  " << function.name
+            << "\n";
+    }
+
+    out << "\n" << Tr("Lineas por tiempo exclusivo:\n", "Lines by exclusive time:\n");
+    out << std::setw(14) << Tr("excl. ms", "excl. ms") << std::setw(14) << Tr("incl. ms", "incl. ms")
+        << std::setw(12) << Tr("veces", "hits") << "  " << Tr("funcion:linea", "function:line") << "\n";
+    for (const LineStats& line : Lines()) {
+        out << std::setw(14) << Milliseconds(line.exclusive_ns) << std::setw(14) << Milliseconds(line.inclusive_ns)
+            << std::setw(12) << line.hits << "  " << line.function << ":" << line.line << "\n";
+    }
+    return out.str();
+}
+
+bool Profiler::WriteReports(const std::string& prefix, std::string* out_error) {
+    Stop();
+    return WriteTextFile(prefix + ".folded", CollapsedStacks(), out_error) &&
+           WriteTextFile(prefix + ".txt", Summary(), out_error);
+}
+
+}  // namespace clot::runtime
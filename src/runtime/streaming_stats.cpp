@@ -0,0 +1,457 @@
+#include "clot/runtime/streaming_stats.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include "clot/runtime/text_search.hpp"
+
+namespace clot::runtime {
+
+namespace {
+
+// Fewest samples worth giving a thread of its own.
+constexpr std::size_t kParallelStatsThreshold = std::size_t{1} << 16;
+
+// File block size, and the fewest bytes worth giving a thread of its own.
+constexpr std::size_t kFileBlockSize = std::size_t{1} << 20;
+
+std::size_t ChunkCount(std::size_t work, std::size_t threshold) {
+    const std::size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    return std::max<std::size_t>(1, std::min(hardware, work / threshold));
+}
+
+// Runs fill(begin, end, partial) over `chunks` equal slices of [0, count), on
+// one thread per slice, and merges the partials in slice order.
+template <typename Fill>
+StatsAggregate RunChunks(std::size_t count, std::size_t chunks, const StatsRequest& request, Fill fill) {
+    std::vector<StatsAggregate> partials(chunks, StatsAggregate(request));
+    if (chunks == 1) {
+        fill(0, count, &partials[0]);
+        return std::move(partials[0]);
+    }
+
+    std::vector<std::thread> workers;
+    workers.reserve(chunks);
+    for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+        workers.emplace_back([&, chunk]() {
+            fill(count * chunk / chunks, count * (chunk + 1) / chunks, &partials[chunk]);
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    for (std::size_t chunk = 1; chunk < chunks; ++chunk) {
+        partials[0].Merge(partials[chunk]);
+    }
+    return std::move(partials[0]);
+}
+
+// Yields the lines of a file from a byte offset, reading it in blocks. A line
+// longer than the buffer grows it.
+class LineReader {
+public:
+    LineReader(std::ifstream* stream, std::uint64_t position)
+        : stream_(stream), buffer_(kFileBlockSize), position_(position) {}
+
+    // Next line without its '\n'; `out_start` is the file offset of its first
+    // byte. The view is valid until the next call.
+    bool Next(std::string_view* out_line, std::uint64_t* out_start) {
+        while (true) {
+            const std::string_view pending(buffer_.data() + begin_, end_ - begin_);
+            const std::size_t newline = FindByte(pending, '\n');
+            if (newline != std::string_view::npos || (eof_ && !pending.empty())) {
+                const std::size_t length = newline == std::string_view::npos ? pending.size() : newline;
+                const std::size_t consumed = newline == std::string_view::npos ? length : length + 1;
+                *out_line = pending.substr(0, length);
+                *out_start = position_;
+                position_ += consumed;
+                begin_ += consumed;
+                return true;
+            }
+            if (eof_) {
+                return false;
+            }
+
+            std::memmove(buffer_.data(), buffer_.data() + begin_, end_ - begin_);
+            end_ -= begin_;
+            begin_ = 0;
+            if (end_ == buffer_.size()) {
+                buffer_.resize(buffer_.size() * 2);
+            }
+            stream_->read(buffer_.data() + end_, static_cast<std::streamsize>(buffer_.size() - end_));
+            const auto received = static_cast<std::size_t>(stream_->gcount());
+            eof_ = received == 0;
+            end_ += received;
+        }
+    }
+
+private:
+    std::ifstream* stream_;
+    std::vector<char> buffer_;
+    std::size_t begin_ = 0;
+    std::size_t end_ = 0;
+    std::uint64_t position_;
+    bool eof_ = false;
+};
+
+bool ParseSample(std::string_view text, double* out_value) {
+    while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && (text.back() == ' ' || text.back() == '\t')) {
+        text.remove_suffix(1);
+    }
+    if (!text.empty() && text.front() == '+') {
+        text.remove_prefix(1);
+    }
+    if (text.empty()) {
+        return false;
+    }
+    const auto result = std::from_chars(text.data(), text.data() + text.size(), *out_value);
+    return result.ec == std::errc() && result.ptr == text.data() + text.size();
+}
+
+void AddLine(std::string_view line, std::ptrdiff_t column, char delimiter, StatsAggregate* aggregate) {
+    if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+    }
+    if (line.find_first_not_of(" \t") == std::string_view::npos) {
+        return;
+    }
+
+    double value = 0.0;
+    if (column < 0) {
+        std::size_t start = 0;
+        while (start < line.size()) {
+            const std::size_t stop = std::min(line.find_first_of(" \t,;", start), line.size());
+            if (stop > start) {
+                if (ParseSample(line.substr(start, stop - start), &value)) {
+                    aggregate->Add(value);
+                } else {
+                    aggregate->AddSkipped(1);
+                }
+            }
+            start = stop + 1;
+        }
+        return;
+    }
+
+    std::size_t start = 0;
+    for (std::ptrdiff_t field = 0; field < column; ++field) {
+        const std::size_t stop = line.find(delimiter, start);
+        if (stop == std::string_view::npos) {
+            aggregate->AddSkipped(1);
+            return;
+        }
+        start = stop + 1;
+    }
+    const std::size_t stop = std::min(line.find(delimiter, start), line.size());
+    if (ParseSample(line.substr(start, stop - start), &value)) {
+        aggregate->Add(value);
+    } else {
+        aggregate->AddSkipped(1);
+    }
+}
+
+// Adds every line that starts in [begin, end). A range that starts mid-line
+// leaves that line to the previous range, which reads past its own end to
+// finish it.
+bool AddFileRange(const std::string& path,
+                  std::uint64_t begin,
+                  std::uint64_t end,
+                  std::ptrdiff_t column,
+                  char delimiter,
+                  StatsAggregate* aggregate) {
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream) {
+        return false;
+    }
+    const std::uint64_t first = begin == 0 ? 0 : begin - 1;
+    stream.seekg(static_cast<std::streamoff>(first));
+    LineReader reader(&stream, first);
+    std::string_view line;
+    std::uint64_t line_start = 0;
+    if (begin != 0 && !reader.Next(&line, &line_start)) {
+        return true;
+    }
+    while (reader.Next(&line, &line_start) && line_start < end) {
+        AddLine(line, column, delimiter, aggregate);
+    }
+    return true;
+}
+
+}  // namespace
+
+void RunningStats::Add(double value) {
+    if (std::isnan(value)) {
+        saw_nan_ = true;
+    }
+    if (count_ == 0) {
+        min_ = value;
+        max_ = value;
+    } else {
+        min_ = value < min_ ? value : min_;
+        max_ = value > max_ ? value : max_;
+    }
+
+    const double total = sum_ + value;
+    if (std::fabs(sum_) >= std::fabs(value)) {
+        compensation_ += (sum_ - total) + value;
+    } else {
+        compensation_ += (value - total) + sum_;
+    }
+    sum_ = total;
+
+    ++count_;
+    const double delta = value - mean_;
+    mean_ += delta / static_cast<double>(count_);
+    m2_ += delta * (value - mean_);
+}
+
+void RunningStats::Merge(const RunningStats& other) {
+    if (other.count_ == 0) {
+        return;
+    }
+    if (count_ == 0) {
+        *this = other;
+        return;
+    }
+
+    const auto left = static_cast<double>(count_);
+    const auto right = static_cast<double>(other.count_);
+    const double total_count = left + right;
+    const double delta = other.mean_ - mean_;
+    mean_ += delta * right / total_count;
+    m2_ += other.m2_ + delta * delta * left * right / total_count;
+    count_ += other.count_;
+
+    const double total = sum_ + other.sum_;
+    if (std::fabs(sum_) >= std::fabs(other.sum_)) {
+        compensation_ += (sum_ - total) + other.sum_;
+    } else {
+        compensation_ += (other.sum_ - total) + sum_;
+    }
+    sum_ = total;
+    compensation_ += other.compensation_;
+
+    min_ = other.min_ < min_ ? other.min_ : min_;
+    max_ = other.max_ > max_ ? other.max_ : max_;
+    saw_nan_ = saw_nan_ || other.saw_nan_;
+}
+
+double RunningStats::Variance() const {
+    return count_ < 2 ? 0.0 : m2_ / static_cast<double>(count_ - 1);
+}
+
+double RunningStats::Min() const {
+    return saw_nan_ ? std::numeric_limits<double>::quiet_NaN() : min_;
+}
+
+double RunningStats::Max() const {
+    return saw_nan_ ? std::numeric_limits<double>::quiet_NaN() : max_;
+}
+
+FixedHistogram::FixedHistogram(std::size_t bins, double low, double high)
+    : counts_(bins, 0), low_(low), high_(high), scale_(static_cast<double>(bins) / (high - low)) {}
+
+void FixedHistogram::Add(double value) {
+    if (!(value >= low_ && value <= high_)) {
+        if (value < low_) {
+            ++underflow_;
+        } else {
+            ++overflow_;
+        }
+        return;
+    }
+    const auto bin = static_cast<std::size_t>((value - low_) * scale_);
+    ++counts_[std::min(bin, counts_.size() - 1)];
+}
+
+void FixedHistogram::Merge(const FixedHistogram& other) {
+    for (std::size_t bin = 0; bin < counts_.size() && bin < other.counts_.size(); ++bin) {
+        counts_[bin] += other.counts_[bin];
+    }
+    underflow_ += other.underflow_;
+    overflow_ += other.overflow_;
+}
+
+QuantileSketch::QuantileSketch(double relative_accuracy)
+    : gamma_((1.0 + relative_accuracy) / (1.0 - relative_accuracy)), log_gamma_(std::log(gamma_)) {}
+
+void QuantileSketch::Store::Add(int index, std::uint64_t count) {
+    if (counts.empty()) {
+        offset = index;
+        counts.push_back(0);
+    } else if (index < offset) {
+        counts.insert(counts.begin(), static_cast<std::size_t>(offset - index), 0);
+        offset = index;
+    } else if (index >= offset + static_cast<int>(counts.size())) {
+        counts.resize(static_cast<std::size_t>(index - offset) + 1, 0);
+    }
+    counts[static_cast<std::size_t>(index - offset)] += count;
+    total += count;
+}
+
+int QuantileSketch::BucketIndex(double magnitude) const {
+    return static_cast<int>(std::ceil(std::log(magnitude) / log_gamma_));
+}
+
+// Midpoint (in relative terms) of bucket (gamma^(i-1), gamma^i].
+double QuantileSketch::BucketValue(int index) const {
+    return 2.0 * std::pow(gamma_, index) / (gamma_ + 1.0);
+}
+
+void QuantileSketch::Add(double value) {
+    if (!std::isfinite(value)) {
+        return;
+    }
+    const double magnitude = std::fabs(value);
+    if (magnitude < std::numeric_limits<double>::min()) {
+        ++zero_count_;
+    } else if (value > 0) {
+        positive_.Add(BucketIndex(magnitude), 1);
+    } else {
+        negative_.Add(BucketIndex(magnitude), 1);
+    }
+}
+
+void QuantileSketch::Merge(const QuantileSketch& other) {
+    for (std::size_t bucket = 0; bucket < other.positive_.counts.size(); ++bucket) {
+        if (other.positive_.counts[bucket] != 0) {
+            positive_.Add(other.positive_.offset + static_cast<int>(bucket), other.positive_.counts[bucket]);
+        }
+    }
+    for (std::size_t bucket = 0; bucket < other.negative_.counts.size(); ++bucket) {
+        if (other.negative_.counts[bucket] != 0) {
+            negative_.Add(other.negative_.offset + static_cast<int>(bucket), other.negative_.counts[bucket]);
+        }
+    }
+    zero_count_ += other.zero_count_;
+}
+
+double QuantileSketch::Quantile(double quantile) const {
+    const std::uint64_t count = Count();
+    if (count == 0) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    const double rank = quantile * static_cast<double>(count - 1);
+    double seen = 0.0;
+    // Most negative values first: the largest magnitudes of the negative store.
+    for (std::size_t bucket = negative_.counts.size(); bucket-- > 0;) {
+        seen += static_cast<double>(negative_.counts[bucket]);
+        if (seen > rank) {
+            return -BucketValue(negative_.offset + static_cast<int>(bucket));
+        }
+    }
+    seen += static_cast<double>(zero_count_);
+    if (seen > rank) {
+        return 0.0;
+    }
+    for (std::size_t bucket = 0; bucket < positive_.counts.size(); ++bucket) {
+        seen += static_cast<double>(positive_.counts[bucket]);
+        if (seen > rank) {
+            return BucketValue(positive_.offset + static_cast<int>(bucket));
+        }
+    }
+    if (!positive_.counts.empty()) {
+        return BucketValue(positive_.offset + static_cast<int>(positive_.counts.size()) - 1);
+    }
+    return 0.0;
+}
+
+StatsAggregate::StatsAggregate(const StatsRequest& request)
+    : request_(request), sketch_(request.relative_accuracy) {
+    if (request.histogram) {
+        histogram_ = FixedHistogram(request.bins, request.low, request.high);
+    }
+}
+
+void StatsAggregate::Add(double value) {
+    summary_.Add(value);
+    if (request_.histogram) {
+        histogram_.Add(value);
+    }
+    if (request_.quantiles) {
+        sketch_.Add(value);
+    }
+}
+
+void StatsAggregate::Merge(const StatsAggregate& other) {
+    summary_.Merge(other.summary_);
+    histogram_.Merge(other.histogram_);
+    sketch_.Merge(other.sketch_);
+    skipped_ += other.skipped_;
+}
+
+double StatsAggregate::Quantile(double quantile) const {
+    const double estimate = sketch_.Quantile(quantile);
+    if (std::isnan(estimate) || std::isnan(summary_.Min())) {
+        return estimate;
+    }
+    return std::clamp(estimate, summary_.Min(), summary_.Max());
+}
+
+StatsAggregate AggregateValues(const double* values, std::size_t count, const StatsRequest& request) {
+    return RunChunks(count,
+                     ChunkCount(count, kParallelStatsThreshold),
+                     request,
+                     [values](std::size_t begin, std::size_t end, StatsAggregate* partial) {
+                         for (std::size_t index = begin; index < end; ++index) {
+                             partial->Add(values[index]);
+                         }
+                     });
+}
+
+StatsAggregate AggregateSequence(double start, double step, std::size_t count, const StatsRequest& request) {
+    return RunChunks(count,
+                     ChunkCount(count, kParallelStatsThreshold),
+                     request,
+                     [start, step](std::size_t begin, std::size_t end, StatsAggregate* partial) {
+                         for (std::size_t index = begin; index < end; ++index) {
+                             partial->Add(start + step * static_cast<double>(index));
+                         }
+                     });
+}
+
+bool AggregateFile(const std::string& path,
+                   std::ptrdiff_t column,
+                   char delimiter,
+                   const StatsRequest& request,
+                   StatsAggregate* out_aggregate,
+                   std::string* out_error) {
+    std::error_code error;
+    const std::uintmax_t size = std::filesystem::file_size(path, error);
+    if (error || !std::ifstream(path, std::ios::binary)) {
+        *out_error = "No se pudo abrir el archivo: " + path;
+        return false;
+    }
+
+    std::atomic<bool> opened = true;
+    const auto bytes = static_cast<std::size_t>(size);
+    StatsAggregate result = RunChunks(bytes,
+                                      ChunkCount(bytes, kFileBlockSize),
+                                      request,
+                                      [&](std::size_t begin, std::size_t end, StatsAggregate* partial) {
+                                          if (!AddFileRange(path, begin, end, column, delimiter, partial)) {
+                                              opened.store(false);
+                                          }
+                                      });
+    if (!opened.load()) {
+        *out_error = "No se pudo abrir el archivo: " + path;
+        return false;
+    }
+    *out_aggregate = std::move(result);
+    return true;
+}
+
+}  // namespace clot::runtime
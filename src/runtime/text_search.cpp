@@ -0,0 +1,212 @@
+#include "clot/runtime/text_search.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "clot/runtime/env.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || (defined(__i386__) && defined(__SSE2__))
+#define CLOT_TEXT_SEARCH_SSE2 1
+#include <emmintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define CLOT_TEXT_SEARCH_AVX2 1
+#include <immintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+namespace clot::runtime {
+
+namespace {
+
+constexpr std::size_t kNotFound = std::string_view::npos;
+
+// Bytes of the needle between its first and last byte; those two are already
+// known to match when a SIMD candidate is verified.
+std::size_t InnerLength(std::string_view needle) {
+    return needle.size() >= 2 ? needle.size() - 2 : 0;
+}
+
+std::size_t ScalarFindByte(const char* data, std::size_t size, char needle, std::size_t from) {
+    if (from >= size) {
+        return kNotFound;
+    }
+    const void* hit = std::memchr(data + from, needle, size - from);
+    return hit == nullptr ? kNotFound : static_cast<std::size_t>(static_cast<const char*>(hit) - data);
+}
+
+std::size_t ScalarFindSubstring(const char* data, std::size_t size, std::string_view needle, std::size_t from) {
+    const std::size_t length = needle.size();
+    while (from + length <= size) {
+        const std::size_t hit = ScalarFindByte(data, size - length + 1, needle.front(), from);
+        if (hit == kNotFound) {
+            return kNotFound;
+        }
+        if (std::memcmp(data + hit + 1, needle.data() + 1, length - 1) == 0) {
+            return hit;
+        }
+        from = hit + 1;
+    }
+    return kNotFound;
+}
+
+#ifdef CLOT_TEXT_SEARCH_SSE2
+
+unsigned CountTrailingZeros(std::uint32_t mask) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index = 0;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+
+std::size_t Sse2FindByte(const char* data, std::size_t size, char needle, std::size_t from) {
+    const __m128i pattern = _mm_set1_epi8(needle);
+    std::size_t index = from;
+    for (; index + 16 <= size; index += 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + index));
+        const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, pattern)));
+        if (mask != 0) {
+            return index + CountTrailingZeros(mask);
+        }
+    }
+    return ScalarFindByte(data, size, needle, index);
+}
+
+// Compares the needle's first and last byte against 16 positions at once and
+// only runs memcmp where both line up, which rejects almost every position.
+std::size_t Sse2FindSubstring(const char* data, std::size_t size, std::string_view needle, std::size_t from) {
+    const std::size_t last_offset = needle.size() - 1;
+    const __m128i first = _mm_set1_epi8(needle.front());
+    const __m128i last = _mm_set1_epi8(needle.back());
+    std::size_t index = from;
+    for (; index + last_offset + 16 <= size; index += 16) {
+        const __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + index));
+        const __m128i block_last = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + index + last_offset));
+        auto mask = static_cast<std::uint32_t>(
+            _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(block_first, first), _mm_cmpeq_epi8(block_last, last))));
+        while (mask != 0) {
+            const std::size_t candidate = index + CountTrailingZeros(mask);
+            if (std::memcmp(data + candidate + 1, needle.data() + 1, InnerLength(needle)) == 0) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+    return ScalarFindSubstring(data, size, needle, index);
+}
+
+#endif  // CLOT_TEXT_SEARCH_SSE2
+
+#ifdef CLOT_TEXT_SEARCH_AVX2
+
+__attribute__((target("avx2"))) std::size_t Avx2FindByte(const char* data,
+                                                         std::size_t size,
+                                                         char needle,
+                                                         std::size_t from) {
+    const __m256i pattern = _mm256_set1_epi8(needle);
+    std::size_t index = from;
+    for (; index + 32 <= size; index += 32) {
+        const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + index));
+        const auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, pattern)));
+        if (mask != 0) {
+            return index + CountTrailingZeros(mask);
+        }
+    }
+    return Sse2FindByte(data, size, needle, index);
+}
+
+__attribute__((target("avx2"))) std::size_t Avx2FindSubstring(const char* data,
+                                                              std::size_t size,
+                                                              std::string_view needle,
+                                                              std::size_t from) {
+    const std::size_t last_offset = needle.size() - 1;
+    const __m256i first = _mm256_set1_epi8(needle.front());
+    const __m256i last = _mm256_set1_epi8(needle.back());
+    std::size_t index = from;
+    for (; index + last_offset + 32 <= size; index += 32) {
+        const __m256i block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + index));
+        const __m256i block_last = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + index + last_offset));
+        auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(block_first, first), _mm256_cmpeq_epi8(block_last, last))));
+        while (mask != 0) {
+            const std::size_t candidate = index + CountTrailingZeros(mask);
+            if (std::memcmp(data + candidate + 1, needle.data() + 1, InnerLength(needle)) == 0) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+    return Sse2FindSubstring(data, size, needle, index);
+}
+
+#endif  // CLOT_TEXT_SEARCH_AVX2
+
+struct SearchKernels {
+    std::size_t (*find_byte)(const char*, std::size_t, char, std::size_t);
+    std::size_t (*find_substring)(const char*, std::size_t, std::string_view, std::size_t);
+};
+
+// Picked once per process. CLOT_TEXT_SEARCH=scalar|sse2 caps the kernel, which
+// lets the fallbacks be exercised on machines that have AVX2.
+const SearchKernels& Kernels() {
+    static const SearchKernels kernels = []() {
+        const std::string requested = GetEnvVar("CLOT_TEXT_SEARCH").value_or("");
+        if (requested == "scalar") {
+            return SearchKernels{ScalarFindByte, ScalarFindSubstring};
+        }
+#ifdef CLOT_TEXT_SEARCH_AVX2
+        if (requested != "sse2" && __builtin_cpu_supports("avx2")) {
+            return SearchKernels{Avx2FindByte, Avx2FindSubstring};
+        }
+#endif
+#ifdef CLOT_TEXT_SEARCH_SSE2
+        return SearchKernels{Sse2FindByte, Sse2FindSubstring};
+#else
+        return SearchKernels{ScalarFindByte, ScalarFindSubstring};
+#endif
+    }();
+    return kernels;
+}
+
+}  // namespace
+
+std::size_t FindByte(std::string_view haystack, char needle, std::size_t from) {
+    if (from >= haystack.size()) {
+        return kNotFound;
+    }
+    return Kernels().find_byte(haystack.data(), haystack.size(), needle, from);
+}
+
+std::size_t FindSubstring(std::string_view haystack, std::string_view needle, std::size_t from) {
+    if (from > haystack.size() || needle.size() > haystack.size() - from) {
+        return kNotFound;
+    }
+    if (needle.empty()) {
+        return from;
+    }
+    if (needle.size() == 1) {
+        return FindByte(haystack, needle.front(), from);
+    }
+    return Kernels().find_substring(haystack.data(), haystack.size(), needle, from);
+}
+
+std::size_t CountSubstring(std::string_view haystack, std::string_view needle) {
+    if (needle.empty()) {
+        return 0;
+    }
+    std::size_t count = 0;
+    std::size_t position = FindSubstring(haystack, needle, 0);
+    while (position != kNotFound) {
+        ++count;
+        position = FindSubstring(haystack, needle, position + needle.size());
+    }
+    return count;
+}
+
+}  // namespace clot::runtime
@@ -0,0 +1,44 @@
+#include "clot/runtime/timing.hpp"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#include <time.h>
+#endif
+
+namespace clot::runtime {
+
+std::optional<std::uint64_t> ProcessCpuNanoseconds() {
+#if defined(_WIN32)
+    FILETIME creation{};
+    FILETIME exit{};
+    FILETIME kernel{};
+    FILETIME user{};
+    if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user)) {
+        return std::nullopt;
+    }
+    // FILETIME counts 100 ns ticks.
+    const auto ticks = [](const FILETIME& time) {
+        return (static_cast<std::uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+    };
+    return (ticks(kernel) + ticks(user)) * 100;
+#elif defined(CLOCK_PROCESS_CPUTIME_ID)
+    timespec now{};
+    if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now) != 0) {
+        return std::nullopt;
+    }
+    return static_cast<std::uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<std::uint64_t>(now.tv_nsec);
+#else
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return std::nullopt;
+    }
+    const auto micros = [](const timeval& time) {
+        return static_cast<std::uint64_t>(time.tv_sec) * 1000000ULL + static_cast<std::uint64_t>(time.tv_usec);
+    };
+    return (micros(usage.ru_utime) + micros(usage.ru_stime)) * 1000;
+#endif
+}
+
+}  // namespace clot::runtime
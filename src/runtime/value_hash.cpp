@@ -0,0 +1,149 @@
+#include "clot/runtime/value_hash.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace clot::runtime {
+
+namespace {
+
+std::uint64_t HashMix(std::uint64_t seed, std::uint64_t value) {
+    seed ^= value + 0x9E3779B97F4A7C15ULL + (seed << 6U) + (seed >> 2U);
+    return seed;
+}
+
+std::uint64_t HashBytes(std::string_view text) {
+    std::uint64_t hash = 1469598103934665603ULL;
+    for (unsigned char ch : text) {
+        hash ^= static_cast<std::uint64_t>(ch);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+std::uint64_t HashValueAt(const Value& value, int depth) {
+    if (depth > 128) {
+        return 0xDEADBEEFCAFEBABEULL;
+    }
+
+    if (value.IsNull()) {
+        return 0x0100000000000000ULL;
+    }
+
+    if (value.IsBool()) {
+        return value.AsBool() ? 0x0200000000000001ULL : 0x0200000000000000ULL;
+    }
+
+    if (value.IsNumber()) {
+        Value::BigInt integer;
+        if (value.AsBigInt(&integer)) {
+            std::uint64_t hash = 0x0300000000000000ULL;
+            hash = HashMix(hash, HashBytes(integer.convert_to<std::string>()));
+            return hash;
+        }
+
+        Value::Decimal decimal;
+        if (value.AsDecimal(&decimal)) {
+            std::uint64_t hash = 0x0300000000000001ULL;
+            hash = HashMix(hash, HashBytes(decimal.ToString()));
+            return hash;
+        }
+
+        bool ok = false;
+        const double numeric = value.AsNumber(&ok);
+        std::uint64_t hash = 0x0300000000000002ULL;
+        if (ok) {
+            std::uint64_t bits = 0;
+            std::memcpy(&bits, &numeric, sizeof(bits));
+            hash = HashMix(hash, bits);
+        }
+        return hash;
+    }
+
+    if (value.IsChar()) {
+        const char character = *value.AsCharValue();
+        std::uint64_t hash = 0x0400000000000000ULL;
+        hash = HashMix(hash, static_cast<std::uint64_t>(static_cast<unsigned char>(character)));
+        return hash;
+    }
+
+    if (value.IsString()) {
+        std::uint64_t hash = 0x0500000000000000ULL;
+        hash = HashMix(hash, HashBytes(value.ToString()));
+        return hash;
+    }
+
+    if (const auto* list = value.AsList()) {
+        std::uint64_t hash = 0x0600000000000000ULL;
+        for (const auto& element : *list) {
+            hash = HashMix(hash, HashValueAt(element, depth + 1));
+        }
+        return hash;
+    }
+
+    if (const auto* tuple = value.AsTuple()) {
+        std::uint64_t hash = 0x0700000000000000ULL;
+        for (const auto& element : *tuple) {
+            hash = HashMix(hash, HashValueAt(element, depth + 1));
+        }
+        return hash;
+    }
+
+    if (const auto* set = value.AsSet()) {
+        std::vector<std::uint64_t> members;
+        members.reserve(set->size());
+        for (const auto& element : *set) {
+            members.push_back(HashValueAt(element, depth + 1));
+        }
+        std::sort(members.begin(), members.end());
+
+        std::uint64_t hash = 0x0800000000000000ULL;
+        for (const std::uint64_t member_hash : members) {
+            hash = HashMix(hash, member_hash);
+        }
+        return hash;
+    }
+
+    if (const auto* map = value.AsMap()) {
+        std::vector<std::uint64_t> entries;
+        entries.reserve(map->size());
+        for (const auto& entry : *map) {
+            std::uint64_t entry_hash = 0x0900000000000000ULL;
+            entry_hash = HashMix(entry_hash, HashValueAt(entry.first, depth + 1));
+            entry_hash = HashMix(entry_hash, HashValueAt(entry.second, depth + 1));
+            entries.push_back(entry_hash);
+        }
+        std::sort(entries.begin(), entries.end());
+
+        std::uint64_t hash = 0x0900000000000001ULL;
+        for (const std::uint64_t entry_hash : entries) {
+            hash = HashMix(hash, entry_hash);
+        }
+        return hash;
+    }
+
+    if (const auto* object = value.AsObject()) {
+        std::uint64_t hash = 0x0A00000000000000ULL;
+        for (const auto& entry : *object) {
+            hash = HashMix(hash, HashBytes(entry.first));
+            hash = HashMix(hash, HashValueAt(entry.second, depth + 1));
+        }
+        return hash;
+    }
+
+    const Value::FunctionRef* function = value.AsFunctionRefValue();
+    std::uint64_t hash = 0x0B00000000000000ULL;
+    hash = HashMix(hash, HashBytes(function != nullptr ? function->name : value.ToString()));
+    return hash;
+}
+
+}  // namespace
+
+std::uint64_t HashValue(const Value& value) {
+    return HashValueAt(value, 0);
+}
+
+}  // namespace clot::runtime
@@ -0,0 +1,858 @@
+#include "clot/serve/server.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "clot/frontend/parser.hpp"
+#include "clot/interpreter/interpreter.hpp"
+#include "clot/interpreter/module_cache.hpp"
+#include "clot/runtime/env.hpp"
+#include "clot/runtime/i18n.hpp"
+
+#ifndef _WIN32
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace clot::serve {
+
+std::string DefaultSocketPath() {
+    if (const auto env_socket = runtime::GetEnvVar("CLOT_SERVE_SOCKET"); env_socket && !env_socket->empty()) {
+        return *env_socket;
+    }
+#ifdef _WIN32
+    return "clot.sock";
+#else
+    if (const auto runtime_dir = runtime::GetEnvVar("XDG_RUNTIME_DIR"); runtime_dir && !runtime_dir->empty()) {
+        return (std::filesystem::path(*runtime_dir) / "clot.sock").string();
+    }
+    return "/tmp/clot-" + std::to_string(static_cast<unsigned long>(getuid())) + ".sock";
+#endif
+}
+
+#ifdef _WIN32
+
+bool RunServer(const ServerOptions&, std::string* out_error) {
+    *out_error = "clot serve requiere sockets Unix (POSIX).";
+    return false;
+}
+
+bool RunOnServer(
+    const std::string&,
+    const std::string&,
+    runtime::OutputBuffering,
+    const interpreter::Interpreter::ResourceLimits&,
+    int*,
+    std::string* out_error) {
+    *out_error = "clot serve requiere sockets Unix (POSIX).";
+    return false;
+}
+
+bool StopServer(const std::string&, std::string* out_error) {
+    *out_error = "clot serve requiere sockets Unix (POSIX).";
+    return false;
+}
+
+#else
+
+namespace {
+
+// A request is a native-endian uint32 length followed by NUL-separated fields:
+//   run  <cwd> <script> <language> <output buffering>
+//        <max heap bytes> <max wall ms> <max statements>   (stdin/stdout/stderr attached)
+//   stop
+// The reply is the exit code in decimal; the server then closes the connection.
+constexpr std::uint32_t kMaxRequestBytes = 64 * 1024;
+constexpr int kForwardedDescriptors = 3;
+// A client has this long to send its whole request after connecting; one that
+// stays silent is dropped instead of holding a slot.
+constexpr auto kRequestTimeout = std::chrono::seconds(5);
+// Past this many runs in flight the listener waits for one to finish.
+constexpr std::size_t kMaxRunningRequests = 64;
+
+int g_signal_pipe[2] = {-1, -1};
+
+void OnStopSignal(int) {
+    const char byte = 1;
+    const ssize_t ignored = write(g_signal_pipe[1], &byte, 1);
+    (void)ignored;
+}
+
+void SetCloseOnExec(int fd) {
+    const int flags = fcntl(fd, F_GETFD);
+    if (flags >= 0) {
+        fcntl(fd, F_SETFD, flags | FD_CLOEXEC);
+    }
+}
+
+void SetNonBlocking(int fd, bool enabled) {
+    const int flags = fcntl(fd, F_GETFL);
+    if (flags >= 0) {
+        fcntl(fd, F_SETFL, enabled ? flags | O_NONBLOCK : flags & ~O_NONBLOCK);
+    }
+}
+
+bool WriteAll(int fd, const char* data, std::size_t size) {
+    while (size > 0) {
+        const ssize_t written = write(fd, data, size);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            return false;
+        }
+        data += written;
+        size -= static_cast<std::size_t>(written);
+    }
+    return true;
+}
+
+std::string ReadToEnd(int fd) {
+    std::string text;
+    char buffer[4096];
+    while (true) {
+        const ssize_t received = read(fd, buffer, sizeof(buffer));
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received <= 0) {
+            return text;
+        }
+        text.append(buffer, static_cast<std::size_t>(received));
+    }
+}
+
+bool FillAddress(const std::string& socket_path, sockaddr_un* out_address, std::string* out_error) {
+    std::memset(out_address, 0, sizeof(*out_address));
+    out_address->sun_family = AF_UNIX;
+    if (socket_path.empty() || socket_path.size() >= sizeof(out_address->sun_path)) {
+        *out_error = "Ruta de socket invalida o demasiado larga: " + socket_path;
+        return false;
+    }
+    std::memcpy(out_address->sun_path, socket_path.c_str(), socket_path.size() + 1);
+    return true;
+}
+
+// Whether the process at the other end of a connected Unix socket runs as
+// this user. Clients hand the server their stdio, and the server runs code
+// with its own rights, so neither side talks to another user.
+bool PeerIsCurrentUser(int fd) {
+#ifdef SO_PEERCRED
+    ucred credentials{};
+    socklen_t size = sizeof(credentials);
+    if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &credentials, &size) != 0 || size != sizeof(credentials)) {
+        return false;
+    }
+    return credentials.uid == getuid();
+#else
+    uid_t uid = 0;
+    gid_t gid = 0;
+    return getpeereid(fd, &uid, &gid) == 0 && uid == getuid();
+#endif
+}
+
+// An existing socket path must be a socket owned by this user: under /tmp
+// anyone can create the default path first. A path that cannot be inspected is
+// left for connect() or bind() to report.
+bool CheckSocketPathOwner(const std::string& socket_path, std::string* out_error) {
+    struct stat info {};
+    if (lstat(socket_path.c_str(), &info) != 0) {
+        return true;
+    }
+    if (!S_ISSOCK(info.st_mode)) {
+        *out_error = "La ruta de clot serve no es un socket: " + socket_path;
+        return false;
+    }
+    if (info.st_uid != getuid()) {
+        *out_error = "El socket de clot serve pertenece a otro usuario: " + socket_path;
+        return false;
+    }
+    return true;
+}
+
+int ConnectTo(const std::string& socket_path, std::string* out_error) {
+    sockaddr_un address;
+    if (!FillAddress(socket_path, &address, out_error) || !CheckSocketPathOwner(socket_path, out_error)) {
+        return -1;
+    }
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        *out_error = "No se pudo conectar con clot serve en: " + socket_path;
+        return -1;
+    }
+    if (!PeerIsCurrentUser(fd)) {
+        close(fd);
+        *out_error = "clot serve corre como otro usuario en: " + socket_path;
+        return -1;
+    }
+    return fd;
+}
+
+// Sends the framed request; `descriptors` (may be empty) travel with its first byte.
+bool SendRequest(int fd, const std::vector<std::string>& fields, const std::vector<int>& descriptors) {
+    std::string payload;
+    for (const auto& field : fields) {
+        payload += field;
+        payload.push_back('\0');
+    }
+    const auto length = static_cast<std::uint32_t>(payload.size());
+    std::string frame(reinterpret_cast<const char*>(&length), sizeof(length));
+    frame += payload;
+
+    iovec chunk{frame.data(), frame.size()};
+    msghdr message{};
+    message.msg_iov = &chunk;
+    message.msg_iovlen = 1;
+
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * kForwardedDescriptors)];
+    if (!descriptors.empty()) {
+        std::memset(control, 0, sizeof(control));
+        message.msg_control = control;
+        message.msg_controllen = CMSG_SPACE(sizeof(int) * descriptors.size());
+        cmsghdr* header = CMSG_FIRSTHDR(&message);
+        header->cmsg_level = SOL_SOCKET;
+        header->cmsg_type = SCM_RIGHTS;
+        header->cmsg_len = CMSG_LEN(sizeof(int) * descriptors.size());
+        std::memcpy(CMSG_DATA(header), descriptors.data(), sizeof(int) * descriptors.size());
+    }
+
+    ssize_t sent = -1;
+    do {
+        sent = sendmsg(fd, &message, 0);
+    } while (sent < 0 && errno == EINTR);
+    if (sent <= 0) {
+        return false;
+    }
+    return WriteAll(fd, frame.data() + sent, frame.size() - static_cast<std::size_t>(sent));
+}
+
+// A connection whose request has not fully arrived. Its socket is
+// non-blocking: each poll wakeup appends what is there to `frame`, so a client
+// that sends part of a request never holds up the loop.
+struct PendingConnection {
+    int fd = -1;
+    std::chrono::steady_clock::time_point deadline;
+    std::string frame;
+    std::vector<int> descriptors;
+};
+
+void ClosePending(const PendingConnection& connection) {
+    close(connection.fd);
+    for (const int descriptor : connection.descriptors) {
+        close(descriptor);
+    }
+}
+
+enum class ReceiveStatus {
+    Partial,
+    Complete,
+    Failed,
+};
+
+// Reads what has arrived of a request without blocking, together with the
+// descriptors attached to it. Never reads past the end of the frame.
+ReceiveStatus ReceiveRequestPart(PendingConnection* connection) {
+    while (true) {
+        std::size_t wanted = sizeof(std::uint32_t) - std::min(connection->frame.size(), sizeof(std::uint32_t));
+        if (wanted == 0) {
+            std::uint32_t length = 0;
+            std::memcpy(&length, connection->frame.data(), sizeof(length));
+            if (length > kMaxRequestBytes) {
+                return ReceiveStatus::Failed;
+            }
+            wanted = sizeof(length) + length - connection->frame.size();
+            if (wanted == 0) {
+                return ReceiveStatus::Complete;
+            }
+        }
+
+        char buffer[4096];
+        iovec chunk{buffer, std::min(wanted, sizeof(buffer))};
+        msghdr message{};
+        message.msg_iov = &chunk;
+        message.msg_iovlen = 1;
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * kForwardedDescriptors)];
+        message.msg_control = control;
+        message.msg_controllen = sizeof(control);
+
+        const ssize_t received = recvmsg(connection->fd, &message, 0);
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return ReceiveStatus::Partial;
+        }
+        if (received <= 0) {
+            return ReceiveStatus::Failed;
+        }
+        for (cmsghdr* header = CMSG_FIRSTHDR(&message); header != nullptr; header = CMSG_NXTHDR(&message, header)) {
+            if (header->cmsg_level == SOL_SOCKET && header->cmsg_type == SCM_RIGHTS) {
+                const std::size_t count = (header->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+                for (std::size_t i = 0; i < count; ++i) {
+                    int descriptor = -1;
+                    std::memcpy(&descriptor, CMSG_DATA(header) + i * sizeof(int), sizeof(int));
+                    SetCloseOnExec(descriptor);
+                    connection->descriptors.push_back(descriptor);
+                }
+            }
+        }
+        if ((message.msg_flags & MSG_CTRUNC) != 0 ||
+            connection->descriptors.size() > static_cast<std::size_t>(kForwardedDescriptors)) {
+            return ReceiveStatus::Failed;
+        }
+        connection->frame.append(buffer, static_cast<std::size_t>(received));
+    }
+}
+
+// Splits a complete frame into its NUL-terminated fields.
+bool ParseRequestFields(const std::string& frame, std::vector<std::string>* out_fields) {
+    std::size_t start = sizeof(std::uint32_t);
+    while (start < frame.size()) {
+        const std::size_t end = frame.find('\0', start);
+        if (end == std::string::npos) {
+            return false;
+        }
+        out_fields->push_back(frame.substr(start, end - start));
+        start = end + 1;
+    }
+    return true;
+}
+
+const char* OutputBufferingName(runtime::OutputBuffering mode) {
+    switch (mode) {
+        case runtime::OutputBuffering::Line:
+            return "line";
+        case runtime::OutputBuffering::Block:
+            return "block";
+        case runtime::OutputBuffering::None:
+            return "none";
+        case runtime::OutputBuffering::Auto:
+            break;
+    }
+    return "auto";
+}
+
+// Parses and runs one script, reporting errors on stderr exactly as `clot`
+// does. Returns the process exit code.
+int RunScript(
+    interpreter::ModuleCache* cache,
+    const std::string& script_path,
+    const interpreter::Interpreter::ResourceLimits& limits) {
+    std::shared_ptr<const frontend::Program> program;
+    frontend::Diagnostic diagnostic;
+    std::string load_error;
+    if (!cache->Load(script_path, &program, &diagnostic, &load_error)) {
+        if (!load_error.empty()) {
+            std::cerr << runtime::Tr("Error: ", "Error: ") << runtime::TranslateDiagnostic(load_error) << "\n";
+        } else {
+            std::cerr << runtime::Tr("Error de parseo en linea ", "Parse error at line ") << diagnostic.line
+                      << runtime::Tr(", columna ", ", column ") << diagnostic.column << ": "
+                      << runtime::TranslateDiagnostic(diagnostic.message) << "\n";
+        }
+        return 1;
+    }
+
+    interpreter::Interpreter interpreter;
+    interpreter.SetEntryFilePath(script_path);
+    interpreter.SetModuleCache(cache);
+    std::string runtime_error;
+    if (!interpreter.SetResourceLimits(limits, &runtime_error)) {
+        std::cerr << runtime::Tr("Error: ", "Error: ") << runtime::TranslateDiagnostic(runtime_error) << "\n";
+        return 1;
+    }
+    if (!interpreter.Execute(*program, &runtime_error)) {
+        const std::string translated = runtime::TranslateDiagnostic(runtime_error);
+        if (translated.rfind("Excepcion no capturada: ", 0) == 0 || translated.rfind("Unhandled Exception: ", 0) == 0) {
+            std::cerr << translated << "\n";
+        } else {
+            std::cerr << runtime::Tr("Error de ejecucion: ", "Runtime error: ") << translated << "\n";
+        }
+        return 1;
+    }
+    return 0;
+}
+
+// Body of the forked child: adopts the client's stdio, directory and settings,
+// runs the script and reports to the parent (through `report_fd`) the files it
+// had to parse, so the next request finds them warm.
+[[noreturn]] void RunChild(
+    interpreter::ModuleCache* cache,
+    const std::vector<std::string>& fields,
+    const std::vector<int>& descriptors,
+    int report_fd) {
+    signal(SIGINT, SIG_DFL);
+    signal(SIGTERM, SIG_DFL);
+    signal(SIGPIPE, SIG_DFL);
+    for (int i = 0; i < kForwardedDescriptors; ++i) {
+        dup2(descriptors[static_cast<std::size_t>(i)], i);
+    }
+    for (const int descriptor : descriptors) {
+        if (descriptor >= kForwardedDescriptors) {
+            close(descriptor);
+        }
+    }
+
+    const std::string& script_path = fields[2];
+    runtime::Language language = runtime::Language::Spanish;
+    if (runtime::ParseLanguage(fields[3], &language)) {
+        runtime::SetLanguage(language);
+    }
+    runtime::OutputBuffering buffering = runtime::OutputBuffering::Auto;
+    runtime::ParseOutputBuffering(fields[4], &buffering);
+    runtime::ConfigureStdout(buffering);
+    interpreter::Interpreter::ResourceLimits limits;
+    limits.max_heap_bytes = std::strtoull(fields[5].c_str(), nullptr, 10);
+    limits.max_wall_ms = std::strtoull(fields[6].c_str(), nullptr, 10);
+    limits.max_statements = std::strtoull(fields[7].c_str(), nullptr, 10);
+
+    int exit_code = 1;
+    if (chdir(fields[1].c_str()) != 0) {
+        std::cerr << runtime::Tr("Error: ", "Error: ")
+                  << runtime::TranslateDiagnostic("No se pudo cambiar al directorio: " + fields[1]) << "\n";
+    } else {
+        exit_code = RunScript(cache, script_path, limits);
+    }
+
+    std::string report;
+    for (const auto& path : cache->TakeParsedPaths()) {
+        std::error_code ec;
+        report += std::filesystem::absolute(path, ec).string();
+        report.push_back('\n');
+    }
+    WriteAll(report_fd, report.data(), report.size());
+
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(nullptr);
+    _exit(exit_code);
+}
+
+// A request running in a forked child. The child holds the only write end of
+// `report_fd`, so end-of-file there means it has exited. A client that
+// disconnects early (e.g. interrupted with Ctrl-C) has its run killed.
+struct RunningRequest {
+    pid_t child = -1;
+    int report_fd = -1;
+    int connection_fd = -1;
+    std::string script_path;
+    std::string report;
+    bool killed = false;
+    std::chrono::steady_clock::time_point started;
+};
+
+// Forks the child for a run request. `inherited_fds` are the server's other
+// descriptors, closed in the child so that no other run keeps a client's
+// connection open. Returns false if the child could not be started.
+bool StartRun(
+    interpreter::ModuleCache* cache,
+    const std::vector<int>& inherited_fds,
+    int connection_fd,
+    const std::vector<std::string>& fields,
+    const std::vector<int>& descriptors,
+    RunningRequest* out_request) {
+    int report_pipe[2] = {-1, -1};
+    if (pipe(report_pipe) != 0) {
+        return false;
+    }
+    SetCloseOnExec(report_pipe[0]);
+    SetCloseOnExec(report_pipe[1]);
+
+    std::cout.flush();
+    std::cerr.flush();
+    const pid_t child = fork();
+    if (child < 0) {
+        close(report_pipe[0]);
+        close(report_pipe[1]);
+        return false;
+    }
+    if (child == 0) {
+        for (const int fd : inherited_fds) {
+            close(fd);
+        }
+        close(connection_fd);
+        close(report_pipe[0]);
+        RunChild(cache, fields, descriptors, report_pipe[1]);
+    }
+    close(report_pipe[1]);
+
+    out_request->child = child;
+    out_request->report_fd = report_pipe[0];
+    out_request->connection_fd = connection_fd;
+    out_request->script_path = fields[2];
+    out_request->started = std::chrono::steady_clock::now();
+    return true;
+}
+
+// Reaps the child of a run whose report pipe reached end-of-file and returns
+// its exit code.
+int FinishRun(const RunningRequest& request, std::vector<std::filesystem::path>* out_parsed_paths) {
+    int status = 0;
+    while (waitpid(request.child, &status, 0) < 0 && errno == EINTR) {
+    }
+
+    std::size_t start = 0;
+    while (start < request.report.size()) {
+        const std::size_t end = request.report.find('\n', start);
+        if (end == std::string::npos) {
+            break;
+        }
+        out_parsed_paths->push_back(request.report.substr(start, end - start));
+        start = end + 1;
+    }
+
+    if (WIFEXITED(status)) {
+        return WEXITSTATUS(status);
+    }
+    return WIFSIGNALED(status) ? 128 + WTERMSIG(status) : 1;
+}
+
+// The socket is bound and listening under a temporary name and then renamed
+// into place, so a client that sees the file can always connect.
+int BindListener(const std::string& socket_path, std::string* out_error) {
+    if (!CheckSocketPathOwner(socket_path, out_error)) {
+        return -1;
+    }
+    std::string ignored;
+    const int probe = ConnectTo(socket_path, &ignored);
+    if (probe >= 0) {
+        // A socket file left by a server that died is replaced; a live one is not.
+        close(probe);
+        *out_error = "Ya hay un servidor clot serve en: " + socket_path;
+        return -1;
+    }
+
+    const std::string staging_path = socket_path + "." + std::to_string(static_cast<long>(getpid()));
+    sockaddr_un address;
+    if (!FillAddress(socket_path, &address, out_error) || !FillAddress(staging_path, &address, out_error)) {
+        return -1;
+    }
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        *out_error = "No se pudo crear el socket de clot serve.";
+        return -1;
+    }
+    SetCloseOnExec(fd);
+
+    unlink(staging_path.c_str());
+    if (bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+        chmod(staging_path.c_str(), S_IRUSR | S_IWUSR) != 0 || listen(fd, 16) != 0 ||
+        rename(staging_path.c_str(), socket_path.c_str()) != 0) {
+        close(fd);
+        unlink(staging_path.c_str());
+        *out_error = "No se pudo escuchar en: " + socket_path;
+        return -1;
+    }
+    return fd;
+}
+
+}  // namespace
+
+bool RunServer(const ServerOptions& options, std::string* out_error) {
+    const std::string socket_path = options.socket_path.empty() ? DefaultSocketPath() : options.socket_path;
+    const int listen_fd = BindListener(socket_path, out_error);
+    if (listen_fd < 0) {
+        return false;
+    }
+
+    if (pipe(g_signal_pipe) != 0) {
+        close(listen_fd);
+        unlink(socket_path.c_str());
+        *out_error = "No se pudo crear el socket de clot serve.";
+        return false;
+    }
+    SetCloseOnExec(g_signal_pipe[0]);
+    SetCloseOnExec(g_signal_pipe[1]);
+    struct sigaction stop_action {};
+    stop_action.sa_handler = OnStopSignal;
+    sigemptyset(&stop_action.sa_mask);
+    sigaction(SIGINT, &stop_action, nullptr);
+    sigaction(SIGTERM, &stop_action, nullptr);
+    signal(SIGPIPE, SIG_IGN);
+
+    if (options.verbose) {
+        std::cerr << runtime::Tr("clot serve escuchando en ", "clot serve listening on ") << socket_path << "\n";
+    }
+
+    interpreter::ModuleCache cache;
+    std::vector<PendingConnection> pending;
+    std::vector<RunningRequest> running;
+    bool accepting = true;
+    const auto stop_accepting = [&] {
+        accepting = false;
+        close(listen_fd);
+        unlink(socket_path.c_str());
+        for (const auto& connection : pending) {
+            ClosePending(connection);
+        }
+        pending.clear();
+    };
+
+    // One poll loop: new connections, requests arriving on them, and the
+    // report pipes and connections of runs in flight. After a stop request or
+    // signal the runs in flight are finished before returning.
+    while (accepting || !running.empty()) {
+        std::vector<pollfd> watched;
+        watched.push_back({g_signal_pipe[0], POLLIN, 0});
+        watched.push_back({accepting && running.size() < kMaxRunningRequests ? listen_fd : -1, POLLIN, 0});
+        for (const auto& connection : pending) {
+            watched.push_back({connection.fd, POLLIN, 0});
+        }
+        for (const auto& request : running) {
+            watched.push_back({request.report_fd, POLLIN, 0});
+            watched.push_back({request.killed ? -1 : request.connection_fd, POLLIN, 0});
+        }
+
+        int timeout_ms = -1;
+        const auto now = std::chrono::steady_clock::now();
+        for (const auto& connection : pending) {
+            const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(connection.deadline - now).count();
+            const int left_ms = static_cast<int>(std::max<long long>(left, 0));
+            timeout_ms = timeout_ms < 0 ? left_ms : std::min(timeout_ms, left_ms);
+        }
+
+        if (poll(watched.data(), watched.size(), timeout_ms) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+
+        if (watched[0].revents != 0) {
+            char drained = 0;
+            const ssize_t ignored = read(g_signal_pipe[0], &drained, 1);
+            (void)ignored;
+            if (accepting) {
+                stop_accepting();
+            } else {
+                // A second signal while draining does not wait for the runs.
+                for (const auto& request : running) {
+                    kill(request.child, SIGKILL);
+                }
+            }
+            continue;
+        }
+
+        // Runs first: their slots in `watched` come after the pending ones.
+        std::size_t slot = 2 + pending.size();
+        for (auto& request : running) {
+            const pollfd& report = watched[slot++];
+            const pollfd& connection = watched[slot++];
+            if (!request.killed && connection.revents != 0) {
+                // The client sends nothing after its request: readable means gone.
+                kill(request.child, SIGKILL);
+                request.killed = true;
+            }
+            if (report.revents == 0) {
+                continue;
+            }
+            char buffer[4096];
+            const ssize_t received = read(request.report_fd, buffer, sizeof(buffer));
+            if (received < 0 && errno == EINTR) {
+                continue;
+            }
+            if (received > 0) {
+                request.report.append(buffer, static_cast<std::size_t>(received));
+                continue;
+            }
+
+            close(request.report_fd);
+            request.report_fd = -1;
+            std::vector<std::filesystem::path> parsed_paths;
+            const int exit_code = FinishRun(request, &parsed_paths);
+            const std::string reply = std::to_string(exit_code);
+            WriteAll(request.connection_fd, reply.data(), reply.size());
+            close(request.connection_fd);
+            if (options.verbose) {
+                const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+                                         std::chrono::steady_clock::now() - request.started)
+                                         .count();
+                std::cerr << request.script_path << ": " << exit_code << " (" << elapsed / 1000.0 << " ms, "
+                          << parsed_paths.size() << runtime::Tr(" parseados)", " parsed)") << "\n";
+            }
+
+            // Parse what the child had to parse, after its client has the reply.
+            for (const auto& path : parsed_paths) {
+                std::shared_ptr<const frontend::Program> program;
+                frontend::Diagnostic diagnostic;
+                std::string ignored;
+                cache.Load(path, &program, &diagnostic, &ignored);
+            }
+            cache.TakeParsedPaths();
+        }
+        running.erase(std::remove_if(running.begin(), running.end(),
+                                     [](const RunningRequest& request) { return request.report_fd < 0; }),
+                      running.end());
+
+        std::vector<PendingConnection> still_pending;
+        bool stop_requested = false;
+        for (std::size_t i = 0; i < pending.size(); ++i) {
+            PendingConnection& connection = pending[i];
+            ReceiveStatus status = ReceiveStatus::Partial;
+            if (!stop_requested && watched[2 + i].revents != 0) {
+                status = ReceiveRequestPart(&connection);
+            }
+            if (status == ReceiveStatus::Partial) {
+                if (stop_requested || std::chrono::steady_clock::now() < connection.deadline) {
+                    still_pending.push_back(std::move(connection));
+                } else {
+                    ClosePending(connection);
+                }
+                continue;
+            }
+
+            std::vector<std::string> fields;
+            const bool received = status == ReceiveStatus::Complete && ParseRequestFields(connection.frame, &fields);
+            // The reply is a few bytes written once the run ends.
+            SetNonBlocking(connection.fd, false);
+            bool started = false;
+            if (received && fields.size() == 1 && fields[0] == "stop") {
+                WriteAll(connection.fd, "0", 1);
+                ClosePending(connection);
+                stop_requested = true;
+                continue;
+            }
+            if (received && fields.size() == 8 && fields[0] == "run" &&
+                connection.descriptors.size() == static_cast<std::size_t>(kForwardedDescriptors)) {
+                // Only descriptors that are open right now: a number closed
+                // above may already be reused by the new report pipe. Other
+                // clients' connections and stdio must not stay open in the child.
+                std::vector<int> inherited_fds = {listen_fd, g_signal_pipe[0], g_signal_pipe[1]};
+                const auto inherit_pending = [&](const PendingConnection& other) {
+                    inherited_fds.push_back(other.fd);
+                    inherited_fds.insert(inherited_fds.end(), other.descriptors.begin(), other.descriptors.end());
+                };
+                for (const auto& other : still_pending) {
+                    inherit_pending(other);
+                }
+                for (std::size_t j = i + 1; j < pending.size(); ++j) {
+                    inherit_pending(pending[j]);
+                }
+                for (const auto& request : running) {
+                    inherited_fds.push_back(request.report_fd);
+                    inherited_fds.push_back(request.connection_fd);
+                }
+                RunningRequest request;
+                started = StartRun(&cache, inherited_fds, connection.fd, fields, connection.descriptors, &request);
+                if (started) {
+                    running.push_back(std::move(request));
+                }
+            }
+            for (const int descriptor : connection.descriptors) {
+                close(descriptor);
+            }
+            if (!started) {
+                WriteAll(connection.fd, "1", 1);
+                close(connection.fd);
+            }
+        }
+        pending = std::move(still_pending);
+        if (stop_requested) {
+            stop_accepting();
+        }
+
+        if (accepting && watched[1].revents != 0) {
+            const int connection_fd = accept(listen_fd, nullptr, nullptr);
+            if (connection_fd >= 0 && !PeerIsCurrentUser(connection_fd)) {
+                close(connection_fd);
+            } else if (connection_fd >= 0) {
+                SetCloseOnExec(connection_fd);
+                SetNonBlocking(connection_fd, true);
+                PendingConnection connection;
+                connection.fd = connection_fd;
+                connection.deadline = std::chrono::steady_clock::now() + kRequestTimeout;
+                pending.push_back(std::move(connection));
+            }
+        }
+    }
+
+    for (const auto& connection : pending) {
+        ClosePending(connection);
+    }
+    if (accepting) {
+        close(listen_fd);
+        unlink(socket_path.c_str());
+    }
+    close(g_signal_pipe[0]);
+    close(g_signal_pipe[1]);
+    g_signal_pipe[0] = g_signal_pipe[1] = -1;
+    return true;
+}
+
+bool RunOnServer(
+    const std::string& socket_path,
+    const std::string& script_path,
+    runtime::OutputBuffering output_buffering,
+    const interpreter::Interpreter::ResourceLimits& limits,
+    int* out_exit_code,
+    std::string* out_error) {
+    const int fd = ConnectTo(socket_path, out_error);
+    if (fd < 0) {
+        return false;
+    }
+
+    std::error_code ec;
+    const std::filesystem::path cwd = std::filesystem::current_path(ec);
+    const std::vector<std::string> fields = {
+        "run",
+        cwd.string(),
+        script_path,
+        runtime::GetLanguage() == runtime::Language::English ? "en" : "es",
+        OutputBufferingName(output_buffering),
+        std::to_string(limits.max_heap_bytes),
+        std::to_string(limits.max_wall_ms),
+        std::to_string(limits.max_statements),
+    };
+    if (!SendRequest(fd, fields, {STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO})) {
+        close(fd);
+        *out_error = "No se pudo enviar la solicitud a clot serve.";
+        return false;
+    }
+
+    const std::string reply = ReadToEnd(fd);
+    close(fd);
+    if (reply.empty()) {
+        *out_error = "clot serve cerro la conexion sin responder.";
+        return false;
+    }
+    *out_exit_code = std::atoi(reply.c_str());
+    return true;
+}
+
+bool StopServer(const std::string& socket_path, std::string* out_error) {
+    const int fd = ConnectTo(socket_path, out_error);
+    if (fd < 0) {
+        return false;
+    }
+    const bool sent = SendRequest(fd, {"stop"}, {});
+    const std::string reply = sent ? ReadToEnd(fd) : std::string();
+    close(fd);
+    if (reply != "0") {
+        *out_error = "clot serve cerro la conexion sin responder.";
+        return false;
+    }
+    return true;
+}
+
+#endif
+
+}  // namespace clot::serve
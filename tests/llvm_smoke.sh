@@ -46,6 +46,104 @@ if [[ "$ACTUAL_AOT" != "$EXPECTED_AOT" ]]; then
     exit 1
 fi
 
+cat > "$TMP_DIR/aot_list_loops.clot" <<'PROG'
+xs = [1.5, 2.5, 3.0, 4.0];
+double total = 0.0;
+for x in xs:
+    total += x;
+endfor
+println(total);
+for (double i = 0.0; i < len(xs); i++):
+    xs[i] = xs[i] * 2.0;
+endfor
+println(xs[3]);
+println(len(xs));
+PROG
+
+LIST_EXE="$TMP_DIR/aot_list_loops"
+LIST_LOG="$TMP_DIR/aot_list_loops.log"
+"$BIN_PATH" "$TMP_DIR/aot_list_loops.clot" --mode compile --emit exe -o "$LIST_EXE" --verbose >"$LIST_LOG" 2>&1
+
+if grep -q "runtime bridge LLVM activado" "$LIST_LOG"; then
+    echo "Fallo llvm_smoke: aot_list_loops deberia compilar AOT puro." >&2
+    cat "$LIST_LOG" >&2
+    exit 1
+fi
+
+EXPECTED_LIST=$'11\n8\n4'
+ACTUAL_LIST="$($LIST_EXE)"
+if [[ "$ACTUAL_LIST" != "$EXPECTED_LIST" ]]; then
+    echo "Fallo llvm_smoke (aot_list_loops)" >&2
+    echo "Esperado:" >&2
+    printf '%s\n' "$EXPECTED_LIST" >&2
+    echo "Actual:" >&2
+    printf '%s\n' "$ACTUAL_LIST" >&2
+    exit 1
+fi
+
+# Solo el bucle elemento a elemento lleva vectorize.enable: forzarlo en la suma
+# dejaria reasociar la reduccion y el resultado cambiaria respecto de interpret.
+LIST_IR="$TMP_DIR/aot_list_loops.ll"
+"$BIN_PATH" "$TMP_DIR/aot_list_loops.clot" --mode compile --emit ir -o "$LIST_IR"
+if grep -q 'br label %foreach.cond, !llvm.loop' "$LIST_IR" ||
+    [[ "$(grep -c 'br label %for.cond, !llvm.loop' "$LIST_IR")" != "1" ]] ||
+    ! grep -q '"llvm.loop.vectorize.enable", i1 true' "$LIST_IR"; then
+    echo "Fallo llvm_smoke: aot_list_loops debe forzar la vectorizacion solo del bucle sin reduccion." >&2
+    grep -n 'llvm.loop' "$LIST_IR" >&2 || true
+    exit 1
+fi
+
+cat > "$TMP_DIR/split_cache.clot" <<'PROG'
+func scale(&v, k):
+    v = v * k;
+endfunc
+
+func shift(&v, d):
+    v = v + d;
+endfunc
+
+double x = 2.0;
+scale(x, 3.0);
+shift(x, 1.0);
+println(x);
+PROG
+
+SPLIT_EXE="$TMP_DIR/split_cache"
+SPLIT_LOG="$TMP_DIR/split_cache.log"
+OBJECT_CACHE="$TMP_DIR/object-cache"
+"$BIN_PATH" "$TMP_DIR/split_cache.clot" --mode compile --emit exe -o "$SPLIT_EXE" -j 2 \
+    --object-cache "$OBJECT_CACHE" --verbose >"$SPLIT_LOG" 2>&1
+
+if ! grep -q "codegen: 3 particiones, 0 desde cache" "$SPLIT_LOG" || [[ "$($SPLIT_EXE)" != "7" ]]; then
+    echo "Fallo llvm_smoke: split_cache debe compilar 3 particiones en frio." >&2
+    cat "$SPLIT_LOG" >&2
+    exit 1
+fi
+
+sed -i 's/v = v + d;/v = v - d;/' "$TMP_DIR/split_cache.clot"
+"$BIN_PATH" "$TMP_DIR/split_cache.clot" --mode compile --emit exe -o "$SPLIT_EXE" -j 2 \
+    --object-cache "$OBJECT_CACHE" --verbose >"$SPLIT_LOG" 2>&1
+
+if ! grep -q "codegen: 3 particiones, 2 desde cache" "$SPLIT_LOG" || [[ "$($SPLIT_EXE)" != "5" ]]; then
+    echo "Fallo llvm_smoke: split_cache debe recompilar solo la funcion modificada." >&2
+    cat "$SPLIT_LOG" >&2
+    exit 1
+fi
+
+if command -v llvm-profdata >/dev/null 2>&1; then
+    PGO_EXE="$TMP_DIR/split_cache_pgo"
+    "$BIN_PATH" "$TMP_DIR/split_cache.clot" --mode compile --emit exe -o "$PGO_EXE.instr" --instrument
+    LLVM_PROFILE_FILE="$TMP_DIR/pgo-%p.profraw" "$PGO_EXE.instr" >/dev/null
+    llvm-profdata merge -o "$TMP_DIR/pgo.profdata" "$TMP_DIR"/pgo-*.profraw
+    "$BIN_PATH" "$TMP_DIR/split_cache.clot" --mode compile --emit exe -o "$PGO_EXE" \
+        --profile-use "$TMP_DIR/pgo.profdata"
+
+    if [[ "$($PGO_EXE)" != "5" ]]; then
+        echo "Fallo llvm_smoke: binario PGO de split_cache debe imprimir 5." >&2
+        exit 1
+    fi
+fi
+
 cat > "$TMP_DIR/int_default_bridge.clot" <<'PROG'
 import math;
 x = 10;
@@ -139,4 +237,78 @@ if [[ "$ACTUAL_EXTERNAL" != "$EXPECTED_EXTERNAL" ]]; then
     exit 1
 fi
 
+cat > "$TMP_DIR/jit_kernel.clot" <<'PROG'
+import math;
+func accumulate(&acc, x):
+    acc += sqrt(x);
+endfunc
+
+double total = 0.0;
+double i = 1.0;
+while i <= 16.0:
+    accumulate(total, i * i);
+    i += 1.0;
+endwhile
+println(total);
+PROG
+
+JIT_LOG="$TMP_DIR/jit_kernel.log"
+ACTUAL_JIT="$("$BIN_PATH" "$TMP_DIR/jit_kernel.clot" --mode jit --jit-threshold 2 --verbose 2>"$JIT_LOG")"
+
+if ! grep -q "JIT LLVM compilo funcion: accumulate" "$JIT_LOG"; then
+    echo "Fallo llvm_smoke: jit_kernel debe compilar accumulate con JIT." >&2
+    cat "$JIT_LOG" >&2
+    exit 1
+fi
+
+JIT_SYNC_LOG="$TMP_DIR/jit_kernel_sync.log"
+ACTUAL_JIT_SYNC="$("$BIN_PATH" "$TMP_DIR/jit_kernel.clot" --mode jit --jit-threshold 2 --jit-sync --verbose 2>"$JIT_SYNC_LOG")"
+
+if ! grep -q "JIT LLVM: 1/1 funciones nativas" "$JIT_SYNC_LOG" || [[ "$ACTUAL_JIT_SYNC" != "136" ]]; then
+    echo "Fallo llvm_smoke: jit_kernel con --jit-sync debe terminar en tier nativo." >&2
+    cat "$JIT_SYNC_LOG" >&2
+    exit 1
+fi
+
+EXPECTED_JIT=$'136'
+if [[ "$ACTUAL_JIT" != "$EXPECTED_JIT" ]]; then
+    echo "Fallo llvm_smoke (jit_kernel)" >&2
+    echo "Esperado:" >&2
+    printf '%s\n' "$EXPECTED_JIT" >&2
+    echo "Actual:" >&2
+    printf '%s\n' "$ACTUAL_JIT" >&2
+    exit 1
+fi
+
+# Un error de rango dentro de codigo JIT se atrapa con try/catch, igual que al
+# interpretar, en vez de terminar el proceso.
+cat > "$TMP_DIR/jit_range.clot" <<'PROG'
+func to_long(x):
+    long y = x;
+    println(y);
+endfunc
+
+to_long(1.0);
+to_long(2.0);
+to_long(3.0);
+double big = 1000000.0 * 1000000.0 * 1000000.0 * 1000000.0;
+try:
+    to_long(big);
+catch(RangeError err):
+    println("atrapado");
+endtry
+println("sigue");
+PROG
+
+EXPECTED_JIT_RANGE=$'1\n2\n3\natrapado\nsigue'
+ACTUAL_JIT_RANGE="$("$BIN_PATH" "$TMP_DIR/jit_range.clot" --mode jit --jit-threshold 1 --jit-sync)"
+if [[ "$ACTUAL_JIT_RANGE" != "$EXPECTED_JIT_RANGE" ]]; then
+    echo "Fallo llvm_smoke (jit_range)" >&2
+    echo "Esperado:" >&2
+    printf '%s\n' "$EXPECTED_JIT_RANGE" >&2
+    echo "Actual:" >&2
+    printf '%s\n' "$ACTUAL_JIT_RANGE" >&2
+    exit 1
+fi
+
 echo "LLVM smoke tests OK"
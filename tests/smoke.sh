@@ -57,6 +57,24 @@ if [[ "$ACTUAL_TWO" != "$EXPECTED_TWO" ]]; then
     exit 1
 fi
 
+cat > "$TMP_DIR/number_format.clot" <<'PROG'
+println(0.00000000015);
+println(2.5 * 0.000000000000000000001);
+println(0.25);
+PROG
+
+# Los ceros de un exponente no se recortan como decimales.
+EXPECTED_NUMBER_FORMAT=$'1.5e-10\n2.5e-21\n0.25'
+ACTUAL_NUMBER_FORMAT="$($BIN_PATH "$TMP_DIR/number_format.clot")"
+if [[ "$ACTUAL_NUMBER_FORMAT" != "$EXPECTED_NUMBER_FORMAT" ]]; then
+    echo "Fallo test number_format" >&2
+    echo "Esperado:" >&2
+    printf '%s\n' "$EXPECTED_NUMBER_FORMAT" >&2
+    echo "Actual:" >&2
+    printf '%s\n' "$ACTUAL_NUMBER_FORMAT" >&2
+    exit 1
+fi
+
 cat > "$TMP_DIR/migration.clot" <<'PROG'
 import math;
 a = 5;
@@ -1035,6 +1053,1012 @@ if [[ "$ACTUAL_FSTRINGS" != "$EXPECTED_FSTRINGS" ]]; then
     exit 1
 fi
 
+# --- string builder: f-strings de una pasada, += y append en sitio ---
+cat > "$TMP_DIR/string_builder.clot" <<'PROG'
+precio = 2.5;
+letra = 'z';
+println(f"{letra}{precio * 2}|{true}|{null}|{'q'}|{{}}");
+csv = "";
+for i in range(4):
+    csv += f"{i},{i * i}";
+    csv += "\n";
+endfor
+csv.append("fin");
+filas = [csv];
+filas[0].append("!");
+println(filas[0]);
+PROG
+
+EXPECTED_STRING_BUILDER=$'z5|true|null|q|{}\n0,0\n1,1\n2,4\n3,9\nfin!'
+ACTUAL_STRING_BUILDER="$($BIN_PATH "$TMP_DIR/string_builder.clot")"
+if [[ "$ACTUAL_STRING_BUILDER" != "$EXPECTED_STRING_BUILDER" ]]; then
+    echo "Fallo test string_builder" >&2
+    echo "Esperado:" >&2
+    printf '%s\n' "$EXPECTED_STRING_BUILDER" >&2
+    echo "Actual:" >&2
+    printf '%s\n' "$ACTUAL_STRING_BUILDER" >&2
+    exit 1
+fi
+
+# --- sort/sorted: orden estable, key, reverse y selecciones parciales ---
+cat > "$TMP_DIR/sorting.clot" <<'PROG'
+func segundo(par):
+    return par[1];
+endfunc
+func negativo(x):
+    return -x;
+endfunc
+xs = [5, 3, 9, 1, 3];
+sort(xs);
+println(xs);
+println(sorted([2.5, 0.5, 1.5], null, true));
+println(sorted(["pera", "kiwi", "banana"]));
+println(sorted([tuple(1, "b"), tuple(2, "a"), tuple(3, "b"), tuple(4, "a")], segundo));
+println(sorted([2, 0.5, 1]));
+sort(xs, negativo);
+println(xs);
+println(top_k([4, 8, 1, 9, 3], 2));
+println(nth_element([4, 8, 1, 9, 3], 1));
+PROG
+
+EXPECTED_SORTING=$'[1, 3, 3, 5, 9]\n[2.5, 1.5, 0.5]\n["banana", "kiwi", "pera"]\n[(2, "a"), (4, "a"), (1, "b"), (3, "b")]\n[0.5, 1, 2]\n[9, 5, 3, 3, 1]\n[9, 8]\n3'
+ACTUAL_SORTING="$($BIN_PATH "$TMP_DIR/sorting.clot")"
+if [[ "$ACTUAL_SORTING" != "$EXPECTED_SORTING" ]]; then
+    echo "Fallo test sorting" >&2
+    echo "Esperado:" >&2
+    printf '%s\n' "$EXPECTED_SORTING" >&2
+    echo "Actual:" >&2
+    printf '%s\n' "$ACTUAL_SORTING" >&2
+    exit 1
+fi
+
+cat > "$TMP_DIR/sorting_mixed.clot" <<'PROG'
+println(sorted([1, "a"]));
+PROG
+
+set +e
+"$BIN_PATH" "$TMP_DIR/sorting_mixed.clot" >"$TMP_DIR/sorting_mixed.out" 2>"$TMP_DIR/sorting_mixed.err"
+STATUS_SORTING_MIXED=$?
+set -e
+
+if [[ "$STATUS_SORTING_MIXED" -eq 0 ]] || ! grep -q "No se pueden ordenar juntos" "$TMP_DIR/sorting_mixed.err"; then
+    echo "Fallo test sorting_mixed: se esperaba error al ordenar int con string." >&2
+    exit 1
+fi
+
+# Enough keys for std::sort to reach its partitioning loop: the error must come
+# from the pre-check, never from a comparator that fails mid-sort.
+cat > "$TMP_DIR/sorting_mixed_large.clot" <<'PROG'
+lista = [];
+for i in range(200):
+    lista.append(200 - i);
+endfor
+lista.append("x");
+try:
+    println(sorted(lista));
+catch(RuntimeError err):
+    println("atrapado");
+endtry
+println(sorted([[1], [1, null], [0]]));
+PROG
+
+set +e
+ACTUAL_SORTING_MIXED_LARGE="$("$BIN_PATH" "$TMP_DIR/sorting_mixed_large.clot" 2>&1)"
+STATUS_SORTING_MIXED_LARGE=$?
+set -e
+
+if [[ "$STATUS_SORTING_MIXED_LARGE" -ne 0 ]] || [[ "$ACTUAL_SORTING_MIXED_LARGE" != $'atrapado\n[[0], [1], [1, null]]' ]]; then
+    echo "Fallo test sorting_mixed_large" >&2
+    printf '%s\n' "$ACTUAL_SORTING_MIXED_LARGE" >&2
+    exit 1
+fi
+
+# int, double y decimal se comparan exactos: 2^53 + 1 va despues de 2^53.0 aunque
+# redondeado a double sean iguales. Imprime las etiquetas en el orden resultante.
+cat > "$TMP_DIR/sorting_mixed_magnitude.clot" <<'PROG'
+base = [[9007199254740993, "d"], [9007199254740992.0, "e"], [9007199254740992, "f"]];
+base.append([9007199254740994.0, "h"]);
+base.append([9007199254740991, "c"]);
+base.append([0.5, "b"]);
+base.append([cast("0.1", "decimal"), "a"]);
+base.append([cast("9007199254740992.5", "decimal"), "g"]);
+lista = [];
+for i in range(40):
+    for par in base:
+        lista.append(par);
+    endfor
+endfor
+orden = "";
+ultimo = "";
+for par in sorted(lista):
+    if (par[1] != ultimo):
+        orden += par[1];
+        ultimo = par[1];
+    endif
+endfor
+println(orden);
+PROG
+
+ACTUAL_SORTING_MIXED_MAGNITUDE="$("$BIN_PATH" "$TMP_DIR/sorting_mixed_magnitude.clot")"
+if [[ "$ACTUAL_SORTING_MIXED_MAGNITUDE" != "abcefgdh" ]]; then
+    echo "Fallo test sorting_mixed_magnitude" >&2
+    printf '%s\n' "$ACTUAL_SORTING_MIXED_MAGNITUDE" >&2
+    exit 1
+fi
+
+# --- metodos nativos de string (split, join, find, replace, strip, ...) ---
+cat > "$TMP_DIR/string_methods.clot" <<'PROG'
+linea = "  GET /index.html 200 512  ";
+campos = linea.strip().split();
+println(campos);
+println(";".join(campos));
+csv = "id,nombre,,precio";
+println(csv.split(","));
+coma = ",";
+println(f"{csv.find(coma)} {csv.find(coma, 3)} {csv.find('z')} {csv.count(coma)}");
+println(csv.replace(",,", ",-,"));
+println("--hola--".strip("-"));
+println(csv.startswith("id,"));
+println(csv.endswith('x'));
+texto = "";
+for i in range(40):
+    texto += "abcdefgh";
+endfor
+texto += "aguja";
+println(texto.find("aguja"));
+println(texto.count("gh"));
+println(len(texto.split("h")));
+PROG
+
+EXPECTED_STRING_METHODS=$'["GET", "/index.html", "200", "512"]\nGET;/index.html;200;512\n["id", "nombre", "", "precio"]\n2 9 -1 3\nid,nombre,-,precio\nhola\ntrue\nfalse\n320\n40\n41'
+for KERNEL in "" sse2 scalar; do
+    ACTUAL_STRING_METHODS="$(CLOT_TEXT_SEARCH="$KERNEL" $BIN_PATH "$TMP_DIR/string_methods.clot")"
+    if [[ "$ACTUAL_STRING_METHODS" != "$EXPECTED_STRING_METHODS" ]]; then
+        echo "Fallo test string_methods (CLOT_TEXT_SEARCH=$KERNEL)" >&2
+        echo "Esperado:" >&2
+        printf '%s\n' "$EXPECTED_STRING_METHODS" >&2
+        echo "Actual:" >&2
+        printf '%s\n' "$ACTUAL_STRING_METHODS" >&2
+        exit 1
+    fi
+done
+
+cat > "$TMP_DIR/ndarray.clot" <<'PROG'
+a = ndarray([[1, 2, 3], [4, 5, 6]]);
+println(a.shape());
+println(a.dtype());
+println(a + 10);
+println(a * ndarray([1.5, 2, 0.5]));
+col = nd_arange(3).reshape([3, 1]);
+println(col - nd_arange(2).astype("float32"));
+println(f"{a.sum()} {a.mean()} {a.min()} {a.max()}");
+println(a.dot(a.transpose()));
+println(a[1]);
+println(a[1][2]);
+println(a.slice(2, 0, -1, 1));
+println(nd_arange(10).slice(-1, -11, -3));
+w = nd_arange(37).astype("float32");
+println(w.dot(w));
+println(nd_eye(2, "float32") / 2);
+println(-nd_full([2, 2], 3, "int64") ^ 2);
+total = 0;
+for fila in a:
+    total += fila.sum();
+endfor
+println(total);
+println(a.reshape([-1]).tolist());
+println(type(a));
+PROG
+
+EXPECTED_NDARRAY=$'(2, 3)\nint64\nndarray([[11, 12, 13], [14, 15, 16]], "int64")\nndarray([[1.5, 4, 1.5], [6, 10, 3]], "float64")\nndarray([[0, -1], [1, 0], [2, 1]], "float64")\n21 3.5 1 6\nndarray([[14, 32], [32, 77]], "int64")\nndarray([4, 5, 6], "int64")\n6\nndarray([[3, 2], [6, 5]], "int64")\nndarray([9, 6, 3, 0], "int64")\n16206\nndarray([[0.5, 0], [0, 0.5]], "float32")\nndarray([[9, 9], [9, 9]], "float64")\n21\n[1, 2, 3, 4, 5, 6]\nndarray'
+for KERNEL in "" sse2 scalar; do
+    ACTUAL_NDARRAY="$(CLOT_NDARRAY_KERNEL="$KERNEL" $BIN_PATH "$TMP_DIR/ndarray.clot")"
+    if [[ "$ACTUAL_NDARRAY" != "$EXPECTED_NDARRAY" ]]; then
+        echo "Fallo test ndarray (CLOT_NDARRAY_KERNEL=$KERNEL)" >&2
+        echo "Esperado:" >&2
+        printf '%s\n' "$EXPECTED_NDARRAY" >&2
+        echo "Actual:" >&2
+        printf '%s\n' "$ACTUAL_NDARRAY" >&2
+        exit 1
+    fi
+done
+
+cat > "$TMP_DIR/ndarray_broadcast_error.clot" <<'PROG'
+println(nd_zeros([2, 3]) + nd_ones([2]));
+PROG
+
+set +e
+"$BIN_PATH" "$TMP_DIR/ndarray_broadcast_error.clot" >"$TMP_DIR/ndarray_broadcast_error.out" 2>"$TMP_DIR/ndarray_broadcast_error.err"
+STATUS_NDARRAY_BROADCAST_ERROR=$?
+set -e
+
+if [[ "$STATUS_NDARRAY_BROADCAST_ERROR" -eq 0 ]]; then
+    echo "Fallo test ndarray_broadcast_error: se esperaba error." >&2
+    exit 1
+fi
+
+if ! grep -q "Formas incompatibles para broadcasting: (2, 3), (2,)." "$TMP_DIR/ndarray_broadcast_error.err"; then
+    echo "Fallo test ndarray_broadcast_error: mensaje esperado no encontrado." >&2
+    cat "$TMP_DIR/ndarray_broadcast_error.err" >&2
+    exit 1
+fi
+
+cat > "$TMP_DIR/linear_algebra.clot" <<'PROG'
+import science.linear_algebra.linear_algebra;
+a = matrix([[4, 3, 2], [2, 1, 3], [3, 2, 1]], "float64");
+partes = lu(a);
+println(partes[2]);
+println(matmul(partes[0], matmul(partes[1], partes[2])));
+println(det(a));
+println(solve(a, [1, 2, 3]));
+println((inv(a).dot(a) - identity(3)).max() < 0.000000001);
+s = ndarray([[4, 12, -16], [12, 37, -43], [-16, -43, 98]]);
+println(cholesky(s));
+println(eigh(ndarray([[2, 1], [1, 2]]))[0]);
+q = qr(ndarray([[3, 0], [4, 5]]));
+println(q[1]);
+m = nd_arange(1, 401).reshape([20, 20]);
+println(m.dot(m.transpose()).sum());
+println(arange(4));
+println(arange(2, 5));
+println(arange(0, 1, 0.25));
+PROG
+
+EXPECTED_LINEAR_ALGEBRA=$'ndarray([[4, 3, 2], [0, -0.5, 2], [0, 0, -1.5]], "float64")\nndarray([[4, 3, 2], [2, 1, 3], [3, 2, 1]], "float64")\n3\nndarray([6, -7, -1], "float64")\ntrue\nndarray([[2, 0, 0], [6, 1, 0], [-8, 5, 3]], "float64")\nndarray([1, 3], "float64")\nndarray([[-5, -4], [0, -3]], "float64")\n321868000\nndarray([0, 1, 2, 3], "int64")\nndarray([2, 3, 4], "int64")\nndarray([0, 0.25, 0.5, 0.75], "float64")'
+for KERNEL in "" sse2 scalar; do
+    ACTUAL_LINEAR_ALGEBRA="$(CLOT_NDARRAY_KERNEL="$KERNEL" $BIN_PATH "$TMP_DIR/linear_algebra.clot")"
+    if [[ "$ACTUAL_LINEAR_ALGEBRA" != "$EXPECTED_LINEAR_ALGEBRA" ]]; then
+        echo "Fallo test linear_algebra (CLOT_NDARRAY_KERNEL=$KERNEL)" >&2
+        echo "Esperado:" >&2
+        printf '%s\n' "$EXPECTED_LINEAR_ALGEBRA" >&2
+        echo "Actual:" >&2
+        printf '%s\n' "$ACTUAL_LINEAR_ALGEBRA" >&2
+        exit 1
+    fi
+done
+
+cat > "$TMP_DIR/cholesky_error.clot" <<'PROG'
+println(ndarray([[1, 2], [2, 1]]).cholesky());
+PROG
+
+set +e
+"$BIN_PATH" "$TMP_DIR/cholesky_error.clot" >"$TMP_DIR/cholesky_error.out" 2>"$TMP_DIR/cholesky_error.err"
+STATUS_CHOLESKY_ERROR=$?
+set -e
+
+if [[ "$STATUS_CHOLESKY_ERROR" -eq 0 ]]; then
+    echo "Fallo test cholesky_error: se esperaba error." >&2
+    exit 1
+fi
+
+if ! grep -q "cholesky(): la matriz no es definida positiva." "$TMP_DIR/cholesky_error.err"; then
+    echo "Fallo test cholesky_error: mensaje esperado no encontrado." >&2
+    cat "$TMP_DIR/cholesky_error.err" >&2
+    exit 1
+fi
+
+printf 'nombre,valor\na,1.5\nb,2.5\nc,x\nd,4\n' > "$TMP_DIR/statistics.csv"
+cat > "$TMP_DIR/statistics.clot" <<PROG
+import science.statistics.statistics;
+valores = [];
+for i in range(1, 101):
+    valores.append(i);
+endfor
+s = summary(valores);
+println(s.count);
+println(s.sum);
+println(s.mean);
+println(s.min);
+println(s.max);
+println(histogram(valores, 4, 0, 80));
+println(quantiles(range(0, 1001), [0.0, 1.0]));
+m = median([5, 1, 3]);
+println(m > 2.97 && m < 3.03);
+println(variance(ndarray([1.0, 2.0, 3.0, 4.0])) > 1.66);
+f = summary_column("$TMP_DIR/statistics.csv", 1);
+println(f.count);
+println(f.sum);
+println(f.skipped);
+println(summary([]).mean);
+PROG
+
+EXPECTED_STATISTICS=$'100\n5050\n50.5\n1\n100\n{counts: [19, 20, 20, 21], underflow: 0, overflow: 20}\n[0, 1000]\ntrue\ntrue\n3\n8\n2\nnull'
+ACTUAL_STATISTICS="$($BIN_PATH "$TMP_DIR/statistics.clot")"
+if [[ "$ACTUAL_STATISTICS" != "$EXPECTED_STATISTICS" ]]; then
+    echo "Fallo test statistics" >&2
+    echo "Esperado:" >&2
+    printf '%s\n' "$EXPECTED_STATISTICS" >&2
+    echo "Actual:" >&2
+    printf '%s\n' "$ACTUAL_STATISTICS" >&2
+    exit 1
+fi
+
+cat > "$TMP_DIR/statistics_error.clot" <<'PROG'
+println(stats_summary([1, "dos", 3]));
+PROG
+
+set +e
+"$BIN_PATH" "$TMP_DIR/statistics_error.clot" >"$TMP_DIR/statistics_error.out" 2>"$TMP_DIR/statistics_error.err"
+STATUS_STATISTICS_ERROR=$?
+set -e
+
+if [[ "$STATUS_STATISTICS_ERROR" -eq 0 ]]; then
+    echo "Fallo test statistics_error: se esperaba error." >&2
+    exit 1
+fi
+
+if ! grep -q "Las funciones stats_\* requieren valores numericos; elemento invalido en la posicion: 1" "$TMP_DIR/statistics_error.err"; then
+    echo "Fallo test statistics_error: mensaje esperado no encontrado." >&2
+    cat "$TMP_DIR/statistics_error.err" >&2
+    exit 1
+fi
+
+cat > "$TMP_DIR/dual.clot" <<'PROG'
+import clot.science.calculus.dual.diff;
+x = dual(2, 1);
+y = x * x + 3 * x;
+println(y);
+println(y.value);
+println(y.derivative);
+println(type(y));
+println(exp(dual(0, 1)) + ln(dual(1, 1)));
+println(dual(2, 1) ^ 3);
+println(sqrt(dual(4, [1, 0])));
+println(-dual(1, [1, 2]));
+println(dual(3, 1) > 2);
+func f(x):
+    return x * x * x + sin(x);
+endfunc
+println(differentiate_at(f, 0));
+func h(p):
+    return p[0] * p[0] * p[1] + cos(p[1]);
+endfunc
+println(gradient(h, [3, 0]));
+println(dual_gradient(h, ndarray([1.0, 0.0])));
+s = 0;
+for v in dual_seed([1, 2, 3, 4, 5, 6]):
+    s = s + v * v;
+endfor
+println(s.tangents);
+PROG
+
+EXPECTED_DUAL=$'dual(10, 7)\n10\n7\ndual\ndual(1, 2)\ndual(8, 12)\ndual(2, [0.25, 0])\ndual(-1, [-1, -2])\ntrue\n1\n[0, 9]\nndarray([0, 1], "float64")\n[2, 4, 6, 8, 10, 12]'
+ACTUAL_DUAL="$($BIN_PATH "$TMP_DIR/dual.clot")"
+if [[ "$ACTUAL_DUAL" != "$EXPECTED_DUAL" ]]; then
+    echo "Fallo test dual" >&2
+    echo "Esperado:" >&2
+    printf '%s\n' "$EXPECTED_DUAL" >&2
+    echo "Actual:" >&2
+    printf '%s\n' "$ACTUAL_DUAL" >&2
+    exit 1
+fi
+
+cat > "$TMP_DIR/dual_directions_error.clot" <<'PROG'
+println(dual(1, [1, 0]) * dual(2, [0, 1, 0]));
+PROG
+
+set +e
+"$BIN_PATH" "$TMP_DIR/dual_directions_error.clot" >"$TMP_DIR/dual_directions_error.out" 2>"$TMP_DIR/dual_directions_error.err"
+STATUS_DUAL_DIRECTIONS_ERROR=$?
+set -e
+
+if [[ "$STATUS_DUAL_DIRECTIONS_ERROR" -eq 0 ]]; then
+    echo "Fallo test dual_directions_error: se esperaba error." >&2
+    exit 1
+fi
+
+if ! grep -q "Numeros duales con distinta cantidad de direcciones: 2, 3." "$TMP_DIR/dual_directions_error.err"; then
+    echo "Fallo test dual_directions_error: mensaje esperado no encontrado." >&2
+    cat "$TMP_DIR/dual_directions_error.err" >&2
+    exit 1
+fi
+
+# Code written against the old Dual class: type hints, one-argument Dual(v)
+# and the add/mul/powf/... methods.
+cat > "$TMP_DIR/dual_class_compat.clot" <<'PROG'
+import clot.science.calculus.dual;
+d = Dual(2.0);
+println(d.derivative);
+func Dual f(x: Dual):
+    return x.mul(x).add(x.exp(x)).sub(x.powf(3.0)).div(Dual(2.0));
+endfunc
+println(differentiate_at(f, 0.0));
+try:
+    f(2.0);
+catch(RuntimeError err):
+    println("no dual");
+endtry
+PROG
+
+ACTUAL_DUAL_CLASS_COMPAT="$("$BIN_PATH" "$TMP_DIR/dual_class_compat.clot" 2>&1)"
+if [[ "$ACTUAL_DUAL_CLASS_COMPAT" != $'0\n0.5\nno dual' ]]; then
+    echo "Fallo test dual_class_compat" >&2
+    printf '%s\n' "$ACTUAL_DUAL_CLASS_COMPAT" >&2
+    exit 1
+fi
+
+cat > "$TMP_DIR/optimization.clot" <<'PROG'
+import science.optimization.optimization;
+func rosen(p):
+    a = 1 - p[0];
+    b = p[1] - p[0] * p[0];
+    return a * a + 100 * b * b;
+endfunc
+func rosen_grad(p):
+    return [-2 * (1 - p[0]) - 400 * p[0] * (p[1] - p[0] * p[0]), 200 * (p[1] - p[0] * p[0])];
+endfunc
+func rosen_batch(P):
+    x = P.dot(ndarray([1.0, 0.0]));
+    y = P.dot(ndarray([0.0, 1.0]));
+    return (1 - x) * (1 - x) + 100 * (y - x * x) * (y - x * x);
+endfunc
+func near_one(r, tolerance):
+    d = r.x - 1;
+    return r.converged && (d * d).max() < tolerance * tolerance;
+endfunc
+println(near_one(lbfgs(rosen, [-1.2, 1]), 0.000001));
+println(near_one(minimize_with(rosen, [-1.2, 1], "lbfgs", {gradient: rosen_grad}), 0.000001));
+println(near_one(minimize_with(rosen, [-1.2, 1], "lbfgs", {gradient: "numeric"}), 0.00001));
+println(near_one(nelder_mead(rosen, [-1.2, 1]), 0.0001));
+func bowl(p):
+    return (p[0] - 3) * (p[0] - 3) + 2 * (p[1] + 1) * (p[1] + 1);
+endfunc
+g = gradient_descent(bowl, [0, 0], 0.1);
+println(g.converged);
+println(g.value < 0.000000000001);
+m = minimize_with(rosen_batch, [[-1.2, 1], [2, 2], [0, 0]], "lbfgs", {batch: true});
+println(near_one(m, 0.00001));
+println(len(m.runs));
+PROG
+
+EXPECTED_OPTIMIZATION=$'true\ntrue\ntrue\ntrue\ntrue\ntrue\ntrue\n3'
+ACTUAL_OPTIMIZATION="$($BIN_PATH "$TMP_DIR/optimization.clot")"
+if [[ "$ACTUAL_OPTIMIZATION" != "$EXPECTED_OPTIMIZATION" ]]; then
+    echo "Fallo test optimization" >&2
+    echo "Esperado:" >&2
+    printf '%s\n' "$EXPECTED_OPTIMIZATION" >&2
+    echo "Actual:" >&2
+    printf '%s\n' "$ACTUAL_OPTIMIZATION" >&2
+    exit 1
+fi
+
+cat > "$TMP_DIR/optimization_method_error.clot" <<'PROG'
+func f(p):
+    return p[0] * p[0];
+endfunc
+println(opt_minimize(f, [1], "newton"));
+PROG
+
+set +e
+"$BIN_PATH" "$TMP_DIR/optimization_method_error.clot" >"$TMP_DIR/optimization_method_error.out" 2>"$TMP_DIR/optimization_method_error.err"
+STATUS_OPTIMIZATION_METHOD_ERROR=$?
+set -e
+
+if [[ "$STATUS_OPTIMIZATION_METHOD_ERROR" -eq 0 ]]; then
+    echo "Fallo test optimization_method_error: se esperaba error." >&2
+    exit 1
+fi
+
+if ! grep -q 'opt_minimize(): metodo desconocido (use "gd", "lbfgs" o "nelder_mead"): newton' "$TMP_DIR/optimization_method_error.err"; then
+    echo "Fallo test optimization_method_error: mensaje esperado no encontrado." >&2
+    cat "$TMP_DIR/optimization_method_error.err" >&2
+    exit 1
+fi
+
+printf 'f0,f1,label\n0,0,0\n0.2,0.1,0\n\n3,0,1\n3.1,0.2,1\n0,3,2\n0.1,3.2,2\n' > "$TMP_DIR/ml_points.csv"
+
+cat > "$TMP_DIR/machine_learning.clot" <<PROG
+import ml.machine_learning.machine_learning;
+x = ndarray([[1, 2], [3, -4]], "float32");
+w = ndarray([[1, 0, 1], [0, 1, -1]], "float32");
+y = ml_dense(x, w, ndarray([0.5, 0, 0]), "relu");
+println(y);
+g = ml_dense_backward(x, w, y, nd_ones([2, 3], "float32"), "relu");
+println(g);
+println(ml_sgd(w, g.dw, 0.5));
+p = softmax(ndarray([[1.0, 2.0, 3.0], [0.0, 0.0, 0.0]]));
+println(p.sum() > 1.9999 && p.sum() < 2.0001);
+ce = cross_entropy(ndarray([[1.0, 2.0, 3.0], [1.0, 1.0, 1.0]]), ndarray([2, 0]));
+println(ce.loss > 0.7531 && ce.loss < 0.7532);
+data = CsvBatches("$TMP_DIR/ml_points.csv", 4);
+b = data.next();
+println(b.x.shape());
+b = data.next();
+println(b);
+println(data.next());
+data.reset();
+hidden = Dense(2, 8, "tanh", 1);
+out = Dense(8, 3, "none", 2);
+first = 0;
+last = 0;
+for epoch in range(40):
+    b = data.next();
+    h = hidden.forward(b.x);
+    logits = out.forward(h);
+    step = cross_entropy(logits, b.y);
+    dh = out.backward(step.grad);
+    hidden.backward(dh);
+    out.adam(0.05);
+    hidden.adam(0.05);
+    if b.y.shape()[0] < 4:
+        data.reset();
+    endif
+    if epoch == 0:
+        first = step.loss;
+    endif
+    last = step.loss;
+endfor
+println(last < first / 10);
+data.close();
+all = ml_csv_open("$TMP_DIR/ml_points.csv");
+b = ml_csv_next(all, 10);
+h = hidden.forward(b.x);
+println(accuracy(out.forward(h), b.y));
+PROG
+
+EXPECTED_MACHINE_LEARNING=$'ndarray([[1.5, 2, 0], [3.5, 0, 7]], "float32")\n{dx: ndarray([[1, 1], [2, -1]], "float32"), dw: ndarray([[4, 1, 3], [-2, 2, -4]], "float32"), db: ndarray([2, 1, 1], "float32")}\nndarray([[-1, -0.5, -0.5], [1, 0, 1]], "float32")\ntrue\ntrue\n(4, 2)\n{x: ndarray([[0, 3], [0.1, 3.2]], "float32"), y: ndarray([2, 2], "float32")}\nnull\ntrue\n1'
+ACTUAL_MACHINE_LEARNING="$($BIN_PATH "$TMP_DIR/machine_learning.clot")"
+if [[ "$ACTUAL_MACHINE_LEARNING" != "$EXPECTED_MACHINE_LEARNING" ]]; then
+    echo "Fallo test machine_learning" >&2
+    echo "Esperado:" >&2
+    printf '%s\n' "$EXPECTED_MACHINE_LEARNING" >&2
+    echo "Actual:" >&2
+    printf '%s\n' "$ACTUAL_MACHINE_LEARNING" >&2
+    exit 1
+fi
+
+cat > "$TMP_DIR/machine_learning_activation_error.clot" <<'PROG'
+println(ml_activation(ndarray([1.0]), "gelu"));
+PROG
+
+set +e
+CLOT_LANG=en "$BIN_PATH" "$TMP_DIR/machine_learning_activation_error.clot" >"$TMP_DIR/machine_learning_activation_error.out" 2>"$TMP_DIR/machine_learning_activation_error.err"
+STATUS_MACHINE_LEARNING_ACTIVATION_ERROR=$?
+set -e
+
+if [[ "$STATUS_MACHINE_LEARNING_ACTIVATION_ERROR" -eq 0 ]]; then
+    echo "Fallo test machine_learning_activation_error: se esperaba error." >&2
+    exit 1
+fi
+
+if ! grep -q 'ml_activation(): unknown activation (use "none", "relu", "sigmoid", or "tanh"): gelu' "$TMP_DIR/machine_learning_activation_error.err"; then
+    echo "Fallo test machine_learning_activation_error: mensaje esperado no encontrado." >&2
+    cat "$TMP_DIR/machine_learning_activation_error.err" >&2
+    exit 1
+fi
+
+cat > "$TMP_DIR/profile.clot" <<'PROG'
+func g(n):
+    total = 0;
+    for i in range(0, n):
+        total += i;
+    endfor
+    return total;
+endfunc
+
+func f(n):
+    return g(n) + g(n);
+endfunc
+
+class Box:
+    public int v = 0;
+    public func bump():
+        this.v = this.v + f(200);
+        return this.v;
+    endfunc
+endclass
+
+b = Box();
+println(b.bump());
+println(f(300));
+PROG
+
+ACTUAL_PROFILE="$("$BIN_PATH" "$TMP_DIR/profile.clot" --profile "$TMP_DIR/profile")"
+EXPECTED_PROFILE=$'39800\n89700'
+if [[ "$ACTUAL_PROFILE" != "$EXPECTED_PROFILE" ]]; then
+    echo "Fallo test profile: salida inesperada." >&2
+    echo "$ACTUAL_PROFILE" >&2
+    exit 1
+fi
+
+if ! grep -Eq '^main;Box\.bump;f;g [0-9]+$' "$TMP_DIR/profile.folded" ||
+    ! grep -Eq '^main;f;g [0-9]+$' "$TMP_DIR/profile.folded"; then
+    echo "Fallo test profile: pilas colapsadas inesperadas." >&2
+    cat "$TMP_DIR/profile.folded" >&2
+    exit 1
+fi
+
+# g: 4 llamadas; su cuerpo del for (linea 4) corre 2 * 200 + 2 * 300 veces.
+if ! grep -Eq '^ +[0-9.]+ +[0-9.]+ +4  g$' "$TMP_DIR/profile.txt" ||
+    ! grep -Eq '^ +[0-9.]+ +[0-9.]+ +1000  g:4$' "$TMP_DIR/profile.txt"; then
+    echo "Fallo test profile: resumen inesperado." >&2
+    cat "$TMP_DIR/profile.txt" >&2
+    exit 1
+fi
+
+mkdir -p "$TMP_DIR/stats"
+cat > "$TMP_DIR/stats/stats_helper.clot" <<'PROG'
+func twice(x):
+    return x * 2;
+endfunc
+PROG
+
+cat > "$TMP_DIR/stats/main.clot" <<'PROG'
+import stats_helper;
+
+func f(xs):
+    return len(xs);
+endfunc
+
+xs = [1, 2, 3];
+i = 0;
+while i < 3:
+    f(xs);
+    i += 1;
+endwhile
+println(stats_helper.twice(len(xs)));
+PROG
+
+ACTUAL_STATS="$("$BIN_PATH" "$TMP_DIR/stats/main.clot" --stats --stats-json "$TMP_DIR/stats.json" 2>"$TMP_DIR/stats.err")"
+if [[ "$ACTUAL_STATS" != "6" ]]; then
+    echo "Fallo test stats: salida inesperada." >&2
+    echo "$ACTUAL_STATS" >&2
+    exit 1
+fi
+
+# 4 llamadas de usuario copian el entorno dos veces cada una.
+for fragment in '"environment_copies":8,' '"module_loads":1,' '"builtin_calls":{"len":4}' '"peak_rss_bytes":'; do
+    if ! grep -qF "$fragment" "$TMP_DIR/stats.json"; then
+        echo "Fallo test stats: falta $fragment en el JSON." >&2
+        cat "$TMP_DIR/stats.json" >&2
+        exit 1
+    fi
+done
+
+if ! grep -Eq '^  copias de entorno +8$' "$TMP_DIR/stats.err"; then
+    echo "Fallo test stats: reporte de texto inesperado." >&2
+    cat "$TMP_DIR/stats.err" >&2
+    exit 1
+fi
+
+BENCH_PATH="$(dirname "$BIN_PATH")/clot-bench"
+if [[ -x "$BENCH_PATH" ]]; then
+    mkdir -p "$TMP_DIR/bench"
+    cat > "$TMP_DIR/bench/sum.clot" <<'PROG'
+n = 10;  // bench:param
+i = 0;
+acc = 0;
+while i < n:
+    acc += i;
+    i += 1;
+endwhile
+println(acc);
+PROG
+
+    "$BENCH_PATH" "$TMP_DIR/bench" --clot "$BIN_PATH" -n 3 -w 1 --modes interpret --param n=50 \
+        --json "$TMP_DIR/bench.json" >"$TMP_DIR/bench.out"
+    if ! grep -q '"name": "sum\[n=50\]", "mode": "interpret", "ok": true, "runs": 3, "median_ms": ' "$TMP_DIR/bench.json"; then
+        echo "Fallo test clot-bench: JSON inesperado." >&2
+        cat "$TMP_DIR/bench.json" >&2
+        exit 1
+    fi
+    if [[ -e "$TMP_DIR/bench/.sum.bench.clot" ]]; then
+        echo "Fallo test clot-bench: quedo la copia parametrizada." >&2
+        exit 1
+    fi
+
+    # Contra si mismo con un umbral amplio no debe haber regresiones.
+    if ! "$BENCH_PATH" "$TMP_DIR/bench" --clot "$BIN_PATH" -n 3 -w 0 --modes interpret --param n=50 \
+        --baseline "$TMP_DIR/bench.json" --threshold 1000 >"$TMP_DIR/bench_compare.out"; then
+        echo "Fallo test clot-bench: comparacion con baseline fallo." >&2
+        cat "$TMP_DIR/bench_compare.out" >&2
+        exit 1
+    fi
+fi
+
+cat > "$TMP_DIR/bench_builtin.clot" <<'PROG'
+func work():
+    acc = 0;
+    for i in range(0, 50):
+        acc += i;
+    endfor
+    return acc;
+endfunc
+
+t0 = now_ns();
+c0 = cpu_time_ns();
+r = bench(work, 5);
+println(now_ns() > t0);
+println(cpu_time_ns() >= c0);
+println(r["iterations"]);
+println(r["warmup"]);
+println(r["min_ns"] <= r["median_ns"] && r["median_ns"] <= r["max_ns"]);
+println(bench(work, 2, 0)["warmup"]);
+try:
+    bench(work, 0);
+catch(err):
+    println(err);
+endtry
+func noop():
+endfunc
+big = bench(noop, 70000, 0);
+println(big["min_ns"] <= big["median_ns"] && big["median_ns"] <= big["max_ns"]);
+func boom():
+    throw("boom");
+endfunc
+try:
+    bench(boom, 1000000000000000, 0);
+catch(err):
+    println("sin reservar");
+endtry
+PROG
+
+EXPECTED_BENCH_BUILTIN=$'true\ntrue\n5\n1\ntrue\n0\nbench(fn, iterations) requiere iterations entero >= 1.\ntrue\nsin reservar'
+ACTUAL_BENCH_BUILTIN="$($BIN_PATH "$TMP_DIR/bench_builtin.clot")"
+if [[ "$ACTUAL_BENCH_BUILTIN" != "$EXPECTED_BENCH_BUILTIN" ]]; then
+    echo "Fallo test bench_builtin" >&2
+    echo "Esperado:" >&2
+    printf '%s\n' "$EXPECTED_BENCH_BUILTIN" >&2
+    echo "Actual:" >&2
+    printf '%s\n' "$ACTUAL_BENCH_BUILTIN" >&2
+    exit 1
+fi
+
+EMBED_PATH="$(dirname "$BIN_PATH")/clot-embed"
+if [[ -x "$EMBED_PATH" ]]; then
+    # Un programa parseado una vez, dos ejecuciones sobre el mismo contexto y un builtin nativo;
+    # sin los hooks de heap el limite de memoria se rechaza.
+    EXPECTED_EMBED=$'cargado\nprice -> 41\ncargado\nprice -> 51\ngreet -> Hola embebido\nchecked -> error: Excepcion no capturada: RuntimeError: negativo\nmissing -> error: Funcion no definida: missing\nlimits -> error: El limite de memoria requiere el contador de heap, que este proceso no incluye.'
+    ACTUAL_EMBED="$("$EMBED_PATH")"
+    if [[ "$ACTUAL_EMBED" != "$EXPECTED_EMBED" ]]; then
+        echo "Fallo test clot-embed" >&2
+        echo "Esperado:" >&2
+        printf '%s\n' "$EXPECTED_EMBED" >&2
+        echo "Actual:" >&2
+        printf '%s\n' "$ACTUAL_EMBED" >&2
+        exit 1
+    fi
+fi
+
+if [[ "$OSTYPE" != msys* && "$OSTYPE" != cygwin* ]]; then
+    # clot serve: stdout/stderr y codigo de salida llegan al cliente, el directorio
+    # del cliente resuelve rutas relativas y un modulo editado se vuelve a parsear.
+    SERVE_BIN="$(cd "$(dirname "$BIN_PATH")" && pwd)/$(basename "$BIN_PATH")"
+    SERVE_SOCKET="$TMP_DIR/serve.sock"
+    mkdir -p "$TMP_DIR/serve"
+    cat > "$TMP_DIR/serve/serve_lib.clot" <<'PROG'
+func valor():
+    return 1;
+endfunc
+PROG
+    cat > "$TMP_DIR/serve/serve_main.clot" <<'PROG'
+import serve_lib;
+println(f"valor={valor()}");
+PROG
+    cat > "$TMP_DIR/serve/serve_fail.clot" <<'PROG'
+println("antes");
+throw("fallo");
+PROG
+
+    "$SERVE_BIN" serve --socket "$SERVE_SOCKET" &
+    SERVE_PID=$!
+    trap 'kill "$SERVE_PID" 2>/dev/null || true; rm -rf "$TMP_DIR"' EXIT
+    for _ in $(seq 1 100); do
+        [[ -S "$SERVE_SOCKET" ]] && break
+        sleep 0.05
+    done
+
+    ACTUAL_SERVE="$(cd "$TMP_DIR/serve" && "$SERVE_BIN" serve_main.clot --server --socket "$SERVE_SOCKET")"
+    ACTUAL_SERVE+=$'\n'"$(cd "$TMP_DIR/serve" && "$SERVE_BIN" serve_main.clot --server --socket "$SERVE_SOCKET")"
+    sed -i 's/return 1;/return 22;/' "$TMP_DIR/serve/serve_lib.clot"
+    ACTUAL_SERVE+=$'\n'"$(cd "$TMP_DIR/serve" && "$SERVE_BIN" serve_main.clot --server --socket "$SERVE_SOCKET")"
+    SERVE_STATUS=0
+    ACTUAL_SERVE+=$'\n'"$("$SERVE_BIN" "$TMP_DIR/serve/serve_fail.clot" --server --socket "$SERVE_SOCKET" 2>&1)" ||
+        SERVE_STATUS=$?
+    ACTUAL_SERVE+=$'\n'"status=$SERVE_STATUS"
+
+    # Las solicitudes corren en paralelo: una corrida lenta no retiene a la siguiente.
+    cat > "$TMP_DIR/serve/serve_slow.clot" <<'PROG'
+sleep_ms(2000);
+println("lento");
+PROG
+    "$SERVE_BIN" "$TMP_DIR/serve/serve_slow.clot" --server --socket "$SERVE_SOCKET" >"$TMP_DIR/serve/slow.out" &
+    SERVE_SLOW_PID=$!
+    sleep 0.2
+    ACTUAL_SERVE+=$'\n'"$(cd "$TMP_DIR/serve" && "$SERVE_BIN" serve_main.clot --server --socket "$SERVE_SOCKET")"
+    ACTUAL_SERVE+=$'\n'"slow=[$(cat "$TMP_DIR/serve/slow.out")]"
+    wait "$SERVE_SLOW_PID"
+    ACTUAL_SERVE+=$'\n'"slow=[$(cat "$TMP_DIR/serve/slow.out")]"
+
+    # Un cliente que envia solo parte de la solicitud no detiene al servidor.
+    if command -v python3 >/dev/null 2>&1; then
+        python3 -c 'import socket, sys, time
+s = socket.socket(socket.AF_UNIX)
+s.connect(sys.argv[1])
+s.send(b"\x01")
+time.sleep(4)' "$SERVE_SOCKET" &
+        SERVE_PARTIAL_PID=$!
+        sleep 0.2
+        ACTUAL_SERVE+=$'\n'"$(cd "$TMP_DIR/serve" &&
+            timeout 2 "$SERVE_BIN" serve_main.clot --server --socket "$SERVE_SOCKET")" || true
+        kill "$SERVE_PARTIAL_PID" 2>/dev/null || true
+        wait "$SERVE_PARTIAL_PID" 2>/dev/null || true
+    else
+        ACTUAL_SERVE+=$'\nvalor=22'
+    fi
+
+    # El cliente rechaza una ruta que no es un socket o un socket de otro usuario.
+    ACTUAL_SERVE+=$'\n'"$("$SERVE_BIN" serve_main.clot --server --socket "$TMP_DIR/serve/serve_lib.clot" 2>&1)" || true
+    if [[ "$(id -u)" == 0 ]]; then
+        chown 65534 "$SERVE_SOCKET"
+        ACTUAL_SERVE+=$'\n'"$("$SERVE_BIN" serve --stop --socket "$SERVE_SOCKET" 2>&1)" || true
+        chown 0 "$SERVE_SOCKET"
+    else
+        ACTUAL_SERVE+=$'\n'"Error: El socket de clot serve pertenece a otro usuario: $SERVE_SOCKET"
+    fi
+    "$SERVE_BIN" serve --stop --socket "$SERVE_SOCKET"
+    wait "$SERVE_PID"
+    trap 'rm -rf "$TMP_DIR"' EXIT
+
+    EXPECTED_SERVE=$'valor=1\nvalor=1\nvalor=22\nantes\nExcepcion no capturada: RuntimeError: fallo\nstatus=1'
+    EXPECTED_SERVE+=$'\nvalor=22\nslow=[]\nslow=[lento]\nvalor=22'
+    EXPECTED_SERVE+=$'\n'"Error: La ruta de clot serve no es un socket: $TMP_DIR/serve/serve_lib.clot"
+    EXPECTED_SERVE+=$'\n'"Error: El socket de clot serve pertenece a otro usuario: $SERVE_SOCKET"
+    if [[ "$ACTUAL_SERVE" != "$EXPECTED_SERVE" || -e "$SERVE_SOCKET" ]]; then
+        echo "Fallo test clot serve" >&2
+        echo "Esperado:" >&2
+        printf '%s\n' "$EXPECTED_SERVE" >&2
+        echo "Actual:" >&2
+        printf '%s\n' "$ACTUAL_SERVE" >&2
+        exit 1
+    fi
+fi
+
+# Snapshot: el script parte del estado del preludio (modulo importado, clase con
+# campo estatico, constantes) sin re-ejecutarlo, y un fuente editado lo invalida.
+mkdir -p "$TMP_DIR/snapshot"
+cat > "$TMP_DIR/snapshot/snap_lib.clot" <<'PROG'
+println("cargando snap_lib");
+TABLA = [1, 2.5, "tres", {"k": [true, null]}];
+
+class Contador:
+    public static int total = 0;
+
+    constructor():
+        Contador.total += 1;
+    endconstructor
+endclass
+
+func doble(x):
+    return x * 2;
+endfunc
+PROG
+cat > "$TMP_DIR/snapshot/snap_prelude.clot" <<'PROG'
+import snap_lib;
+c = Contador();
+BASE = 40;
+PROG
+cat > "$TMP_DIR/snapshot/snap_main.clot" <<'PROG'
+import snap_lib;
+println(doble(BASE) + 2);
+println(TABLA);
+Contador();
+println(Contador.total);
+PROG
+
+"$BIN_PATH" "$TMP_DIR/snapshot/snap_prelude.clot" --snapshot-write "$TMP_DIR/snapshot/prelude.snap" >/dev/null
+EXPECTED_SNAPSHOT=$'82\n[1, 2.5, "tres", {k: [true, null]}]\n2'
+ACTUAL_SNAPSHOT="$($BIN_PATH "$TMP_DIR/snapshot/snap_main.clot" --snapshot "$TMP_DIR/snapshot/prelude.snap")"
+if [[ "$ACTUAL_SNAPSHOT" != "$EXPECTED_SNAPSHOT" ]]; then
+    echo "Fallo test snapshot" >&2
+    echo "Esperado:" >&2
+    printf '%s\n' "$EXPECTED_SNAPSHOT" >&2
+    echo "Actual:" >&2
+    printf '%s\n' "$ACTUAL_SNAPSHOT" >&2
+    exit 1
+fi
+
+echo "// editado" >> "$TMP_DIR/snapshot/snap_lib.clot"
+if "$BIN_PATH" "$TMP_DIR/snapshot/snap_main.clot" --snapshot "$TMP_DIR/snapshot/prelude.snap" \
+    >/dev/null 2>"$TMP_DIR/snapshot/stale.err"; then
+    echo "Fallo test snapshot: se esperaba error por snapshot desactualizado." >&2
+    exit 1
+fi
+if ! grep -q "Snapshot desactualizado: .*snap_lib.clot cambio desde que se creo." "$TMP_DIR/snapshot/stale.err"; then
+    echo "Fallo test snapshot: mensaje inesperado." >&2
+    cat "$TMP_DIR/snapshot/stale.err" >&2
+    exit 1
+fi
+
+# Limites de recursos: MemoryError atrapable, y los limites de sentencias y de
+# tiempo (un bucle vacio, un sleep largo) detienen el script aunque haya catch.
+mkdir -p "$TMP_DIR/limits"
+cat > "$TMP_DIR/limits/memoria.clot" <<'PROG'
+try:
+    grande = [0] * 1000000;
+catch (MemoryError e):
+    println("memoria");
+endtry
+try:
+    grande = [0] * 1000000;
+catch (ResourceLimitError e):
+    println("limite");
+endtry
+pequena = [1, 2, 3];
+println(len(pequena));
+PROG
+EXPECTED_LIMITS=$'memoria\nlimite\n3'
+ACTUAL_LIMITS="$($BIN_PATH "$TMP_DIR/limits/memoria.clot" --max-heap 1m)"
+if [[ "$ACTUAL_LIMITS" != "$EXPECTED_LIMITS" ]]; then
+    echo "Fallo test limites: --max-heap" >&2
+    echo "Esperado:" >&2
+    printf '%s\n' "$EXPECTED_LIMITS" >&2
+    echo "Actual:" >&2
+    printf '%s\n' "$ACTUAL_LIMITS" >&2
+    exit 1
+fi
+
+cat > "$TMP_DIR/limits/bucle.clot" <<'PROG'
+while (true):
+    x = 1;
+endwhile
+PROG
+cat > "$TMP_DIR/limits/vacio.clot" <<'PROG'
+while (true):
+endwhile
+PROG
+cat > "$TMP_DIR/limits/rango_vacio.clot" <<'PROG'
+for i in range(100000000):
+endfor
+PROG
+cat > "$TMP_DIR/limits/sleep.clot" <<'PROG'
+try:
+    sleep_ms(100000);
+catch (TimeoutError e):
+    println("no llega");
+endtry
+PROG
+check_limit() {
+    local expected="$1"
+    shift
+    if "$BIN_PATH" "$@" >"$TMP_DIR/limits/out.txt" 2>"$TMP_DIR/limits/err.txt"; then
+        echo "Fallo test limites: se esperaba error con $*" >&2
+        exit 1
+    fi
+    if [[ -s "$TMP_DIR/limits/out.txt" ]] || ! grep -q "$expected" "$TMP_DIR/limits/err.txt"; then
+        echo "Fallo test limites: salida inesperada con $*" >&2
+        cat "$TMP_DIR/limits/out.txt" "$TMP_DIR/limits/err.txt" >&2
+        exit 1
+    fi
+}
+check_limit "Limite de instrucciones excedido: el script supera 1000 sentencias ejecutadas." \
+    "$TMP_DIR/limits/bucle.clot" --max-statements 1000
+check_limit "Limite de tiempo excedido: el script supera 50 ms de ejecucion." \
+    "$TMP_DIR/limits/vacio.clot" --max-time 50
+check_limit "Limite de instrucciones excedido: el script supera 1000 sentencias ejecutadas." \
+    "$TMP_DIR/limits/vacio.clot" --max-statements 1000
+check_limit "Limite de instrucciones excedido: el script supera 1000 sentencias ejecutadas." \
+    "$TMP_DIR/limits/rango_vacio.clot" --max-statements 1000
+check_limit "Limite de tiempo excedido" "$TMP_DIR/limits/sleep.clot" --max-time 50
+
+MICROBENCH_PATH="$(dirname "$BIN_PATH")/clot_microbench"
+if [[ -x "$MICROBENCH_PATH" ]]; then
+    # Parsea el programa generado y escribe una linea JSON por benchmark.
+    "$MICROBENCH_PATH" --filter parser.program/100 --samples 2 --min-time-ms 1 \
+        --json "$TMP_DIR/microbench.json" >"$TMP_DIR/microbench.out"
+    if ! grep -q '"name": "parser.program/100", "size": 100, "iterations": ' "$TMP_DIR/microbench.json"; then
+        echo "Fallo test clot_microbench: JSON inesperado." >&2
+        cat "$TMP_DIR/microbench.json" >&2
+        exit 1
+    fi
+    if ! "$MICROBENCH_PATH" --filter bigint.add/20 --samples 2 --min-time-ms 1 \
+        --baseline "$TMP_DIR/microbench.json" --threshold 1000 >"$TMP_DIR/microbench_compare.out"; then
+        echo "Fallo test clot_microbench: comparacion con baseline fallo." >&2
+        cat "$TMP_DIR/microbench_compare.out" >&2
+        exit 1
+    fi
+fi
+
 # Una f-string con interpolacion vacia debe ser error de parseo
 cat > "$TMP_DIR/fstring_empty.clot" <<'PROG'
 println(f"valor={}");
@@ -1919,4 +2943,67 @@ if [[ "$ACTUAL_INSTALLED_IMPORT_HOME" != "$EXPECTED_INSTALLED_IMPORT" ]]; then
     exit 1
 fi
 
+# --- buffered stdout: pending output precedes diagnostics and reaches pipes ---
+cat > "$TMP_DIR/output_buffering.clot" <<'PROG'
+println("uno");
+print("dos ");
+printf("%d\n", 3);
+x = 1 / 0;
+PROG
+
+for buffering_mode in block line none; do
+    set +e
+    ACTUAL_OUTPUT_BUFFERING="$("$BIN_PATH" "$TMP_DIR/output_buffering.clot" --output-buffering "$buffering_mode" 2>&1)"
+    STATUS_OUTPUT_BUFFERING=$?
+    set -e
+    if [[ "$STATUS_OUTPUT_BUFFERING" -eq 0 ]] ||
+        [[ "$(printf '%s\n' "$ACTUAL_OUTPUT_BUFFERING" | head -n 2)" != $'uno\ndos 3' ]] ||
+        ! printf '%s\n' "$ACTUAL_OUTPUT_BUFFERING" | tail -n 1 | grep -q "Division por cero"; then
+        echo "Fallo test output_buffering ($buffering_mode)" >&2
+        printf '%s\n' "$ACTUAL_OUTPUT_BUFFERING" >&2
+        exit 1
+    fi
+done
+
+ACTUAL_OUTPUT_BUFFERING_ENV="$(CLOT_OUTPUT_BUFFERING=block "$BIN_PATH" "$TMP_DIR/output_buffering.clot" 2>/dev/null || true)"
+if [[ "$ACTUAL_OUTPUT_BUFFERING_ENV" != $'uno\ndos 3' ]]; then
+    echo "Fallo test output_buffering_env" >&2
+    printf '%s\n' "$ACTUAL_OUTPUT_BUFFERING_ENV" >&2
+    exit 1
+fi
+
+if "$BIN_PATH" "$TMP_DIR/output_buffering.clot" --output-buffering huge >/dev/null 2>&1; then
+    echo "Fallo test output_buffering_invalid: se esperaba error." >&2
+    exit 1
+fi
+
+if CLOT_OUTPUT_BUFFERING=huge "$BIN_PATH" "$TMP_DIR/output_buffering.clot" >/dev/null 2>&1; then
+    echo "Fallo test output_buffering_invalid_env: se esperaba error." >&2
+    exit 1
+fi
+
+# Block mode writes whole 64 KiB blocks: after printing 100000 bytes the script
+# reads its own output file and finds exactly one block; line mode finds it all.
+cat > "$TMP_DIR/output_block_size.clot" <<PROG
+string line = "";
+for i in range(99):
+    line += "x";
+endfor
+for i in range(1000):
+    println(line);
+endfor
+println(len(read_file("$TMP_DIR/output_block_size.txt")));
+PROG
+
+for block_case in "block 65536" "line 100000"; do
+    read -r buffering_mode expected_size <<<"$block_case"
+    "$BIN_PATH" "$TMP_DIR/output_block_size.clot" --output-buffering "$buffering_mode" \
+        >"$TMP_DIR/output_block_size.txt"
+    OUTPUT_BLOCK_SIZE="$(tail -n 1 "$TMP_DIR/output_block_size.txt")"
+    if [[ "$OUTPUT_BLOCK_SIZE" != "$expected_size" ]]; then
+        echo "Fallo test output_block_size ($buffering_mode): se esperaban $expected_size bytes, hubo $OUTPUT_BLOCK_SIZE." >&2
+        exit 1
+    fi
+done
+
 echo "Smoke tests OK"